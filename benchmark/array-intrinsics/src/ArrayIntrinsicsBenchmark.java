@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.Arrays;
+
+public class ArrayIntrinsicsBenchmark {
+    private static final int SIZE = 1024;
+
+    private final byte[] bytes = new byte[SIZE];
+    private final byte[] sameBytes = new byte[SIZE];
+    private final char[] chars = new char[SIZE];
+
+    public ArrayIntrinsicsBenchmark() {
+        for (int i = 0; i < SIZE; ++i) {
+            bytes[i] = (byte) (i * 37);
+            sameBytes[i] = bytes[i];
+            chars[i] = (char) ('a' + i % 26);
+        }
+    }
+
+    public int timeStringHashCode(int count) {
+        int result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            // A new string does not have a cached hash code.
+            result += new String(chars).hashCode();
+        }
+        return result;
+    }
+
+    public int timeStringHashCodeLoop(int count) {
+        int result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            String s = new String(chars);
+            int h = 0;
+            for (int i = 0; i < s.length(); ++i) {
+                h = 31 * h + s.charAt(i);
+            }
+            result += h;
+        }
+        return result;
+    }
+
+    public int timeArraysHashCode(int count) {
+        int result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            result += Arrays.hashCode(bytes);
+        }
+        return result;
+    }
+
+    public int timeArraysHashCodeLoop(int count) {
+        byte[] a = bytes;
+        int result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            int h = 1;
+            for (int i = 0; i < a.length; ++i) {
+                h = 31 * h + a[i];
+            }
+            result += h;
+        }
+        return result;
+    }
+
+    public int timeArraysEquals(int count) {
+        int result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            if (Arrays.equals(bytes, sameBytes)) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    public int timeArraysEqualsLoop(int count) {
+        byte[] a = bytes;
+        byte[] b = sameBytes;
+        int result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            boolean equal = true;
+            for (int i = 0; i < a.length; ++i) {
+                if (a[i] != b[i]) {
+                    equal = false;
+                    break;
+                }
+            }
+            if (equal) {
+                ++result;
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.zip.Adler32;
+import java.util.zip.CRC32;
+import java.util.zip.Checksum;
+
+public class ChecksumBenchmark {
+    private static final int SMALL_SIZE = 64;
+    private static final int MEDIUM_SIZE = 1024;
+    private static final int LARGE_SIZE = 64 * 1024;
+
+    private final byte[] bytes = new byte[LARGE_SIZE];
+
+    public ChecksumBenchmark() {
+        for (int i = 0; i < LARGE_SIZE; ++i) {
+            bytes[i] = (byte) (i * 37);
+        }
+    }
+
+    private long checksumOfBytes(Checksum checksum, int size, int count) {
+        long result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            checksum.reset();
+            checksum.update(bytes, 0, size);
+            result += checksum.getValue();
+        }
+        return result;
+    }
+
+    private long checksumOfSingleBytes(Checksum checksum, int count) {
+        long result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            checksum.reset();
+            for (int i = 0; i < SMALL_SIZE; ++i) {
+                checksum.update(bytes[i]);
+            }
+            result += checksum.getValue();
+        }
+        return result;
+    }
+
+    public long timeCRC32Small(int count) {
+        return checksumOfBytes(new CRC32(), SMALL_SIZE, count);
+    }
+
+    public long timeCRC32Medium(int count) {
+        return checksumOfBytes(new CRC32(), MEDIUM_SIZE, count);
+    }
+
+    public long timeCRC32Large(int count) {
+        return checksumOfBytes(new CRC32(), LARGE_SIZE, count);
+    }
+
+    public long timeCRC32SingleBytes(int count) {
+        return checksumOfSingleBytes(new CRC32(), count);
+    }
+
+    public long timeAdler32Small(int count) {
+        return checksumOfBytes(new Adler32(), SMALL_SIZE, count);
+    }
+
+    public long timeAdler32Medium(int count) {
+        return checksumOfBytes(new Adler32(), MEDIUM_SIZE, count);
+    }
+
+    public long timeAdler32Large(int count) {
+        return checksumOfBytes(new Adler32(), LARGE_SIZE, count);
+    }
+
+    public long timeAdler32SingleBytes(int count) {
+        return checksumOfSingleBytes(new Adler32(), count);
+    }
+}
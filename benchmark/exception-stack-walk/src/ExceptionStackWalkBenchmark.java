@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class ExceptionStackWalkBenchmark {
+    private static final int DEPTH = 16;
+    private static final int THROWS_PER_ITERATION = 100;
+
+    static class ValueException extends Exception {
+        final int value;
+
+        ValueException(int value) {
+            this.value = value;
+        }
+    }
+
+    // Not inlined, so that each level is a separate JIT frame.
+    private static int descend(int depth, int value) throws ValueException {
+        if (depth == 0) {
+            throw new ValueException(value);
+        }
+        try {
+            return descend(depth - 1, value + 1) + 1;
+        } finally {
+            value ^= depth;
+        }
+    }
+
+    private static int throwAndCatch(int count) {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            try {
+                sum += descend(DEPTH, i);
+            } catch (ValueException e) {
+                sum += e.value;
+            }
+        }
+        return sum;
+    }
+
+    private static int expectedSum(int count) {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += i + DEPTH;
+        }
+        return sum;
+    }
+
+    private static void runThreads(int numThreads, int count) {
+        final int throwsPerThread = count * THROWS_PER_ITERATION;
+        final int expected = expectedSum(throwsPerThread);
+        Thread[] threads = new Thread[numThreads];
+        final boolean[] failed = new boolean[numThreads];
+        for (int t = 0; t < numThreads; ++t) {
+            final int index = t;
+            threads[t] = new Thread(() -> {
+                if (throwAndCatch(throwsPerThread) != expected) {
+                    failed[index] = true;
+                }
+            });
+            threads[t].start();
+        }
+        for (int t = 0; t < numThreads; ++t) {
+            try {
+                threads[t].join();
+            } catch (InterruptedException e) {
+                throw new AssertionError(e);
+            }
+            if (failed[t]) {
+                throw new AssertionError();
+            }
+        }
+    }
+
+    public void timeThrow1Thread(int count) {
+        runThreads(1, count);
+    }
+
+    public void timeThrow4Threads(int count) {
+        runThreads(4, count);
+    }
+
+    public void timeThrow16Threads(int count) {
+        runThreads(16, count);
+    }
+}
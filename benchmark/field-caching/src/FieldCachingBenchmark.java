@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class FieldCachingBenchmark {
+    private static final int SIZE = 1024;
+
+    private final int[] values = new int[SIZE];
+    private final int[] histogram = new int[16];
+
+    // Configuration read by the loops, never written by `record`.
+    private int scale = 3;
+    private int offset = 7;
+    private int limit = 1 << 20;
+
+    // Statistics written by `record`. They have the same type as the configuration.
+    private int total;
+    private int max;
+    private int clamped;
+
+    public FieldCachingBenchmark() {
+        for (int i = 0; i < SIZE; ++i) {
+            values[i] = (i * 31) ^ (i >> 3);
+        }
+    }
+
+    // Large enough not to be inlined.
+    private void record(int value) {
+        histogram[value & 15]++;
+        histogram[(value >> 4) & 15]++;
+        histogram[(value >> 8) & 15]++;
+        total += value;
+        if (value > max) {
+            max = value;
+        }
+        if (value < 0) {
+            clamped++;
+            total -= value;
+        }
+    }
+
+    private void reset() {
+        total = 0;
+        max = 0;
+        clamped = 0;
+    }
+
+    public void timeFieldLoadsAcrossCall(int count) {
+        int[] values = this.values;
+        for (int iter = 0; iter < count; ++iter) {
+            reset();
+            for (int i = 0; i < values.length; ++i) {
+                int value = values[i] * scale + offset;
+                if (value > limit) {
+                    value = limit;
+                }
+                record(value);
+            }
+            if (total != expectedTotal()) {
+                throw new AssertionError();
+            }
+        }
+    }
+
+    public void timeLocalCopiesAcrossCall(int count) {
+        int[] values = this.values;
+        int scale = this.scale;
+        int offset = this.offset;
+        int limit = this.limit;
+        for (int iter = 0; iter < count; ++iter) {
+            reset();
+            for (int i = 0; i < values.length; ++i) {
+                int value = values[i] * scale + offset;
+                if (value > limit) {
+                    value = limit;
+                }
+                record(value);
+            }
+            if (total != expectedTotal()) {
+                throw new AssertionError();
+            }
+        }
+    }
+
+    private int expectedTotal() {
+        int sum = 0;
+        for (int i = 0; i < SIZE; ++i) {
+            sum += Math.min(values[i] * scale + offset, limit);
+        }
+        return sum;
+    }
+}
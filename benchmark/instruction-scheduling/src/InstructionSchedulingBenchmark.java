@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class InstructionSchedulingBenchmark {
+    private static final int SIZE = 4096;
+
+    private final int[] ints = new int[SIZE];
+    private final int[] divisors = new int[SIZE];
+    private final long[] longs = new long[SIZE];
+    private final double[] doubles = new double[SIZE];
+    private final float[] floats = new float[SIZE];
+
+    public InstructionSchedulingBenchmark() {
+        for (int i = 0; i < SIZE; ++i) {
+            ints[i] = (i * 31) ^ (i >> 3);
+            divisors[i] = (i & 15) + 1;
+            longs[i] = ((long) i << 33) + i * 7L;
+            doubles[i] = i * 0.5 + 1.0;
+            floats[i] = (i & 255) * 0.25f;
+        }
+    }
+
+    // Two independent loads per iteration feeding multiplies.
+    public int timeLoadMulAccumulate(int count) {
+        int[] a = ints;
+        int[] b = divisors;
+        int result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            int sum = 0;
+            for (int i = 0; i < SIZE - 1; i += 2) {
+                sum += a[i] * b[i];
+                sum += a[i + 1] * b[i + 1];
+            }
+            result += sum;
+        }
+        return result;
+    }
+
+    // Integer divides by loaded values next to independent arithmetic.
+    public int timeIntegerDivide(int count) {
+        int[] a = ints;
+        int[] b = divisors;
+        int result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            for (int i = 0; i < SIZE; ++i) {
+                int q = a[i] / b[i];
+                int r = a[i] % b[i];
+                result += q ^ (r << 3) ^ (i * 5);
+            }
+        }
+        return result;
+    }
+
+    public long timeLongDivide(int count) {
+        long[] a = longs;
+        int[] b = divisors;
+        long result = 0;
+        for (int iter = 0; iter < count; ++iter) {
+            for (int i = 0; i < SIZE; ++i) {
+                result += a[i] / b[i] + (a[i] >>> 7);
+            }
+        }
+        return result;
+    }
+
+    // Floating point divides and a polynomial evaluation.
+    public double timeFloatingPoint(int count) {
+        double[] a = doubles;
+        double result = 0.0;
+        for (int iter = 0; iter < count; ++iter) {
+            for (int i = 0; i < SIZE; ++i) {
+                double x = a[i];
+                double p = ((x * 0.25 + 1.5) * x - 3.0) * x + 7.0;
+                result += p / (x + 1.0);
+            }
+        }
+        return result;
+    }
+
+    // Vectorized loop with loads, multiplies and a conversion.
+    public void timeVectorScale(int count) {
+        float[] f = floats;
+        int[] a = ints;
+        for (int iter = 0; iter < count; ++iter) {
+            for (int i = 0; i < SIZE; ++i) {
+                f[i] = f[i] * 0.5f + (float) a[i] * 0.125f;
+            }
+        }
+    }
+}
@@ -0,0 +1,614 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class InterfaceDispatchBenchmark {
+    // Enough interface methods for each IMT slot to hold a conflict table of about 9 entries.
+    interface Wide {
+        int call();
+
+        default int m0() { return 0; }
+        default int m1() { return 1; }
+        default int m2() { return 2; }
+        default int m3() { return 3; }
+        default int m4() { return 4; }
+        default int m5() { return 5; }
+        default int m6() { return 6; }
+        default int m7() { return 7; }
+        default int m8() { return 8; }
+        default int m9() { return 9; }
+        default int m10() { return 10; }
+        default int m11() { return 11; }
+        default int m12() { return 12; }
+        default int m13() { return 13; }
+        default int m14() { return 14; }
+        default int m15() { return 15; }
+        default int m16() { return 16; }
+        default int m17() { return 17; }
+        default int m18() { return 18; }
+        default int m19() { return 19; }
+        default int m20() { return 20; }
+        default int m21() { return 21; }
+        default int m22() { return 22; }
+        default int m23() { return 23; }
+        default int m24() { return 24; }
+        default int m25() { return 25; }
+        default int m26() { return 26; }
+        default int m27() { return 27; }
+        default int m28() { return 28; }
+        default int m29() { return 29; }
+        default int m30() { return 30; }
+        default int m31() { return 31; }
+        default int m32() { return 32; }
+        default int m33() { return 33; }
+        default int m34() { return 34; }
+        default int m35() { return 35; }
+        default int m36() { return 36; }
+        default int m37() { return 37; }
+        default int m38() { return 38; }
+        default int m39() { return 39; }
+        default int m40() { return 40; }
+        default int m41() { return 41; }
+        default int m42() { return 42; }
+        default int m43() { return 43; }
+        default int m44() { return 44; }
+        default int m45() { return 45; }
+        default int m46() { return 46; }
+        default int m47() { return 47; }
+        default int m48() { return 48; }
+        default int m49() { return 49; }
+        default int m50() { return 50; }
+        default int m51() { return 51; }
+        default int m52() { return 52; }
+        default int m53() { return 53; }
+        default int m54() { return 54; }
+        default int m55() { return 55; }
+        default int m56() { return 56; }
+        default int m57() { return 57; }
+        default int m58() { return 58; }
+        default int m59() { return 59; }
+        default int m60() { return 60; }
+        default int m61() { return 61; }
+        default int m62() { return 62; }
+        default int m63() { return 63; }
+        default int m64() { return 64; }
+        default int m65() { return 65; }
+        default int m66() { return 66; }
+        default int m67() { return 67; }
+        default int m68() { return 68; }
+        default int m69() { return 69; }
+        default int m70() { return 70; }
+        default int m71() { return 71; }
+        default int m72() { return 72; }
+        default int m73() { return 73; }
+        default int m74() { return 74; }
+        default int m75() { return 75; }
+        default int m76() { return 76; }
+        default int m77() { return 77; }
+        default int m78() { return 78; }
+        default int m79() { return 79; }
+        default int m80() { return 80; }
+        default int m81() { return 81; }
+        default int m82() { return 82; }
+        default int m83() { return 83; }
+        default int m84() { return 84; }
+        default int m85() { return 85; }
+        default int m86() { return 86; }
+        default int m87() { return 87; }
+        default int m88() { return 88; }
+        default int m89() { return 89; }
+        default int m90() { return 90; }
+        default int m91() { return 91; }
+        default int m92() { return 92; }
+        default int m93() { return 93; }
+        default int m94() { return 94; }
+        default int m95() { return 95; }
+        default int m96() { return 96; }
+        default int m97() { return 97; }
+        default int m98() { return 98; }
+        default int m99() { return 99; }
+        default int m100() { return 100; }
+        default int m101() { return 101; }
+        default int m102() { return 102; }
+        default int m103() { return 103; }
+        default int m104() { return 104; }
+        default int m105() { return 105; }
+        default int m106() { return 106; }
+        default int m107() { return 107; }
+        default int m108() { return 108; }
+        default int m109() { return 109; }
+        default int m110() { return 110; }
+        default int m111() { return 111; }
+        default int m112() { return 112; }
+        default int m113() { return 113; }
+        default int m114() { return 114; }
+        default int m115() { return 115; }
+        default int m116() { return 116; }
+        default int m117() { return 117; }
+        default int m118() { return 118; }
+        default int m119() { return 119; }
+        default int m120() { return 120; }
+        default int m121() { return 121; }
+        default int m122() { return 122; }
+        default int m123() { return 123; }
+        default int m124() { return 124; }
+        default int m125() { return 125; }
+        default int m126() { return 126; }
+        default int m127() { return 127; }
+        default int m128() { return 128; }
+        default int m129() { return 129; }
+        default int m130() { return 130; }
+        default int m131() { return 131; }
+        default int m132() { return 132; }
+        default int m133() { return 133; }
+        default int m134() { return 134; }
+        default int m135() { return 135; }
+        default int m136() { return 136; }
+        default int m137() { return 137; }
+        default int m138() { return 138; }
+        default int m139() { return 139; }
+        default int m140() { return 140; }
+        default int m141() { return 141; }
+        default int m142() { return 142; }
+        default int m143() { return 143; }
+        default int m144() { return 144; }
+        default int m145() { return 145; }
+        default int m146() { return 146; }
+        default int m147() { return 147; }
+        default int m148() { return 148; }
+        default int m149() { return 149; }
+        default int m150() { return 150; }
+        default int m151() { return 151; }
+        default int m152() { return 152; }
+        default int m153() { return 153; }
+        default int m154() { return 154; }
+        default int m155() { return 155; }
+        default int m156() { return 156; }
+        default int m157() { return 157; }
+        default int m158() { return 158; }
+        default int m159() { return 159; }
+        default int m160() { return 160; }
+        default int m161() { return 161; }
+        default int m162() { return 162; }
+        default int m163() { return 163; }
+        default int m164() { return 164; }
+        default int m165() { return 165; }
+        default int m166() { return 166; }
+        default int m167() { return 167; }
+        default int m168() { return 168; }
+        default int m169() { return 169; }
+        default int m170() { return 170; }
+        default int m171() { return 171; }
+        default int m172() { return 172; }
+        default int m173() { return 173; }
+        default int m174() { return 174; }
+        default int m175() { return 175; }
+        default int m176() { return 176; }
+        default int m177() { return 177; }
+        default int m178() { return 178; }
+        default int m179() { return 179; }
+        default int m180() { return 180; }
+        default int m181() { return 181; }
+        default int m182() { return 182; }
+        default int m183() { return 183; }
+        default int m184() { return 184; }
+        default int m185() { return 185; }
+        default int m186() { return 186; }
+        default int m187() { return 187; }
+        default int m188() { return 188; }
+        default int m189() { return 189; }
+        default int m190() { return 190; }
+        default int m191() { return 191; }
+        default int m192() { return 192; }
+        default int m193() { return 193; }
+        default int m194() { return 194; }
+        default int m195() { return 195; }
+        default int m196() { return 196; }
+        default int m197() { return 197; }
+        default int m198() { return 198; }
+        default int m199() { return 199; }
+        default int m200() { return 200; }
+        default int m201() { return 201; }
+        default int m202() { return 202; }
+        default int m203() { return 203; }
+        default int m204() { return 204; }
+        default int m205() { return 205; }
+        default int m206() { return 206; }
+        default int m207() { return 207; }
+        default int m208() { return 208; }
+        default int m209() { return 209; }
+        default int m210() { return 210; }
+        default int m211() { return 211; }
+        default int m212() { return 212; }
+        default int m213() { return 213; }
+        default int m214() { return 214; }
+        default int m215() { return 215; }
+        default int m216() { return 216; }
+        default int m217() { return 217; }
+        default int m218() { return 218; }
+        default int m219() { return 219; }
+        default int m220() { return 220; }
+        default int m221() { return 221; }
+        default int m222() { return 222; }
+        default int m223() { return 223; }
+        default int m224() { return 224; }
+        default int m225() { return 225; }
+        default int m226() { return 226; }
+        default int m227() { return 227; }
+        default int m228() { return 228; }
+        default int m229() { return 229; }
+        default int m230() { return 230; }
+        default int m231() { return 231; }
+        default int m232() { return 232; }
+        default int m233() { return 233; }
+        default int m234() { return 234; }
+        default int m235() { return 235; }
+        default int m236() { return 236; }
+        default int m237() { return 237; }
+        default int m238() { return 238; }
+        default int m239() { return 239; }
+        default int m240() { return 240; }
+        default int m241() { return 241; }
+        default int m242() { return 242; }
+        default int m243() { return 243; }
+        default int m244() { return 244; }
+        default int m245() { return 245; }
+        default int m246() { return 246; }
+        default int m247() { return 247; }
+        default int m248() { return 248; }
+        default int m249() { return 249; }
+        default int m250() { return 250; }
+        default int m251() { return 251; }
+        default int m252() { return 252; }
+        default int m253() { return 253; }
+        default int m254() { return 254; }
+        default int m255() { return 255; }
+        default int m256() { return 256; }
+        default int m257() { return 257; }
+        default int m258() { return 258; }
+        default int m259() { return 259; }
+        default int m260() { return 260; }
+        default int m261() { return 261; }
+        default int m262() { return 262; }
+        default int m263() { return 263; }
+        default int m264() { return 264; }
+        default int m265() { return 265; }
+        default int m266() { return 266; }
+        default int m267() { return 267; }
+        default int m268() { return 268; }
+        default int m269() { return 269; }
+        default int m270() { return 270; }
+        default int m271() { return 271; }
+        default int m272() { return 272; }
+        default int m273() { return 273; }
+        default int m274() { return 274; }
+        default int m275() { return 275; }
+        default int m276() { return 276; }
+        default int m277() { return 277; }
+        default int m278() { return 278; }
+        default int m279() { return 279; }
+        default int m280() { return 280; }
+        default int m281() { return 281; }
+        default int m282() { return 282; }
+        default int m283() { return 283; }
+        default int m284() { return 284; }
+        default int m285() { return 285; }
+        default int m286() { return 286; }
+        default int m287() { return 287; }
+        default int m288() { return 288; }
+        default int m289() { return 289; }
+        default int m290() { return 290; }
+        default int m291() { return 291; }
+        default int m292() { return 292; }
+        default int m293() { return 293; }
+        default int m294() { return 294; }
+        default int m295() { return 295; }
+        default int m296() { return 296; }
+        default int m297() { return 297; }
+        default int m298() { return 298; }
+        default int m299() { return 299; }
+        default int m300() { return 300; }
+        default int m301() { return 301; }
+        default int m302() { return 302; }
+        default int m303() { return 303; }
+        default int m304() { return 304; }
+        default int m305() { return 305; }
+        default int m306() { return 306; }
+        default int m307() { return 307; }
+        default int m308() { return 308; }
+        default int m309() { return 309; }
+        default int m310() { return 310; }
+        default int m311() { return 311; }
+        default int m312() { return 312; }
+        default int m313() { return 313; }
+        default int m314() { return 314; }
+        default int m315() { return 315; }
+        default int m316() { return 316; }
+        default int m317() { return 317; }
+        default int m318() { return 318; }
+        default int m319() { return 319; }
+        default int m320() { return 320; }
+        default int m321() { return 321; }
+        default int m322() { return 322; }
+        default int m323() { return 323; }
+        default int m324() { return 324; }
+        default int m325() { return 325; }
+        default int m326() { return 326; }
+        default int m327() { return 327; }
+        default int m328() { return 328; }
+        default int m329() { return 329; }
+        default int m330() { return 330; }
+        default int m331() { return 331; }
+        default int m332() { return 332; }
+        default int m333() { return 333; }
+        default int m334() { return 334; }
+        default int m335() { return 335; }
+        default int m336() { return 336; }
+        default int m337() { return 337; }
+        default int m338() { return 338; }
+        default int m339() { return 339; }
+        default int m340() { return 340; }
+        default int m341() { return 341; }
+        default int m342() { return 342; }
+        default int m343() { return 343; }
+        default int m344() { return 344; }
+        default int m345() { return 345; }
+        default int m346() { return 346; }
+        default int m347() { return 347; }
+        default int m348() { return 348; }
+        default int m349() { return 349; }
+        default int m350() { return 350; }
+        default int m351() { return 351; }
+        default int m352() { return 352; }
+        default int m353() { return 353; }
+        default int m354() { return 354; }
+        default int m355() { return 355; }
+        default int m356() { return 356; }
+        default int m357() { return 357; }
+        default int m358() { return 358; }
+        default int m359() { return 359; }
+        default int m360() { return 360; }
+        default int m361() { return 361; }
+        default int m362() { return 362; }
+        default int m363() { return 363; }
+        default int m364() { return 364; }
+        default int m365() { return 365; }
+        default int m366() { return 366; }
+        default int m367() { return 367; }
+        default int m368() { return 368; }
+        default int m369() { return 369; }
+        default int m370() { return 370; }
+        default int m371() { return 371; }
+        default int m372() { return 372; }
+        default int m373() { return 373; }
+        default int m374() { return 374; }
+        default int m375() { return 375; }
+        default int m376() { return 376; }
+        default int m377() { return 377; }
+        default int m378() { return 378; }
+        default int m379() { return 379; }
+        default int m380() { return 380; }
+        default int m381() { return 381; }
+        default int m382() { return 382; }
+        default int m383() { return 383; }
+    }
+
+    static abstract class Base implements Wide {}
+
+    static final class R0 extends Base { public int call() { return 0; } }
+    static final class R1 extends Base { public int call() { return 1; } }
+    static final class R2 extends Base { public int call() { return 2; } }
+    static final class R3 extends Base { public int call() { return 3; } }
+    static final class R4 extends Base { public int call() { return 4; } }
+    static final class R5 extends Base { public int call() { return 5; } }
+    static final class R6 extends Base { public int call() { return 6; } }
+    static final class R7 extends Base { public int call() { return 7; } }
+    static final class R8 extends Base { public int call() { return 8; } }
+    static final class R9 extends Base { public int call() { return 9; } }
+    static final class R10 extends Base { public int call() { return 10; } }
+    static final class R11 extends Base { public int call() { return 11; } }
+    static final class R12 extends Base { public int call() { return 12; } }
+    static final class R13 extends Base { public int call() { return 13; } }
+    static final class R14 extends Base { public int call() { return 14; } }
+    static final class R15 extends Base { public int call() { return 15; } }
+    static final class R16 extends Base { public int call() { return 16; } }
+    static final class R17 extends Base { public int call() { return 17; } }
+    static final class R18 extends Base { public int call() { return 18; } }
+    static final class R19 extends Base { public int call() { return 19; } }
+    static final class R20 extends Base { public int call() { return 20; } }
+    static final class R21 extends Base { public int call() { return 21; } }
+    static final class R22 extends Base { public int call() { return 22; } }
+    static final class R23 extends Base { public int call() { return 23; } }
+    static final class R24 extends Base { public int call() { return 24; } }
+    static final class R25 extends Base { public int call() { return 25; } }
+    static final class R26 extends Base { public int call() { return 26; } }
+    static final class R27 extends Base { public int call() { return 27; } }
+    static final class R28 extends Base { public int call() { return 28; } }
+    static final class R29 extends Base { public int call() { return 29; } }
+    static final class R30 extends Base { public int call() { return 30; } }
+    static final class R31 extends Base { public int call() { return 31; } }
+    static final class R32 extends Base { public int call() { return 32; } }
+    static final class R33 extends Base { public int call() { return 33; } }
+    static final class R34 extends Base { public int call() { return 34; } }
+    static final class R35 extends Base { public int call() { return 35; } }
+    static final class R36 extends Base { public int call() { return 36; } }
+    static final class R37 extends Base { public int call() { return 37; } }
+    static final class R38 extends Base { public int call() { return 38; } }
+    static final class R39 extends Base { public int call() { return 39; } }
+    static final class R40 extends Base { public int call() { return 40; } }
+    static final class R41 extends Base { public int call() { return 41; } }
+    static final class R42 extends Base { public int call() { return 42; } }
+    static final class R43 extends Base { public int call() { return 43; } }
+    static final class R44 extends Base { public int call() { return 44; } }
+    static final class R45 extends Base { public int call() { return 45; } }
+    static final class R46 extends Base { public int call() { return 46; } }
+    static final class R47 extends Base { public int call() { return 47; } }
+    static final class R48 extends Base { public int call() { return 48; } }
+    static final class R49 extends Base { public int call() { return 49; } }
+    static final class R50 extends Base { public int call() { return 50; } }
+    static final class R51 extends Base { public int call() { return 51; } }
+    static final class R52 extends Base { public int call() { return 52; } }
+    static final class R53 extends Base { public int call() { return 53; } }
+    static final class R54 extends Base { public int call() { return 54; } }
+    static final class R55 extends Base { public int call() { return 55; } }
+    static final class R56 extends Base { public int call() { return 56; } }
+    static final class R57 extends Base { public int call() { return 57; } }
+    static final class R58 extends Base { public int call() { return 58; } }
+    static final class R59 extends Base { public int call() { return 59; } }
+    static final class R60 extends Base { public int call() { return 60; } }
+    static final class R61 extends Base { public int call() { return 61; } }
+    static final class R62 extends Base { public int call() { return 62; } }
+    static final class R63 extends Base { public int call() { return 63; } }
+    static final class R64 extends Base { public int call() { return 64; } }
+    static final class R65 extends Base { public int call() { return 65; } }
+    static final class R66 extends Base { public int call() { return 66; } }
+    static final class R67 extends Base { public int call() { return 67; } }
+    static final class R68 extends Base { public int call() { return 68; } }
+    static final class R69 extends Base { public int call() { return 69; } }
+    static final class R70 extends Base { public int call() { return 70; } }
+    static final class R71 extends Base { public int call() { return 71; } }
+    static final class R72 extends Base { public int call() { return 72; } }
+    static final class R73 extends Base { public int call() { return 73; } }
+    static final class R74 extends Base { public int call() { return 74; } }
+    static final class R75 extends Base { public int call() { return 75; } }
+    static final class R76 extends Base { public int call() { return 76; } }
+    static final class R77 extends Base { public int call() { return 77; } }
+    static final class R78 extends Base { public int call() { return 78; } }
+    static final class R79 extends Base { public int call() { return 79; } }
+    static final class R80 extends Base { public int call() { return 80; } }
+    static final class R81 extends Base { public int call() { return 81; } }
+    static final class R82 extends Base { public int call() { return 82; } }
+    static final class R83 extends Base { public int call() { return 83; } }
+    static final class R84 extends Base { public int call() { return 84; } }
+    static final class R85 extends Base { public int call() { return 85; } }
+    static final class R86 extends Base { public int call() { return 86; } }
+    static final class R87 extends Base { public int call() { return 87; } }
+    static final class R88 extends Base { public int call() { return 88; } }
+    static final class R89 extends Base { public int call() { return 89; } }
+    static final class R90 extends Base { public int call() { return 90; } }
+    static final class R91 extends Base { public int call() { return 91; } }
+    static final class R92 extends Base { public int call() { return 92; } }
+    static final class R93 extends Base { public int call() { return 93; } }
+    static final class R94 extends Base { public int call() { return 94; } }
+    static final class R95 extends Base { public int call() { return 95; } }
+    static final class R96 extends Base { public int call() { return 96; } }
+    static final class R97 extends Base { public int call() { return 97; } }
+    static final class R98 extends Base { public int call() { return 98; } }
+    static final class R99 extends Base { public int call() { return 99; } }
+    static final class R100 extends Base { public int call() { return 100; } }
+    static final class R101 extends Base { public int call() { return 101; } }
+    static final class R102 extends Base { public int call() { return 102; } }
+    static final class R103 extends Base { public int call() { return 103; } }
+    static final class R104 extends Base { public int call() { return 104; } }
+    static final class R105 extends Base { public int call() { return 105; } }
+    static final class R106 extends Base { public int call() { return 106; } }
+    static final class R107 extends Base { public int call() { return 107; } }
+    static final class R108 extends Base { public int call() { return 108; } }
+    static final class R109 extends Base { public int call() { return 109; } }
+    static final class R110 extends Base { public int call() { return 110; } }
+    static final class R111 extends Base { public int call() { return 111; } }
+    static final class R112 extends Base { public int call() { return 112; } }
+    static final class R113 extends Base { public int call() { return 113; } }
+    static final class R114 extends Base { public int call() { return 114; } }
+    static final class R115 extends Base { public int call() { return 115; } }
+    static final class R116 extends Base { public int call() { return 116; } }
+    static final class R117 extends Base { public int call() { return 117; } }
+    static final class R118 extends Base { public int call() { return 118; } }
+    static final class R119 extends Base { public int call() { return 119; } }
+    static final class R120 extends Base { public int call() { return 120; } }
+    static final class R121 extends Base { public int call() { return 121; } }
+    static final class R122 extends Base { public int call() { return 122; } }
+    static final class R123 extends Base { public int call() { return 123; } }
+    static final class R124 extends Base { public int call() { return 124; } }
+    static final class R125 extends Base { public int call() { return 125; } }
+    static final class R126 extends Base { public int call() { return 126; } }
+    static final class R127 extends Base { public int call() { return 127; } }
+
+    private static Wide[] createReceivers(int count) {
+        Wide[] all = new Wide[] {
+            new R0(), new R1(), new R2(), new R3(), new R4(), new R5(),
+            new R6(), new R7(), new R8(), new R9(), new R10(), new R11(),
+            new R12(), new R13(), new R14(), new R15(), new R16(), new R17(),
+            new R18(), new R19(), new R20(), new R21(), new R22(), new R23(),
+            new R24(), new R25(), new R26(), new R27(), new R28(), new R29(),
+            new R30(), new R31(), new R32(), new R33(), new R34(), new R35(),
+            new R36(), new R37(), new R38(), new R39(), new R40(), new R41(),
+            new R42(), new R43(), new R44(), new R45(), new R46(), new R47(),
+            new R48(), new R49(), new R50(), new R51(), new R52(), new R53(),
+            new R54(), new R55(), new R56(), new R57(), new R58(), new R59(),
+            new R60(), new R61(), new R62(), new R63(), new R64(), new R65(),
+            new R66(), new R67(), new R68(), new R69(), new R70(), new R71(),
+            new R72(), new R73(), new R74(), new R75(), new R76(), new R77(),
+            new R78(), new R79(), new R80(), new R81(), new R82(), new R83(),
+            new R84(), new R85(), new R86(), new R87(), new R88(), new R89(),
+            new R90(), new R91(), new R92(), new R93(), new R94(), new R95(),
+            new R96(), new R97(), new R98(), new R99(), new R100(), new R101(),
+            new R102(), new R103(), new R104(), new R105(), new R106(), new R107(),
+            new R108(), new R109(), new R110(), new R111(), new R112(), new R113(),
+            new R114(), new R115(), new R116(), new R117(), new R118(), new R119(),
+            new R120(), new R121(), new R122(), new R123(), new R124(), new R125(),
+            new R126(), new R127()
+        };
+        Wide[] receivers = new Wide[count];
+        System.arraycopy(all, 0, receivers, 0, count);
+        return receivers;
+    }
+
+    private static final Wide[] receivers8 = createReceivers(8);
+    private static final Wide[] receivers32 = createReceivers(32);
+    private static final Wide[] receivers128 = createReceivers(128);
+
+    // Each benchmark has its own call site, so that they do not share an inline cache.
+
+    private static int expectedSum(int count, int numReceivers) {
+        // Receiver `i` returns `i`.
+        int fullRounds = count / numReceivers;
+        int rest = count % numReceivers;
+        return fullRounds * (numReceivers * (numReceivers - 1) / 2) + rest * (rest - 1) / 2;
+    }
+
+    public void timeInterfaceCall8(int count) {
+        Wide[] receivers = receivers8;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += receivers[i & 7].call();
+        }
+        if (sum != expectedSum(count, 8)) {
+            throw new AssertionError();
+        }
+    }
+
+    public void timeInterfaceCall32(int count) {
+        Wide[] receivers = receivers32;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += receivers[i & 31].call();
+        }
+        if (sum != expectedSum(count, 32)) {
+            throw new AssertionError();
+        }
+    }
+
+    public void timeInterfaceCall128(int count) {
+        Wide[] receivers = receivers128;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += receivers[i & 127].call();
+        }
+        if (sum != expectedSum(count, 128)) {
+            throw new AssertionError();
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class LargeObjectAllocBenchmark {
+    private static final int NUM_THREADS = Runtime.getRuntime().availableProcessors();
+    // The number of arrays each thread keeps alive, so that frees interleave with allocations.
+    private static final int NUM_LIVE_ARRAYS = 8;
+
+    private static void runOnAllThreads(Runnable task) {
+        Thread[] threads = new Thread[NUM_THREADS];
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads[i] = new Thread(task);
+            threads[i].start();
+        }
+        try {
+            for (Thread thread : threads) {
+                thread.join();
+            }
+        } catch (InterruptedException e) {
+            throw new AssertionError(e);
+        }
+    }
+
+    private static void allocateOnAllThreads(final int count, final int minSize,
+                                             final int maxSize) {
+        runOnAllThreads(new Runnable() {
+            public void run() {
+                byte[][] live = new byte[NUM_LIVE_ARRAYS][];
+                int size = minSize;
+                long sum = 0;
+                for (int i = 0; i < count; ++i) {
+                    byte[] array = new byte[size];
+                    array[size - 1] = 1;
+                    live[i % NUM_LIVE_ARRAYS] = array;
+                    sum += array[size - 1];  // Make sure the allocation is not optimized away.
+                    // Cycle through the sizes, hitting sizes between the size classes too.
+                    size = size * 5 / 4 + 4096;
+                    if (size > maxSize) {
+                        size = minSize;
+                    }
+                }
+                if (sum != count) {
+                    throw new AssertionError();
+                }
+            }
+        });
+    }
+
+    /** Measures allocation of arrays from 64KB to 256KB, which fit the smaller size classes. */
+    public void timeAllocateSmallLargeObjects(int count) {
+        allocateOnAllThreads(count, 64 * 1024, 256 * 1024);
+    }
+
+    /** Measures allocation of arrays from 256KB to 1MB. */
+    public void timeAllocateMediumLargeObjects(int count) {
+        allocateOnAllThreads(count, 256 * 1024, 1024 * 1024);
+    }
+
+    /** Measures allocation of arrays from 1MB to 4MB, which span huge pages. */
+    public void timeAllocateHugeLargeObjects(int count) {
+        allocateOnAllThreads(count, 1024 * 1024, 4 * 1024 * 1024);
+    }
+}
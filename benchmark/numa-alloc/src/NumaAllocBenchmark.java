@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class NumaAllocBenchmark {
+    // Use as many threads as there are CPUs so that every NUMA node allocates.
+    private static final int NUM_THREADS = Runtime.getRuntime().availableProcessors();
+    // The number of nodes of the graph retained by each thread for the marking benchmark.
+    private static final int GRAPH_SIZE = 1 << 16;
+
+    static class Node {
+        Node left;
+        Node right;
+        int value;
+    }
+
+    private static void runOnAllThreads(Runnable task) {
+        Thread[] threads = new Thread[NUM_THREADS];
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads[i] = new Thread(task);
+            threads[i].start();
+        }
+        try {
+            for (Thread thread : threads) {
+                thread.join();
+            }
+        } catch (InterruptedException e) {
+            throw new AssertionError(e);
+        }
+    }
+
+    private static Node buildGraph(int size) {
+        Node[] nodes = new Node[size];
+        for (int i = 0; i < size; ++i) {
+            nodes[i] = new Node();
+            nodes[i].value = i;
+        }
+        // Link each node to its children in a complete binary tree.
+        for (int i = 0; 2 * i + 1 < size; ++i) {
+            nodes[i].left = nodes[2 * i + 1];
+            if (2 * i + 2 < size) {
+                nodes[i].right = nodes[2 * i + 2];
+            }
+        }
+        return nodes[0];
+    }
+
+    /** Measures the throughput of small allocations served from TLABs. */
+    public void timeAllocateSmallObjects(final int count) {
+        runOnAllThreads(new Runnable() {
+            public void run() {
+                int sum = 0;
+                for (int i = 0; i < count; ++i) {
+                    Node node = new Node();
+                    node.value = i;
+                    sum += node.value;  // Make sure the allocation is not optimized away.
+                }
+                if (sum != (int) ((long) count * (count - 1) / 2)) {
+                    throw new AssertionError();
+                }
+            }
+        });
+    }
+
+    /** Measures the throughput of allocations of several KB, requesting new TLABs often. */
+    public void timeAllocateArrays(final int count) {
+        runOnAllThreads(new Runnable() {
+            public void run() {
+                long sum = 0;
+                for (int i = 0; i < count; ++i) {
+                    int[] array = new int[2048];
+                    array[i & 2047] = i;
+                    sum += array.length;  // Make sure the allocation is not optimized away.
+                }
+                if (sum != 2048L * count) {
+                    throw new AssertionError();
+                }
+            }
+        });
+    }
+
+    /**
+     * Measures the marking throughput: every thread builds a graph in its own TLABs,
+     * then the whole heap is collected while the graphs are still reachable.
+     */
+    public void timeMarkThreadLocalGraphs(int count) {
+        final Node[] roots = new Node[NUM_THREADS];
+        final int[] nextRoot = new int[1];
+        runOnAllThreads(new Runnable() {
+            public void run() {
+                Node root = buildGraph(GRAPH_SIZE);
+                synchronized (roots) {
+                    roots[nextRoot[0]++] = root;
+                }
+            }
+        });
+        for (int i = 0; i < count; ++i) {
+            Runtime.getRuntime().gc();
+        }
+        for (Node root : roots) {
+            if (root == null || root.left.value != 1) {
+                throw new AssertionError();
+            }
+        }
+    }
+}
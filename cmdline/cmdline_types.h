@@ -553,6 +553,8 @@ struct XGcOption {
   bool verify_pre_gc_heap_ = false;
   bool verify_pre_sweeping_heap_ = kIsDebugBuild;
   bool generational_cc = kEnableGenerationalCCByDefault;
+  bool generational_cmc = false;
+  bool numa_aware_ = false;
   bool verify_post_gc_heap_ = kIsDebugBuild;
   bool verify_pre_gc_rosalloc_ = kIsDebugBuild;
   bool verify_pre_sweeping_rosalloc_ = false;
@@ -595,6 +597,14 @@ struct CmdlineType<XGcOption> : CmdlineTypeParser<XGcOption> {
         // for compatibility reasons (this should not prevent the runtime from
         // starting up).
         xgc.generational_cc = false;
+      } else if (gc_option == "generational_cmc") {
+        xgc.generational_cmc = true;
+      } else if (gc_option == "nogenerational_cmc") {
+        xgc.generational_cmc = false;
+      } else if (gc_option == "numa_aware") {
+        xgc.numa_aware_ = true;
+      } else if (gc_option == "nonuma_aware") {
+        xgc.numa_aware_ = false;
       } else if (gc_option == "postverify") {
         xgc.verify_post_gc_heap_ = true;
       } else if (gc_option == "nopostverify") {
@@ -633,7 +643,8 @@ struct CmdlineType<XGcOption> : CmdlineTypeParser<XGcOption> {
   static const char* Name() { return "XgcOption"; }
   static const char* DescribeType() {
     return "MS|nonconccurent|concurrent|CMS|SS|CC|[no]preverify[_rosalloc]|"
-           "[no]presweepingverify[_rosalloc]|[no]generation_cc|[no]postverify[_rosalloc]|"
+           "[no]presweepingverify[_rosalloc]|[no]generation_cc|[no]generational_cmc|"
+           "[no]numa_aware|[no]postverify[_rosalloc]|"
            "[no]gcstress|measure|[no]precisce|[no]verifycardtable";
   }
 };
@@ -40,6 +40,7 @@ CompilerOptions::CompilerOptions()
     : compiler_filter_(CompilerFilter::kDefaultCompilerFilter),
       huge_method_threshold_(kDefaultHugeMethodThreshold),
       inline_max_code_units_(kUnsetInlineMaxCodeUnits),
+      jit_compile_budget_ms_(0u),
       instruction_set_(kRuntimeISA == InstructionSet::kArm ? InstructionSet::kThumb2 : kRuntimeISA),
       instruction_set_features_(nullptr),
       no_inline_from_(),
@@ -78,6 +79,8 @@ CompilerOptions::CompilerOptions()
       resolve_startup_const_strings_(false),
       initialize_app_image_classes_(false),
       check_profiled_methods_(ProfileMethodsCheck::kNone),
+      register_allocation_strategy_(RegisterAllocator::kRegisterAllocatorDefault),
+      register_allocation_hot_methods_only_(false),
       max_image_block_size_(std::numeric_limits<uint32_t>::max()),
       passes_to_run_(nullptr) {
 }
@@ -113,6 +116,25 @@ bool CompilerOptions::ParseDumpInitFailures(const std::string& option, std::stri
   return true;
 }
 
+bool CompilerOptions::ParseRegisterAllocationStrategy(const std::string& option,
+                                                      std::string* error_msg) {
+  if (option == "linear-scan") {
+    register_allocation_strategy_ = RegisterAllocator::kRegisterAllocatorLinearScan;
+    register_allocation_hot_methods_only_ = false;
+  } else if (option == "graph-color") {
+    register_allocation_strategy_ = RegisterAllocator::kRegisterAllocatorGraphColor;
+    register_allocation_hot_methods_only_ = false;
+  } else if (option == "graph-color-hot") {
+    register_allocation_strategy_ = RegisterAllocator::kRegisterAllocatorGraphColor;
+    register_allocation_hot_methods_only_ = true;
+  } else {
+    *error_msg = "Unrecognized register allocation strategy. "
+                 "Try linear-scan, graph-color, or graph-color-hot.";
+    return false;
+  }
+  return true;
+}
+
 bool CompilerOptions::ParseCompilerOptions(const std::vector<std::string>& options,
                                            bool ignore_unrecognized,
                                            std::string* error_msg) {
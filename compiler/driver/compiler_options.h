@@ -135,6 +135,13 @@ class CompilerOptions final {
     inline_max_code_units_ = units;
   }
 
+  // Thread CPU time after which the JIT skips expensive optimizations of a method,
+  // and gives up on an optimized compilation at twice that if the method has
+  // baseline code to keep running. 0 means no budget.
+  uint32_t GetJitCompileBudgetMs() const {
+    return jit_compile_budget_ms_;
+  }
+
   bool EmitReadBarrier() const {
     return emit_read_barrier_;
   }
@@ -354,6 +361,16 @@ class CompilerOptions final {
     return check_profiled_methods_;
   }
 
+  RegisterAllocator::Strategy GetRegisterAllocationStrategy() const {
+    return register_allocation_strategy_;
+  }
+
+  // Whether `GetRegisterAllocationStrategy()` applies only to methods that are hot in the
+  // profile, other methods using the default strategy. Without a profile, no method is hot.
+  bool UseRegisterAllocationStrategyForHotMethodsOnly() const {
+    return register_allocation_hot_methods_only_;
+  }
+
   uint32_t MaxImageBlockSize() const {
     return max_image_block_size_;
   }
@@ -379,10 +396,12 @@ class CompilerOptions final {
 
  private:
   EXPORT bool ParseDumpInitFailures(const std::string& option, std::string* error_msg);
+  EXPORT bool ParseRegisterAllocationStrategy(const std::string& option, std::string* error_msg);
 
   CompilerFilter::Filter compiler_filter_;
   size_t huge_method_threshold_;
   size_t inline_max_code_units_;
+  uint32_t jit_compile_budget_ms_;
 
   InstructionSet instruction_set_;
   std::unique_ptr<const InstructionSetFeatures> instruction_set_features_;
@@ -469,6 +488,10 @@ class CompilerOptions final {
   // up compiled and are not punted.
   ProfileMethodsCheck check_profiled_methods_;
 
+  // Register allocator used for optimized code, and whether only for hot methods.
+  RegisterAllocator::Strategy register_allocation_strategy_;
+  bool register_allocation_hot_methods_only_;
+
   // Maximum solid block size in the generated image.
   uint32_t max_image_block_size_;
 
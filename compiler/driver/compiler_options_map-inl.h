@@ -91,6 +91,12 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
   if (map.Exists(Base::CheckProfiledMethods)) {
     options->check_profiled_methods_ = *map.Get(Base::CheckProfiledMethods);
   }
+  if (map.Exists(Base::RegisterAllocationStrategy)) {
+    if (!options->ParseRegisterAllocationStrategy(*map.Get(Base::RegisterAllocationStrategy),
+                                                  error_msg)) {
+      return false;
+    }
+  }
   map.AssignIfExists(Base::MaxImageBlockSize, &options->max_image_block_size_);
 
   if (map.Exists(Base::DumpTimings)) {
@@ -170,6 +176,13 @@ NO_INLINE void AddCompilerOptionsArgumentParserOptions(Builder& b) {
                          {"abort", ProfileMethodsCheck::kAbort}})
           .IntoKey(Map::CheckProfiledMethods)
 
+      .Define("--register-allocation-strategy=_")
+          .template WithType<std::string>()
+          .WithHelp("Select the register allocator for optimized code: linear-scan (default),\n"
+                    "graph-color, or graph-color-hot to use graph coloring only for methods\n"
+                    "that are hot in the profile.")
+          .IntoKey(Map::RegisterAllocationStrategy)
+
       .Define({"--dump-timings"})
           .WithHelp("Display a breakdown of where time was spent.")
           .IntoKey(Map::DumpTimings)
@@ -77,6 +77,7 @@ void JitCompiler::ParseCompilerOptions() {
   compiler_options_->implicit_null_checks_ = runtime->GetImplicitNullChecks();
   compiler_options_->implicit_so_checks_ = runtime->GetImplicitStackOverflowChecks();
   compiler_options_->implicit_suspend_checks_ = runtime->GetImplicitSuspendChecks();
+  compiler_options_->jit_compile_budget_ms_ = runtime->GetJITOptions()->GetCompileBudgetMs();
 
   const InstructionSet instruction_set = compiler_options_->GetInstructionSet();
   if (kRuntimeISA == InstructionSet::kArm) {
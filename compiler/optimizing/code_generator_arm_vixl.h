@@ -129,6 +129,9 @@ using VIXLUInt32Literal = vixl::aarch32::Literal<uint32_t>;
   V(CRC32Update)                                                           \
   V(CRC32UpdateBytes)                                                      \
   V(CRC32UpdateByteBuffer)                                                 \
+  V(Adler32Update)                                                         \
+  V(Adler32UpdateBytes)                                                    \
+  V(Adler32UpdateByteBuffer)                                               \
   V(FP16ToFloat)                                                           \
   V(FP16ToHalf)                                                            \
   V(FP16Floor)                                                             \
@@ -142,6 +145,9 @@ using VIXLUInt32Literal = vixl::aarch32::Literal<uint32_t>;
   V(FP16Min)                                                               \
   V(FP16Max)                                                               \
   V(MathMultiplyHigh)                                                      \
+  V(ArraysEqualsByte)                                                      \
+  V(ArraysHashCodeByte)                                                    \
+  V(StringHashCode)                                                        \
   V(StringStringIndexOf)                                                   \
   V(StringStringIndexOfAfter)                                              \
   V(StringBufferAppend)                                                    \
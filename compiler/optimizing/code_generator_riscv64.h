@@ -70,6 +70,7 @@ static constexpr int32_t kFClassNaNMinValue = 0x100;
   V(FP16Max)                                    \
   V(StringStringIndexOf)                        \
   V(StringStringIndexOfAfter)                   \
+  V(StringHashCode)                             \
   V(StringBufferAppend)                         \
   V(StringBufferLength)                         \
   V(StringBufferToString)                       \
@@ -88,6 +89,11 @@ static constexpr int32_t kFClassNaNMinValue = 0x100;
   V(CRC32Update)                                \
   V(CRC32UpdateBytes)                           \
   V(CRC32UpdateByteBuffer)                      \
+  V(Adler32Update)                              \
+  V(Adler32UpdateBytes)                         \
+  V(Adler32UpdateByteBuffer)                    \
+  V(ArraysEqualsByte)                           \
+  V(ArraysHashCodeByte)                         \
   V(MethodHandleInvokeExact)                    \
   V(MethodHandleInvoke)
 
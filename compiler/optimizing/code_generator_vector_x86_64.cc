@@ -25,6 +25,12 @@ namespace x86_64 {
 // NOLINT on __ macro to suppress wrong warning/fix (misc-macro-parentheses) from clang-tidy.
 #define __ down_cast<X86_64Assembler*>(GetAssembler())->  // NOLINT
 
+// Returns whether the vector operation works on the 256-bit YMM registers. This is only
+// the case in graphs vectorized for AVX2, see HGraph::HasWideSIMD().
+static bool IsWideVector(HVecOperation* instruction) {
+  return instruction->GetVectorNumberOfBytes() == 4 * kX86_64WordSize;
+}
+
 void LocationsBuilderX86_64::VisitVecReplicateScalar(HVecReplicateScalar* instruction) {
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
   HInstruction* input = instruction->InputAt(0);
@@ -59,12 +65,49 @@ void InstructionCodeGeneratorX86_64::VisitVecReplicateScalar(HVecReplicateScalar
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
 
   bool cpu_has_avx = CpuHasAvxFeatureFlag();
-  // Shorthand for any type of zero.
+  // Shorthand for any type of zero. The VEX form also clears the upper half of a wide vector.
   if (IsZeroBitPattern(instruction->InputAt(0))) {
     cpu_has_avx ? __ vxorps(dst, dst, dst) : __ xorps(dst, dst);
     return;
   }
 
+  if (IsWideVector(instruction)) {
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
+        __ vpbroadcastb(wide_dst, dst);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
+        __ vpbroadcastw(wide_dst, dst);
+        break;
+      case DataType::Type::kInt32:
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
+        __ vpbroadcastd(wide_dst, dst);
+        break;
+      case DataType::Type::kInt64:
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ true);
+        __ vpbroadcastq(wide_dst, dst);
+        break;
+      case DataType::Type::kFloat32:
+        DCHECK(locations->InAt(0).Equals(locations->Out()));
+        __ vbroadcastss(wide_dst, dst);
+        break;
+      case DataType::Type::kFloat64:
+        DCHECK(locations->InAt(0).Equals(locations->Out()));
+        __ vbroadcastsd(wide_dst, dst);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -247,7 +290,11 @@ void InstructionCodeGeneratorX86_64::VisitVecCnv(HVecCnv* instruction) {
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DataType::Type from = instruction->GetInputType();
   DataType::Type to = instruction->GetResultType();
-  if (from == DataType::Type::kInt32 && to == DataType::Type::kFloat32) {
+  if (from == DataType::Type::kInt32 && to == DataType::Type::kFloat32 &&
+      IsWideVector(instruction)) {
+    DCHECK_EQ(8u, instruction->GetVectorLength());
+    __ vcvtdq2ps(YmmRegister(dst), YmmRegister(src));
+  } else if (from == DataType::Type::kInt32 && to == DataType::Type::kFloat32) {
     DCHECK_EQ(4u, instruction->GetVectorLength());
     __ cvtdq2ps(dst, src);
   } else {
@@ -263,6 +310,42 @@ void InstructionCodeGeneratorX86_64::VisitVecNeg(HVecNeg* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsWideVector(instruction)) {
+    YmmRegister wide_src(src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ vpxor(wide_dst, wide_dst, wide_dst);
+        __ vpsubb(wide_dst, wide_dst, wide_src);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpxor(wide_dst, wide_dst, wide_dst);
+        __ vpsubw(wide_dst, wide_dst, wide_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpxor(wide_dst, wide_dst, wide_dst);
+        __ vpsubd(wide_dst, wide_dst, wide_src);
+        break;
+      case DataType::Type::kInt64:
+        __ vpxor(wide_dst, wide_dst, wide_dst);
+        __ vpsubq(wide_dst, wide_dst, wide_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vxorps(wide_dst, wide_dst, wide_dst);
+        __ vsubps(wide_dst, wide_dst, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vxorpd(wide_dst, wide_dst, wide_dst);
+        __ vsubpd(wide_dst, wide_dst, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
@@ -355,6 +438,41 @@ void InstructionCodeGeneratorX86_64::VisitVecNot(HVecNot* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsWideVector(instruction)) {
+    YmmRegister wide_src(src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool: {  // special case boolean-not
+        YmmRegister wide_tmp(locations->GetTemp(0).AsFpuRegister<XmmRegister>());
+        __ vpxor(wide_dst, wide_dst, wide_dst);
+        __ vpcmpeqb(wide_tmp, wide_tmp, wide_tmp);  // all ones
+        __ vpsubb(wide_dst, wide_dst, wide_tmp);  // 32 x one
+        __ vpxor(wide_dst, wide_dst, wide_src);
+        break;
+      }
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpcmpeqb(wide_dst, wide_dst, wide_dst);  // all ones
+        __ vpxor(wide_dst, wide_dst, wide_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vpcmpeqb(wide_dst, wide_dst, wide_dst);  // all ones
+        __ vxorps(wide_dst, wide_dst, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vpcmpeqb(wide_dst, wide_dst, wide_dst);  // all ones
+        __ vxorpd(wide_dst, wide_dst, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool: {  // special case boolean-not
       DCHECK_EQ(16u, instruction->GetVectorLength());
@@ -452,6 +570,38 @@ void InstructionCodeGeneratorX86_64::VisitVecAdd(HVecAdd* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsWideVector(instruction)) {
+    DCHECK(cpu_has_avx);
+    YmmRegister wide_src(src);
+    YmmRegister wide_other_src(other_src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ vpaddb(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpaddw(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpaddd(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kInt64:
+        __ vpaddq(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vaddps(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vaddpd(wide_dst, wide_other_src, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
@@ -559,6 +709,38 @@ void InstructionCodeGeneratorX86_64::VisitVecSub(HVecSub* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsWideVector(instruction)) {
+    DCHECK(cpu_has_avx);
+    YmmRegister wide_src(src);
+    YmmRegister wide_other_src(other_src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ vpsubb(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsubw(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpsubd(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kInt64:
+        __ vpsubq(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vsubps(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vsubpd(wide_dst, wide_other_src, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
@@ -639,6 +821,31 @@ void InstructionCodeGeneratorX86_64::VisitVecMul(HVecMul* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsWideVector(instruction)) {
+    DCHECK(cpu_has_avx);
+    YmmRegister wide_src(src);
+    YmmRegister wide_other_src(other_src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpmullw(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpmulld(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vmulps(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vmulpd(wide_dst, wide_other_src, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
@@ -678,6 +885,24 @@ void InstructionCodeGeneratorX86_64::VisitVecDiv(HVecDiv* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsWideVector(instruction)) {
+    DCHECK(cpu_has_avx);
+    YmmRegister wide_src(src);
+    YmmRegister wide_other_src(other_src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kFloat32:
+        __ vdivps(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vdivpd(wide_dst, wide_other_src, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kFloat32:
       DCHECK_EQ(4u, instruction->GetVectorLength());
@@ -806,6 +1031,33 @@ void InstructionCodeGeneratorX86_64::VisitVecAnd(HVecAnd* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsWideVector(instruction)) {
+    DCHECK(cpu_has_avx);
+    YmmRegister wide_src(src);
+    YmmRegister wide_other_src(other_src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpand(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vandps(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vandpd(wide_dst, wide_other_src, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -847,6 +1099,33 @@ void InstructionCodeGeneratorX86_64::VisitVecAndNot(HVecAndNot* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsWideVector(instruction)) {
+    DCHECK(cpu_has_avx);
+    YmmRegister wide_src(src);
+    YmmRegister wide_other_src(other_src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpandn(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vandnps(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vandnpd(wide_dst, wide_other_src, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -888,6 +1167,33 @@ void InstructionCodeGeneratorX86_64::VisitVecOr(HVecOr* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsWideVector(instruction)) {
+    DCHECK(cpu_has_avx);
+    YmmRegister wide_src(src);
+    YmmRegister wide_other_src(other_src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpor(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vorps(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vorpd(wide_dst, wide_other_src, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -929,6 +1235,33 @@ void InstructionCodeGeneratorX86_64::VisitVecXor(HVecXor* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsWideVector(instruction)) {
+    DCHECK(cpu_has_avx);
+    YmmRegister wide_src(src);
+    YmmRegister wide_other_src(other_src);
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpxor(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vxorps(wide_dst, wide_other_src, wide_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vxorpd(wide_dst, wide_other_src, wide_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -982,6 +1315,25 @@ void InstructionCodeGeneratorX86_64::VisitVecShl(HVecShl* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsWideVector(instruction)) {
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsllw(wide_dst, wide_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt32:
+        __ vpslld(wide_dst, wide_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt64:
+        __ vpsllq(wide_dst, wide_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
@@ -1011,6 +1363,22 @@ void InstructionCodeGeneratorX86_64::VisitVecShr(HVecShr* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsWideVector(instruction)) {
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsraw(wide_dst, wide_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt32:
+        __ vpsrad(wide_dst, wide_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
@@ -1036,6 +1404,25 @@ void InstructionCodeGeneratorX86_64::VisitVecUShr(HVecUShr* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsWideVector(instruction)) {
+    YmmRegister wide_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsrlw(wide_dst, wide_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt32:
+        __ vpsrld(wide_dst, wide_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      case DataType::Type::kInt64:
+        __ vpsrlq(wide_dst, wide_dst, Immediate(static_cast<int8_t>(value)));
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
@@ -1268,6 +1655,31 @@ void InstructionCodeGeneratorX86_64::VisitVecLoad(HVecLoad* instruction) {
   size_t size = DataType::Size(instruction->GetPackedType());
   Address address = VecAddress(locations, size, instruction->IsStringCharAt());
   XmmRegister reg = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsWideVector(instruction)) {
+    // Unaligned loads are as fast as aligned ones when the address is aligned.
+    DCHECK(!instruction->IsStringCharAt());
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vmovdqu(YmmRegister(reg), address);
+        break;
+      case DataType::Type::kFloat32:
+        __ vmovups(YmmRegister(reg), address);
+        break;
+      case DataType::Type::kFloat64:
+        __ vmovupd(YmmRegister(reg), address);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
   switch (instruction->GetPackedType()) {
     case DataType::Type::kInt16:  // (short) s.charAt(.) can yield HVecLoad/Int16/StringCharAt.
@@ -1327,6 +1739,29 @@ void InstructionCodeGeneratorX86_64::VisitVecStore(HVecStore* instruction) {
   size_t size = DataType::Size(instruction->GetPackedType());
   Address address = VecAddress(locations, size, /*is_string_char_at*/ false);
   XmmRegister reg = locations->InAt(2).AsFpuRegister<XmmRegister>();
+  if (IsWideVector(instruction)) {
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vmovdqu(address, YmmRegister(reg));
+        break;
+      case DataType::Type::kFloat32:
+        __ vmovups(address, YmmRegister(reg));
+        break;
+      case DataType::Type::kFloat64:
+        __ vmovupd(address, YmmRegister(reg));
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
   bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
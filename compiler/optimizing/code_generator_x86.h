@@ -60,6 +60,9 @@ static constexpr size_t kRuntimeParameterFpuRegistersLength =
   V(CRC32Update)                            \
   V(CRC32UpdateBytes)                       \
   V(CRC32UpdateByteBuffer)                  \
+  V(Adler32Update)                          \
+  V(Adler32UpdateBytes)                     \
+  V(Adler32UpdateByteBuffer)                \
   V(FP16ToFloat)                            \
   V(FP16ToHalf)                             \
   V(FP16Floor)                              \
@@ -73,6 +76,9 @@ static constexpr size_t kRuntimeParameterFpuRegistersLength =
   V(FP16Min)                                \
   V(FP16Max)                                \
   V(MathMultiplyHigh)                       \
+  V(ArraysEqualsByte)                       \
+  V(ArraysHashCodeByte)                     \
+  V(StringHashCode)                         \
   V(StringStringIndexOf)                    \
   V(StringStringIndexOfAfter)               \
   V(StringBufferAppend)                     \
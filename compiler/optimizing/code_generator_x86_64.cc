@@ -1169,6 +1169,7 @@ void CodeGeneratorX86_64::LoadMethod(MethodLoadKind load_kind, Location temp, HI
 void CodeGeneratorX86_64::GenerateStaticOrDirectCall(
     HInvokeStaticOrDirect* invoke, Location temp, SlowPathCode* slow_path) {
   // All registers are assumed to be correctly set up.
+  MaybeEmitVZeroUpper();
 
   Location callee_method = temp;  // For all kinds except kRecursive, callee will be in temp.
   switch (invoke->GetMethodLoadKind()) {
@@ -1263,6 +1264,7 @@ void CodeGeneratorX86_64::GenerateStaticOrDirectCall(
 
 void CodeGeneratorX86_64::GenerateVirtualCall(
     HInvokeVirtual* invoke, Location temp_in, SlowPathCode* slow_path) {
+  MaybeEmitVZeroUpper();
   CpuRegister temp = temp_in.AsRegister<CpuRegister>();
   size_t method_offset = mirror::Class::EmbeddedVTableEntryOffset(
       invoke->GetVTableIndex(), kX86_64PointerSize).SizeValue();
@@ -1528,7 +1530,7 @@ size_t CodeGeneratorX86_64::RestoreCoreRegister(size_t stack_index, uint32_t reg
 
 size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
   if (GetGraph()->HasSIMD()) {
-    __ movups(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
+    StoreSIMDRegister(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
   } else {
     __ movsd(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
   }
@@ -1537,7 +1539,7 @@ size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32
 
 size_t CodeGeneratorX86_64::RestoreFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
   if (GetGraph()->HasSIMD()) {
-    __ movups(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
+    LoadSIMDRegister(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
   } else {
     __ movsd(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
   }
@@ -1563,6 +1565,9 @@ void CodeGeneratorX86_64::InvokeRuntimeWithoutRecordingPcInfo(int32_t entry_poin
 }
 
 void CodeGeneratorX86_64::GenerateInvokeRuntime(int32_t entry_point_offset) {
+  // The runtime is compiled without AVX. Live SIMD values have been saved by the caller (slow
+  // paths save full width registers) or are not preserved across calls anyway.
+  MaybeEmitVZeroUpper();
   __ gs()->call(Address::Absolute(entry_point_offset, /* no_rip= */ true));
 }
 
@@ -1925,6 +1930,7 @@ void CodeGeneratorX86_64::GenerateFrameEntry() {
 
 void CodeGeneratorX86_64::GenerateFrameExit() {
   __ cfi().RememberState();
+  MaybeEmitVZeroUpper();
   if (!HasEmptyFrame()) {
     uint32_t xmm_spill_location = GetFpuSpillStart();
     size_t xmm_spill_slot_size = GetCalleePreservedFPWidth();
@@ -3240,6 +3246,7 @@ void InstructionCodeGeneratorX86_64::VisitInvokeInterface(HInvokeInterface* invo
     Location hidden_reg = locations->GetTemp(1);
     __ movq(hidden_reg.AsRegister<CpuRegister>(), temp);
   }
+  codegen_->MaybeEmitVZeroUpper();
   // call temp->GetEntryPoint();
   __ call(Address(
       temp, ArtMethod::EntryPointFromQuickCompiledCodeOffset(kX86_64PointerSize).SizeValue()));
@@ -6403,15 +6410,17 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsSIMDStackSlot()) {
     if (destination.IsFpuRegister()) {
-      __ movups(destination.AsFpuRegister<XmmRegister>(),
-                Address(CpuRegister(RSP), source.GetStackIndex()));
+      codegen_->LoadSIMDRegister(destination.AsFpuRegister<XmmRegister>(),
+                                 Address(CpuRegister(RSP), source.GetStackIndex()));
     } else {
       DCHECK(destination.IsSIMDStackSlot());
-      size_t high = kX86_64WordSize;
-      __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex()));
-      __ movq(Address(CpuRegister(RSP), destination.GetStackIndex()), CpuRegister(TMP));
-      __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex() + high));
-      __ movq(Address(CpuRegister(RSP), destination.GetStackIndex() + high), CpuRegister(TMP));
+      for (size_t offset = 0, e = codegen_->GetSIMDRegisterWidth();
+           offset != e;
+           offset += kX86_64WordSize) {
+        __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex() + offset));
+        __ movq(Address(CpuRegister(RSP), destination.GetStackIndex() + offset),
+                CpuRegister(TMP));
+      }
     }
   } else if (source.IsConstant()) {
     HConstant* constant = source.GetConstant();
@@ -6459,7 +6468,12 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsFpuRegister()) {
     if (destination.IsFpuRegister()) {
-      __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      if (codegen_->GetGraph()->HasWideSIMD()) {
+        __ vmovaps(YmmRegister(destination.AsFpuRegister<XmmRegister>()),
+                   YmmRegister(source.AsFpuRegister<XmmRegister>()));
+      } else {
+        __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      }
     } else if (destination.IsStackSlot()) {
       __ movss(Address(CpuRegister(RSP), destination.GetStackIndex()),
                source.AsFpuRegister<XmmRegister>());
@@ -6468,8 +6482,8 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
                source.AsFpuRegister<XmmRegister>());
     } else {
        DCHECK(destination.IsSIMDStackSlot());
-      __ movups(Address(CpuRegister(RSP), destination.GetStackIndex()),
-                source.AsFpuRegister<XmmRegister>());
+      codegen_->StoreSIMDRegister(Address(CpuRegister(RSP), destination.GetStackIndex()),
+                                  source.AsFpuRegister<XmmRegister>());
     }
   }
 }
@@ -6513,6 +6527,15 @@ void ParallelMoveResolverX86_64::Exchange128(XmmRegister reg, int mem) {
   __ addq(CpuRegister(RSP), Immediate(extra_slot));
 }
 
+void ParallelMoveResolverX86_64::Exchange256(XmmRegister reg, int mem) {
+  size_t extra_slot = 4 * kX86_64WordSize;
+  __ subq(CpuRegister(RSP), Immediate(extra_slot));
+  __ vmovups(Address(CpuRegister(RSP), 0), YmmRegister(reg));
+  ExchangeMemory64(0, mem + extra_slot, 4);
+  __ vmovups(YmmRegister(reg), Address(CpuRegister(RSP), 0));
+  __ addq(CpuRegister(RSP), Immediate(extra_slot));
+}
+
 void ParallelMoveResolverX86_64::ExchangeMemory32(int mem1, int mem2) {
   ScratchRegisterScope ensure_scratch(
       this, TMP, RAX, codegen_->GetNumberOfCoreRegisters());
@@ -6565,6 +6588,18 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
     Exchange64(destination.AsRegister<CpuRegister>(), source.GetStackIndex());
   } else if (source.IsDoubleStackSlot() && destination.IsDoubleStackSlot()) {
     ExchangeMemory64(destination.GetStackIndex(), source.GetStackIndex(), 1);
+  } else if (source.IsFpuRegister() &&
+             destination.IsFpuRegister() &&
+             codegen_->GetGraph()->HasWideSIMD()) {
+    // Swap all 256 bits through the stack, there is no spare vector register.
+    YmmRegister reg1(source.AsFpuRegister<XmmRegister>());
+    YmmRegister reg2(destination.AsFpuRegister<XmmRegister>());
+    size_t extra_slot = 4 * kX86_64WordSize;
+    __ subq(CpuRegister(RSP), Immediate(extra_slot));
+    __ vmovups(Address(CpuRegister(RSP), 0), reg1);
+    __ vmovaps(reg1, reg2);
+    __ vmovups(reg2, Address(CpuRegister(RSP), 0));
+    __ addq(CpuRegister(RSP), Immediate(extra_slot));
   } else if (source.IsFpuRegister() && destination.IsFpuRegister()) {
     __ movd(CpuRegister(TMP), source.AsFpuRegister<XmmRegister>());
     __ movaps(source.AsFpuRegister<XmmRegister>(), destination.AsFpuRegister<XmmRegister>());
@@ -6578,11 +6613,21 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
   } else if (source.IsDoubleStackSlot() && destination.IsFpuRegister()) {
     Exchange64(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
   } else if (source.IsSIMDStackSlot() && destination.IsSIMDStackSlot()) {
-    ExchangeMemory64(destination.GetStackIndex(), source.GetStackIndex(), 2);
+    ExchangeMemory64(destination.GetStackIndex(),
+                     source.GetStackIndex(),
+                     codegen_->GetSIMDRegisterWidth() / kX86_64WordSize);
   } else if (source.IsFpuRegister() && destination.IsSIMDStackSlot()) {
-    Exchange128(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
+    if (codegen_->GetGraph()->HasWideSIMD()) {
+      Exchange256(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
+    } else {
+      Exchange128(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
+    }
   } else if (destination.IsFpuRegister() && source.IsSIMDStackSlot()) {
-    Exchange128(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
+    if (codegen_->GetGraph()->HasWideSIMD()) {
+      Exchange256(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
+    } else {
+      Exchange128(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
+    }
   } else {
     LOG(FATAL) << "Unimplemented swap between " << source << " and " << destination;
   }
@@ -8390,6 +8435,28 @@ void CodeGeneratorX86_64::Store64BitValueToStack(Location dest, int64_t value) {
   }
 }
 
+void CodeGeneratorX86_64::LoadSIMDRegister(XmmRegister dest, const Address& src) {
+  if (GetGraph()->HasWideSIMD()) {
+    __ vmovups(YmmRegister(dest), src);
+  } else {
+    __ movups(dest, src);
+  }
+}
+
+void CodeGeneratorX86_64::StoreSIMDRegister(const Address& dest, XmmRegister src) {
+  if (GetGraph()->HasWideSIMD()) {
+    __ vmovups(dest, YmmRegister(src));
+  } else {
+    __ movups(dest, src);
+  }
+}
+
+void CodeGeneratorX86_64::MaybeEmitVZeroUpper() {
+  if (GetGraph()->HasWideSIMD()) {
+    __ vzeroupper();
+  }
+}
+
 /**
  * Class to handle late fixup of offsets into constant area.
  */
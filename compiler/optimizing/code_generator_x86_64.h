@@ -54,9 +54,6 @@ static constexpr size_t kRuntimeParameterFpuRegistersLength =
 static constexpr FloatRegister non_volatile_xmm_regs[] = { XMM12, XMM13, XMM14, XMM15 };
 
 #define UNIMPLEMENTED_INTRINSIC_LIST_X86_64(V) \
-  V(CRC32Update)                               \
-  V(CRC32UpdateBytes)                          \
-  V(CRC32UpdateByteBuffer)                     \
   V(FP16ToFloat)                               \
   V(FP16ToHalf)                                \
   V(FP16Floor)                                 \
@@ -207,6 +204,7 @@ class ParallelMoveResolverX86_64 : public ParallelMoveResolverWithSwap {
   void Exchange64(CpuRegister reg, int mem);
   void Exchange64(XmmRegister reg, int mem);
   void Exchange128(XmmRegister reg, int mem);
+  void Exchange256(XmmRegister reg, int mem);
   void ExchangeMemory32(int mem1, int mem2);
   void ExchangeMemory64(int mem1, int mem2, int num_of_qwords);
 
@@ -431,7 +429,8 @@ class CodeGeneratorX86_64 : public CodeGenerator {
   }
 
   size_t GetSIMDRegisterWidth() const override {
-    return 2 * kX86_64WordSize;
+    // Graphs vectorized with AVX2 use the full 256-bit YMM registers.
+    return GetGraph()->HasWideSIMD() ? 4 * kX86_64WordSize : 2 * kX86_64WordSize;
   }
 
   HGraphVisitor* GetLocationBuilder() override {
@@ -685,6 +684,16 @@ class CodeGeneratorX86_64 : public CodeGenerator {
   // Store a 64 bit value into a DoubleStackSlot in the most efficient manner.
   void Store64BitValueToStack(Location dest, int64_t value);
 
+  // Load or store the full SIMD register, 256 bits wide in graphs with wide SIMD.
+  void LoadSIMDRegister(XmmRegister dest, const Address& src);
+  void StoreSIMDRegister(const Address& dest, XmmRegister src);
+
+  // Clear the upper halves of the YMM registers before leaving code using wide SIMD,
+  // avoiding the AVX-SSE transition penalty in the code that follows. Emitted before
+  // every call to managed code, native code (including @CriticalNative) and the runtime,
+  // and on method exit.
+  void MaybeEmitVZeroUpper();
+
   void MoveFromReturnRegister(Location trg, DataType::Type type) override;
 
   // Assign a 64 bit constant to an address.
@@ -45,8 +45,21 @@ bool CodeSinking::Run() {
 void CodeSinking::UncommonBranchSinking() {
   HBasicBlock* exit = graph_->GetExitBlock();
   DCHECK(exit != nullptr);
-  // TODO(ngeoffray): we do not profile branches yet, so use throw instructions
-  // as an indicator of an uncommon branch.
+  // Use the branch profile when we have one. We do not sink to unlikely
+  // successors in loops, as this could move instructions into the loop.
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    HInstruction* last = block->GetLastInstruction();
+    if (last->IsIf()) {
+      HBasicBlock* unlikely = last->AsIf()->GetUnlikelySuccessor();
+      if (unlikely != nullptr &&
+          unlikely->GetSinglePredecessor() == block &&
+          !unlikely->IsInLoop()) {
+        SinkCodeToUncommonBranch(unlikely);
+      }
+    }
+  }
+
+  // Throw instructions are also an indicator of an uncommon branch.
   for (HBasicBlock* exit_predecessor : exit->GetPredecessors()) {
     HInstruction* last = exit_predecessor->GetLastInstruction();
 
@@ -340,8 +353,8 @@ void CodeSinking::SinkCodeToUncommonBranch(HBasicBlock* end_block) {
   // Step (1): Visit post order to get a subset of blocks post dominated by `end_block`.
   // TODO(ngeoffray): Getting the full set of post-dominated should be done by
   // computing the post dominator tree, but that could be too time consuming. Also,
-  // we should start the analysis from blocks dominated by an uncommon branch, but we
-  // don't profile branches yet.
+  // we should start the analysis from blocks dominated by an uncommon branch, not
+  // just `end_block`.
   bool found_block = false;
   for (HBasicBlock* block : graph_->GetPostOrder()) {
     if (block == end_block) {
@@ -969,6 +969,8 @@ void HDeadCodeElimination::UpdateGraphFlags() {
   graph_->SetHasMonitorOperations(has_monitor_operations);
   graph_->SetHasTraditionalSIMD(has_traditional_simd);
   graph_->SetHasPredicatedSIMD(has_predicated_simd);
+  // The vector width is only kept while the wide vector operations remain.
+  graph_->SetHasWideSIMD(graph_->HasWideSIMD() && has_traditional_simd);
   graph_->SetHasBoundsChecks(has_bounds_checks);
   graph_->SetHasAlwaysThrowingInvokes(has_always_throwing_invokes);
 }
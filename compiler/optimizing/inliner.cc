@@ -52,6 +52,10 @@ namespace art HIDDEN {
 // Instruction limit to control memory.
 static constexpr size_t kMaximumNumberOfTotalInstructions = 1024;
 
+// Instruction limit when compiling OSR. OSR code is only entered at loop headers, so the
+// budget only accounts for loops and is larger than for regular compilations.
+static constexpr size_t kMaximumNumberOfTotalInstructionsForOsr = 2048;
+
 // Maximum number of instructions for considering a method small,
 // which we will always try to inline if the other non-instruction limits
 // are not reached.
@@ -111,9 +115,12 @@ std::string HInliner::DepthString(int line) const {
   return value;
 }
 
-static size_t CountNumberOfInstructions(HGraph* graph) {
+static size_t CountNumberOfInstructions(HGraph* graph, bool only_in_loops = false) {
   size_t number_of_instructions = 0;
   for (HBasicBlock* block : graph->GetReversePostOrderSkipEntryBlock()) {
+    if (only_in_loops && !block->IsInLoop()) {
+      continue;
+    }
     for (HInstructionIterator instr_it(block->GetInstructions());
          !instr_it.Done();
          instr_it.Advance()) {
@@ -124,13 +131,16 @@ static size_t CountNumberOfInstructions(HGraph* graph) {
 }
 
 void HInliner::UpdateInliningBudget() {
-  if (total_number_of_instructions_ >= kMaximumNumberOfTotalInstructions) {
+  size_t maximum_number_of_total_instructions = outermost_graph_->IsCompilingOsr()
+      ? kMaximumNumberOfTotalInstructionsForOsr
+      : kMaximumNumberOfTotalInstructions;
+  if (total_number_of_instructions_ >= maximum_number_of_total_instructions) {
     // Always try to inline small methods.
     inlining_budget_ = kMaximumNumberOfInstructionsForSmallMethod;
   } else {
     inlining_budget_ = std::max(
         kMaximumNumberOfInstructionsForSmallMethod,
-        kMaximumNumberOfTotalInstructions - total_number_of_instructions_);
+        maximum_number_of_total_instructions - total_number_of_instructions_);
   }
 }
 
@@ -146,10 +156,19 @@ bool HInliner::Run() {
 
   bool did_inline = false;
 
+  // OSR code is only entered at loop headers: the code outside loops of the method being
+  // compiled runs at most once per OSR entry and is not worth inlining into. Calls in inlined
+  // methods were all in a loop of the outermost graph.
+  const bool only_inline_in_loops = graph_->IsCompilingOsr() && outermost_graph_ == graph_;
+
   // Initialize the number of instructions for the method being compiled. Recursive calls
   // to HInliner::Run have already updated the instruction count.
   if (outermost_graph_ == graph_) {
-    total_number_of_instructions_ = CountNumberOfInstructions(graph_);
+    total_number_of_instructions_ = CountNumberOfInstructions(graph_, only_inline_in_loops);
+    if (total_number_of_instructions_ == 0u) {
+      DCHECK(only_inline_in_loops);
+      return false;
+    }
   }
 
   UpdateInliningBudget();
@@ -176,6 +195,14 @@ bool HInliner::Run() {
   // we just iterate over the blocks of the outer method.
   // This avoids doing the inlining work again on the inlined blocks.
   for (HBasicBlock* block : blocks) {
+    if (only_inline_in_loops && !block->IsInLoop()) {
+      for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+        if (it.Current()->IsInvoke()) {
+          MaybeRecordStat(stats_, MethodCompilationStat::kNotInlinedOsrOutsideLoop);
+        }
+      }
+      continue;
+    }
     for (HInstruction* instruction = block->GetFirstInstruction(); instruction != nullptr;) {
       HInstruction* next = instruction->GetNext();
       HInvoke* call = instruction->AsInvokeOrNull();
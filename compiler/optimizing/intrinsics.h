@@ -35,6 +35,35 @@ static constexpr uint64_t kPositiveInfinityDouble = UINT64_C(0x7ff0000000000000)
 static constexpr uint32_t kNanFloat = 0x7fc00000U;
 static constexpr uint64_t kNanDouble = 0x7ff8000000000000;
 
+// Multiplier of the polynomial hash computed by `String.hashCode()` and `Arrays.hashCode()`.
+static constexpr uint32_t kHashCodeMultiplier = 31u;
+
+// Number of elements processed by one iteration of the vectorized hash code loops.
+static constexpr size_t kHashCodeBlockSize = 16u;
+
+// Returns `kHashCodeMultiplier` raised to the power `n`, with int32 overflow semantics.
+static constexpr int32_t HashCodeMultiplierPower(uint32_t n) {
+  uint32_t result = 1u;
+  for (uint32_t i = 0; i != n; ++i) {
+    result *= kHashCodeMultiplier;
+  }
+  return static_cast<int32_t>(result);
+}
+
+// Modulus of the Adler-32 checksum, the largest prime below 65536.
+static constexpr uint32_t kAdler32Base = 65521u;
+
+// Largest number of bytes for which the Adler-32 sums cannot overflow 32 bits
+// between two modulo reductions, the NMAX of zlib.
+static constexpr uint32_t kAdler32MaxBlock = 5552u;
+
+// The threshold for sizes of data to use the library provided implementation of
+// Adler32.updateBytes() and Adler32.updateByteBuffer() instead of the intrinsic.
+// The library is faster for long data, where the cost of the native call is amortized.
+// The intrinsics rely on the threshold to reduce the sums only once.
+static constexpr int32_t kAdler32UpdateBytesThreshold = 1024;
+static_assert(static_cast<uint32_t>(kAdler32UpdateBytesThreshold) <= kAdler32MaxBlock);
+
 class IntrinsicVisitor : public ValueObject {
  public:
   virtual ~IntrinsicVisitor() {}
@@ -2729,6 +2729,360 @@ void IntrinsicCodeGeneratorARM64::VisitStringGetCharsNoCheck(HInvoke* invoke) {
   __ Bind(&done);
 }
 
+// Number of SIMD temporaries used by `GenerateHashCode()`.
+static constexpr size_t kHashCodeVRegisterTemps = 8u;
+
+static void CreateHashCodeLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  // Data pointer and remaining length.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  for (size_t i = 0; i != kHashCodeVRegisterTemps; ++i) {
+    locations->AddTemp(Location::RequiresFpuRegister());
+  }
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Widens the low or high half of the packed elements of `src` to twice their size.
+static void UnpackToWider(MacroAssembler* masm,
+                          const VRegister& dst,
+                          const VRegister& src,
+                          size_t element_size,
+                          bool is_signed,
+                          bool high) {
+  DCHECK(element_size == 1u || element_size == 2u);
+  VRegister wide_dst = (element_size == 1u) ? dst.V8H() : dst.V4S();
+  VRegister narrow_src = (element_size == 1u)
+      ? (high ? src.V16B() : src.V8B())
+      : (high ? src.V8H() : src.V4H());
+  if (is_signed) {
+    if (high) {
+      __ Sxtl2(wide_dst, narrow_src);
+    } else {
+      __ Sxtl(wide_dst, narrow_src);
+    }
+  } else {
+    if (high) {
+      __ Uxtl2(wide_dst, narrow_src);
+    } else {
+      __ Uxtl(wide_dst, narrow_src);
+    }
+  }
+}
+
+// Computes the polynomial hash `hash = 31 * hash + element` over `length` elements of `type`
+// starting at `data`. Blocks of 16 elements are processed with four accumulators of four
+// int32 lanes each, where each lane holds the hash of the elements at its position in the
+// blocks; the lanes are combined with the right powers of 31 after the loop. The remaining
+// elements are processed one at a time. Clobbers `data`, `length` and all the temporaries.
+static void GenerateHashCode(MacroAssembler* masm,
+                             LocationSummary* locations,
+                             DataType::Type type,
+                             const Register& data,
+                             const Register& length,
+                             const Register& hash) {
+  DCHECK(type == DataType::Type::kUint8 ||
+         type == DataType::Type::kInt8 ||
+         type == DataType::Type::kUint16);
+  const size_t element_size = DataType::Size(type);
+  const bool is_signed = (type == DataType::Type::kInt8);
+  VRegister multiplier = QRegisterFrom(locations->GetTemp(2));
+  VRegister acc[] = {
+      QRegisterFrom(locations->GetTemp(3)),
+      QRegisterFrom(locations->GetTemp(4)),
+      QRegisterFrom(locations->GetTemp(5)),
+      QRegisterFrom(locations->GetTemp(6)),
+  };
+  VRegister values = QRegisterFrom(locations->GetTemp(7));
+  VRegister values2 = QRegisterFrom(locations->GetTemp(8));
+  VRegister half = QRegisterFrom(locations->GetTemp(9));
+  static_assert(kHashCodeBlockSize == 16u);
+
+  UseScratchRegisterScope temps(masm);
+  Register temp = temps.AcquireW();
+
+  auto load_multiplier = [&](uint32_t power) {
+    __ Mov(temp, HashCodeMultiplierPower(power));
+    __ Dup(multiplier.V4S(), temp);
+  };
+  auto accumulate = [&](const VRegister& accumulator, const VRegister& value) {
+    __ Mul(accumulator.V4S(), accumulator.V4S(), multiplier.V4S());
+    __ Add(accumulator.V4S(), accumulator.V4S(), value.V4S());
+  };
+
+  vixl::aarch64::Label scalar_loop;
+  vixl::aarch64::Label vector_loop;
+  vixl::aarch64::Label done;
+  __ Cmp(length, kHashCodeBlockSize);
+  __ B(lt, &scalar_loop);
+
+  load_multiplier(kHashCodeBlockSize);
+  __ Movi(acc[0].V2D(), 0);
+  __ Movi(acc[1].V2D(), 0);
+  __ Movi(acc[2].V2D(), 0);
+  __ Movi(acc[3].V2D(), 0);
+  // The initial hash goes to the last lane, which is not multiplied when combining the lanes.
+  __ Mov(acc[3].V4S(), 3, hash);
+
+  __ Bind(&vector_loop);
+  if (element_size == 1u) {
+    __ Ldr(values, MemOperand(data.X(), kHashCodeBlockSize, PostIndex));
+    UnpackToWider(masm, values2, values, /*element_size=*/ 1u, is_signed, /*high=*/ true);
+    UnpackToWider(masm, values, values, /*element_size=*/ 1u, is_signed, /*high=*/ false);
+  } else {
+    __ Ldp(values, values2, MemOperand(data.X(), kHashCodeBlockSize * element_size, PostIndex));
+  }
+  __ Sub(length, length, kHashCodeBlockSize);
+  UnpackToWider(masm, half, values, /*element_size=*/ 2u, is_signed, /*high=*/ false);
+  accumulate(acc[0], half);
+  UnpackToWider(masm, half, values, /*element_size=*/ 2u, is_signed, /*high=*/ true);
+  accumulate(acc[1], half);
+  UnpackToWider(masm, half, values2, /*element_size=*/ 2u, is_signed, /*high=*/ false);
+  accumulate(acc[2], half);
+  UnpackToWider(masm, half, values2, /*element_size=*/ 2u, is_signed, /*high=*/ true);
+  accumulate(acc[3], half);
+  __ Cmp(length, kHashCodeBlockSize);
+  __ B(ge, &vector_loop);
+
+  // Combine the accumulators, halving the number of lanes at each step.
+  load_multiplier(8u);
+  accumulate(acc[0], acc[2]);
+  accumulate(acc[1], acc[3]);
+  load_multiplier(4u);
+  accumulate(acc[0], acc[1]);
+  load_multiplier(2u);
+  __ Ext(values.V16B(), acc[0].V16B(), acc[0].V16B(), 8);  // Lanes 2 and 3 to lanes 0 and 1.
+  accumulate(acc[0], values);
+  load_multiplier(1u);
+  __ Ext(values.V16B(), acc[0].V16B(), acc[0].V16B(), 4);  // Lane 1 to lane 0.
+  accumulate(acc[0], values);
+  __ Umov(hash, acc[0].V4S(), 0);
+
+  __ Bind(&scalar_loop);
+  __ Cbz(length, &done);
+  switch (type) {
+    case DataType::Type::kUint8:
+      __ Ldrb(temp, MemOperand(data.X(), element_size, PostIndex));
+      break;
+    case DataType::Type::kInt8:
+      __ Ldrsb(temp, MemOperand(data.X(), element_size, PostIndex));
+      break;
+    default:
+      __ Ldrh(temp, MemOperand(data.X(), element_size, PostIndex));
+      break;
+  }
+  __ Sub(length, length, 1);
+  // hash = 31 * hash + element = (hash << 5) - hash + element.
+  __ Add(temp, temp, Operand(hash, LSL, 5));
+  __ Sub(hash, temp, hash);
+  __ B(&scalar_loop);
+
+  __ Bind(&done);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitStringHashCode(HInvoke* invoke) {
+  CreateHashCodeLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitStringHashCode(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register str = WRegisterFrom(locations->InAt(0));
+  Register data = XRegisterFrom(locations->GetTemp(0));
+  Register length = WRegisterFrom(locations->GetTemp(1));
+  Register out = WRegisterFrom(locations->Out());
+
+  const int32_t count_offset = mirror::String::CountOffset().Int32Value();
+  const int32_t hash_code_offset = mirror::String::HashCodeOffset().Int32Value();
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  vixl::aarch64::Label store;
+  vixl::aarch64::Label done;
+  // Return the cached hash code if it has been computed already.
+  __ Ldr(out, MemOperand(str.X(), hash_code_offset));
+  __ Cbnz(out, &done);
+
+  __ Ldr(length, MemOperand(str.X(), count_offset));
+  // The hash code of the empty string is 0, no need to store it. Even with string
+  // compression `count == 0` means empty.
+  static_assert(static_cast<uint32_t>(mirror::StringCompressionFlag::kCompressed) == 0u,
+                "Expecting 0=compressed, 1=uncompressed");
+  __ Cbz(length, &done);
+  __ Add(data, str.X(), value_offset);
+  if (mirror::kUseStringCompression) {
+    vixl::aarch64::Label uncompressed;
+    __ Tbnz(length, 0, &uncompressed);
+    __ Lsr(length, length, 1u);
+    GenerateHashCode(masm, locations, DataType::Type::kUint8, data, length, out);
+    __ B(&store);
+    __ Bind(&uncompressed);
+    __ Lsr(length, length, 1u);
+  }
+  GenerateHashCode(masm, locations, DataType::Type::kUint16, data, length, out);
+
+  __ Bind(&store);
+  // Another thread may compute and store the same value concurrently, which is benign.
+  __ Str(out, MemOperand(str.X(), hash_code_offset));
+  __ Bind(&done);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysHashCodeByte(HInvoke* invoke) {
+  CreateHashCodeLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysHashCodeByte(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register array = WRegisterFrom(locations->InAt(0));
+  Register data = XRegisterFrom(locations->GetTemp(0));
+  Register length = WRegisterFrom(locations->GetTemp(1));
+  Register out = WRegisterFrom(locations->Out());
+
+  const int32_t length_offset = mirror::Array::LengthOffset().Int32Value();
+  const int32_t data_offset = mirror::Array::DataOffset(sizeof(int8_t)).Int32Value();
+
+  vixl::aarch64::Label done;
+  // The hash code of a null array is 0.
+  __ Mov(out, 0);
+  __ Cbz(array, &done);
+
+  __ Ldr(length, MemOperand(array.X(), length_offset));
+  __ Add(data, array.X(), data_offset);
+  __ Mov(out, 1);
+  GenerateHashCode(masm, locations, DataType::Type::kInt8, data, length, out);
+  __ Bind(&done);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysEqualsByte(HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysEqualsByte(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register lhs = WRegisterFrom(locations->InAt(0));
+  Register rhs = WRegisterFrom(locations->InAt(1));
+  Register lhs_ptr = XRegisterFrom(locations->GetTemp(0));
+  Register rhs_ptr = XRegisterFrom(locations->GetTemp(1));
+  Register length = WRegisterFrom(locations->GetTemp(2));
+  Register rhs_value2 = XRegisterFrom(locations->GetTemp(3));
+  Register out = XRegisterFrom(locations->Out());
+
+  UseScratchRegisterScope scratch_scope(masm);
+  Register lhs_value = scratch_scope.AcquireX();
+  Register lhs_value2 = scratch_scope.AcquireX();
+  // The output register is used as a temporary until the result is known.
+  Register rhs_value = out;
+
+  const int32_t length_offset = mirror::Array::LengthOffset().Int32Value();
+  const int32_t data_offset = mirror::Array::DataOffset(sizeof(int8_t)).Int32Value();
+
+  vixl::aarch64::Label loop;
+  vixl::aarch64::Label below_16;
+  vixl::aarch64::Label below_8;
+  vixl::aarch64::Label byte_loop;
+  vixl::aarch64::Label return_true;
+  vixl::aarch64::Label return_false;
+  vixl::aarch64::Label end;
+
+  // Reference equality check, return true if same reference (including both null).
+  __ Cmp(lhs, rhs);
+  __ B(&return_true, eq);
+  __ Cbz(lhs, &return_false);
+  __ Cbz(rhs, &return_false);
+
+  __ Ldr(length, MemOperand(lhs.X(), length_offset));
+  __ Ldr(lhs_value.W(), MemOperand(rhs.X(), length_offset));
+  __ Cmp(length, lhs_value.W());
+  __ B(&return_false, ne);
+
+  __ Add(lhs_ptr, lhs.X(), data_offset);
+  __ Add(rhs_ptr, rhs.X(), data_offset);
+  __ Cmp(length, 16);
+  __ B(lt, &below_16);
+
+  // Compare 16 bytes at a time. The last, possibly partial, block is compared as a full
+  // block ending at the end of the data, overlapping the previous one.
+  __ Sub(length, length, 16);
+  __ Bind(&loop);
+  __ Ldp(lhs_value, lhs_value2, MemOperand(lhs_ptr, 16, PostIndex));
+  __ Ldp(rhs_value, rhs_value2, MemOperand(rhs_ptr, 16, PostIndex));
+  __ Cmp(lhs_value, rhs_value);
+  __ Ccmp(lhs_value2, rhs_value2, NoFlag, eq);
+  __ B(&return_false, ne);
+  __ Subs(length, length, 16);
+  __ B(gt, &loop);
+  // Here `length` is in the range [-16, 0]; at -16 the last block is compared again.
+  __ Add(lhs_ptr, lhs_ptr, Operand(length, SXTW));
+  __ Add(rhs_ptr, rhs_ptr, Operand(length, SXTW));
+  __ Ldp(lhs_value, lhs_value2, MemOperand(lhs_ptr));
+  __ Ldp(rhs_value, rhs_value2, MemOperand(rhs_ptr));
+  __ Cmp(lhs_value, rhs_value);
+  __ Ccmp(lhs_value2, rhs_value2, NoFlag, eq);
+  __ B(&return_false, ne);
+  __ B(&return_true);
+
+  // For 4 to 15 bytes, compare the first and the last 8 or 4 bytes, which may overlap.
+  __ Bind(&below_16);
+  __ Cmp(length, 8);
+  __ B(lt, &below_8);
+  __ Ldr(lhs_value, MemOperand(lhs_ptr));
+  __ Ldr(rhs_value, MemOperand(rhs_ptr));
+  __ Add(lhs_ptr, lhs_ptr, Operand(length, UXTW));
+  __ Add(rhs_ptr, rhs_ptr, Operand(length, UXTW));
+  __ Ldr(lhs_value2, MemOperand(lhs_ptr, -8));
+  __ Ldr(rhs_value2, MemOperand(rhs_ptr, -8));
+  __ Cmp(lhs_value, rhs_value);
+  __ Ccmp(lhs_value2, rhs_value2, NoFlag, eq);
+  __ B(&return_false, ne);
+  __ B(&return_true);
+  __ Bind(&below_8);
+  __ Cmp(length, 4);
+  __ B(lt, &byte_loop);
+  __ Ldr(lhs_value.W(), MemOperand(lhs_ptr));
+  __ Ldr(rhs_value.W(), MemOperand(rhs_ptr));
+  __ Add(lhs_ptr, lhs_ptr, Operand(length, UXTW));
+  __ Add(rhs_ptr, rhs_ptr, Operand(length, UXTW));
+  __ Ldr(lhs_value2.W(), MemOperand(lhs_ptr, -4));
+  __ Ldr(rhs_value2.W(), MemOperand(rhs_ptr, -4));
+  __ Cmp(lhs_value.W(), rhs_value.W());
+  __ Ccmp(lhs_value2.W(), rhs_value2.W(), NoFlag, eq);
+  __ B(&return_false, ne);
+  __ B(&return_true);
+
+  // Compare up to 3 bytes one at a time.
+  __ Bind(&byte_loop);
+  __ Cbz(length, &return_true);
+  __ Ldrb(lhs_value.W(), MemOperand(lhs_ptr, 1, PostIndex));
+  __ Ldrb(rhs_value.W(), MemOperand(rhs_ptr, 1, PostIndex));
+  __ Sub(length, length, 1);
+  __ Cmp(lhs_value.W(), rhs_value.W());
+  __ B(&byte_loop, eq);
+
+  __ Bind(&return_false);
+  __ Mov(out, 0);
+  __ B(&end);
+  __ Bind(&return_true);
+  __ Mov(out, 1);
+  __ Bind(&end);
+}
+
 // This value is greater than ARRAYCOPY_SHORT_CHAR_ARRAY_THRESHOLD in libcore,
 // so if we choose to jump to the slow path we will end up in the native implementation.
 static constexpr int32_t kSystemArrayCopyCharThreshold = 192;
@@ -3918,6 +4272,174 @@ void IntrinsicCodeGeneratorARM64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
   GenerateCodeForCalculationCRC32ValueOfBytes(masm, crc, ptr, length, out);
 }
 
+void IntrinsicLocationsBuilderARM64::VisitAdler32Update(HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Lower the invoke of Adler32.update(int adler, int b).
+void IntrinsicCodeGeneratorARM64::VisitAdler32Update(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register adler = WRegisterFrom(locations->InAt(0));
+  Register val = WRegisterFrom(locations->InAt(1));
+  Register sum1 = WRegisterFrom(locations->GetTemp(0));
+  Register out = WRegisterFrom(locations->Out());
+  UseScratchRegisterScope temps(masm);
+  Register temp = temps.AcquireW();
+
+  // The general algorithm of the Adler-32 calculation of a byte is:
+  //   sum1 = ((adler & 0xffff) + (b & 0xff)) % base
+  //   sum2 = ((adler >> 16) + sum1) % base
+  //   adler = (sum2 << 16) | sum1
+  // As both sums are below 2 * base before the modulo, a conditional subtraction
+  // is enough.
+  __ Uxtb(temp, val);
+  __ Add(sum1, temp, Operand(adler, UXTH));
+  __ Subs(temp, sum1, kAdler32Base);
+  __ Csel(sum1, temp, sum1, hs);
+  __ Add(out, sum1, Operand(adler, LSR, 16));
+  __ Subs(temp, out, kAdler32Base);
+  __ Csel(out, temp, out, hs);
+  __ Orr(out, sum1, Operand(out, LSL, 16));
+}
+
+static void CreateAdler32OfBytesLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RegisterOrConstant(invoke->InputAt(2)));
+  locations->SetInAt(3, Location::RequiresRegister());
+  // Data pointer, remaining length and the first sum.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Generate code which calculates the Adler-32 checksum of `length` bytes at `ptr`,
+// starting from `adler`. Clobbers `ptr` and all the temporaries.
+//
+// The intrinsic is used only for lengths that cannot overflow the sums, so they are
+// reduced modulo `kAdler32Base` only once, at the end.
+static void GenerateCodeForCalculationAdler32ValueOfBytes(MacroAssembler* masm,
+                                                         LocationSummary* locations,
+                                                         const Register& adler,
+                                                         const Register& ptr,
+                                                         const Register& length,
+                                                         const Register& out) {
+  Register len = WRegisterFrom(locations->GetTemp(1));
+  Register sum1 = WRegisterFrom(locations->GetTemp(2));
+  // The second sum is accumulated in `out`.
+  Register sum2 = out;
+  UseScratchRegisterScope temps(masm);
+  Register temp = temps.AcquireW();
+  Register quotient = temps.AcquireW();
+
+  vixl::aarch64::Label loop, done;
+  __ Uxth(sum1, adler);
+  __ Lsr(sum2, adler, 16);
+  __ Mov(len, length);
+  __ Cbz(len, &done);
+
+  __ Bind(&loop);
+  __ Ldrb(temp, MemOperand(ptr, 1, PostIndex));
+  __ Add(sum1, sum1, temp);
+  __ Add(sum2, sum2, sum1);
+  __ Subs(len, len, 1);
+  __ B(&loop, ne);
+
+  __ Mov(temp, kAdler32Base);
+  __ Udiv(quotient, sum1, temp);
+  __ Msub(sum1, quotient, temp, sum1);
+  __ Udiv(quotient, sum2, temp);
+  __ Msub(sum2, quotient, temp, sum2);
+
+  __ Bind(&done);
+  __ Orr(out, sum1, Operand(sum2, LSL, 16));
+}
+
+void IntrinsicLocationsBuilderARM64::VisitAdler32UpdateBytes(HInvoke* invoke) {
+  CreateAdler32OfBytesLocations(allocator_, invoke);
+}
+
+// Lower the invoke of Adler32.updateBytes(int adler, byte[] b, int off, int len)
+//
+// Note: The intrinsic is not used if len exceeds a threshold.
+void IntrinsicCodeGeneratorARM64::VisitAdler32UpdateBytes(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  Register length = WRegisterFrom(locations->InAt(3));
+  __ Cmp(length, kAdler32UpdateBytesThreshold);
+  __ B(slow_path->GetEntryLabel(), hi);
+
+  const uint32_t array_data_offset =
+      mirror::Array::DataOffset(Primitive::kPrimByte).Uint32Value();
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register array = XRegisterFrom(locations->InAt(1));
+  Location offset = locations->InAt(2);
+  if (offset.IsConstant()) {
+    int32_t offset_value = offset.GetConstant()->AsIntConstant()->GetValue();
+    __ Add(ptr, array, array_data_offset + offset_value);
+  } else {
+    __ Add(ptr, array, array_data_offset);
+    __ Add(ptr, ptr, XRegisterFrom(offset));
+  }
+
+  Register adler = WRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+  GenerateCodeForCalculationAdler32ValueOfBytes(masm, locations, adler, ptr, length, out);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitAdler32UpdateByteBuffer(HInvoke* invoke) {
+  CreateAdler32OfBytesLocations(allocator_, invoke);
+}
+
+// Lower the invoke of Adler32.updateByteBuffer(int adler, long addr, int off, int len)
+//
+// Note: The intrinsic is not used if len exceeds a threshold.
+void IntrinsicCodeGeneratorARM64::VisitAdler32UpdateByteBuffer(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  Register length = WRegisterFrom(locations->InAt(3));
+  __ Cmp(length, kAdler32UpdateBytesThreshold);
+  __ B(slow_path->GetEntryLabel(), hi);
+
+  Register addr = XRegisterFrom(locations->InAt(1));
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Location offset = locations->InAt(2);
+  if (offset.IsConstant()) {
+    int32_t offset_value = offset.GetConstant()->AsIntConstant()->GetValue();
+    __ Add(ptr, addr, offset_value);
+  } else {
+    __ Add(ptr, addr, XRegisterFrom(offset));
+  }
+
+  Register adler = WRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+  GenerateCodeForCalculationAdler32ValueOfBytes(masm, locations, adler, ptr, length, out);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
 void IntrinsicLocationsBuilderARM64::VisitFP16ToFloat(HInvoke* invoke) {
   if (!codegen_->GetInstructionSetFeatures().HasFP16()) {
     return;
@@ -1648,6 +1648,379 @@ void IntrinsicCodeGeneratorX86_64::VisitStringGetCharsNoCheck(HInvoke* invoke) {
   __ Bind(&done);
 }
 
+// Number of XMM temporaries used by `GenerateHashCode()`.
+static constexpr size_t kHashCodeXmmTemps = 9u;
+
+static void CreateHashCodeLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  // Data pointer, remaining length and a temporary for the scalar loop.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  for (size_t i = 0; i != kHashCodeXmmTemps; ++i) {
+    locations->AddTemp(Location::RequiresFpuRegister());
+  }
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+static void LoadBroadcastInt32(X86_64Assembler* assembler,
+                               XmmRegister dst,
+                               CpuRegister temp,
+                               int32_t value) {
+  __ movl(temp, Immediate(value));
+  __ movd(dst, temp, /*is64bit=*/ false);
+  __ pshufd(dst, dst, Immediate(0));
+}
+
+// Widens the low or high half of the packed elements of `reg` to twice their size, in place.
+static void UnpackToWider(X86_64Assembler* assembler,
+                          XmmRegister reg,
+                          XmmRegister zero,
+                          size_t element_size,
+                          bool is_signed,
+                          bool high) {
+  DCHECK(element_size == 1u || element_size == 2u);
+  // For signed elements, interleave the elements with themselves and shift right
+  // arithmetically, otherwise interleave them with zeros.
+  XmmRegister other = is_signed ? reg : zero;
+  if (element_size == 1u) {
+    if (high) {
+      __ punpckhbw(reg, other);
+    } else {
+      __ punpcklbw(reg, other);
+    }
+    if (is_signed) {
+      __ psraw(reg, Immediate(8));
+    }
+  } else {
+    if (high) {
+      __ punpckhwd(reg, other);
+    } else {
+      __ punpcklwd(reg, other);
+    }
+    if (is_signed) {
+      __ psrad(reg, Immediate(16));
+    }
+  }
+}
+
+static void AccumulateHashCode(X86_64Assembler* assembler,
+                               XmmRegister acc,
+                               XmmRegister multiplier,
+                               XmmRegister values) {
+  __ pmulld(acc, multiplier);
+  __ paddd(acc, values);
+}
+
+// Computes the polynomial hash `hash = 31 * hash + element` over `length` elements of `type`
+// starting at `data`. Blocks of 16 elements are processed with four accumulators of four
+// int32 lanes each, where each lane holds the hash of the elements at its position in the
+// blocks; the lanes are combined with the right powers of 31 after the loop. The remaining
+// elements are processed one at a time. Clobbers `data`, `length` and all the temporaries.
+static void GenerateHashCode(X86_64Assembler* assembler,
+                             LocationSummary* locations,
+                             DataType::Type type,
+                             CpuRegister data,
+                             CpuRegister length,
+                             CpuRegister hash) {
+  DCHECK(type == DataType::Type::kUint8 ||
+         type == DataType::Type::kInt8 ||
+         type == DataType::Type::kUint16);
+  const size_t element_size = DataType::Size(type);
+  const bool is_signed = (type == DataType::Type::kInt8);
+  CpuRegister temp = locations->GetTemp(2).AsRegister<CpuRegister>();
+  XmmRegister zero = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
+  XmmRegister multiplier = locations->GetTemp(4).AsFpuRegister<XmmRegister>();
+  XmmRegister acc[] = {
+      locations->GetTemp(5).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(6).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(7).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(8).AsFpuRegister<XmmRegister>(),
+  };
+  XmmRegister values = locations->GetTemp(9).AsFpuRegister<XmmRegister>();
+  XmmRegister half = locations->GetTemp(10).AsFpuRegister<XmmRegister>();
+  XmmRegister quarter = locations->GetTemp(11).AsFpuRegister<XmmRegister>();
+  static_assert(kHashCodeBlockSize == 16u);
+
+  Label scalar_loop, vector_loop, done;
+  __ cmpl(length, Immediate(kHashCodeBlockSize));
+  __ j(kLess, &scalar_loop);
+
+  __ pxor(zero, zero);
+  LoadBroadcastInt32(assembler, multiplier, temp, HashCodeMultiplierPower(kHashCodeBlockSize));
+  __ pxor(acc[0], acc[0]);
+  __ pxor(acc[1], acc[1]);
+  __ pxor(acc[2], acc[2]);
+  // The initial hash goes to the last lane, which is not multiplied when combining the lanes.
+  __ movd(acc[3], hash, /*is64bit=*/ false);
+  __ pshufd(acc[3], acc[3], Immediate(0x15));
+
+  __ Bind(&vector_loop);
+  if (element_size == 1u) {
+    __ movdqu(values, Address(data, 0));
+    __ movdqa(half, values);
+    UnpackToWider(assembler, half, zero, /*element_size=*/ 1u, is_signed, /*high=*/ false);
+    __ movdqa(quarter, half);
+    UnpackToWider(assembler, quarter, zero, /*element_size=*/ 2u, is_signed, /*high=*/ false);
+    AccumulateHashCode(assembler, acc[0], multiplier, quarter);
+    UnpackToWider(assembler, half, zero, /*element_size=*/ 2u, is_signed, /*high=*/ true);
+    AccumulateHashCode(assembler, acc[1], multiplier, half);
+    UnpackToWider(assembler, values, zero, /*element_size=*/ 1u, is_signed, /*high=*/ true);
+    __ movdqa(quarter, values);
+    UnpackToWider(assembler, quarter, zero, /*element_size=*/ 2u, is_signed, /*high=*/ false);
+    AccumulateHashCode(assembler, acc[2], multiplier, quarter);
+    UnpackToWider(assembler, values, zero, /*element_size=*/ 2u, is_signed, /*high=*/ true);
+    AccumulateHashCode(assembler, acc[3], multiplier, values);
+  } else {
+    for (size_t i = 0; i != 2u; ++i) {
+      __ movdqu(values, Address(data, dchecked_integral_cast<int32_t>(i * 16u)));
+      __ movdqa(quarter, values);
+      UnpackToWider(assembler, quarter, zero, /*element_size=*/ 2u, is_signed, /*high=*/ false);
+      AccumulateHashCode(assembler, acc[2u * i], multiplier, quarter);
+      UnpackToWider(assembler, values, zero, /*element_size=*/ 2u, is_signed, /*high=*/ true);
+      AccumulateHashCode(assembler, acc[2u * i + 1u], multiplier, values);
+    }
+  }
+  __ addq(data, Immediate(kHashCodeBlockSize * element_size));
+  __ subl(length, Immediate(kHashCodeBlockSize));
+  __ cmpl(length, Immediate(kHashCodeBlockSize));
+  __ j(kGreaterEqual, &vector_loop);
+
+  // Combine the accumulators, halving the number of lanes at each step.
+  LoadBroadcastInt32(assembler, multiplier, temp, HashCodeMultiplierPower(8u));
+  AccumulateHashCode(assembler, acc[0], multiplier, acc[2]);
+  AccumulateHashCode(assembler, acc[1], multiplier, acc[3]);
+  LoadBroadcastInt32(assembler, multiplier, temp, HashCodeMultiplierPower(4u));
+  AccumulateHashCode(assembler, acc[0], multiplier, acc[1]);
+  LoadBroadcastInt32(assembler, multiplier, temp, HashCodeMultiplierPower(2u));
+  __ pshufd(values, acc[0], Immediate(0x0e));  // Lanes 2 and 3 to lanes 0 and 1.
+  AccumulateHashCode(assembler, acc[0], multiplier, values);
+  LoadBroadcastInt32(assembler, multiplier, temp, HashCodeMultiplierPower(1u));
+  __ pshufd(values, acc[0], Immediate(0x01));  // Lane 1 to lane 0.
+  AccumulateHashCode(assembler, acc[0], multiplier, values);
+  __ movd(hash, acc[0], /*is64bit=*/ false);
+
+  __ Bind(&scalar_loop);
+  __ testl(length, length);
+  __ j(kEqual, &done);
+  __ imull(hash, hash, Immediate(kHashCodeMultiplier));
+  switch (type) {
+    case DataType::Type::kUint8:
+      __ movzxb(temp, Address(data, 0));
+      break;
+    case DataType::Type::kInt8:
+      __ movsxb(temp, Address(data, 0));
+      break;
+    default:
+      __ movzxw(temp, Address(data, 0));
+      break;
+  }
+  __ addl(hash, temp);
+  __ addq(data, Immediate(element_size));
+  __ subl(length, Immediate(1));
+  __ jmp(&scalar_loop);
+
+  __ Bind(&done);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitStringHashCode(HInvoke* invoke) {
+  // PMULLD is an SSE4.1 instruction.
+  if (!codegen_->GetInstructionSetFeatures().HasSSE4_1()) {
+    return;
+  }
+  CreateHashCodeLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitStringHashCode(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister str = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister data = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister length = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+
+  const uint32_t count_offset = mirror::String::CountOffset().Uint32Value();
+  const uint32_t hash_code_offset = mirror::String::HashCodeOffset().Uint32Value();
+  const uint32_t value_offset = mirror::String::ValueOffset().Uint32Value();
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  Label store, done;
+  // Return the cached hash code if it has been computed already.
+  __ movl(out, Address(str, hash_code_offset));
+  __ testl(out, out);
+  __ j(kNotEqual, &done);
+
+  __ movl(length, Address(str, count_offset));
+  __ leaq(data, Address(str, value_offset));
+  if (mirror::kUseStringCompression) {
+    Label uncompressed;
+    static_assert(static_cast<uint32_t>(mirror::StringCompressionFlag::kCompressed) == 0u,
+                  "Expecting 0=compressed, 1=uncompressed");
+    __ shrl(length, Immediate(1));
+    // The hash code of the empty string is 0, no need to store it.
+    __ j(kEqual, &done);
+    __ j(kCarrySet, &uncompressed);
+    GenerateHashCode(assembler, locations, DataType::Type::kUint8, data, length, out);
+    __ jmp(&store);
+    __ Bind(&uncompressed);
+  } else {
+    __ testl(length, length);
+    __ j(kEqual, &done);
+  }
+  GenerateHashCode(assembler, locations, DataType::Type::kUint16, data, length, out);
+
+  __ Bind(&store);
+  // Another thread may compute and store the same value concurrently, which is benign.
+  __ movl(Address(str, hash_code_offset), out);
+  __ Bind(&done);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysHashCodeByte(HInvoke* invoke) {
+  // PMULLD is an SSE4.1 instruction.
+  if (!codegen_->GetInstructionSetFeatures().HasSSE4_1()) {
+    return;
+  }
+  CreateHashCodeLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysHashCodeByte(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister array = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister data = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister length = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+
+  const uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const uint32_t data_offset = mirror::Array::DataOffset(sizeof(int8_t)).Uint32Value();
+
+  Label done;
+  // The hash code of a null array is 0.
+  __ xorl(out, out);
+  __ testl(array, array);
+  __ j(kEqual, &done);
+
+  __ movl(length, Address(array, length_offset));
+  __ leaq(data, Address(array, data_offset));
+  __ movl(out, Immediate(1));
+  GenerateHashCode(assembler, locations, DataType::Type::kInt8, data, length, out);
+  __ Bind(&done);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysEqualsByte(HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysEqualsByte(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister lhs = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister rhs = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister length = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister index = locations->GetTemp(1).AsRegister<CpuRegister>();
+  XmmRegister lhs_block = locations->GetTemp(2).AsFpuRegister<XmmRegister>();
+  XmmRegister rhs_block = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+
+  const uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const int32_t data_offset = mirror::Array::DataOffset(sizeof(int8_t)).Int32Value();
+
+  Label loop, last_block, below_16, below_8, byte_loop, return_true, return_false, end;
+
+  // Reference equality check, return true if same reference (including both null).
+  __ cmpl(lhs, rhs);
+  __ j(kEqual, &return_true);
+  __ testl(lhs, lhs);
+  __ j(kEqual, &return_false);
+  __ testl(rhs, rhs);
+  __ j(kEqual, &return_false);
+
+  __ movl(length, Address(lhs, length_offset));
+  __ cmpl(length, Address(rhs, length_offset));
+  __ j(kNotEqual, &return_false);
+
+  // Compare 16 bytes at a time with SIMD. The last, possibly partial, block is compared
+  // as a full block ending at the end of the data, overlapping the previous one.
+  __ cmpl(length, Immediate(16));
+  __ j(kLess, &below_16);
+  __ xorl(index, index);
+  __ subl(length, Immediate(16));
+  __ jmp(&last_block);
+  __ Bind(&loop);
+  __ movdqu(lhs_block, Address(lhs, index, TIMES_1, data_offset));
+  __ movdqu(rhs_block, Address(rhs, index, TIMES_1, data_offset));
+  __ pcmpeqb(lhs_block, rhs_block);
+  __ pmovmskb(out, lhs_block);
+  __ cmpl(out, Immediate(0xffff));
+  __ j(kNotEqual, &return_false);
+  __ addl(index, Immediate(16));
+  __ Bind(&last_block);
+  __ cmpl(index, length);
+  __ j(kLess, &loop);
+  __ movdqu(lhs_block, Address(lhs, length, TIMES_1, data_offset));
+  __ movdqu(rhs_block, Address(rhs, length, TIMES_1, data_offset));
+  __ pcmpeqb(lhs_block, rhs_block);
+  __ pmovmskb(out, lhs_block);
+  __ cmpl(out, Immediate(0xffff));
+  __ j(kNotEqual, &return_false);
+  __ jmp(&return_true);
+
+  // For 4 to 15 bytes, compare the first and the last 8 or 4 bytes, which may overlap.
+  __ Bind(&below_16);
+  __ cmpl(length, Immediate(8));
+  __ j(kLess, &below_8);
+  __ movq(out, Address(lhs, data_offset));
+  __ cmpq(out, Address(rhs, data_offset));
+  __ j(kNotEqual, &return_false);
+  __ movq(out, Address(lhs, length, TIMES_1, data_offset - 8));
+  __ cmpq(out, Address(rhs, length, TIMES_1, data_offset - 8));
+  __ j(kNotEqual, &return_false);
+  __ jmp(&return_true);
+  __ Bind(&below_8);
+  __ cmpl(length, Immediate(4));
+  __ j(kLess, &byte_loop);
+  __ movl(out, Address(lhs, data_offset));
+  __ cmpl(out, Address(rhs, data_offset));
+  __ j(kNotEqual, &return_false);
+  __ movl(out, Address(lhs, length, TIMES_1, data_offset - 4));
+  __ cmpl(out, Address(rhs, length, TIMES_1, data_offset - 4));
+  __ j(kNotEqual, &return_false);
+  __ jmp(&return_true);
+
+  // Compare up to 3 bytes one at a time, from the end.
+  __ Bind(&byte_loop);
+  __ testl(length, length);
+  __ j(kEqual, &return_true);
+  __ movzxb(out, Address(lhs, length, TIMES_1, data_offset - 1));
+  __ movzxb(index, Address(rhs, length, TIMES_1, data_offset - 1));
+  __ cmpl(out, index);
+  __ j(kNotEqual, &return_false);
+  __ subl(length, Immediate(1));
+  __ jmp(&byte_loop);
+
+  __ Bind(&return_true);
+  __ movl(out, Immediate(1));
+  __ jmp(&end);
+  __ Bind(&return_false);
+  __ xorl(out, out);
+  __ Bind(&end);
+}
+
 static void GenPeek(LocationSummary* locations, DataType::Type size, X86_64Assembler* assembler) {
   CpuRegister address = locations->InAt(0).AsRegister<CpuRegister>();
   CpuRegister out = locations->Out().AsRegister<CpuRegister>();  // == address, here for clarity.
@@ -3422,6 +3795,574 @@ void IntrinsicLocationsBuilderX86_64::VisitReachabilityFence(HInvoke* invoke) {
 
 void IntrinsicCodeGeneratorX86_64::VisitReachabilityFence([[maybe_unused]] HInvoke* invoke) {}
 
+// Constants for the CRC32 computation with carry-less multiplication, see Intel's
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+// All of them are bit-reflected, as the CRC32 of java.util.zip.
+// x^(4*128+32) mod P and x^(4*128-32) mod P, for folding 64 bytes at a time.
+static constexpr uint64_t kCRC32FoldBy4Low = UINT64_C(0x154442bd4);
+static constexpr uint64_t kCRC32FoldBy4High = UINT64_C(0x1c6e41596);
+// x^(128+32) mod P and x^(128-32) mod P, for folding 16 bytes at a time.
+static constexpr uint64_t kCRC32FoldBy1Low = UINT64_C(0x1751997d0);
+static constexpr uint64_t kCRC32FoldBy1High = UINT64_C(0xccaa009e);
+// x^64 mod P, for folding 64 bits to 32 bits.
+static constexpr uint64_t kCRC32Fold64 = UINT64_C(0x163cd6124);
+// The polynomial P and floor(x^64 / P), for the Barrett reduction.
+static constexpr uint64_t kCRC32Polynomial = UINT64_C(0x1db710641);
+static constexpr uint64_t kCRC32BarrettMu = UINT64_C(0x1f7011641);
+
+// Loads a 128-bit constant with the given 64-bit halves to `dst`.
+static void LoadCRC32Constant(X86_64Assembler* assembler,
+                              XmmRegister dst,
+                              XmmRegister temp,
+                              CpuRegister temp_reg,
+                              uint64_t low,
+                              uint64_t high) {
+  __ movq(temp_reg, Immediate(static_cast<int64_t>(low)));
+  __ movd(dst, temp_reg, /*is64bit=*/ true);
+  if (high != 0u) {
+    __ movq(temp_reg, Immediate(static_cast<int64_t>(high)));
+    __ movd(temp, temp_reg, /*is64bit=*/ true);
+    __ punpcklqdq(dst, temp);
+  }
+}
+
+// Loads the constants of `GenerateCRC32BarrettReduction()`.
+static void LoadCRC32BarrettConstants(X86_64Assembler* assembler,
+                                      XmmRegister constants,
+                                      XmmRegister mask,
+                                      CpuRegister temp_reg) {
+  LoadCRC32Constant(assembler, constants, mask, temp_reg, kCRC32Polynomial, kCRC32BarrettMu);
+  // Low 32 bits set, the movl clears the upper half of the register.
+  __ movl(temp_reg, Immediate(-1));
+  __ movd(mask, temp_reg, /*is64bit=*/ true);
+}
+
+// Reduces the polynomial in the low 64 bits of `value` modulo P and puts the 32-bit
+// result to `out`. Clobbers `value` and `temp`.
+static void GenerateCRC32BarrettReduction(X86_64Assembler* assembler,
+                                          CpuRegister out,
+                                          XmmRegister value,
+                                          XmmRegister temp,
+                                          XmmRegister constants,
+                                          XmmRegister mask) {
+  __ movdqa(temp, value);
+  __ pand(value, mask);
+  __ pclmulqdq(value, constants, Immediate(0x10));  // Multiply by mu.
+  __ pand(value, mask);
+  __ pclmulqdq(value, constants, Immediate(0x00));  // Multiply by P.
+  __ pxor(value, temp);
+  // The result is in bits 32-63.
+  __ psrldq(value, Immediate(4));
+  __ movd(out, value, /*is64bit=*/ false);
+}
+
+// Updates the non-inverted CRC32 value in `crc` with the byte in the low bits of `value`.
+// Clobbers `value` and the XMM registers except `constants` and `mask`.
+static void GenerateCRC32UpdateByte(X86_64Assembler* assembler,
+                                    CpuRegister crc,
+                                    CpuRegister value,
+                                    XmmRegister xmm_value,
+                                    XmmRegister xmm_temp,
+                                    XmmRegister constants,
+                                    XmmRegister mask) {
+  //   crc = (crc >> 8) ^ reduce(((crc ^ value) & 0xff) << 24)
+  __ xorl(value, crc);
+  __ shll(value, Immediate(24));
+  __ movd(xmm_value, value, /*is64bit=*/ false);
+  GenerateCRC32BarrettReduction(assembler, value, xmm_value, xmm_temp, constants, mask);
+  __ shrl(crc, Immediate(8));
+  __ xorl(crc, value);
+}
+
+// Multiplies the two halves of `acc` by the two halves of `constants`, moving the
+// 128 bits in `acc` forward in the message by the distance the constants are computed
+// for. The next data of the message is then added to `acc` by the caller.
+static void GenerateCRC32Fold(X86_64Assembler* assembler,
+                              XmmRegister acc,
+                              XmmRegister temp,
+                              XmmRegister constants) {
+  __ movdqa(temp, acc);
+  __ pclmulqdq(acc, constants, Immediate(0x00));
+  __ pclmulqdq(temp, constants, Immediate(0x11));
+  __ pxor(acc, temp);
+}
+
+// Number of XMM temporaries used by `GenerateCRC32OfBytes()`.
+static constexpr size_t kCRC32XmmTemps = 9u;
+
+static void CreateCRC32OfBytesLocations(ArenaAllocator* allocator,
+                                        HInvoke* invoke,
+                                        LocationSummary::CallKind call_kind) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, call_kind, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RegisterOrConstant(invoke->InputAt(2)));
+  locations->SetInAt(3, Location::RequiresRegister());
+  // Data pointer, remaining length and a temporary.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  for (size_t i = 0; i != kCRC32XmmTemps; ++i) {
+    locations->AddTemp(Location::RequiresFpuRegister());
+  }
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Computes the CRC32 of `length` bytes at `ptr`, starting from `crc`, and puts it
+// to `out`. Clobbers `ptr` and all the temporaries.
+//
+// Blocks of 16 bytes are folded with carry-less multiplications into a 128-bit
+// value, using four independent accumulators while at least 64 bytes are left. The
+// 128-bit value is then reduced to the 32-bit CRC with a Barrett reduction, and the
+// last bytes, which do not fill a block, are processed 4 bytes and then 1 byte at a
+// time, with a Barrett reduction each.
+static void GenerateCRC32OfBytes(X86_64Assembler* assembler,
+                                 LocationSummary* locations,
+                                 CpuRegister crc,
+                                 CpuRegister ptr,
+                                 CpuRegister length,
+                                 CpuRegister out) {
+  CpuRegister len = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(2).AsRegister<CpuRegister>();
+  XmmRegister acc[] = {
+      locations->GetTemp(3).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(4).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(5).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(6).AsFpuRegister<XmmRegister>(),
+  };
+  XmmRegister tmp[] = {
+      locations->GetTemp(7).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(8).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(9).AsFpuRegister<XmmRegister>(),
+      locations->GetTemp(10).AsFpuRegister<XmmRegister>(),
+  };
+  XmmRegister constants = locations->GetTemp(11).AsFpuRegister<XmmRegister>();
+  // The mask for the Barrett reduction is only needed once the accumulators are folded.
+  XmmRegister mask = tmp[3];
+
+  Label fold_by_1, fold_by_1_loop, fold_by_1_check, fold_by_4_loop, fold_4_to_1, reduce;
+  Label short_data, tail_4_bytes, tail_1_byte, done;
+
+  __ movl(out, crc);
+  __ notl(out);
+  __ movl(len, length);
+  __ cmpl(len, Immediate(16));
+  __ j(kLess, &short_data);
+
+  // Add the initial CRC to the first block.
+  __ movdqu(acc[0], Address(ptr, 0));
+  __ movd(tmp[0], out, /*is64bit=*/ false);
+  __ pxor(acc[0], tmp[0]);
+  __ addq(ptr, Immediate(16));
+  __ subl(len, Immediate(16));
+  __ cmpl(len, Immediate(48));
+  __ j(kLess, &fold_by_1);
+
+  for (size_t i = 1; i != 4u; ++i) {
+    __ movdqu(acc[i], Address(ptr, dchecked_integral_cast<int32_t>((i - 1u) * 16u)));
+  }
+  __ addq(ptr, Immediate(48));
+  __ subl(len, Immediate(48));
+  LoadCRC32Constant(assembler, constants, tmp[0], temp, kCRC32FoldBy4Low, kCRC32FoldBy4High);
+  __ cmpl(len, Immediate(64));
+  __ j(kLess, &fold_4_to_1);
+
+  __ Bind(&fold_by_4_loop);
+  for (size_t i = 0; i != 4u; ++i) {
+    GenerateCRC32Fold(assembler, acc[i], tmp[i], constants);
+    __ movdqu(tmp[i], Address(ptr, dchecked_integral_cast<int32_t>(i * 16u)));
+    __ pxor(acc[i], tmp[i]);
+  }
+  __ addq(ptr, Immediate(64));
+  __ subl(len, Immediate(64));
+  __ cmpl(len, Immediate(64));
+  __ j(kGreaterEqual, &fold_by_4_loop);
+
+  __ Bind(&fold_4_to_1);
+  LoadCRC32Constant(assembler, constants, tmp[0], temp, kCRC32FoldBy1Low, kCRC32FoldBy1High);
+  for (size_t i = 1; i != 4u; ++i) {
+    GenerateCRC32Fold(assembler, acc[0], tmp[0], constants);
+    __ pxor(acc[0], acc[i]);
+  }
+  __ jmp(&fold_by_1_check);
+
+  __ Bind(&fold_by_1);
+  LoadCRC32Constant(assembler, constants, tmp[0], temp, kCRC32FoldBy1Low, kCRC32FoldBy1High);
+  __ Bind(&fold_by_1_check);
+  __ cmpl(len, Immediate(16));
+  __ j(kLess, &reduce);
+  __ Bind(&fold_by_1_loop);
+  GenerateCRC32Fold(assembler, acc[0], tmp[0], constants);
+  __ movdqu(tmp[0], Address(ptr, 0));
+  __ pxor(acc[0], tmp[0]);
+  __ addq(ptr, Immediate(16));
+  __ subl(len, Immediate(16));
+  __ cmpl(len, Immediate(16));
+  __ j(kGreaterEqual, &fold_by_1_loop);
+
+  __ Bind(&reduce);
+  // Fold 128 bits to 64 bits, appending 32 zero bits: multiply the low half by
+  // x^(128-32) mod P, in the high half of the constants, and add the high half.
+  __ movdqa(tmp[0], constants);
+  __ pclmulqdq(tmp[0], acc[0], Immediate(0x01));
+  __ psrldq(acc[0], Immediate(8));
+  __ pxor(acc[0], tmp[0]);
+  // Fold the low 32 bits into the rest.
+  LoadCRC32BarrettConstants(assembler, constants, mask, temp);
+  __ movdqa(tmp[1], acc[0]);
+  __ psrldq(tmp[1], Immediate(4));
+  __ pand(acc[0], mask);
+  LoadCRC32Constant(assembler, tmp[2], tmp[2], temp, kCRC32Fold64, /*high=*/ 0u);
+  __ pclmulqdq(acc[0], tmp[2], Immediate(0x00));
+  __ pxor(acc[0], tmp[1]);
+  GenerateCRC32BarrettReduction(assembler, out, acc[0], tmp[0], constants, mask);
+  __ jmp(&tail_4_bytes);
+
+  __ Bind(&short_data);
+  LoadCRC32BarrettConstants(assembler, constants, mask, temp);
+
+  __ Bind(&tail_4_bytes);
+  __ cmpl(len, Immediate(4));
+  __ j(kLess, &tail_1_byte);
+  //   crc = reduce(crc ^ value)
+  __ movl(temp, Address(ptr, 0));
+  __ xorl(temp, out);
+  __ movd(acc[0], temp, /*is64bit=*/ false);
+  GenerateCRC32BarrettReduction(assembler, out, acc[0], tmp[0], constants, mask);
+  __ addq(ptr, Immediate(4));
+  __ subl(len, Immediate(4));
+  __ jmp(&tail_4_bytes);
+
+  __ Bind(&tail_1_byte);
+  __ testl(len, len);
+  __ j(kEqual, &done);
+  __ movzxb(temp, Address(ptr, 0));
+  GenerateCRC32UpdateByte(assembler, out, temp, acc[0], tmp[0], constants, mask);
+  __ addq(ptr, Immediate(1));
+  __ subl(len, Immediate(1));
+  __ jmp(&tail_1_byte);
+
+  __ Bind(&done);
+  __ notl(out);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitCRC32Update(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasPCLMULQDQ()) {
+    return;
+  }
+
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Lower the invoke of CRC32.update(int crc, int b).
+void IntrinsicCodeGeneratorX86_64::VisitCRC32Update(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasPCLMULQDQ());
+
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister crc = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister val = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(0).AsRegister<CpuRegister>();
+  XmmRegister xmm_value = locations->GetTemp(1).AsFpuRegister<XmmRegister>();
+  XmmRegister xmm_temp = locations->GetTemp(2).AsFpuRegister<XmmRegister>();
+  XmmRegister constants = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
+  XmmRegister mask = locations->GetTemp(4).AsFpuRegister<XmmRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+
+  // Only the low eight bits of `val` are used, the shift in `GenerateCRC32UpdateByte()`
+  // discards the others.
+  LoadCRC32BarrettConstants(assembler, constants, mask, temp);
+  __ movl(out, crc);
+  __ notl(out);
+  __ movl(temp, val);
+  GenerateCRC32UpdateByte(assembler, out, temp, xmm_value, xmm_temp, constants, mask);
+  __ notl(out);
+}
+
+// The threshold for sizes of arrays to use the library provided implementation
+// of CRC32.updateBytes instead of the intrinsic.
+static constexpr int32_t kCRC32UpdateBytesThreshold = 64 * 1024;
+
+void IntrinsicLocationsBuilderX86_64::VisitCRC32UpdateBytes(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasPCLMULQDQ()) {
+    return;
+  }
+  CreateCRC32OfBytesLocations(allocator_, invoke, LocationSummary::kCallOnSlowPath);
+}
+
+// Lower the invoke of CRC32.updateBytes(int crc, byte[] b, int off, int len)
+//
+// Note: The intrinsic is not used if len exceeds a threshold.
+void IntrinsicCodeGeneratorX86_64::VisitCRC32UpdateBytes(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasPCLMULQDQ());
+
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  SlowPathCode* slow_path = new (codegen_->GetScopedAllocator()) IntrinsicSlowPathX86_64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  CpuRegister length = locations->InAt(3).AsRegister<CpuRegister>();
+  __ cmpl(length, Immediate(kCRC32UpdateBytesThreshold));
+  __ j(kAbove, slow_path->GetEntryLabel());
+
+  const int32_t array_data_offset = mirror::Array::DataOffset(sizeof(int8_t)).Int32Value();
+  CpuRegister ptr = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister array = locations->InAt(1).AsRegister<CpuRegister>();
+  Location offset = locations->InAt(2);
+  if (offset.IsConstant()) {
+    int32_t offset_value = offset.GetConstant()->AsIntConstant()->GetValue();
+    __ leaq(ptr, Address(array, array_data_offset + offset_value));
+  } else {
+    __ movsxd(ptr, offset.AsRegister<CpuRegister>());
+    __ leaq(ptr, Address(array, ptr, TIMES_1, array_data_offset));
+  }
+
+  CpuRegister crc = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  GenerateCRC32OfBytes(assembler, locations, crc, ptr, length, out);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasPCLMULQDQ()) {
+    return;
+  }
+  CreateCRC32OfBytesLocations(allocator_, invoke, LocationSummary::kNoCall);
+}
+
+// Lower the invoke of CRC32.updateByteBuffer(int crc, long addr, int off, int len)
+//
+// There is no need to generate code checking if addr is 0, see the comment
+// in the ARM64 implementation.
+void IntrinsicCodeGeneratorX86_64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasPCLMULQDQ());
+
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister addr = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister ptr = locations->GetTemp(0).AsRegister<CpuRegister>();
+  Location offset = locations->InAt(2);
+  if (offset.IsConstant()) {
+    int32_t offset_value = offset.GetConstant()->AsIntConstant()->GetValue();
+    __ leaq(ptr, Address(addr, offset_value));
+  } else {
+    __ movsxd(ptr, offset.AsRegister<CpuRegister>());
+    __ addq(ptr, addr);
+  }
+
+  CpuRegister crc = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister length = locations->InAt(3).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  GenerateCRC32OfBytes(assembler, locations, crc, ptr, length, out);
+}
+
+// Reduces `value` modulo `kAdler32Base`, using 65536 % kAdler32Base == 15
+// to avoid a division.
+static void GenerateAdler32Modulo(X86_64Assembler* assembler,
+                                  CpuRegister value,
+                                  CpuRegister temp) {
+  static_assert((1u << 16) % kAdler32Base == 15u);
+  // Two steps of `value = (value & 0xffff) + 15 * (value >> 16)` bring any 32-bit
+  // value below 2 * kAdler32Base.
+  for (size_t i = 0; i != 2u; ++i) {
+    __ movl(temp, value);
+    __ shrl(temp, Immediate(16));
+    __ movzxw(value, value);
+    __ subl(value, temp);
+    __ shll(temp, Immediate(4));
+    __ addl(value, temp);
+  }
+  __ leal(temp, Address(value, -static_cast<int32_t>(kAdler32Base)));
+  __ cmpl(value, Immediate(kAdler32Base));
+  __ cmov(kAboveEqual, value, temp, /*is64bit=*/ false);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitAdler32Update(HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Lower the invoke of Adler32.update(int adler, int b).
+void IntrinsicCodeGeneratorX86_64::VisitAdler32Update(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister adler = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister val = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister sum1 = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+
+  // The general algorithm of the Adler-32 calculation of a byte is:
+  //   sum1 = ((adler & 0xffff) + (b & 0xff)) % base
+  //   sum2 = ((adler >> 16) + sum1) % base
+  //   adler = (sum2 << 16) | sum1
+  // As both sums are below 2 * base before the modulo, a conditional subtraction
+  // is enough.
+  __ movzxb(temp, val);
+  __ movzxw(sum1, adler);
+  __ addl(sum1, temp);
+  __ leal(temp, Address(sum1, -static_cast<int32_t>(kAdler32Base)));
+  __ cmpl(sum1, Immediate(kAdler32Base));
+  __ cmov(kAboveEqual, sum1, temp, /*is64bit=*/ false);
+  __ movl(out, adler);
+  __ shrl(out, Immediate(16));
+  __ addl(out, sum1);
+  __ leal(temp, Address(out, -static_cast<int32_t>(kAdler32Base)));
+  __ cmpl(out, Immediate(kAdler32Base));
+  __ cmov(kAboveEqual, out, temp, /*is64bit=*/ false);
+  __ shll(out, Immediate(16));
+  __ orl(out, sum1);
+}
+
+static void CreateAdler32OfBytesLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RegisterOrConstant(invoke->InputAt(2)));
+  locations->SetInAt(3, Location::RequiresRegister());
+  // Data pointer, remaining length, the first sum and a temporary.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Computes the Adler-32 checksum of `length` bytes at `ptr`, starting from `adler`,
+// and puts it to `out`. Clobbers `ptr` and all the temporaries.
+//
+// The intrinsic is used only for lengths that cannot overflow the sums, so they are
+// reduced modulo `kAdler32Base` only once, at the end.
+static void GenerateAdler32OfBytes(X86_64Assembler* assembler,
+                                   LocationSummary* locations,
+                                   CpuRegister adler,
+                                   CpuRegister ptr,
+                                   CpuRegister length,
+                                   CpuRegister out) {
+  CpuRegister len = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister sum1 = locations->GetTemp(2).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(3).AsRegister<CpuRegister>();
+  // The second sum is accumulated in `out`.
+  CpuRegister sum2 = out;
+
+  NearLabel loop, done;
+  __ movzxw(sum1, adler);
+  __ movl(sum2, adler);
+  __ shrl(sum2, Immediate(16));
+  __ movl(len, length);
+  __ testl(len, len);
+  __ j(kEqual, &done);
+
+  __ Bind(&loop);
+  __ movzxb(temp, Address(ptr, 0));
+  __ addl(sum1, temp);
+  __ addl(sum2, sum1);
+  __ addq(ptr, Immediate(1));
+  __ subl(len, Immediate(1));
+  __ j(kNotEqual, &loop);
+
+  GenerateAdler32Modulo(assembler, sum1, temp);
+  GenerateAdler32Modulo(assembler, sum2, temp);
+
+  __ Bind(&done);
+  __ shll(sum2, Immediate(16));
+  __ orl(sum2, sum1);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitAdler32UpdateBytes(HInvoke* invoke) {
+  CreateAdler32OfBytesLocations(allocator_, invoke);
+}
+
+// Lower the invoke of Adler32.updateBytes(int adler, byte[] b, int off, int len)
+//
+// Note: The intrinsic is not used if len exceeds a threshold.
+void IntrinsicCodeGeneratorX86_64::VisitAdler32UpdateBytes(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  SlowPathCode* slow_path = new (codegen_->GetScopedAllocator()) IntrinsicSlowPathX86_64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  CpuRegister length = locations->InAt(3).AsRegister<CpuRegister>();
+  __ cmpl(length, Immediate(kAdler32UpdateBytesThreshold));
+  __ j(kAbove, slow_path->GetEntryLabel());
+
+  const int32_t array_data_offset = mirror::Array::DataOffset(sizeof(int8_t)).Int32Value();
+  CpuRegister ptr = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister array = locations->InAt(1).AsRegister<CpuRegister>();
+  Location offset = locations->InAt(2);
+  if (offset.IsConstant()) {
+    int32_t offset_value = offset.GetConstant()->AsIntConstant()->GetValue();
+    __ leaq(ptr, Address(array, array_data_offset + offset_value));
+  } else {
+    __ movsxd(ptr, offset.AsRegister<CpuRegister>());
+    __ leaq(ptr, Address(array, ptr, TIMES_1, array_data_offset));
+  }
+
+  CpuRegister adler = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  GenerateAdler32OfBytes(assembler, locations, adler, ptr, length, out);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitAdler32UpdateByteBuffer(HInvoke* invoke) {
+  CreateAdler32OfBytesLocations(allocator_, invoke);
+}
+
+// Lower the invoke of Adler32.updateByteBuffer(int adler, long addr, int off, int len)
+//
+// Note: The intrinsic is not used if len exceeds a threshold.
+void IntrinsicCodeGeneratorX86_64::VisitAdler32UpdateByteBuffer(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  SlowPathCode* slow_path = new (codegen_->GetScopedAllocator()) IntrinsicSlowPathX86_64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  CpuRegister length = locations->InAt(3).AsRegister<CpuRegister>();
+  __ cmpl(length, Immediate(kAdler32UpdateBytesThreshold));
+  __ j(kAbove, slow_path->GetEntryLabel());
+
+  CpuRegister addr = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister ptr = locations->GetTemp(0).AsRegister<CpuRegister>();
+  Location offset = locations->InAt(2);
+  if (offset.IsConstant()) {
+    int32_t offset_value = offset.GetConstant()->AsIntConstant()->GetValue();
+    __ leaq(ptr, Address(addr, offset_value));
+  } else {
+    __ movsxd(ptr, offset.AsRegister<CpuRegister>());
+    __ addq(ptr, addr);
+  }
+
+  CpuRegister adler = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  GenerateAdler32OfBytes(assembler, locations, adler, ptr, length, out);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
 static void CreateDivideUnsignedLocations(HInvoke* invoke, ArenaAllocator* allocator) {
   LocationSummary* locations =
       new (allocator) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
@@ -16,10 +16,21 @@
 
 #include "licm.h"
 
+#include "art_field-inl.h"
+#include "art_method-inl.h"
+#include "base/scoped_arena_allocator.h"
+#include "class_linker.h"
+#include "dex/dex_instruction_utils.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change-inl.h"
 #include "side_effects_analysis.h"
 
 namespace art HIDDEN {
 
+// Limits for the analysis of the methods called in a loop.
+static constexpr size_t kMaximumCalleeDepth = 3;
+static constexpr size_t kMaximumCalleeCodeUnits = 1000;
+
 static bool IsPhiOf(HInstruction* instruction, HBasicBlock* block) {
   return instruction->IsPhi() && instruction->GetBlock() == block;
 }
@@ -78,10 +89,207 @@ static void UpdateLoopPhisIn(HEnvironment* environment, HLoopInformation* info)
   }
 }
 
+/**
+ * Returns whether `method`, or a method it calls, may write `field`, or synchronize
+ * with another thread and make a write of that thread visible. Anything the bytecode
+ * does not tell is assumed to write: native methods, calls whose target is not known
+ * statically, class initializers that may run, and methods past the analysis limits.
+ */
+static bool MethodMayWriteField(ArtMethod* method,
+                                ArtField* field,
+                                size_t depth,
+                                /*inout*/ size_t* code_units_budget)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (depth > kMaximumCalleeDepth ||
+      method->IsNative() ||
+      method->IsSynchronized() ||
+      method->IsProxyMethod() ||
+      method->IsStringConstructor() ||
+      !method->GetDeclaringClass()->IsInitialized()) {
+    return true;
+  }
+  CodeItemInstructionAccessor accessor = method->DexInstructions();
+  if (!accessor.HasCodeItem() || accessor.InsnsSizeInCodeUnits() > *code_units_budget) {
+    return true;
+  }
+  *code_units_budget -= accessor.InsnsSizeInCodeUnits();
+
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  for (const DexInstructionPcPair& inst : accessor) {
+    Instruction::Code opcode = inst->Opcode();
+    if (IsInstructionIGetOrIPut(opcode) || IsInstructionSGetOrSPut(opcode)) {
+      bool is_static = IsInstructionSGetOrSPut(opcode);
+      uint32_t field_idx = is_static ? inst->VRegB_21c() : inst->VRegC_22c();
+      ArtField* accessed = class_linker->LookupResolvedField(field_idx, method, is_static);
+      if (accessed == nullptr ||
+          accessed->IsVolatile() ||
+          (is_static && !accessed->GetDeclaringClass()->IsInitialized()) ||
+          (accessed == field && (IsInstructionIPut(opcode) || IsInstructionSPut(opcode)))) {
+        return true;
+      }
+      continue;
+    }
+    switch (opcode) {
+      case Instruction::INVOKE_STATIC:
+      case Instruction::INVOKE_STATIC_RANGE:
+      case Instruction::INVOKE_DIRECT:
+      case Instruction::INVOKE_DIRECT_RANGE:
+      case Instruction::INVOKE_VIRTUAL:
+      case Instruction::INVOKE_VIRTUAL_RANGE: {
+        uint32_t method_idx =
+            IsInvokeInstructionRange(opcode) ? inst->VRegB_3rc() : inst->VRegB_35c();
+        ArtMethod* callee = class_linker->LookupResolvedMethod(
+            method_idx, method->GetDexCache(), method->GetClassLoader());
+        if (callee == nullptr) {
+          return true;
+        }
+        bool is_virtual =
+            (opcode == Instruction::INVOKE_VIRTUAL || opcode == Instruction::INVOKE_VIRTUAL_RANGE);
+        if (is_virtual &&
+            !callee->IsFinal() &&
+            !callee->IsPrivate() &&
+            !callee->GetDeclaringClass()->IsFinal()) {
+          // The target depends on the receiver.
+          return true;
+        }
+        if (MethodMayWriteField(callee, field, depth + 1u, code_units_budget)) {
+          return true;
+        }
+        break;
+      }
+      case Instruction::NEW_INSTANCE: {
+        ObjPtr<mirror::Class> klass =
+            class_linker->LookupResolvedType(dex::TypeIndex(inst->VRegB_21c()), method);
+        if (klass == nullptr || !klass->IsInitialized()) {
+          return true;
+        }
+        break;
+      }
+      default:
+        if (IsInstructionInvoke(opcode) ||
+            opcode == Instruction::MONITOR_ENTER ||
+            opcode == Instruction::MONITOR_EXIT) {
+          return true;
+        }
+        break;
+    }
+  }
+  return false;
+}
+
+bool LICM::InvokeMayWriteField(HInvoke* invoke,
+                               ArtField* field,
+                               /*inout*/ ScopedArenaVector<HInvoke*>* cha_invokes) {
+  Runtime* runtime = Runtime::Current();
+  // AOT code cannot rely on which classes are initialized at compile time.
+  if (runtime->IsAotCompiler() ||
+      invoke->IsIntrinsic() ||
+      invoke->GetResolvedMethod() == nullptr) {
+    return true;
+  }
+  ScopedObjectAccess soa(Thread::Current());
+  ArtMethod* resolved_method = invoke->GetResolvedMethod();
+  ArtMethod* target = nullptr;
+  bool needs_cha_guard = false;
+  if (invoke->IsInvokeStaticOrDirect()) {
+    if (invoke->AsInvokeStaticOrDirect()->IsStringInit()) {
+      return true;
+    }
+    target = resolved_method;
+  } else if (invoke->IsInvokeVirtual() || invoke->IsInvokeInterface()) {
+    if (resolved_method->IsFinal() || resolved_method->GetDeclaringClass()->IsFinal()) {
+      target = resolved_method;
+    } else if (resolved_method->HasSingleImplementation() &&
+               !runtime->IsZygote() &&
+               !graph_->IsCompilingOsr()) {
+      // Like CHA-based inlining, assume the target stays the only implementation,
+      // and deoptimize before the call if a class overriding it gets loaded.
+      // OSR compilations cannot deoptimize, and the zygote compiles with offline
+      // information.
+      target = resolved_method->GetSingleImplementation(
+          InstructionSetPointerSize(graph_->GetInstructionSet()));
+      if (target == nullptr ||
+          target->IsProxyMethod() ||
+          !target->GetDeclaringClass()->IsResolved()) {
+        return true;
+      }
+      needs_cha_guard = true;
+    }
+  }
+  size_t code_units_budget = kMaximumCalleeCodeUnits;
+  if (target == nullptr || MethodMayWriteField(target, field, 0u, &code_units_budget)) {
+    return true;
+  }
+  if (needs_cha_guard) {
+    cha_invokes->push_back(invoke);
+  }
+  return false;
+}
+
+bool LICM::CanHoistFieldGetAcrossWrites(HInstruction* instruction,
+                                        HLoopInformation* loop_info,
+                                        /*inout*/ ScopedArenaVector<HInvoke*>* cha_invokes) {
+  DCHECK(instruction->IsInstanceFieldGet() || instruction->IsStaticFieldGet());
+  ArtField* field = instruction->GetFieldInfo().GetField();
+  if (field == nullptr) {
+    return false;
+  }
+  SideEffects effects = instruction->GetSideEffects();
+  for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
+    for (HInstructionIterator inst_it(it_loop.Current()->GetInstructions());
+         !inst_it.Done();
+         inst_it.Advance()) {
+      HInstruction* other = inst_it.Current();
+      if (!effects.MayDependOn(other->GetSideEffects()) || other->IsDeoptimize()) {
+        // A deoptimization resumes in the interpreter, which loads the field again.
+        continue;
+      }
+      if (other->IsInstanceFieldSet() || other->IsStaticFieldSet()) {
+        // Different fields never alias.
+        const FieldInfo& other_info = other->GetFieldInfo();
+        if (other_info.IsVolatile() ||
+            other_info.GetField() == nullptr ||
+            other_info.GetField() == field) {
+          return false;
+        }
+      } else if (!other->IsInvoke() ||
+                 InvokeMayWriteField(other->AsInvoke(), field, cha_invokes)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void LICM::AddCHAGuard(HInvoke* invoke) {
+  ArenaAllocator* allocator = graph_->GetAllocator();
+  uint32_t dex_pc = invoke->GetDexPc();
+  HShouldDeoptimizeFlag* deopt_flag = new (allocator) HShouldDeoptimizeFlag(allocator, dex_pc);
+  HInstruction* compare =
+      new (allocator) HNotEqual(deopt_flag, graph_->GetIntConstant(0, dex_pc));
+  HInstruction* deopt = new (allocator) HDeoptimize(
+      allocator, compare, DeoptimizationKind::kCHA, dex_pc);
+  HBasicBlock* block = invoke->GetBlock();
+  block->InsertInstructionBefore(deopt_flag, invoke);
+  block->InsertInstructionBefore(compare, invoke);
+  block->InsertInstructionBefore(deopt, invoke);
+  // Add receiver as input to aid CHA guard optimization later.
+  deopt_flag->AddInput(invoke->InputAt(0));
+  DCHECK_EQ(deopt_flag->InputCount(), 1u);
+  // Deoptimizing resumes in the interpreter at the call, which has not started yet.
+  deopt->CopyEnvironmentFrom(invoke->GetEnvironment());
+  graph_->AddCHASingleImplementationDependency(invoke->GetResolvedMethod());
+  graph_->IncrementNumberOfCHAGuards();
+}
+
 bool LICM::Run() {
   bool didLICM = false;
   DCHECK(side_effects_.HasRun());
 
+  ScopedArenaAllocator allocator(graph_->GetArenaStack());
+  ScopedArenaVector<HInvoke*> cha_invokes(allocator.Adapter(kArenaAllocLICM));
+  ScopedArenaSet<HInvoke*> guarded_invokes(allocator.Adapter(kArenaAllocLICM));
+
   // Only used during debug.
   ArenaBitVector* visited = nullptr;
   if (kIsDebugBuild) {
@@ -146,6 +354,18 @@ bool LICM::Run() {
             }
           } else if (!instruction->GetSideEffects().MayDependOn(loop_effects)) {
             can_move = true;
+          } else if (instruction->IsInstanceFieldGet() || instruction->IsStaticFieldGet()) {
+            cha_invokes.clear();
+            if (CanHoistFieldGetAcrossWrites(instruction, loop_info, &cha_invokes)) {
+              for (HInvoke* invoke : cha_invokes) {
+                if (guarded_invokes.insert(invoke).second) {
+                  AddCHAGuard(invoke);
+                }
+              }
+              MaybeRecordStat(stats_,
+                              MethodCompilationStat::kLoopInvariantFieldGetMovedAcrossWrites);
+              can_move = true;
+            }
           }
         }
         if (can_move) {
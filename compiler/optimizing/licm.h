@@ -18,6 +18,7 @@
 #define ART_COMPILER_OPTIMIZING_LICM_H_
 
 #include "base/macros.h"
+#include "base/scoped_arena_containers.h"
 #include "nodes.h"
 #include "optimization.h"
 
@@ -39,6 +40,25 @@ class LICM : public HOptimization {
   static constexpr const char* kLoopInvariantCodeMotionPassName = "licm";
 
  private:
+  // Returns whether the field get `instruction`, whose side effects conflict with those of
+  // `loop_info`, can still be hoisted because no instruction of the loop writes its field.
+  // Calls are looked through: the JIT analyzes the bytecode of their targets. Virtual calls
+  // whose target is only known from class hierarchy analysis are added to `cha_invokes`;
+  // they need a CHA guard if `instruction` is hoisted.
+  bool CanHoistFieldGetAcrossWrites(HInstruction* instruction,
+                                    HLoopInformation* loop_info,
+                                    /*inout*/ ScopedArenaVector<HInvoke*>* cha_invokes);
+
+  // Returns whether the loop instruction `invoke` may write `field`, directly or through
+  // the methods it calls. If `invoke` is virtual and its target is only known from class
+  // hierarchy analysis, it is added to `cha_invokes`.
+  bool InvokeMayWriteField(HInvoke* invoke,
+                           ArtField* field,
+                           /*inout*/ ScopedArenaVector<HInvoke*>* cha_invokes);
+
+  // Deoptimizes before `invoke` if class hierarchy analysis of its target got invalidated.
+  void AddCHAGuard(HInvoke* invoke);
+
   const SideEffectsAnalysis& side_effects_;
 
   DISALLOW_COPY_AND_ASSIGN(LICM);
@@ -16,6 +16,7 @@
 
 #include "licm.h"
 
+#include "art_field.h"
 #include "base/arena_allocator.h"
 #include "base/macros.h"
 #include "builder.h"
@@ -176,6 +177,41 @@ TEST_F(LICMTest, NoFieldHoisting) {
   EXPECT_EQ(set_field->GetBlock(), loop_body_);
 }
 
+TEST_F(LICMTest, FieldHoistingAcrossWriteOfOtherField) {
+  BuildLoop();
+
+  // Populate the loop with instructions: set/get different fields with same types.
+  ArtField read_field;
+  ArtField written_field;
+  HInstruction* get_field = new (GetAllocator()) HInstanceFieldGet(parameter_,
+                                                                   &read_field,
+                                                                   DataType::Type::kInt64,
+                                                                   MemberOffset(10),
+                                                                   false,
+                                                                   kUnknownFieldIndex,
+                                                                   kUnknownClassDefIndex,
+                                                                   graph_->GetDexFile(),
+                                                                   0);
+  loop_body_->InsertInstructionBefore(get_field, loop_body_->GetLastInstruction());
+  HInstruction* set_field = new (GetAllocator()) HInstanceFieldSet(parameter_,
+                                                                   get_field,
+                                                                   &written_field,
+                                                                   DataType::Type::kInt64,
+                                                                   MemberOffset(18),
+                                                                   false,
+                                                                   kUnknownFieldIndex,
+                                                                   kUnknownClassDefIndex,
+                                                                   graph_->GetDexFile(),
+                                                                   0);
+  loop_body_->InsertInstructionBefore(set_field, loop_body_->GetLastInstruction());
+
+  EXPECT_EQ(get_field->GetBlock(), loop_body_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+  PerformLICM();
+  EXPECT_EQ(get_field->GetBlock(), loop_preheader_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+}
+
 TEST_F(LICMTest, ArrayHoisting) {
   BuildLoop();
 
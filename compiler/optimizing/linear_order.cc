@@ -16,6 +16,10 @@
 
 #include "linear_order.h"
 
+#include <algorithm>
+
+#include "base/arena_bit_vector.h"
+#include "base/bit_vector-inl.h"
 #include "base/scoped_arena_allocator.h"
 #include "base/scoped_arena_containers.h"
 
@@ -36,9 +40,60 @@ static bool IsInnerLoop(HLoopInformation* outer, HLoopInformation* inner) {
       && inner->IsIn(*outer);
 }
 
+static bool EndsWithThrow(HBasicBlock* block) {
+  HInstruction* last = block->GetLastInstruction();
+  if (last->IsThrow()) {
+    return true;
+  }
+  // Invokes that always throw are followed by a Goto to the exit block.
+  return last->IsGoto() && last->GetPrevious() != nullptr && last->GetPrevious()->AlwaysThrows();
+}
+
+// Find the blocks that are rarely executed:
+// - blocks that throw, catch blocks, and unlikely successors of an HIf according to the
+//   branch profile,
+// - blocks all of whose successors are cold, for example the code building an exception,
+// - blocks all of whose predecessors are cold.
+static void ComputeColdBlocks(const HGraph* graph, ArenaBitVector* cold_blocks) {
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    if (block->IsCatchBlock() || EndsWithThrow(block)) {
+      cold_blocks->SetBit(block->GetBlockId());
+    }
+    HInstruction* last = block->GetLastInstruction();
+    if (last->IsIf()) {
+      HBasicBlock* unlikely = last->AsIf()->GetUnlikelySuccessor();
+      if (unlikely != nullptr && unlikely->GetSinglePredecessor() == block) {
+        cold_blocks->SetBit(unlikely->GetBlockId());
+      }
+    }
+  }
+  for (HBasicBlock* block : graph->GetPostOrder()) {
+    if (block->IsEntryBlock() || block->IsExitBlock() || block->GetSuccessors().empty()) {
+      continue;
+    }
+    if (std::all_of(block->GetSuccessors().begin(),
+                    block->GetSuccessors().end(),
+                    [&](HBasicBlock* succ) { return cold_blocks->IsBitSet(succ->GetBlockId()); })) {
+      cold_blocks->SetBit(block->GetBlockId());
+    }
+  }
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    // Loop headers are visited before their back edges, leave them alone.
+    if (block->IsEntryBlock() || block->IsExitBlock() || block->IsLoopHeader()) {
+      continue;
+    }
+    if (std::all_of(block->GetPredecessors().begin(),
+                    block->GetPredecessors().end(),
+                    [&](HBasicBlock* pred) { return cold_blocks->IsBitSet(pred->GetBlockId()); })) {
+      cold_blocks->SetBit(block->GetBlockId());
+    }
+  }
+}
+
 // Helper method to update work list for linear order.
 static void AddToListForLinearization(ScopedArenaVector<HBasicBlock*>* worklist,
-                                      HBasicBlock* block) {
+                                      HBasicBlock* block,
+                                      const ArenaBitVector& cold_blocks) {
   HLoopInformation* block_loop = block->GetLoopInformation();
   auto insert_pos = worklist->rbegin();  // insert_pos.base() will be the actual position.
   for (auto end = worklist->rend(); insert_pos != end; ++insert_pos) {
@@ -51,6 +106,18 @@ static void AddToListForLinearization(ScopedArenaVector<HBasicBlock*>* worklist,
       break;
     }
   }
+  if (cold_blocks.IsBitSet(block->GetBlockId())) {
+    // Let the hot blocks of the same loop that are ready be processed first, so that
+    // they fall through to each other and cold blocks end up at the end of the loop,
+    // or of the method.
+    for (auto end = worklist->rend(); insert_pos != end; ++insert_pos) {
+      HBasicBlock* current = *insert_pos;
+      if (!InSameLoop(block_loop, current->GetLoopInformation()) ||
+          cold_blocks.IsBitSet(current->GetBlockId())) {
+        break;
+      }
+    }
+  }
   worklist->insert(insert_pos.base(), block);
 }
 
@@ -87,7 +154,8 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
   DCHECK_EQ(linear_order.size(), graph->GetReversePostOrder().size());
   // Create a reverse post ordering with the following properties:
   // - Blocks in a loop are consecutive,
-  // - Back-edge is the last block before loop exits.
+  // - Back-edge is the last block before loop exits,
+  // - Cold blocks come after the hot blocks they can be swapped with.
   //
   // (1): Record the number of forward predecessors for each block. This is to
   //      ensure the resulting order is reverse post order. We could use the
@@ -108,6 +176,9 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
   //      iterate over the successors. When all non-back edge predecessors of a
   //      successor block are visited, the successor block is added in the worklist
   //      following an order that satisfies the requirements to build our linear graph.
+  ArenaBitVector cold_blocks(
+      &allocator, graph->GetBlocks().size(), /* expandable= */ false, kArenaAllocLinearOrder);
+  ComputeColdBlocks(graph, &cold_blocks);
   ScopedArenaVector<HBasicBlock*> worklist(allocator.Adapter(kArenaAllocLinearOrder));
   worklist.push_back(graph->GetEntryBlock());
   size_t num_added = 0u;
@@ -120,7 +191,7 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
       int block_id = successor->GetBlockId();
       size_t number_of_remaining_predecessors = forward_predecessors[block_id];
       if (number_of_remaining_predecessors == 1) {
-        AddToListForLinearization(&worklist, successor);
+        AddToListForLinearization(&worklist, successor, cold_blocks);
       }
       forward_predecessors[block_id] = number_of_remaining_predecessors - 1;
     }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <fstream>
 
 #include "base/arena_allocator.h"
@@ -245,4 +246,55 @@ TEST_F(LinearizeTest, CFG7) {
   TestCode(data, blocks);
 }
 
+// Returns whether the likely successor of the only HIf in the code is laid out before the
+// unlikely one, after setting the branch profile to `true_count` and `false_count`.
+static bool LikelySuccessorComesFirst(HGraph* graph,
+                                      CodeGenerator* codegen,
+                                      ScopedArenaAllocator* allocator,
+                                      uint16_t true_count,
+                                      uint16_t false_count) {
+  HIf* if_instr = nullptr;
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    if (block->GetLastInstruction()->IsIf()) {
+      if_instr = block->GetLastInstruction()->AsIf();
+    }
+  }
+  EXPECT_NE(if_instr, nullptr);
+  if_instr->SetTrueCount(true_count);
+  if_instr->SetFalseCount(false_count);
+  HBasicBlock* unlikely = if_instr->GetUnlikelySuccessor();
+  EXPECT_NE(unlikely, nullptr);
+  HBasicBlock* likely = (unlikely == if_instr->IfTrueSuccessor())
+      ? if_instr->IfFalseSuccessor()
+      : if_instr->IfTrueSuccessor();
+
+  SsaLivenessAnalysis liveness(graph, codegen, allocator);
+  liveness.Analyze();
+  const ArenaVector<HBasicBlock*>& linear_order = graph->GetLinearOrder();
+  auto likely_it = std::find(linear_order.begin(), linear_order.end(), likely);
+  auto unlikely_it = std::find(linear_order.begin(), linear_order.end(), unlikely);
+  return likely_it < unlikely_it;
+}
+
+TEST_F(LinearizeTest, BranchProfile) {
+  // One if whose successors both return.
+  const std::vector<uint16_t> data = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQ, 3,
+    Instruction::RETURN_VOID,
+    Instruction::RETURN_VOID);
+  std::unique_ptr<CompilerOptions> compiler_options =
+      CommonCompilerTest::CreateCompilerOptions(kRuntimeISA, "default");
+
+  HGraph* graph = CreateCFG(data);
+  std::unique_ptr<CodeGenerator> codegen = CodeGenerator::Create(graph, *compiler_options);
+  ASSERT_TRUE(LikelySuccessorComesFirst(
+      graph, codegen.get(), GetScopedAllocator(), /* true_count= */ 1000, /* false_count= */ 2));
+
+  graph = CreateCFG(data);
+  codegen = CodeGenerator::Create(graph, *compiler_options);
+  ASSERT_TRUE(LikelySuccessorComesFirst(
+      graph, codegen.get(), GetScopedAllocator(), /* true_count= */ 2, /* false_count= */ 1000));
+}
+
 }  // namespace art
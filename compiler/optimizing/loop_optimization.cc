@@ -32,6 +32,9 @@ namespace art HIDDEN {
 // Enables vectorization (SIMDization) in the loop optimizer.
 static constexpr bool kEnableVectorization = true;
 
+// Size in bytes of the wide SIMD vectors (AVX2 YMM registers on x86-64).
+static constexpr size_t kWideSIMDRegisterSize = 32u;
+
 //
 // Static helpers.
 //
@@ -522,6 +525,7 @@ HLoopOptimization::HLoopOptimization(HGraph* graph,
       reductions_(nullptr),
       simplified_(false),
       predicated_vectorization_mode_(codegen.SupportsPredicatedSIMD()),
+      wide_simd_mode_(false),
       vector_length_(0),
       vector_refs_(nullptr),
       vector_static_peeling_factor_(0),
@@ -602,6 +606,11 @@ bool HLoopOptimization::LocalRun() {
   vector_permanent_map_ = &perm;
   vector_external_set_ = &ext_set;
   predicate_info_map_ = &pred;
+  // Select the vector width for the whole graph.
+  if (ShouldUseWideSIMD()) {
+    wide_simd_mode_ = true;
+    simd_register_size_ = kWideSIMDRegisterSize;
+  }
   // Traverse.
   const bool did_loop_opt = TraverseLoopsInnerToOuter(top_loop_);
   // Detach.
@@ -983,6 +992,9 @@ bool HLoopOptimization::TryVectorizedTraditional(LoopNode* node,
   VectorizeTraditional(node, body, exit, trip_count);
   MaybeRecordStat(stats_, MethodCompilationStat::kLoopVectorized);
   graph_->SetHasTraditionalSIMD(true);  // flag SIMD usage
+  if (wide_simd_mode_) {
+    graph_->SetHasWideSIMD(true);  // flag the wider spill slots and registers
+  }
   return true;
 }
 
@@ -1246,7 +1258,7 @@ bool HLoopOptimization::CanVectorizeDataFlow(LoopNode* node,
       uint32_t vote = (offset == 0)
           ? 0
           : ((desired_alignment - offset) >> DataType::SizeShift(i->type));
-      DCHECK_LT(vote, 16u);
+      DCHECK_LT(vote, desired_alignment);
       ++peeling_votes[vote];
     } else if (BaseAlignment() >= desired_alignment &&
                num_same_alignment > max_num_same_alignment) {
@@ -2021,6 +2033,60 @@ uint32_t HLoopOptimization::GetVectorSizeInBytes() {
   return simd_register_size_;
 }
 
+bool HLoopOptimization::ShouldUseWideSIMD() {
+  if (!kEnableVectorization ||
+      graph_->IsDebuggable() ||
+      graph_->HasSIMD() ||
+      IsInPredicatedVectorizationMode() ||
+      compiler_options_->GetInstructionSet() != InstructionSet::kX86_64 ||
+      !compiler_options_->GetInstructionSetFeatures()->AsX86InstructionSetFeatures()->HasAVX2()) {
+    return false;
+  }
+  bool has_wide_loop = false;
+  bool has_narrow_only_loop = false;
+  CollectWideSIMDCandidates(top_loop_, &has_wide_loop, &has_narrow_only_loop);
+  // Reset the bookkeeping of the analysis.
+  iset_->clear();
+  reductions_->clear();
+  vector_length_ = 0;
+  vector_refs_->clear();
+  return has_wide_loop && !has_narrow_only_loop;
+}
+
+void HLoopOptimization::CollectWideSIMDCandidates(LoopNode* node,
+                                                  /*inout*/ bool* has_wide_loop,
+                                                  /*inout*/ bool* has_narrow_only_loop) {
+  DCHECK(!wide_simd_mode_);
+  const size_t narrow_size = simd_register_size_;
+  for (; node != nullptr; node = node->next) {
+    if (node->inner != nullptr) {
+      CollectWideSIMDCandidates(node->inner, has_wide_loop, has_narrow_only_loop);
+      continue;
+    }
+    // Only the simple inner loops accepted by TryVectorizedTraditional() are of interest.
+    HBasicBlock* header = node->loop_info->GetHeader();
+    HPhi* main_phi = nullptr;
+    int64_t trip_count = 0;
+    if (node->loop_info->GetBlocks().NumSetBits() != 2 ||
+        !induction_range_.IsFinite(node->loop_info, &trip_count) ||
+        !TrySetSimpleLoopHeader(header, &main_phi)) {
+      continue;
+    }
+    wide_simd_mode_ = true;
+    simd_register_size_ = kWideSIMDRegisterSize;
+    bool is_wide = CanVectorizeDataFlow(node, header, /*collect_alignment_info=*/ false) &&
+                   IsVectorizationProfitable(trip_count);
+    wide_simd_mode_ = false;
+    simd_register_size_ = narrow_size;
+    if (is_wide) {
+      *has_wide_loop = true;
+    } else if (CanVectorizeDataFlow(node, header, /*collect_alignment_info=*/ false) &&
+               IsVectorizationProfitable(trip_count)) {
+      *has_narrow_only_loop = true;
+    }
+  }
+}
+
 bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrictions) {
   const InstructionSetFeatures* features = compiler_options_->GetInstructionSetFeatures();
   switch (compiler_options_->GetInstructionSet()) {
@@ -2128,9 +2194,24 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
       }
     case InstructionSet::kX86:
     case InstructionSet::kX86_64:
-      // Allow vectorization for SSE4.1-enabled X86 devices only (128-bit SIMD).
+      // Allow vectorization for SSE4.1-enabled X86 devices only (128-bit SIMD), or with
+      // 256-bit AVX2 vectors in graphs selected by ShouldUseWideSIMD().
       *restrictions |= kNoIfCond;
+      if (wide_simd_mode_) {
+        // Idioms, reductions and string loads only have 128-bit code generation.
+        *restrictions |= kNoAbs |
+                         kNoSignedHAdd |
+                         kNoUnsignedHAdd |
+                         kNoUnroundedHAdd |
+                         kNoStringCharAt |
+                         kNoReduction |
+                         kNoSAD |
+                         kNoWideSAD |
+                         kNoDotProd;
+      }
       if (features->AsX86InstructionSetFeatures()->HasSSE4_1()) {
+        size_t vector_length = simd_register_size_ / DataType::Size(type);
+        DCHECK_EQ(simd_register_size_ % DataType::Size(type), 0u);
         switch (type) {
           case DataType::Type::kBool:
           case DataType::Type::kUint8:
@@ -2143,7 +2224,7 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoUnroundedHAdd |
                              kNoSAD |
                              kNoDotProd;
-            return TrySetVectorLength(type, 16);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kUint16:
             *restrictions |= kNoDiv |
                              kNoAbs |
@@ -2151,26 +2232,26 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoUnroundedHAdd |
                              kNoSAD |
                              kNoDotProd;
-            return TrySetVectorLength(type, 8);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kInt16:
             *restrictions |= kNoDiv |
                              kNoAbs |
                              kNoSignedHAdd |
                              kNoUnroundedHAdd |
                              kNoSAD;
-            return TrySetVectorLength(type, 8);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kInt32:
             *restrictions |= kNoDiv | kNoSAD;
-            return TrySetVectorLength(type, 4);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kInt64:
             *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoSAD;
-            return TrySetVectorLength(type, 2);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kFloat32:
             *restrictions |= kNoReduction;
-            return TrySetVectorLength(type, 4);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kFloat64:
             *restrictions |= kNoReduction;
-            return TrySetVectorLength(type, 2);
+            return TrySetVectorLength(type, vector_length);
           default:
             break;
         }  // switch type
@@ -390,6 +390,14 @@ class HLoopOptimization : public HOptimization {
                     DataType::Type type,
                     uint64_t restrictions);
   uint32_t GetVectorSizeInBytes();
+
+  // Returns whether the loops of the graph should be vectorized with wide SIMD. The vector
+  // width is the same for the whole graph, so this is only done when no inner loop that
+  // is vectorizable with the default width would be left scalar.
+  bool ShouldUseWideSIMD();
+  void CollectWideSIMDCandidates(LoopNode* node,
+                                 /*inout*/ bool* has_wide_loop,
+                                 /*inout*/ bool* has_narrow_only_loop);
   bool TrySetVectorType(DataType::Type type, /*out*/ uint64_t* restrictions);
   bool TrySetVectorLengthImpl(uint32_t length);
 
@@ -485,8 +493,9 @@ class HLoopOptimization : public HOptimization {
   // Compiler options (to query ISA features).
   const CompilerOptions* compiler_options_;
 
-  // Cached target SIMD vector register size in bytes.
-  const size_t simd_register_size_;
+  // Cached target SIMD vector register size in bytes. Widened for the whole graph
+  // when the loops are vectorized with wide SIMD.
+  size_t simd_register_size_;
 
   // Range information based on prior induction variable analysis.
   InductionVarRange induction_range_;
@@ -520,6 +529,9 @@ class HLoopOptimization : public HOptimization {
   // Whether to use predicated loop vectorization (e.g. for arm64 SVE target).
   bool predicated_vectorization_mode_;
 
+  // Whether to vectorize with the wider SIMD vectors of the target (AVX2 on x86-64).
+  bool wide_simd_mode_;
+
   // Number of "lanes" for selected packed type.
   uint32_t vector_length_;
 
@@ -2699,6 +2699,9 @@ HInstruction* HGraph::InlineInto(HGraph* outer_graph, HInvoke* invoke) {
   if (HasPredicatedSIMD()) {
     outer_graph->SetHasPredicatedSIMD(true);
   }
+  if (HasWideSIMD()) {
+    outer_graph->SetHasWideSIMD(true);
+  }
   if (HasAlwaysThrowingInvokes()) {
     outer_graph->SetHasAlwaysThrowingInvokes(true);
   }
@@ -406,6 +406,7 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
         has_monitor_operations_(false),
         has_traditional_simd_(false),
         has_predicated_simd_(false),
+        has_wide_simd_(false),
         has_loops_(false),
         has_irreducible_loops_(false),
         has_direct_critical_native_call_(false),
@@ -714,6 +715,9 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
 
   bool HasSIMD() const { return has_traditional_simd_ || has_predicated_simd_; }
 
+  bool HasWideSIMD() const { return has_wide_simd_; }
+  void SetHasWideSIMD(bool value) { has_wide_simd_ = value; }
+
   bool HasLoops() const { return has_loops_; }
   void SetHasLoops(bool value) { has_loops_ = value; }
 
@@ -830,6 +834,11 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   bool has_traditional_simd_;
   bool has_predicated_simd_;
 
+  // Flag whether the traditional SIMD instructions use the wider vector size supported by
+  // the target (256-bit AVX2 on x86-64) instead of the default one. The width is chosen for
+  // the whole graph, as all SIMD spill slots of a method have the same size.
+  bool has_wide_simd_;
+
   // Flag whether there are any loops in the graph. We can skip loop
   // optimization if it's false.
   bool has_loops_;
@@ -2099,6 +2108,10 @@ class HEnvironment : public ArenaObject<kArenaAllocEnvironment> {
     locations_.resize(vregs_.size());
   }
 
+  void ClearLocations() {
+    locations_.clear();
+  }
+
   void SetAndCopyParentChain(ArenaAllocator* allocator, HEnvironment* parent) {
     if (parent_ != nullptr) {
       parent_->SetAndCopyParentChain(allocator, parent);
@@ -3557,12 +3570,36 @@ class HIf final : public HExpression<1> {
   void SetFalseCount(uint16_t count) { false_count_ = count; }
   uint16_t GetFalseCount() const { return false_count_; }
 
+  // Whether the branch profile shows that the true (resp. false) successor is rarely taken.
+  bool IsTrueSuccessorUnlikely() const { return IsUnlikely(true_count_, false_count_); }
+  bool IsFalseSuccessorUnlikely() const { return IsUnlikely(false_count_, true_count_); }
+
+  HBasicBlock* GetUnlikelySuccessor() const {
+    if (IsTrueSuccessorUnlikely()) {
+      return IfTrueSuccessor();
+    } else if (IsFalseSuccessorUnlikely()) {
+      return IfFalseSuccessor();
+    }
+    return nullptr;
+  }
+
   DECLARE_INSTRUCTION(If);
 
  protected:
   DEFAULT_COPY_CONSTRUCTOR(If);
 
  private:
+  // A successor is unlikely if it was taken less than once every `kUnlikelyRatio`
+  // times, over at least `kMinimumSamples` executions of the branch.
+  static constexpr uint32_t kUnlikelyRatio = 32u;
+  static constexpr uint32_t kMinimumSamples = 64u;
+
+  // Note that without a profile, both counts are at their maximum and no successor is unlikely.
+  static bool IsUnlikely(uint16_t count, uint16_t other_count) {
+    uint32_t total = static_cast<uint32_t>(count) + other_count;
+    return total >= kMinimumSamples && count * kUnlikelyRatio < total;
+  }
+
   uint16_t true_count_;
   uint16_t false_count_;
 };
@@ -25,12 +25,14 @@
 #include "art_method-inl.h"
 #include "base/arena_allocator.h"
 #include "base/arena_containers.h"
+#include "base/array_ref.h"
 #include "base/dumpable.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/mutex.h"
 #include "base/scoped_arena_allocator.h"
 #include "base/systrace.h"
+#include "base/time_utils.h"
 #include "base/timing_logger.h"
 #include "builder.h"
 #include "code_generator.h"
@@ -38,6 +40,7 @@
 #include "debug/elf_debug_writer.h"
 #include "debug/method_debug_info.h"
 #include "dex/dex_file_types.h"
+#include "dex/method_reference.h"
 #include "driver/compiled_code_storage.h"
 #include "driver/compiler_options.h"
 #include "driver/dex_compilation_unit.h"
@@ -47,6 +50,7 @@
 #include "jit/debugger_interface.h"
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
+#include "jit/jit_compile_report.h"
 #include "jit/jit_logger.h"
 #include "jni/quick/jni_compiler.h"
 #include "linker/linker_patch.h"
@@ -54,6 +58,7 @@
 #include "oat/oat_quick_method_header.h"
 #include "optimizing/write_barrier_elimination.h"
 #include "prepare_for_register_allocation.h"
+#include "profile/profile_compilation_info.h"
 #include "profiling_info_builder.h"
 #include "reference_type_propagation.h"
 #include "register_allocator_linear_scan.h"
@@ -78,12 +83,46 @@ static constexpr const char kStringFilter[] = "";
 
 class PassScope;
 
+// Whether `method` currently runs baseline JIT code, which it can keep running if its optimized
+// compilation is abandoned.
+static bool RunsBaselineJitCode(ArtMethod* method) {
+  jit::Jit* jit = Runtime::Current()->GetJit();
+  if (jit == nullptr) {
+    return false;
+  }
+  ScopedObjectAccess soa(Thread::Current());
+  const void* entry_point = method->GetEntryPointFromQuickCompiledCode();
+  return jit->GetCodeCache()->ContainsPc(entry_point) &&
+      CodeInfo::IsBaseline(
+          OatQuickMethodHeader::FromEntryPoint(entry_point)->GetOptimizedCodeInfoPtr());
+}
+
+// Optimizations that the code generator does not rely on, and that can take long on
+// large methods. They are skipped once a JIT compilation is over its time budget.
+static bool IsExpensivePass(OptimizationPass pass) {
+  switch (pass) {
+    case OptimizationPass::kInliner:
+    case OptimizationPass::kGlobalValueNumbering:
+    case OptimizationPass::kInvariantCodeMotion:
+    case OptimizationPass::kInductionVarAnalysis:
+    case OptimizationPass::kBoundsCheckElimination:
+    case OptimizationPass::kLoopOptimization:
+    case OptimizationPass::kLoadStoreElimination:
+    case OptimizationPass::kCodeSinking:
+    case OptimizationPass::kScheduling:
+      return true;
+    default:
+      return false;
+  }
+}
+
 class PassObserver : public ValueObject {
  public:
   PassObserver(HGraph* graph,
                CodeGenerator* codegen,
                std::ostream* visualizer_output,
-               const CompilerOptions& compiler_options)
+               const CompilerOptions& compiler_options,
+               jit::JitCompileReport* compile_report = nullptr)
       : graph_(graph),
         last_seen_graph_size_(0),
         cached_method_name_(),
@@ -95,7 +134,14 @@ class PassObserver : public ValueObject {
         visualizer_enabled_(!compiler_options.GetDumpCfgFileName().empty()),
         visualizer_(&visualizer_oss_, graph, codegen),
         codegen_(codegen),
-        graph_in_bad_state_(false) {
+        graph_in_bad_state_(false),
+        compile_report_(compile_report),
+        pass_timings_(graph->GetAllocator()->Adapter(kArenaAllocMisc)),
+        budget_ns_(compile_report != nullptr ? MsToNs(compiler_options.GetJitCompileBudgetMs())
+                                             : 0u),
+        start_time_ns_(compile_report != nullptr ? ThreadCpuNanoTime() : 0u),
+        pass_start_time_ns_(0u),
+        over_budget_(false) {
     if (timing_logger_enabled_ || visualizer_enabled_) {
       if (!IsVerboseMethod(compiler_options, GetMethodName())) {
         timing_logger_enabled_ = visualizer_enabled_ = false;
@@ -108,6 +154,14 @@ class PassObserver : public ValueObject {
   }
 
   ~PassObserver() {
+    if (compile_report_ != nullptr) {
+      compile_report_->AddCompilation(
+          graph_->GetCompilationKind(),
+          ThreadCpuNanoTime() - start_time_ns_,
+          over_budget_,
+          ArrayRef<const jit::JitCompileReport::PassTiming>(pass_timings_),
+          [this]() { return std::string(GetMethodName()); });
+    }
     if (timing_logger_enabled_) {
       LOG(INFO) << "TIMINGS " << GetMethodName();
       LOG(INFO) << Dumpable<TimingLogger>(timing_logger_);
@@ -127,6 +181,19 @@ class PassObserver : public ValueObject {
 
   void SetGraphInBadState() { graph_in_bad_state_ = true; }
 
+  // Whether the JIT compilation used up its compile time budget. Expensive
+  // optimizations are skipped from then on.
+  bool IsOverBudget() {
+    return IsOverBudget(budget_ns_);
+  }
+
+  // Whether the JIT compilation used up twice its budget. An optimized compilation
+  // of a method that has baseline code is abandoned then, as register allocation
+  // and code generation of such a method would take long too.
+  bool IsFarOverBudget() {
+    return IsOverBudget(2u * budget_ns_);
+  }
+
   const char* GetMethodName() {
     // PrettyMethod() is expensive, so we delay calling it until we actually have to.
     if (cached_method_name_.empty()) {
@@ -146,6 +213,17 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.StartTiming(pass_name);
     }
+    if (compile_report_ != nullptr) {
+      pass_start_time_ns_ = ThreadCpuNanoTime();
+    }
+  }
+
+  bool IsOverBudget(uint64_t budget_ns) {
+    if (budget_ns_ == 0u || ThreadCpuNanoTime() - start_time_ns_ <= budget_ns) {
+      return false;
+    }
+    over_budget_ = true;
+    return true;
   }
 
   void FlushVisualizer() {
@@ -157,6 +235,9 @@ class PassObserver : public ValueObject {
 
   void EndPass(const char* pass_name, bool pass_change) {
     // Pause timer first, then dump graph.
+    if (compile_report_ != nullptr) {
+      pass_timings_.push_back({pass_name, ThreadCpuNanoTime() - pass_start_time_ns_});
+    }
     if (timing_logger_enabled_) {
       timing_logger_.EndTiming();
     }
@@ -218,6 +299,15 @@ class PassObserver : public ValueObject {
   // expected to validate.
   bool graph_in_bad_state_;
 
+  // Where to report the time of JIT compilations, null for AOT compilations.
+  jit::JitCompileReport* const compile_report_;
+  ArenaVector<jit::JitCompileReport::PassTiming> pass_timings_;
+  // Compile time budget, 0 if none.
+  const uint64_t budget_ns_;
+  const uint64_t start_time_ns_;
+  uint64_t pass_start_time_ns_;
+  bool over_budget_;
+
   friend PassScope;
 
   DISALLOW_COPY_AND_ASSIGN(PassObserver);
@@ -306,7 +396,12 @@ class OptimizingCompiler final : public Compiler {
     pass_changes[static_cast<size_t>(OptimizationPass::kNone)] = true;
     bool change = false;
     for (size_t i = 0; i < length; ++i) {
-      if (pass_changes[static_cast<size_t>(definitions[i].depends_on)]) {
+      if (IsExpensivePass(definitions[i].pass) && pass_observer->IsOverBudget()) {
+        // Out of compile time budget: skip the pass and record that nothing changed.
+        MaybeRecordStat(compilation_stats_.get(),
+                        MethodCompilationStat::kJitPassSkippedOverBudget);
+        pass_changes[static_cast<size_t>(definitions[i].pass)] = false;
+      } else if (pass_changes[static_cast<size_t>(definitions[i].depends_on)]) {
         // Execute the pass and record whether it changed anything.
         PassScope scope(optimizations[i]->GetPassName(), pass_observer);
         bool pass_change = optimizations[i]->Run();
@@ -570,6 +665,10 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
           OptDef(OptimizationPass::kInstructionSimplifierX86_64),
           OptDef(OptimizationPass::kSideEffectsAnalysis),
           OptDef(OptimizationPass::kGlobalValueNumbering, "GVN$after_arch"),
+          // Schedule before instructions get emitted at their use site: moving an instruction
+          // between an ArrayLength emitted at its BoundsCheck and its NullCheck would make the
+          // implicit null check imprecise.
+          OptDef(OptimizationPass::kScheduling),
           OptDef(OptimizationPass::kX86MemoryOperandGeneration)
       };
       return RunOptimizations(graph,
@@ -587,29 +686,70 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
   }
 }
 
+// Returns the register allocation strategy requested for the method. With
+// `--register-allocation-strategy=graph-color-hot`, only methods that are hot in the
+// profile use graph coloring. Without a profile, all methods use the default strategy.
+static RegisterAllocator::Strategy GetRegisterAllocationStrategy(
+    const CompilerOptions& compiler_options,
+    const DexCompilationUnit& dex_compilation_unit) {
+  RegisterAllocator::Strategy strategy = compiler_options.GetRegisterAllocationStrategy();
+  if (!compiler_options.UseRegisterAllocationStrategyForHotMethodsOnly()) {
+    return strategy;
+  }
+  const ProfileCompilationInfo* pci = compiler_options.GetProfileCompilationInfo();
+  bool is_hot = pci != nullptr &&
+                pci->GetMethodHotness(MethodReference(dex_compilation_unit.GetDexFile(),
+                                                      dex_compilation_unit.GetDexMethodIndex()))
+                    .IsHot();
+  return is_hot ? strategy : RegisterAllocator::kRegisterAllocatorDefault;
+}
+
+// Returns the strategy actually used, which may differ from the requested `strategy`
+// if the allocator does not support the graph or bails out.
 NO_INLINE  // Avoid increasing caller's frame size by large stack-allocated objects.
-static void AllocateRegisters(HGraph* graph,
-                              CodeGenerator* codegen,
-                              PassObserver* pass_observer,
-                              OptimizingCompilerStats* stats) {
+static RegisterAllocator::Strategy AllocateRegisters(HGraph* graph,
+                                                     CodeGenerator* codegen,
+                                                     PassObserver* pass_observer,
+                                                     RegisterAllocator::Strategy strategy,
+                                                     OptimizingCompilerStats* stats) {
   {
     PassScope scope(PrepareForRegisterAllocation::kPrepareForRegisterAllocationPassName,
                     pass_observer);
     PrepareForRegisterAllocation(graph, codegen->GetCompilerOptions(), stats).Run();
   }
-  // Use local allocator shared by SSA liveness analysis and register allocator.
-  // (Register allocator creates new objects in the liveness data.)
-  ScopedArenaAllocator local_allocator(graph->GetArenaStack());
-  SsaLivenessAnalysis liveness(graph, codegen, &local_allocator);
-  {
-    PassScope scope(SsaLivenessAnalysis::kLivenessPassName, pass_observer);
-    liveness.Analyze();
-  }
-  {
-    PassScope scope(RegisterAllocator::kRegisterAllocatorPassName, pass_observer);
-    std::unique_ptr<RegisterAllocator> register_allocator =
-        RegisterAllocator::Create(&local_allocator, codegen, liveness);
-    register_allocator->AllocateRegisters();
+  while (true) {
+    // Use local allocator shared by SSA liveness analysis and register allocator.
+    // (Register allocator creates new objects in the liveness data.)
+    ScopedArenaAllocator local_allocator(graph->GetArenaStack());
+    SsaLivenessAnalysis liveness(graph, codegen, &local_allocator);
+    {
+      PassScope scope(SsaLivenessAnalysis::kLivenessPassName, pass_observer);
+      liveness.Analyze();
+    }
+    {
+      PassScope scope(RegisterAllocator::kRegisterAllocatorPassName, pass_observer);
+      std::unique_ptr<RegisterAllocator> register_allocator =
+          RegisterAllocator::Create(&local_allocator, codegen, liveness, strategy);
+      register_allocator->AllocateRegisters();
+      strategy = register_allocator->GetStrategy();
+      if (!register_allocator->HasBailedOut()) {
+        if (stats != nullptr) {
+          bool graph_color = strategy == RegisterAllocator::kRegisterAllocatorGraphColor;
+          stats->RecordStat(graph_color ? MethodCompilationStat::kRegisterAllocationGraphColor
+                                        : MethodCompilationStat::kRegisterAllocationLinearScan);
+          stats->RecordStat(graph_color ? MethodCompilationStat::kSpilledIntervalsGraphColor
+                                        : MethodCompilationStat::kSpilledIntervalsLinearScan,
+                            register_allocator->GetNumberOfSpilledIntervals());
+        }
+        return strategy;
+      }
+    }
+    // The live intervals are left in an unspecified state, so compute liveness again
+    // for the linear scan allocator, which does not bail out.
+    DCHECK_NE(strategy, RegisterAllocator::kRegisterAllocatorLinearScan);
+    MaybeRecordStat(stats, MethodCompilationStat::kRegisterAllocationBailedOut);
+    RegisterAllocator::ClearLivenessData(graph);
+    strategy = RegisterAllocator::kRegisterAllocatorLinearScan;
   }
 }
 
@@ -855,7 +995,8 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
-                             compiler_options);
+                             compiler_options,
+                             jit != nullptr ? jit->GetCompileReport() : nullptr);
 
   {
     VLOG(compiler) << "Building " << pass_observer.GetMethodName();
@@ -924,6 +1065,20 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
     WriteBarrierElimination(graph, compilation_stats_.get()).Run();
   }
 
+  if (compilation_kind == CompilationKind::kOptimized &&
+      pass_observer.IsFarOverBudget() &&
+      RunsBaselineJitCode(method)) {
+    // Keep running the baseline code. Record the abandonment in the profiling info, so that
+    // the method is not enqueued again when the baseline code gets hot again. The method is not
+    // marked as not compilable: it must stay compilable in case the code cache collects the
+    // baseline code. Without baseline code to fall back to, finish the compilation with the
+    // expensive passes already skipped.
+    SCOPED_TRACE << "Not compiling because of compile time budget";
+    MaybeRecordStat(compilation_stats_.get(), MethodCompilationStat::kNotCompiledOverBudget);
+    jit->GetCodeCache()->RecordAbandonedCompilation(method, Thread::Current());
+    return nullptr;
+  }
+
   // If we are compiling baseline and we haven't created a profiling info for
   // this method already, do it now.
   if (jit != nullptr &&
@@ -942,10 +1097,12 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
     }
   }
 
-  AllocateRegisters(graph,
-                    codegen.get(),
-                    &pass_observer,
-                    compilation_stats_.get());
+  RegisterAllocator::Strategy register_allocation_strategy = AllocateRegisters(
+      graph,
+      codegen.get(),
+      &pass_observer,
+      GetRegisterAllocationStrategy(compiler_options, dex_compilation_unit),
+      compilation_stats_.get());
 
   if (UNLIKELY(codegen->GetFrameSize() > codegen->GetMaximumFrameSize())) {
     SCOPED_TRACE << "Not compiling because of stack frame too large";
@@ -959,6 +1116,11 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
   codegen->Compile();
   pass_observer.DumpDisassembly();
 
+  MaybeRecordStat(compilation_stats_.get(),
+                  register_allocation_strategy == RegisterAllocator::kRegisterAllocatorGraphColor
+                      ? MethodCompilationStat::kCodeBytesGraphColor
+                      : MethodCompilationStat::kCodeBytesLinearScan,
+                  codegen->GetAssembler()->CodeSize());
   MaybeRecordStat(compilation_stats_.get(), MethodCompilationStat::kCompiledBytecode);
   return codegen.release();
 }
@@ -1043,10 +1205,12 @@ CodeGenerator* OptimizingCompiler::TryCompileIntrinsic(
     WriteBarrierElimination(graph, compilation_stats_.get()).Run();
   }
 
-  AllocateRegisters(graph,
-                    codegen.get(),
-                    &pass_observer,
-                    compilation_stats_.get());
+  AllocateRegisters(
+      graph,
+      codegen.get(),
+      &pass_observer,
+      GetRegisterAllocationStrategy(compiler_options, dex_compilation_unit),
+      compilation_stats_.get());
   if (!codegen->IsLeafMethod()) {
     VLOG(compiler) << "Intrinsic method is not leaf: " << method->GetIntrinsic()
         << " " << graph->PrettyMethod();
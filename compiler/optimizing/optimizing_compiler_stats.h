@@ -69,6 +69,7 @@ enum class MethodCompilationStat {
   kNotCompiledIrreducibleLoopAndStringInit,
   kNotCompiledPhiEquivalentInOsr,
   kNotCompiledFrameTooBig,
+  kNotCompiledOverBudget,
   kInlinedMonomorphicCall,
   kInlinedPolymorphicCall,
   kMonomorphicCall,
@@ -77,6 +78,7 @@ enum class MethodCompilationStat {
   kBooleanSimplified,
   kIntrinsicRecognized,
   kLoopInvariantMoved,
+  kLoopInvariantFieldGetMovedAcrossWrites,
   kLoopVectorized,
   kLoopVectorizedIdiom,
   kSelectGenerated,
@@ -110,6 +112,7 @@ enum class MethodCompilationStat {
   kNotInlinedNotCompilable,
   kNotInlinedNotVerified,
   kNotInlinedCodeItem,
+  kNotInlinedOsrOutsideLoop,
   kNotInlinedEndsWithThrow,
   kNotInlinedWont,
   kNotInlinedRecursiveBudget,
@@ -129,6 +132,7 @@ enum class MethodCompilationStat {
   kRemovedWriteBarrier,
   kBitstringTypeCheck,
   kJitOutOfMemoryForCommit,
+  kJitPassSkippedOverBudget,
   kFullLSEAllocationRemoved,
   kFullLSEPossible,
   kNonPartialLoadRemoved,
@@ -136,6 +140,13 @@ enum class MethodCompilationStat {
   kPartialStoreRemoved,
   kPartialAllocationMoved,
   kDevirtualized,
+  kRegisterAllocationLinearScan,
+  kRegisterAllocationGraphColor,
+  kRegisterAllocationBailedOut,
+  kSpilledIntervalsLinearScan,
+  kSpilledIntervalsGraphColor,
+  kCodeBytesLinearScan,
+  kCodeBytesGraphColor,
   kLastStat
 };
 std::ostream& operator<<(std::ostream& os, MethodCompilationStat rhs);
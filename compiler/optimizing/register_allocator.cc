@@ -24,6 +24,7 @@
 #include "base/bit_utils_iterator.h"
 #include "base/bit_vector-inl.h"
 #include "code_generator.h"
+#include "register_allocator_graph_color.h"
 #include "register_allocator_linear_scan.h"
 #include "ssa_liveness_analysis.h"
 
@@ -65,11 +66,57 @@ RegisterAllocator::RegisterAllocator(ScopedArenaAllocator* allocator,
 
 std::unique_ptr<RegisterAllocator> RegisterAllocator::Create(ScopedArenaAllocator* allocator,
                                                              CodeGenerator* codegen,
-                                                             const SsaLivenessAnalysis& analysis) {
+                                                             const SsaLivenessAnalysis& analysis,
+                                                             Strategy strategy) {
+  switch (strategy) {
+    case kRegisterAllocatorLinearScan:
+      break;
+    case kRegisterAllocatorGraphColor:
+      if (RegisterAllocatorGraphColor::CanAllocateRegistersFor(*codegen->GetGraph(), *codegen)) {
+        return std::unique_ptr<RegisterAllocator>(
+            new (allocator) RegisterAllocatorGraphColor(allocator, codegen, analysis));
+      }
+      break;
+  }
   return std::unique_ptr<RegisterAllocator>(
       new (allocator) RegisterAllocatorLinearScan(allocator, codegen, analysis));
 }
 
+size_t RegisterAllocator::GetNumberOfSpilledIntervals() const {
+  size_t number_of_spilled_intervals = 0u;
+  for (size_t i = 0, e = liveness_.GetNumberOfSsaValues(); i != e; ++i) {
+    LiveInterval* parent = liveness_.GetInstructionFromSsaIndex(i)->GetLiveInterval();
+    if (!parent->HasSpillSlot()) {
+      // The value is either always in a register or a constant.
+      continue;
+    }
+    for (LiveInterval* sibling = parent; sibling != nullptr; sibling = sibling->GetNextSibling()) {
+      if (!sibling->HasRegister()) {
+        ++number_of_spilled_intervals;
+      }
+    }
+  }
+  return number_of_spilled_intervals;
+}
+
+static void ClearInstructionLivenessData(HInstruction* instruction) {
+  instruction->SetLiveInterval(nullptr);
+  for (HEnvironment* env = instruction->GetEnvironment(); env != nullptr; env = env->GetParent()) {
+    env->ClearLocations();
+  }
+}
+
+void RegisterAllocator::ClearLivenessData(HGraph* graph) {
+  for (HBasicBlock* block : graph->GetLinearOrder()) {
+    for (HInstructionIterator it(block->GetPhis()); !it.Done(); it.Advance()) {
+      ClearInstructionLivenessData(it.Current());
+    }
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      ClearInstructionLivenessData(it.Current());
+    }
+  }
+}
+
 RegisterAllocator::~RegisterAllocator() {
   if (kIsDebugBuild) {
     // Poison live interval pointers with "Error: BAD 71ve1nt3rval."
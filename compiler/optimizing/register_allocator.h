@@ -38,14 +38,24 @@ class SsaLivenessAnalysis;
  */
 class RegisterAllocator : public DeletableArenaObject<kArenaAllocRegisterAllocator> {
  public:
+  enum Strategy {
+    kRegisterAllocatorLinearScan,
+    kRegisterAllocatorGraphColor
+  };
+
   enum class RegisterType {
     kCoreRegister,
     kFpRegister
   };
 
+  static constexpr Strategy kRegisterAllocatorDefault = kRegisterAllocatorLinearScan;
+
+  // Creates a register allocator implementing `strategy`. Falls back to the
+  // default strategy if `strategy` cannot allocate registers for the graph.
   static std::unique_ptr<RegisterAllocator> Create(ScopedArenaAllocator* allocator,
                                                    CodeGenerator* codegen,
-                                                   const SsaLivenessAnalysis& analysis);
+                                                   const SsaLivenessAnalysis& analysis,
+                                                   Strategy strategy = kRegisterAllocatorDefault);
 
   virtual ~RegisterAllocator();
 
@@ -53,6 +63,23 @@ class RegisterAllocator : public DeletableArenaObject<kArenaAllocRegisterAllocat
   // allocates registers to live intervals.
   virtual void AllocateRegisters() = 0;
 
+  // Returns whether `AllocateRegisters()` gave up without allocating registers. The live
+  // intervals are then in an unspecified state. After destroying the allocator, call
+  // `ClearLivenessData()` and compute liveness again before allocating registers with
+  // another allocator. The linear scan allocator never bails out.
+  virtual bool HasBailedOut() const { return false; }
+
+  // Clears the live intervals and environment locations attached to the instructions of
+  // `graph` by liveness analysis, so that liveness can be computed again.
+  static void ClearLivenessData(HGraph* graph);
+
+  // Returns the strategy implemented by this register allocator.
+  virtual Strategy GetStrategy() const = 0;
+
+  // Returns the number of live intervals, including split siblings, that have been
+  // assigned a stack location instead of a register. Must be called after `AllocateRegisters()`.
+  size_t GetNumberOfSpilledIntervals() const;
+
   // Validate that the register allocator did not allocate the same register to
   // intervals that intersect each other. Returns false if it failed.
   virtual bool Validate(bool log_fatal_on_failure) = 0;
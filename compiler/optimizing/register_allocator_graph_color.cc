@@ -0,0 +1,1213 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "register_allocator_graph_color.h"
+
+#include <algorithm>
+
+#include "base/bit_utils.h"
+#include "base/bit_utils_iterator.h"
+#include "base/pointer_size.h"
+#include "code_generator.h"
+#include "register_allocation_resolver.h"
+#include "ssa_liveness_analysis.h"
+
+namespace art HIDDEN {
+
+static constexpr size_t kMaxLifetimePosition = -1;
+static constexpr size_t kDefaultNumberOfSpillSlots = 4;
+
+// Number of coloring rounds during which intervals failing to get a register are first
+// split at loop boundaries. Afterwards, they are split around their register uses.
+static constexpr size_t kMaxRoundsSplittingAtLoopBoundaries = 3;
+
+// Number of coloring rounds after which the allocator bails out. Splitting around register
+// uses usually lets the next round succeed, so this is only reached by pathological graphs.
+static constexpr size_t kMaxColoringRounds = kMaxRoundsSplittingAtLoopBoundaries + 3;
+
+// A use in a loop weighs as much as `kLoopSpillWeightFactor` uses in the enclosing code.
+static constexpr float kLoopSpillWeightFactor = 10.0f;
+static constexpr size_t kMaxLoopDepthForSpillWeight = 6;
+
+/**
+ * A node of the interference graph, for a live interval of the register type being colored.
+ */
+class InterferenceNode : public ArenaObject<kArenaAllocRegisterAllocator> {
+ public:
+  enum class Kind {
+    kPrecolored,  // The interval has been assigned a register by the code generator.
+    kMinimal,     // The interval requires a register and is too short to be split.
+    kDeferred,    // The interval is simplified and selected, and split or spilled on failure.
+  };
+
+  InterferenceNode(LiveInterval* interval,
+                   Kind kind,
+                   size_t id,
+                   bool requires_register,
+                   float spill_weight,
+                   ScopedArenaAllocator* allocator)
+      : interval_(interval),
+        kind_(kind),
+        id_(id),
+        requires_register_(requires_register),
+        spill_weight_(spill_weight),
+        adjacent_nodes_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        blocked_registers_(0u),
+        degree_(0u),
+        available_count_(0u),
+        removed_(false),
+        live_index_(0u) {}
+
+  LiveInterval* GetInterval() const { return interval_; }
+  Kind GetKind() const { return kind_; }
+  size_t GetId() const { return id_; }
+  bool RequiresRegister() const { return requires_register_; }
+  float GetSpillWeight() const { return spill_weight_; }
+
+  void AddInterference(InterferenceNode* other) {
+    DCHECK_NE(this, other);
+    adjacent_nodes_.push_back(other);
+  }
+
+  // Sort adjacent nodes and remove duplicates, which are added for intervals
+  // overlapping in more than one live range.
+  void RemoveDuplicateInterferences() {
+    std::sort(adjacent_nodes_.begin(),
+              adjacent_nodes_.end(),
+              [](InterferenceNode* lhs, InterferenceNode* rhs) {
+                return lhs->GetId() < rhs->GetId();
+              });
+    adjacent_nodes_.erase(std::unique(adjacent_nodes_.begin(), adjacent_nodes_.end()),
+                          adjacent_nodes_.end());
+  }
+
+  ArrayRef<InterferenceNode* const> GetAdjacentNodes() const {
+    return ArrayRef<InterferenceNode* const>(adjacent_nodes_);
+  }
+
+  // Registers blocked by fixed intervals at some position covered by this node.
+  uint32_t GetBlockedRegisters() const { return blocked_registers_; }
+  void BlockRegisters(uint32_t registers) { blocked_registers_ |= registers; }
+
+  size_t GetDegree() const { return degree_; }
+  void SetDegree(size_t degree) { degree_ = degree; }
+  // Returns whether the degree went from `GetAvailableCount()` to one below.
+  bool DecrementDegree() {
+    DCHECK_NE(degree_, 0u);
+    --degree_;
+    return degree_ + 1u == available_count_;
+  }
+
+  // Number of registers left to this node by fixed intervals and colored neighbors.
+  size_t GetAvailableCount() const { return available_count_; }
+  void SetAvailableCount(size_t count) { available_count_ = count; }
+
+  bool IsLowDegree() const { return degree_ < available_count_; }
+
+  bool IsRemoved() const { return removed_; }
+  void SetRemoved() { removed_ = true; }
+
+  size_t GetLiveIndex() const { return live_index_; }
+  void SetLiveIndex(size_t index) { live_index_ = index; }
+
+ private:
+  LiveInterval* const interval_;
+  const Kind kind_;
+  const size_t id_;
+  const bool requires_register_;
+  const float spill_weight_;
+  ScopedArenaVector<InterferenceNode*> adjacent_nodes_;
+  uint32_t blocked_registers_;
+  size_t degree_;
+  size_t available_count_;
+  bool removed_;
+  size_t live_index_;  // Index in the live nodes while building the interference graph.
+
+  DISALLOW_COPY_AND_ASSIGN(InterferenceNode);
+};
+
+// The start or end of a live range of a node or of a fixed interval.
+struct LiveRangeBoundary {
+  size_t position;
+  bool is_start;
+  bool is_fixed;
+  size_t index;  // Index of the node, or of the fixed interval.
+};
+
+static RegisterAllocator::RegisterType GetRegisterType(LiveInterval* interval) {
+  return DataType::IsFloatingPointType(interval->GetType())
+      ? RegisterAllocator::RegisterType::kFpRegister
+      : RegisterAllocator::RegisterType::kCoreRegister;
+}
+
+static uint32_t GetAllocatableRegisters(const CodeGenerator& codegen,
+                                        RegisterAllocator::RegisterType register_type) {
+  bool is_core = (register_type == RegisterAllocator::RegisterType::kCoreRegister);
+  size_t number_of_registers = is_core
+      ? codegen.GetNumberOfCoreRegisters()
+      : codegen.GetNumberOfFloatingPointRegisters();
+  const bool* blocked_registers = is_core
+      ? codegen.GetBlockedCoreRegisters()
+      : codegen.GetBlockedFloatingPointRegisters();
+  DCHECK_LE(number_of_registers, BitSizeOf<uint32_t>());
+  uint32_t registers = 0u;
+  for (size_t reg = 0; reg != number_of_registers; ++reg) {
+    if (!blocked_registers[reg]) {
+      registers |= 1u << reg;
+    }
+  }
+  return registers;
+}
+
+static float GetSpillWeightFactor(HBasicBlock* block) {
+  float factor = 1.0f;
+  size_t depth = 0u;
+  for (HLoopInformationOutwardIterator it(*block);
+       !it.Done() && depth != kMaxLoopDepthForSpillWeight;
+       it.Advance(), ++depth) {
+    factor *= kLoopSpillWeightFactor;
+  }
+  return factor;
+}
+
+// Returns the number of register uses of `interval`, weighted by the loop depth
+// of the users, per lifetime position. Intervals with a lower spill weight are
+// better candidates for spilling.
+static float ComputeSpillWeight(LiveInterval* interval) {
+  float weight = 0.0f;
+  HInstruction* defined_by = interval->GetDefinedBy();
+  if (!interval->IsSplit() && defined_by != nullptr && interval->DefinitionRequiresRegister()) {
+    weight += GetSpillWeightFactor(defined_by->GetBlock());
+  }
+  size_t start = interval->GetStart();
+  size_t end = interval->GetEnd();
+  for (const UsePosition& use : interval->GetUses()) {
+    size_t position = use.GetPosition();
+    if (position > end) {
+      break;
+    }
+    // A use at the start of a split interval belongs to the previous sibling.
+    if (position > start && use.RequiresRegister()) {
+      weight += GetSpillWeightFactor(use.GetUser()->GetBlock());
+    }
+  }
+  return weight / interval->GetLength();
+}
+
+// Returns whether `output`, starting at `position`, may be assigned the register of
+// `input` although `input` is live at `position`. This is the case when `input` is
+// the last use of an input of the instruction defining `output`, and the code generator
+// reads all inputs before writing the output.
+static bool CanShareInputRegister(LiveInterval* output, LiveInterval* input, size_t position) {
+  HInstruction* defined_by = output->GetDefinedBy();
+  if (defined_by == nullptr ||
+      output->IsSplit() ||
+      defined_by->IsPhi() ||
+      output->GetStart() != position ||
+      defined_by->GetLifetimePosition() != position) {
+    return false;
+  }
+  LocationSummary* locations = defined_by->GetLocations();
+  Location out = locations->Out();
+  if (locations->OutputCanOverlapWithInputs() ||
+      !out.IsUnallocated() ||
+      out.GetPolicy() == Location::kSameAsFirstInput) {
+    return false;
+  }
+  if (input->IsTemp() || input->CoversSlow(position + 1u)) {
+    return false;
+  }
+  // A move to the next sibling would be inserted after the instruction, and read
+  // the output instead of the input.
+  LiveInterval* next_sibling = input->GetNextSibling();
+  if (next_sibling != nullptr && next_sibling->GetStart() == position + 1u) {
+    return false;
+  }
+  HInputsRef inputs = defined_by->GetInputs();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!locations->InAt(i).IsValid()) {
+      continue;
+    }
+    LiveInterval* interval = inputs[i]->GetLiveInterval();
+    while (interval != nullptr && !interval->CoversSlow(position)) {
+      interval = interval->GetNextSibling();
+    }
+    if (interval == input) {
+      return true;
+    }
+  }
+  return false;
+}
+
+RegisterAllocatorGraphColor::RegisterAllocatorGraphColor(ScopedArenaAllocator* allocator,
+                                                         CodeGenerator* codegen,
+                                                         const SsaLivenessAnalysis& liveness)
+      : RegisterAllocator(allocator, codegen, liveness),
+        core_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        fp_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        precolored_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        physical_core_register_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        physical_fp_register_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        block_registers_for_call_interval_(
+            LiveInterval::MakeFixedInterval(allocator, kNoRegister, DataType::Type::kVoid)),
+        block_registers_special_interval_(
+            LiveInterval::MakeFixedInterval(allocator, kNoRegister, DataType::Type::kVoid)),
+        temp_intervals_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        int_spill_slots_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        long_spill_slots_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        float_spill_slots_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        double_spill_slots_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        catch_phi_spill_slots_(0),
+        safepoints_(allocator->Adapter(kArenaAllocRegisterAllocator)),
+        reserved_out_slots_(0),
+        bailed_out_(false),
+        max_coloring_rounds_(kMaxColoringRounds) {
+  temp_intervals_.reserve(4);
+  int_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
+  long_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
+  float_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
+  double_spill_slots_.reserve(kDefaultNumberOfSpillSlots);
+
+  codegen->SetupBlockedRegisters();
+  physical_core_register_intervals_.resize(codegen->GetNumberOfCoreRegisters(), nullptr);
+  physical_fp_register_intervals_.resize(codegen->GetNumberOfFloatingPointRegisters(), nullptr);
+  // Always reserve for the current method and the graph's max out registers.
+  // ArtMethod* takes 2 vregs for 64 bits.
+  size_t ptr_size = static_cast<size_t>(InstructionSetPointerSize(codegen->GetInstructionSet()));
+  reserved_out_slots_ = ptr_size / kVRegSize + codegen->GetGraph()->GetMaximumNumberOfOutVRegs();
+}
+
+RegisterAllocatorGraphColor::~RegisterAllocatorGraphColor() {}
+
+bool RegisterAllocatorGraphColor::CanAllocateRegistersFor(const HGraph& graph,
+                                                          const CodeGenerator& codegen) {
+  bool fp_temps_need_two_registers = codegen.NeedsTwoRegisters(DataType::Type::kFloat64);
+  for (HBasicBlock* block : graph.GetLinearOrder()) {
+    for (HInstructionIterator it(block->GetPhis()); !it.Done(); it.Advance()) {
+      if (codegen.NeedsTwoRegisters(it.Current()->GetType())) {
+        return false;
+      }
+    }
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      if (codegen.NeedsTwoRegisters(instruction->GetType())) {
+        return false;
+      }
+      LocationSummary* locations = instruction->GetLocations();
+      if (fp_temps_need_two_registers && locations != nullptr) {
+        for (size_t i = 0; i < locations->GetTempCount(); ++i) {
+          Location temp = locations->GetTemp(i);
+          if (temp.IsUnallocated() && temp.GetPolicy() == Location::kRequiresFpuRegister) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void RegisterAllocatorGraphColor::AllocateRegisters() {
+  ProcessInstructions();
+  if (!ColorIntervals(&core_intervals_, RegisterType::kCoreRegister) ||
+      !ColorIntervals(&fp_intervals_, RegisterType::kFpRegister)) {
+    bailed_out_ = true;
+    return;
+  }
+  AllocateSpillSlots();
+
+  RegisterAllocationResolver(codegen_, liveness_)
+      .Resolve(ArrayRef<HInstruction* const>(safepoints_),
+               reserved_out_slots_,
+               int_spill_slots_.size(),
+               long_spill_slots_.size(),
+               float_spill_slots_.size(),
+               double_spill_slots_.size(),
+               catch_phi_spill_slots_,
+               ArrayRef<LiveInterval* const>(temp_intervals_));
+
+  if (kIsDebugBuild) {
+    ValidateInternal(RegisterType::kCoreRegister, /* log_fatal_on_failure= */ true);
+    ValidateInternal(RegisterType::kFpRegister, /* log_fatal_on_failure= */ true);
+  }
+}
+
+void RegisterAllocatorGraphColor::ProcessInstructions() {
+  for (HBasicBlock* block : codegen_->GetGraph()->GetLinearPostOrder()) {
+    // Note that we currently depend on this ordering, since some helper
+    // code is designed for linear scan register allocation.
+    for (HBackwardInstructionIterator back_it(block->GetInstructions()); !back_it.Done();
+         back_it.Advance()) {
+      ProcessInstruction(back_it.Current());
+    }
+    for (HInstructionIterator inst_it(block->GetPhis()); !inst_it.Done(); inst_it.Advance()) {
+      ProcessInstruction(inst_it.Current());
+    }
+
+    if (block->IsCatchBlock() ||
+        (block->IsLoopHeader() && block->GetLoopInformation()->IsIrreducible())) {
+      // By blocking all registers at the top of each catch block or irreducible loop, we force
+      // intervals belonging to the live-in set of the catch/header block to be spilled.
+      size_t position = block->GetLifetimeStart();
+      DCHECK_EQ(liveness_.GetInstructionFromPosition(position / 2u), nullptr);
+      block_registers_special_interval_->AddRange(position, position + 1u);
+    }
+  }
+}
+
+void RegisterAllocatorGraphColor::ProcessInstruction(HInstruction* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+
+  // Check for early returns.
+  if (locations == nullptr) {
+    return;
+  }
+  if (TryRemoveSuspendCheckEntry(instruction)) {
+    return;
+  }
+
+  bool will_call = locations->WillCall();
+  if (will_call) {
+    // If a call will happen, add the range to a fixed interval that represents all the
+    // caller-save registers blocked at call sites.
+    const size_t position = instruction->GetLifetimePosition();
+    DCHECK_NE(liveness_.GetInstructionFromPosition(position / 2u), nullptr);
+    block_registers_for_call_interval_->AddRange(position, position + 1u);
+  }
+  CheckForTempLiveIntervals(instruction, will_call);
+  CheckForSafepoint(instruction);
+  CheckForFixedInputs(instruction, will_call);
+
+  LiveInterval* interval = instruction->GetLiveInterval();
+  if (interval == nullptr) {
+    return;
+  }
+
+  DCHECK(!codegen_->NeedsTwoRegisters(interval->GetType()));
+  ScopedArenaVector<LiveInterval*>& intervals =
+      (GetRegisterType(interval) == RegisterType::kCoreRegister) ? core_intervals_ : fp_intervals_;
+
+  AddSafepointsFor(instruction);
+  CheckForFixedOutput(instruction, will_call);
+
+  if (instruction->IsPhi() && instruction->AsPhi()->IsCatchPhi()) {
+    AllocateSpillSlotForCatchPhi(instruction->AsPhi());
+  }
+
+  if (interval->HasSpillSlot() || instruction->IsConstant()) {
+    // Split just before first register use.
+    size_t first_register_use = interval->FirstRegisterUse();
+    if (first_register_use != kNoLifetime) {
+      intervals.push_back(SplitBetween(interval, interval->GetStart(), first_register_use - 1));
+    } else {
+      // Nothing to do, we won't allocate a register for this value.
+    }
+  } else if (interval->HasRegister()) {
+    // The output is in a fixed register. Only keep that register at the definition, so
+    // that the rest of the interval is not constrained.
+    precolored_intervals_.push_back(interval);
+    TrySplit(interval, interval->GetStart() + 1u, &intervals);
+  } else {
+    intervals.push_back(interval);
+  }
+}
+
+bool RegisterAllocatorGraphColor::TryRemoveSuspendCheckEntry(HInstruction* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  if (instruction->IsSuspendCheckEntry() && !codegen_->NeedsSuspendCheckEntry()) {
+    // Remove the suspend check now, so that it does not create live registers.
+    DCHECK_EQ(locations->GetTempCount(), 0u);
+    instruction->GetBlock()->RemoveInstruction(instruction);
+    return true;
+  }
+  return false;
+}
+
+void RegisterAllocatorGraphColor::CheckForTempLiveIntervals(HInstruction* instruction,
+                                                            bool will_call) {
+  LocationSummary* locations = instruction->GetLocations();
+  size_t position = instruction->GetLifetimePosition();
+
+  // Create synthesized intervals for temporaries.
+  for (size_t i = 0; i < locations->GetTempCount(); ++i) {
+    Location temp = locations->GetTemp(i);
+    if (temp.IsRegister() || temp.IsFpuRegister()) {
+      BlockRegister(temp, position, will_call);
+      // Ensure that an explicit temporary register is marked as being allocated.
+      codegen_->AddAllocatedRegister(temp);
+    } else {
+      DCHECK(temp.IsUnallocated());
+      switch (temp.GetPolicy()) {
+        case Location::kRequiresRegister: {
+          LiveInterval* interval =
+              LiveInterval::MakeTempInterval(allocator_, DataType::Type::kInt32);
+          temp_intervals_.push_back(interval);
+          interval->AddTempUse(instruction, i);
+          core_intervals_.push_back(interval);
+          break;
+        }
+
+        case Location::kRequiresFpuRegister: {
+          LiveInterval* interval =
+              LiveInterval::MakeTempInterval(allocator_, DataType::Type::kFloat64);
+          temp_intervals_.push_back(interval);
+          interval->AddTempUse(instruction, i);
+          DCHECK(!codegen_->NeedsTwoRegisters(DataType::Type::kFloat64));
+          fp_intervals_.push_back(interval);
+          break;
+        }
+
+        default:
+          LOG(FATAL) << "Unexpected policy for temporary location " << temp.GetPolicy();
+      }
+    }
+  }
+}
+
+void RegisterAllocatorGraphColor::CheckForSafepoint(HInstruction* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  if (locations->NeedsSafepoint()) {
+    safepoints_.push_back(instruction);
+  }
+}
+
+void RegisterAllocatorGraphColor::CheckForFixedInputs(HInstruction* instruction, bool will_call) {
+  LocationSummary* locations = instruction->GetLocations();
+  size_t position = instruction->GetLifetimePosition();
+  for (size_t i = 0; i < locations->GetInputCount(); ++i) {
+    Location input = locations->InAt(i);
+    if (input.IsRegister() || input.IsFpuRegister()) {
+      BlockRegister(input, position, will_call);
+      // Ensure that an explicit input register is marked as being allocated.
+      codegen_->AddAllocatedRegister(input);
+    } else {
+      DCHECK(!input.IsPair());
+    }
+  }
+}
+
+void RegisterAllocatorGraphColor::AddSafepointsFor(HInstruction* instruction) {
+  LiveInterval* current = instruction->GetLiveInterval();
+  for (size_t safepoint_index = safepoints_.size(); safepoint_index > 0; --safepoint_index) {
+    HInstruction* safepoint = safepoints_[safepoint_index - 1u];
+    size_t safepoint_position = SafepointPosition::ComputePosition(safepoint);
+
+    // Test that safepoints are ordered in the optimal way.
+    DCHECK(safepoint_index == safepoints_.size() ||
+           safepoints_[safepoint_index]->GetLifetimePosition() < safepoint_position);
+
+    if (safepoint_position == current->GetStart()) {
+      // The safepoint is for this instruction, so the location of the instruction
+      // does not need to be saved.
+      DCHECK_EQ(safepoint_index, safepoints_.size());
+      DCHECK_EQ(safepoint, instruction);
+      continue;
+    } else if (current->IsDeadAt(safepoint_position)) {
+      break;
+    } else if (!current->CoversSlow(safepoint_position)) {
+      // Hole in the interval.
+      continue;
+    }
+    current->AddSafepoint(safepoint);
+  }
+}
+
+void RegisterAllocatorGraphColor::CheckForFixedOutput(HInstruction* instruction, bool will_call) {
+  LocationSummary* locations = instruction->GetLocations();
+  size_t position = instruction->GetLifetimePosition();
+  LiveInterval* current = instruction->GetLiveInterval();
+  // Some instructions define their output in fixed register/stack slot. We need
+  // to ensure we know these locations before doing register allocation. For a
+  // given register, we create an interval that covers these locations. The register
+  // will be unavailable at these locations when trying to allocate one for an
+  // interval.
+  //
+  // The backwards walking ensures the ranges are ordered on increasing start positions.
+  Location output = locations->Out();
+  if (output.IsUnallocated() && output.GetPolicy() == Location::kSameAsFirstInput) {
+    Location first = locations->InAt(0);
+    if (first.IsRegister() || first.IsFpuRegister()) {
+      current->SetFrom(position + 1u);
+      current->SetRegister(first.reg());
+    } else {
+      DCHECK(!first.IsPair());
+    }
+  } else if (output.IsRegister() || output.IsFpuRegister()) {
+    // Shift the interval's start by one to account for the blocked register.
+    current->SetFrom(position + 1u);
+    current->SetRegister(output.reg());
+    BlockRegister(output, position, will_call);
+    // Ensure that an explicit output register is marked as being allocated.
+    codegen_->AddAllocatedRegister(output);
+  } else if (output.IsStackSlot() || output.IsDoubleStackSlot()) {
+    current->SetSpillSlot(output.GetStackIndex());
+  } else {
+    DCHECK(output.IsUnallocated() || output.IsConstant());
+  }
+}
+
+void RegisterAllocatorGraphColor::BlockRegister(Location location,
+                                                size_t position,
+                                                bool will_call) {
+  DCHECK(location.IsRegister() || location.IsFpuRegister());
+  int reg = location.reg();
+  if (will_call) {
+    uint32_t registers_blocked_for_call =
+        location.IsRegister() ? core_registers_blocked_for_call_ : fp_registers_blocked_for_call_;
+    if ((registers_blocked_for_call & (1u << reg)) != 0u) {
+      // Register is already marked as blocked by the `block_registers_for_call_interval_`.
+      return;
+    }
+  }
+  LiveInterval* interval = location.IsRegister()
+      ? physical_core_register_intervals_[reg]
+      : physical_fp_register_intervals_[reg];
+  DataType::Type type = location.IsRegister()
+      ? DataType::Type::kInt32
+      : DataType::Type::kFloat32;
+  if (interval == nullptr) {
+    interval = LiveInterval::MakeFixedInterval(allocator_, reg, type);
+    if (location.IsRegister()) {
+      physical_core_register_intervals_[reg] = interval;
+    } else {
+      physical_fp_register_intervals_[reg] = interval;
+    }
+  }
+  DCHECK(interval->GetRegister() == reg);
+  interval->AddRange(position, position + 1u);
+}
+
+bool RegisterAllocatorGraphColor::ColorIntervals(ScopedArenaVector<LiveInterval*>* intervals,
+                                                 RegisterType register_type) {
+  // Note that splitting intervals allocates from `allocator_`, so we cannot use
+  // a nested allocator for the data structures of a coloring round.
+  ScopedArenaVector<LiveInterval*> failed(allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (size_t round = 0u; round != max_coloring_rounds_; ++round) {
+    failed.clear();
+    if (TryColorIntervals(ArrayRef<LiveInterval* const>(*intervals), register_type, &failed)) {
+      return true;
+    }
+    if (failed.empty()) {
+      return false;
+    }
+    for (LiveInterval* interval : failed) {
+      // Splitting at loop boundaries lets the part of the interval in a loop keep
+      // a register, with the spill and reload code out of the loop.
+      if (round >= kMaxRoundsSplittingAtLoopBoundaries ||
+          !SplitAtLoopBoundaries(interval, intervals)) {
+        SplitAtRegisterUses(interval, intervals);
+      }
+    }
+  }
+  return false;
+}
+
+bool RegisterAllocatorGraphColor::TryColorIntervals(ArrayRef<LiveInterval* const> intervals,
+                                                    RegisterType register_type,
+                                                    ScopedArenaVector<LiveInterval*>* failed) {
+  ScopedArenaVector<InterferenceNode*> nodes(allocator_->Adapter(kArenaAllocRegisterAllocator));
+  nodes.reserve(precolored_intervals_.size() + intervals.size());
+  for (LiveInterval* interval : precolored_intervals_) {
+    if (GetRegisterType(interval) == register_type) {
+      nodes.push_back(new (allocator_) InterferenceNode(interval,
+                                                        InterferenceNode::Kind::kPrecolored,
+                                                        nodes.size(),
+                                                        /* requires_register= */ true,
+                                                        /* spill_weight= */ 0.0f,
+                                                        allocator_));
+    }
+  }
+  for (LiveInterval* interval : intervals) {
+    DCHECK(GetRegisterType(interval) == register_type);
+    interval->ClearRegister();
+    bool requires_register = interval->RequiresRegister();
+    InterferenceNode::Kind kind =
+        (requires_register && (interval->IsTemp() || interval->GetLength() <= 2u))
+            ? InterferenceNode::Kind::kMinimal
+            : InterferenceNode::Kind::kDeferred;
+    float spill_weight = interval->IsTemp() ? 0.0f : ComputeSpillWeight(interval);
+    nodes.push_back(new (allocator_) InterferenceNode(
+        interval, kind, nodes.size(), requires_register, spill_weight, allocator_));
+  }
+  BuildInterferenceGraph(ArrayRef<InterferenceNode* const>(nodes), register_type);
+
+  ScopedArenaVector<InterferenceNode*> minimal_nodes(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  ScopedArenaVector<InterferenceNode*> deferred_nodes(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (InterferenceNode* node : nodes) {
+    if (node->GetKind() == InterferenceNode::Kind::kMinimal) {
+      minimal_nodes.push_back(node);
+    } else if (node->GetKind() == InterferenceNode::Kind::kDeferred) {
+      deferred_nodes.push_back(node);
+    }
+  }
+
+  // Color the intervals that cannot be split first, the most constrained ones first.
+  // They are short enough that they interfere mostly with each other, so coloring them
+  // in order of start position is close to optimal.
+  uint32_t allocatable_registers = GetAllocatableRegisters(*codegen_, register_type);
+  std::sort(minimal_nodes.begin(),
+            minimal_nodes.end(),
+            [allocatable_registers](InterferenceNode* lhs, InterferenceNode* rhs) {
+              size_t lhs_start = lhs->GetInterval()->GetStart();
+              size_t rhs_start = rhs->GetInterval()->GetStart();
+              if (lhs_start != rhs_start) {
+                return lhs_start < rhs_start;
+              }
+              size_t lhs_count = POPCOUNT(allocatable_registers & ~lhs->GetBlockedRegisters());
+              size_t rhs_count = POPCOUNT(allocatable_registers & ~rhs->GetBlockedRegisters());
+              if (lhs_count != rhs_count) {
+                return lhs_count < rhs_count;
+              }
+              return lhs->GetId() < rhs->GetId();
+            });
+  for (InterferenceNode* node : minimal_nodes) {
+    if (!ColorNode(node, register_type)) {
+      // Too many fixed registers around this interval. It cannot be split, so give up.
+      DCHECK(failed->empty());
+      return false;
+    }
+  }
+
+  // Compute the degree of the other nodes, and the number of registers left to them.
+  for (InterferenceNode* node : deferred_nodes) {
+    uint32_t available_registers = allocatable_registers & ~node->GetBlockedRegisters();
+    size_t degree = 0u;
+    for (InterferenceNode* adjacent : node->GetAdjacentNodes()) {
+      if (adjacent->GetKind() == InterferenceNode::Kind::kDeferred) {
+        ++degree;
+      } else {
+        DCHECK(adjacent->GetInterval()->HasRegister());
+        available_registers &= ~(1u << adjacent->GetInterval()->GetRegister());
+      }
+    }
+    node->SetDegree(degree);
+    node->SetAvailableCount(POPCOUNT(available_registers));
+  }
+
+  // Simplify: remove low degree nodes, which are guaranteed to get a color, and push
+  // them on a stack. When there is none, optimistically remove the best spill candidate:
+  // intervals not requiring a register first, then the ones with the lowest spill weight.
+  ScopedArenaVector<InterferenceNode*> spill_candidates(
+      deferred_nodes.begin(),
+      deferred_nodes.end(),
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  std::sort(spill_candidates.begin(),
+            spill_candidates.end(),
+            [](InterferenceNode* lhs, InterferenceNode* rhs) {
+              if (lhs->RequiresRegister() != rhs->RequiresRegister()) {
+                return rhs->RequiresRegister();
+              }
+              if (lhs->GetSpillWeight() != rhs->GetSpillWeight()) {
+                return lhs->GetSpillWeight() < rhs->GetSpillWeight();
+              }
+              return lhs->GetId() < rhs->GetId();
+            });
+  ScopedArenaVector<InterferenceNode*> low_degree_nodes(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (InterferenceNode* node : deferred_nodes) {
+    if (node->IsLowDegree()) {
+      low_degree_nodes.push_back(node);
+    }
+  }
+  ScopedArenaVector<InterferenceNode*> stack(allocator_->Adapter(kArenaAllocRegisterAllocator));
+  stack.reserve(deferred_nodes.size());
+  auto remove_node = [&](InterferenceNode* node) {
+    node->SetRemoved();
+    stack.push_back(node);
+    for (InterferenceNode* adjacent : node->GetAdjacentNodes()) {
+      if (adjacent->GetKind() == InterferenceNode::Kind::kDeferred &&
+          !adjacent->IsRemoved() &&
+          adjacent->DecrementDegree()) {
+        low_degree_nodes.push_back(adjacent);
+      }
+    }
+  };
+  auto spill_candidate_it = spill_candidates.begin();
+  while (stack.size() != deferred_nodes.size()) {
+    if (!low_degree_nodes.empty()) {
+      InterferenceNode* node = low_degree_nodes.back();
+      low_degree_nodes.pop_back();
+      if (!node->IsRemoved()) {
+        remove_node(node);
+      }
+    } else {
+      while ((*spill_candidate_it)->IsRemoved()) {
+        ++spill_candidate_it;
+      }
+      remove_node(*spill_candidate_it);
+    }
+  }
+
+  // Select: color nodes in the reverse order of their removal.
+  bool successful = true;
+  for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+    InterferenceNode* node = *it;
+    if (!ColorNode(node, register_type) && node->RequiresRegister()) {
+      failed->push_back(node->GetInterval());
+      successful = false;
+    }
+  }
+  return successful;
+}
+
+void RegisterAllocatorGraphColor::BuildInterferenceGraph(ArrayRef<InterferenceNode* const> nodes,
+                                                         RegisterType register_type) {
+  ScopedArenaVector<LiveInterval*> fixed_intervals(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (LiveInterval* block_registers_interval : { block_registers_for_call_interval_,
+                                                  block_registers_special_interval_ }) {
+    if (block_registers_interval->GetFirstRange() != nullptr) {
+      fixed_intervals.push_back(block_registers_interval);
+    }
+  }
+  const ScopedArenaVector<LiveInterval*>& physical_register_intervals =
+      (register_type == RegisterType::kCoreRegister)
+          ? physical_core_register_intervals_
+          : physical_fp_register_intervals_;
+  for (LiveInterval* fixed : physical_register_intervals) {
+    if (fixed != nullptr) {
+      fixed_intervals.push_back(fixed);
+    }
+  }
+
+  // Sort the boundaries of all live ranges. At the same position, ranges end
+  // before others start since they are half-open.
+  ScopedArenaVector<LiveRangeBoundary> boundaries(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (size_t i = 0; i < fixed_intervals.size(); ++i) {
+    for (LiveRange* range = fixed_intervals[i]->GetFirstRange();
+         range != nullptr;
+         range = range->GetNext()) {
+      boundaries.push_back({range->GetStart(), /* is_start= */ true, /* is_fixed= */ true, i});
+      boundaries.push_back({range->GetEnd(), /* is_start= */ false, /* is_fixed= */ true, i});
+    }
+  }
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    for (LiveRange* range = nodes[i]->GetInterval()->GetFirstRange();
+         range != nullptr;
+         range = range->GetNext()) {
+      boundaries.push_back({range->GetStart(), /* is_start= */ true, /* is_fixed= */ false, i});
+      boundaries.push_back({range->GetEnd(), /* is_start= */ false, /* is_fixed= */ false, i});
+    }
+  }
+  std::sort(boundaries.begin(),
+            boundaries.end(),
+            [](const LiveRangeBoundary& lhs, const LiveRangeBoundary& rhs) {
+              if (lhs.position != rhs.position) {
+                return lhs.position < rhs.position;
+              }
+              return !lhs.is_start && rhs.is_start;
+            });
+
+  // Sweep over the boundaries, keeping track of the live nodes and of the registers
+  // blocked by live fixed intervals.
+  size_t number_of_registers = (register_type == RegisterType::kCoreRegister)
+      ? num_core_registers_
+      : num_fp_registers_;
+  ScopedArenaVector<size_t> fixed_register_counts(
+      number_of_registers, 0u, allocator_->Adapter(kArenaAllocRegisterAllocator));
+  uint32_t live_fixed_registers = 0u;
+  ScopedArenaVector<InterferenceNode*> live_nodes(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (const LiveRangeBoundary& boundary : boundaries) {
+    if (boundary.is_fixed) {
+      uint32_t register_mask = GetRegisterMask(fixed_intervals[boundary.index], register_type);
+      for (uint32_t reg : LowToHighBits(register_mask)) {
+        if (boundary.is_start) {
+          if (fixed_register_counts[reg]++ == 0u) {
+            live_fixed_registers |= 1u << reg;
+          }
+        } else {
+          DCHECK_NE(fixed_register_counts[reg], 0u);
+          if (--fixed_register_counts[reg] == 0u) {
+            live_fixed_registers &= ~(1u << reg);
+          }
+        }
+      }
+      if (boundary.is_start) {
+        for (InterferenceNode* live_node : live_nodes) {
+          live_node->BlockRegisters(register_mask);
+        }
+      }
+    } else {
+      InterferenceNode* node = nodes[boundary.index];
+      if (boundary.is_start) {
+        node->BlockRegisters(live_fixed_registers);
+        LiveInterval* interval = node->GetInterval();
+        for (InterferenceNode* live_node : live_nodes) {
+          LiveInterval* live_interval = live_node->GetInterval();
+          if (!CanShareInputRegister(interval, live_interval, boundary.position) &&
+              !CanShareInputRegister(live_interval, interval, boundary.position)) {
+            node->AddInterference(live_node);
+            live_node->AddInterference(node);
+          }
+        }
+        node->SetLiveIndex(live_nodes.size());
+        live_nodes.push_back(node);
+      } else {
+        // Remove the node by moving the last live node in its place.
+        size_t index = node->GetLiveIndex();
+        DCHECK_EQ(live_nodes[index], node);
+        live_nodes[index] = live_nodes.back();
+        live_nodes[index]->SetLiveIndex(index);
+        live_nodes.pop_back();
+      }
+    }
+  }
+  DCHECK(live_nodes.empty());
+
+  for (InterferenceNode* node : nodes) {
+    node->RemoveDuplicateInterferences();
+  }
+}
+
+bool RegisterAllocatorGraphColor::ColorNode(InterferenceNode* node, RegisterType register_type) {
+  LiveInterval* interval = node->GetInterval();
+  DCHECK(!interval->HasRegister());
+  uint32_t free_registers =
+      GetAllocatableRegisters(*codegen_, register_type) & ~node->GetBlockedRegisters();
+  for (InterferenceNode* adjacent : node->GetAdjacentNodes()) {
+    if (adjacent->GetInterval()->HasRegister()) {
+      free_registers &= ~(1u << adjacent->GetInterval()->GetRegister());
+    }
+  }
+  if (free_registers == 0u) {
+    return false;
+  }
+
+  // Prefer the register of an adjacent sibling, which avoids a move between them.
+  int reg = kNoRegister;
+  for (LiveInterval* sibling = interval->GetParent();
+       sibling != nullptr && reg == kNoRegister;
+       sibling = sibling->GetNextSibling()) {
+    if (sibling != interval &&
+        sibling->HasRegister() &&
+        (sibling->GetEnd() == interval->GetStart() || interval->GetEnd() == sibling->GetStart()) &&
+        (free_registers & (1u << sibling->GetRegister())) != 0u) {
+      reg = sibling->GetRegister();
+    }
+  }
+
+  // Then the register of a phi, input or user of the interval.
+  if (reg == kNoRegister) {
+    size_t free_until[BitSizeOf<uint32_t>()];
+    for (size_t i = 0; i < BitSizeOf<uint32_t>(); ++i) {
+      free_until[i] = ((free_registers & (1u << i)) != 0u) ? kMaxLifetimePosition : 0u;
+    }
+    reg = interval->FindFirstRegisterHint(free_until, liveness_);
+  }
+
+  // Otherwise, prefer caller-save registers for intervals that do not span a call,
+  // and small register numbers which have shorter encodings on some platforms.
+  if (reg == kNoRegister) {
+    uint32_t caller_save_registers = (register_type == RegisterType::kCoreRegister)
+        ? core_registers_blocked_for_call_
+        : fp_registers_blocked_for_call_;
+    uint32_t candidates = free_registers;
+    if (!interval->HasWillCallSafepoint() && (free_registers & caller_save_registers) != 0u) {
+      candidates &= caller_save_registers;
+    }
+    reg = CTZ(candidates);
+  }
+
+  DCHECK_NE(free_registers & (1u << reg), 0u);
+  interval->SetRegister(reg);
+  return true;
+}
+
+bool RegisterAllocatorGraphColor::SplitAtLoopBoundaries(
+    LiveInterval* interval, ScopedArenaVector<LiveInterval*>* intervals) {
+  HGraph* graph = codegen_->GetGraph();
+  if (!graph->HasLoops() || graph->HasIrreducibleLoops() || interval->IsTemp()) {
+    return false;
+  }
+
+  size_t start = interval->GetStart();
+  size_t end = interval->GetEnd();
+  HBasicBlock* start_block = liveness_.GetBlockFromPosition(start / 2u);
+  ScopedArenaVector<size_t> positions(allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (HBasicBlock* block : graph->GetLinearOrder()) {
+    size_t block_start = block->GetLifetimeStart();
+    if (block_start >= end) {
+      break;
+    }
+    if (block_start <= start || !block->IsLoopHeader()) {
+      continue;
+    }
+    // Find the outermost loop of this header that does not contain the start of
+    // the interval. Blocks of a loop are contiguous in the linear order.
+    HLoopInformation* outermost_loop = nullptr;
+    for (HLoopInformationOutwardIterator it(*block); !it.Done(); it.Advance()) {
+      if (it.Current()->Contains(*start_block)) {
+        break;
+      }
+      outermost_loop = it.Current();
+    }
+    if (outermost_loop == nullptr) {
+      continue;
+    }
+    size_t header_start = outermost_loop->GetHeader()->GetLifetimeStart();
+    if (interval->CoversSlow(header_start)) {
+      positions.push_back(header_start);
+    }
+    positions.push_back(outermost_loop->GetLifetimeEnd());
+  }
+  std::sort(positions.begin(), positions.end());
+  positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+  bool split = false;
+  for (size_t position : positions) {
+    LiveInterval* new_interval = TrySplit(interval, position, intervals);
+    if (new_interval != interval) {
+      interval = new_interval;
+      split = true;
+    }
+  }
+  return split;
+}
+
+void RegisterAllocatorGraphColor::SplitAtRegisterUses(
+    LiveInterval* interval, ScopedArenaVector<LiveInterval*>* intervals) {
+  DCHECK(!interval->IsTemp());
+
+  // Split just after a register definition.
+  if (!interval->IsSplit() &&
+      interval->GetDefinedBy() != nullptr &&
+      interval->DefinitionRequiresRegister()) {
+    interval = TrySplit(interval, interval->GetStart() + 1u, intervals);
+  }
+
+  // Split around register uses. Note that a use at the end of a sibling
+  // belongs to it, not to the next sibling.
+  size_t end = interval->GetEnd();
+  for (const UsePosition& use : interval->GetUses()) {
+    size_t position = use.GetPosition();
+    if (position > end) {
+      break;
+    }
+    if (position <= interval->GetStart() || !use.RequiresRegister()) {
+      continue;
+    }
+    interval = TrySplit(interval, position - 1u, intervals);
+    HInstruction* user = use.GetUser();
+    if (user->IsControlFlow()) {
+      // Moves cannot be inserted after a control flow instruction, split at the
+      // start of the next instruction or block instead.
+      interval = TrySplit(interval, user->GetLifetimePosition() + 2u, intervals);
+    } else {
+      interval = TrySplit(interval, position, intervals);
+    }
+  }
+}
+
+LiveInterval* RegisterAllocatorGraphColor::TrySplit(LiveInterval* interval,
+                                                    size_t position,
+                                                    ScopedArenaVector<LiveInterval*>* intervals) {
+  if (interval->GetStart() < position && position < interval->GetEnd()) {
+    LiveInterval* new_interval = Split(interval, position);
+    DCHECK_NE(new_interval, interval);
+    intervals->push_back(new_interval);
+    return new_interval;
+  }
+  return interval;
+}
+
+void RegisterAllocatorGraphColor::AllocateSpillSlots() {
+  ScopedArenaVector<LiveInterval*> spilled_intervals(
+      allocator_->Adapter(kArenaAllocRegisterAllocator));
+  for (const ScopedArenaVector<LiveInterval*>* intervals : { &core_intervals_, &fp_intervals_ }) {
+    for (LiveInterval* interval : *intervals) {
+      if (interval->HasRegister()) {
+        codegen_->AddAllocatedRegister(interval->IsFloatingPoint()
+            ? Location::FpuRegisterLocation(interval->GetRegister())
+            : Location::RegisterLocation(interval->GetRegister()));
+      } else {
+        DCHECK(!interval->IsTemp());
+        spilled_intervals.push_back(interval);
+      }
+    }
+  }
+
+  // Allocate spill slots in order of start position of the values, which lets
+  // values with disjoint lifetimes share slots.
+  std::sort(spilled_intervals.begin(),
+            spilled_intervals.end(),
+            [](LiveInterval* lhs, LiveInterval* rhs) {
+              return lhs->GetParent()->GetStart() < rhs->GetParent()->GetStart();
+            });
+  for (LiveInterval* interval : spilled_intervals) {
+    AllocateSpillSlotFor(interval);
+  }
+}
+
+void RegisterAllocatorGraphColor::AllocateSpillSlotFor(LiveInterval* interval) {
+  LiveInterval* parent = interval->GetParent();
+
+  // An instruction gets a spill slot for its entire lifetime. If the parent
+  // of this interval already has a spill slot, there is nothing to do.
+  if (parent->HasSpillSlot()) {
+    return;
+  }
+
+  HInstruction* defined_by = parent->GetDefinedBy();
+  DCHECK_IMPLIES(defined_by->IsPhi(), !defined_by->AsPhi()->IsCatchPhi());
+
+  if (defined_by->IsParameterValue()) {
+    // Parameters have their own stack slot.
+    parent->SetSpillSlot(codegen_->GetStackSlotOfParameter(defined_by->AsParameterValue()));
+    return;
+  }
+
+  if (defined_by->IsCurrentMethod()) {
+    parent->SetSpillSlot(0);
+    return;
+  }
+
+  if (defined_by->IsConstant()) {
+    // Constants don't need a spill slot.
+    return;
+  }
+
+  ScopedArenaVector<size_t>* spill_slots = nullptr;
+  switch (interval->GetType()) {
+    case DataType::Type::kFloat64:
+      spill_slots = &double_spill_slots_;
+      break;
+    case DataType::Type::kInt64:
+      spill_slots = &long_spill_slots_;
+      break;
+    case DataType::Type::kFloat32:
+      spill_slots = &float_spill_slots_;
+      break;
+    case DataType::Type::kReference:
+    case DataType::Type::kInt32:
+    case DataType::Type::kUint16:
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kBool:
+    case DataType::Type::kInt16:
+      spill_slots = &int_spill_slots_;
+      break;
+    case DataType::Type::kUint32:
+    case DataType::Type::kUint64:
+    case DataType::Type::kVoid:
+      LOG(FATAL) << "Unexpected type for interval " << interval->GetType();
+  }
+
+  // Find first available spill slots.
+  size_t number_of_spill_slots_needed = parent->NumberOfSpillSlotsNeeded();
+  size_t slot = 0;
+  for (size_t e = spill_slots->size(); slot < e; ++slot) {
+    bool found = true;
+    for (size_t s = slot, u = std::min(slot + number_of_spill_slots_needed, e); s < u; s++) {
+      if ((*spill_slots)[s] > parent->GetStart()) {
+        found = false;  // failure
+        break;
+      }
+    }
+    if (found) {
+      break;  // success
+    }
+  }
+
+  // Need new spill slots?
+  size_t upper = slot + number_of_spill_slots_needed;
+  if (upper > spill_slots->size()) {
+    spill_slots->resize(upper);
+  }
+  // Set slots to end.
+  size_t end = interval->GetLastSibling()->GetEnd();
+  for (size_t s = slot; s < upper; s++) {
+    (*spill_slots)[s] = end;
+  }
+
+  // Note that the exact spill slot location will be computed when we resolve,
+  // that is when we know the number of spill slots for each type.
+  parent->SetSpillSlot(slot);
+}
+
+void RegisterAllocatorGraphColor::AllocateSpillSlotForCatchPhi(HPhi* phi) {
+  LiveInterval* interval = phi->GetLiveInterval();
+
+  HInstruction* previous_phi = phi->GetPrevious();
+  DCHECK(previous_phi == nullptr || previous_phi->AsPhi()->GetRegNumber() <= phi->GetRegNumber())
+      << "Phis expected to be sorted by vreg number, so that equivalent phis are adjacent.";
+
+  if (phi->IsVRegEquivalentOf(previous_phi)) {
+    // This is an equivalent of the previous phi. We need to assign the same
+    // catch phi slot.
+    DCHECK(previous_phi->GetLiveInterval()->HasSpillSlot());
+    interval->SetSpillSlot(previous_phi->GetLiveInterval()->GetSpillSlot());
+  } else {
+    // Allocate a new spill slot for this catch phi. Slots are not shared between
+    // catch blocks, as catch phis are rare.
+    interval->SetSpillSlot(catch_phi_spill_slots_);
+    catch_phi_spill_slots_ += interval->NumberOfSpillSlotsNeeded();
+  }
+}
+
+bool RegisterAllocatorGraphColor::ValidateInternal(RegisterType register_type,
+                                                   bool log_fatal_on_failure) const {
+  auto should_process = [register_type](LiveInterval* interval) {
+    return interval != nullptr && GetRegisterType(interval) == register_type;
+  };
+
+  // To simplify unit testing, we eagerly create the array of intervals, and
+  // call the helper method.
+  ScopedArenaAllocator allocator(allocator_->GetArenaStack());
+  ScopedArenaVector<LiveInterval*> intervals(
+      allocator.Adapter(kArenaAllocRegisterAllocatorValidate));
+  for (size_t i = 0; i < liveness_.GetNumberOfSsaValues(); ++i) {
+    HInstruction* instruction = liveness_.GetInstructionFromSsaIndex(i);
+    if (should_process(instruction->GetLiveInterval())) {
+      intervals.push_back(instruction->GetLiveInterval());
+    }
+  }
+
+  for (LiveInterval* block_registers_interval : { block_registers_for_call_interval_,
+                                                  block_registers_special_interval_ }) {
+    if (block_registers_interval->GetFirstRange() != nullptr) {
+      intervals.push_back(block_registers_interval);
+    }
+  }
+  const ScopedArenaVector<LiveInterval*>& physical_register_intervals =
+      (register_type == RegisterType::kCoreRegister)
+          ? physical_core_register_intervals_
+          : physical_fp_register_intervals_;
+  for (LiveInterval* fixed : physical_register_intervals) {
+    if (fixed != nullptr) {
+      intervals.push_back(fixed);
+    }
+  }
+
+  for (LiveInterval* temp : temp_intervals_) {
+    if (should_process(temp)) {
+      intervals.push_back(temp);
+    }
+  }
+
+  return ValidateIntervals(ArrayRef<LiveInterval* const>(intervals),
+                           GetNumberOfSpillSlots(),
+                           reserved_out_slots_,
+                           *codegen_,
+                           &liveness_,
+                           register_type,
+                           log_fatal_on_failure);
+}
+
+}  // namespace art
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_GRAPH_COLOR_H_
+#define ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_GRAPH_COLOR_H_
+
+#include "arch/instruction_set.h"
+#include "base/array_ref.h"
+#include "base/macros.h"
+#include "base/scoped_arena_containers.h"
+#include "register_allocator.h"
+
+namespace art HIDDEN {
+
+class CodeGenerator;
+class HBasicBlock;
+class HGraph;
+class HInstruction;
+class HPhi;
+class InterferenceNode;
+class LiveInterval;
+class Location;
+class SsaLivenessAnalysis;
+
+/**
+ * A graph coloring register allocator on an `HGraph` with SSA form.
+ *
+ * Live intervals are the nodes of an interference graph, colored with the optimistic
+ * simplify/select heuristic of Chaitin-Briggs. Colors are biased towards register hints
+ * (adjacent siblings, phis, same-as-first-input outputs and fixed uses) to avoid moves.
+ * Intervals that require a register but cannot be colored are split, first at the
+ * boundaries of the loops they span and then around their register uses, and the graph
+ * is colored again. Intervals that do not require a register are spilled instead. If an
+ * interval that cannot be split does not get a register, or coloring takes too many
+ * rounds, the allocator bails out and the caller falls back to linear scan.
+ *
+ * Register pairs are not supported, see `CanAllocateRegistersFor()`.
+ */
+class RegisterAllocatorGraphColor : public RegisterAllocator {
+ public:
+  RegisterAllocatorGraphColor(ScopedArenaAllocator* allocator,
+                              CodeGenerator* codegen,
+                              const SsaLivenessAnalysis& analysis);
+  ~RegisterAllocatorGraphColor() override;
+
+  void AllocateRegisters() override;
+
+  Strategy GetStrategy() const override {
+    return kRegisterAllocatorGraphColor;
+  }
+
+  bool HasBailedOut() const override {
+    return bailed_out_;
+  }
+
+  bool Validate(bool log_fatal_on_failure) override {
+    return ValidateInternal(RegisterType::kCoreRegister, log_fatal_on_failure) &&
+           ValidateInternal(RegisterType::kFpRegister, log_fatal_on_failure);
+  }
+
+  // Returns whether this allocator supports `graph`, that is whether no value
+  // or temporary of the graph needs a register pair with `codegen`.
+  static bool CanAllocateRegistersFor(const HGraph& graph, const CodeGenerator& codegen);
+
+  size_t GetNumberOfSpillSlots() const {
+    return int_spill_slots_.size()
+        + long_spill_slots_.size()
+        + float_spill_slots_.size()
+        + double_spill_slots_.size()
+        + catch_phi_spill_slots_;
+  }
+
+ private:
+  // Collect the live intervals to color and the register constraints of all instructions.
+  void ProcessInstructions();
+  void ProcessInstruction(HInstruction* instruction);
+
+  // Try to remove the SuspendCheck at function entry. Returns true if it was successful.
+  bool TryRemoveSuspendCheckEntry(HInstruction* instruction);
+
+  // Collect all live intervals associated with the temporary locations
+  // needed by an instruction.
+  void CheckForTempLiveIntervals(HInstruction* instruction, bool will_call);
+
+  // If a safe point is needed, add a synthesized interval to later record
+  // the number of live registers at this point.
+  void CheckForSafepoint(HInstruction* instruction);
+
+  // If any inputs require specific registers, block those registers
+  // at the position of this instruction.
+  void CheckForFixedInputs(HInstruction* instruction, bool will_call);
+
+  // If the output of an instruction requires a specific register, assign
+  // that register to the interval and block it at the position of the instruction.
+  void CheckForFixedOutput(HInstruction* instruction, bool will_call);
+
+  // Add all applicable safepoints to a live interval.
+  // Currently depends on instruction processing order.
+  void AddSafepointsFor(HInstruction* instruction);
+
+  // Update the interval for the register in `location` to cover [position, position + 1).
+  void BlockRegister(Location location, size_t position, bool will_call);
+
+  // Color `*intervals`, splitting the intervals that cannot be colored and adding
+  // the new siblings to `*intervals`, until all intervals requiring a register have one.
+  // Returns false if that could not be done within `max_coloring_rounds_` rounds, or if an
+  // interval that cannot be split did not get a register.
+  bool ColorIntervals(ScopedArenaVector<LiveInterval*>* intervals, RegisterType register_type);
+
+  // Build the interference graph of `intervals` and color it. Returns whether all
+  // intervals requiring a register have been colored, and the ones that have not
+  // in `failed`. If `failed` is empty after a failure, an interval that cannot be
+  // split did not get a register.
+  bool TryColorIntervals(ArrayRef<LiveInterval* const> intervals,
+                         RegisterType register_type,
+                         ScopedArenaVector<LiveInterval*>* failed);
+
+  // Build the interference graph of `nodes`, including the registers blocked by
+  // fixed intervals at the positions covered by each node.
+  void BuildInterferenceGraph(ArrayRef<InterferenceNode* const> nodes,
+                              RegisterType register_type);
+
+  // Assign a register to `node` among the ones not used by its neighbors. Returns
+  // false if there is no such register.
+  bool ColorNode(InterferenceNode* node, RegisterType register_type);
+
+  // Split `interval` at the boundaries of the outermost loops it spans, so that
+  // the parts in and out of a loop can be colored independently. Returns whether
+  // the interval has been split.
+  bool SplitAtLoopBoundaries(LiveInterval* interval, ScopedArenaVector<LiveInterval*>* intervals);
+
+  // Split `interval` around its register definition and uses. The parts containing
+  // a register use cannot be split further.
+  void SplitAtRegisterUses(LiveInterval* interval, ScopedArenaVector<LiveInterval*>* intervals);
+
+  // Split `interval` at `position` if it is strictly inside the interval. Returns the
+  // new sibling, or `interval` if it has not been split.
+  LiveInterval* TrySplit(LiveInterval* interval,
+                         size_t position,
+                         ScopedArenaVector<LiveInterval*>* intervals);
+
+  // Allocate spill slots for the intervals that have not been assigned a register.
+  void AllocateSpillSlots();
+
+  // Allocate a spill slot for the given interval. Should be called in linear
+  // order of interval starting positions.
+  void AllocateSpillSlotFor(LiveInterval* interval);
+
+  // Allocate a spill slot for the given catch phi. Will allocate the same slot
+  // for phis which share the same vreg. Must be called in reverse linear order
+  // of lifetime positions and ascending vreg numbers for correctness.
+  void AllocateSpillSlotForCatchPhi(HPhi* phi);
+
+  bool ValidateInternal(RegisterType register_type, bool log_fatal_on_failure) const;
+
+  // Intervals to color, for core and floating-point registers respectively. Includes
+  // temporaries and the siblings created by splitting.
+  ScopedArenaVector<LiveInterval*> core_intervals_;
+  ScopedArenaVector<LiveInterval*> fp_intervals_;
+
+  // Intervals that have been assigned a register for their definition by the
+  // code generator. They take part in the interference graph but keep their register.
+  ScopedArenaVector<LiveInterval*> precolored_intervals_;
+
+  // Fixed intervals for physical registers. Such intervals cover the positions
+  // where an instruction requires a specific register.
+  ScopedArenaVector<LiveInterval*> physical_core_register_intervals_;
+  ScopedArenaVector<LiveInterval*> physical_fp_register_intervals_;
+  LiveInterval* block_registers_for_call_interval_;
+  LiveInterval* block_registers_special_interval_;  // For catch block or irreducible loop header.
+
+  // Intervals for temporaries. Such intervals cover the positions
+  // where an instruction requires a temporary.
+  ScopedArenaVector<LiveInterval*> temp_intervals_;
+
+  // The spill slots allocated for live intervals, see `RegisterAllocatorLinearScan`.
+  ScopedArenaVector<size_t> int_spill_slots_;
+  ScopedArenaVector<size_t> long_spill_slots_;
+  ScopedArenaVector<size_t> float_spill_slots_;
+  ScopedArenaVector<size_t> double_spill_slots_;
+
+  // Spill slots allocated to catch phis.
+  size_t catch_phi_spill_slots_;
+
+  // Instructions that need a safepoint.
+  ScopedArenaVector<HInstruction*> safepoints_;
+
+  // Slots reserved for out arguments.
+  size_t reserved_out_slots_;
+
+  // Whether coloring failed and no register has been allocated, see `HasBailedOut()`.
+  bool bailed_out_;
+
+  // Number of coloring rounds after which the allocator bails out. Lowered by tests.
+  size_t max_coloring_rounds_;
+
+  friend class RegisterAllocatorTest;
+
+  DISALLOW_COPY_AND_ASSIGN(RegisterAllocatorGraphColor);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_REGISTER_ALLOCATOR_GRAPH_COLOR_H_
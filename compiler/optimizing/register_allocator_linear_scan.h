@@ -46,6 +46,10 @@ class RegisterAllocatorLinearScan : public RegisterAllocator {
 
   void AllocateRegisters() override;
 
+  Strategy GetStrategy() const override {
+    return kRegisterAllocatorLinearScan;
+  }
+
   bool Validate(bool log_fatal_on_failure) override {
     current_register_type_ = RegisterType::kCoreRegister;
     if (!ValidateInternal(log_fatal_on_failure)) {
@@ -28,6 +28,7 @@
 #include "driver/compiler_options.h"
 #include "nodes.h"
 #include "optimizing_unit_test.h"
+#include "register_allocator_graph_color.h"
 #include "register_allocator_linear_scan.h"
 #include "ssa_liveness_analysis.h"
 #include "ssa_phi_elimination.h"
@@ -46,7 +47,6 @@ class RegisterAllocatorTest : public CommonCompilerTest, public OptimizingUnitTe
   }
 
   // Helper functions that make use of the OptimizingUnitTest's members.
-  bool Check(const std::vector<uint16_t>& data);
   HGraph* BuildIfElseWithPhi(HPhi** phi, HInstruction** input1, HInstruction** input2);
   HGraph* BuildFieldReturn(HInstruction** field, HInstruction** ret);
   HGraph* BuildTwoSubs(HInstruction** first_sub, HInstruction** second_sub);
@@ -63,18 +63,45 @@ class RegisterAllocatorTest : public CommonCompilerTest, public OptimizingUnitTe
                                                 /* log_fatal_on_failure= */ false);
   }
 
+  static void SetMaxColoringRounds(RegisterAllocatorGraphColor* register_allocator,
+                                   size_t max_coloring_rounds) {
+    register_allocator->max_coloring_rounds_ = max_coloring_rounds;
+  }
+
   std::unique_ptr<CompilerOptions> compiler_options_;
 };
 
-bool RegisterAllocatorTest::Check(const std::vector<uint16_t>& data) {
+// Tests run with each register allocation strategy.
+class RegisterAllocatorStrategyTest
+    : public RegisterAllocatorTest,
+      public ::testing::WithParamInterface<RegisterAllocator::Strategy> {
+ protected:
+  // Creates a register allocator for the strategy under test and allocates registers.
+  // Returns nullptr if the allocator does not implement that strategy or bails out.
+  std::unique_ptr<RegisterAllocator> AllocateRegisters(CodeGenerator* codegen,
+                                                       const SsaLivenessAnalysis& liveness) {
+    std::unique_ptr<RegisterAllocator> register_allocator =
+        RegisterAllocator::Create(GetScopedAllocator(), codegen, liveness, GetParam());
+    if (register_allocator->GetStrategy() != GetParam()) {
+      return nullptr;
+    }
+    register_allocator->AllocateRegisters();
+    if (register_allocator->HasBailedOut()) {
+      return nullptr;
+    }
+    return register_allocator;
+  }
+
+  bool Check(const std::vector<uint16_t>& data);
+};
+
+bool RegisterAllocatorStrategyTest::Check(const std::vector<uint16_t>& data) {
   HGraph* graph = CreateCFG(data);
   x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
   SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
   liveness.Analyze();
-  std::unique_ptr<RegisterAllocator> register_allocator =
-      RegisterAllocator::Create(GetScopedAllocator(), &codegen, liveness);
-  register_allocator->AllocateRegisters();
-  return register_allocator->Validate(false);
+  std::unique_ptr<RegisterAllocator> register_allocator = AllocateRegisters(&codegen, liveness);
+  return register_allocator != nullptr && register_allocator->Validate(false);
 }
 
 /**
@@ -155,7 +182,7 @@ TEST_F(RegisterAllocatorTest, ValidateIntervals) {
   }
 }
 
-TEST_F(RegisterAllocatorTest, CFG1) {
+TEST_P(RegisterAllocatorStrategyTest, CFG1) {
   /*
    * Test the following snippet:
    *  return 0;
@@ -175,7 +202,7 @@ TEST_F(RegisterAllocatorTest, CFG1) {
   ASSERT_TRUE(Check(data));
 }
 
-TEST_F(RegisterAllocatorTest, Loop1) {
+TEST_P(RegisterAllocatorStrategyTest, Loop1) {
   /*
    * Test the following snippet:
    *  int a = 0;
@@ -214,7 +241,7 @@ TEST_F(RegisterAllocatorTest, Loop1) {
   ASSERT_TRUE(Check(data));
 }
 
-TEST_F(RegisterAllocatorTest, Loop2) {
+TEST_P(RegisterAllocatorStrategyTest, Loop2) {
   /*
    * Test the following snippet:
    *  int a = 0;
@@ -263,7 +290,7 @@ TEST_F(RegisterAllocatorTest, Loop2) {
   ASSERT_TRUE(Check(data));
 }
 
-TEST_F(RegisterAllocatorTest, Loop3) {
+TEST_P(RegisterAllocatorStrategyTest, Loop3) {
   /*
    * Test the following snippet:
    *  int a = 0
@@ -304,9 +331,8 @@ TEST_F(RegisterAllocatorTest, Loop3) {
   x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
   SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
   liveness.Analyze();
-  std::unique_ptr<RegisterAllocator> register_allocator =
-      RegisterAllocator::Create(GetScopedAllocator(), &codegen, liveness);
-  register_allocator->AllocateRegisters();
+  std::unique_ptr<RegisterAllocator> register_allocator = AllocateRegisters(&codegen, liveness);
+  ASSERT_TRUE(register_allocator != nullptr);
   ASSERT_TRUE(register_allocator->Validate(false));
 
   HBasicBlock* loop_header = graph->GetBlocks()[2];
@@ -359,7 +385,7 @@ TEST_F(RegisterAllocatorTest, FirstRegisterUse) {
   ASSERT_EQ(new_interval->FirstRegisterUse(), last_xor->GetLifetimePosition());
 }
 
-TEST_F(RegisterAllocatorTest, DeadPhi) {
+TEST_P(RegisterAllocatorStrategyTest, DeadPhi) {
   /* Test for a dead loop phi taking as back-edge input a phi that also has
    * this loop phi as input. Walking backwards in SsaDeadPhiElimination
    * does not solve the problem because the loop phi will be visited last.
@@ -386,12 +412,50 @@ TEST_F(RegisterAllocatorTest, DeadPhi) {
   x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
   SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
   liveness.Analyze();
-  std::unique_ptr<RegisterAllocator> register_allocator =
-      RegisterAllocator::Create(GetScopedAllocator(), &codegen, liveness);
-  register_allocator->AllocateRegisters();
+  std::unique_ptr<RegisterAllocator> register_allocator = AllocateRegisters(&codegen, liveness);
+  ASSERT_TRUE(register_allocator != nullptr);
   ASSERT_TRUE(register_allocator->Validate(false));
 }
 
+TEST_F(RegisterAllocatorTest, GraphColorBailOut) {
+  /*
+   * Test that linear scan allocates registers after the graph coloring allocator
+   * bailed out, for the snippet of Loop2 whose suspend check has an environment.
+   */
+  const std::vector<uint16_t> data = TWO_REGISTERS_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::CONST_4 | 8 << 12 | 1 << 8,
+    Instruction::IF_EQ | 1 << 8, 7,
+    Instruction::CONST_4 | 4 << 12 | 0 << 8,
+    Instruction::CONST_4 | 5 << 12 | 1 << 8,
+    Instruction::ADD_INT, 1 << 8 | 0,
+    Instruction::GOTO | 0xFA00,
+    Instruction::CONST_4 | 6 << 12 | 1 << 8,
+    Instruction::CONST_4 | 7 << 12 | 1 << 8,
+    Instruction::ADD_INT, 1 << 8 | 0,
+    Instruction::RETURN | 1 << 8);
+
+  HGraph* graph = CreateCFG(data);
+  x86::CodeGeneratorX86 codegen(graph, *compiler_options_);
+  {
+    SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
+    liveness.Analyze();
+    RegisterAllocatorGraphColor register_allocator(GetScopedAllocator(), &codegen, liveness);
+    // Without any coloring round, the allocator bails out after processing the instructions.
+    SetMaxColoringRounds(&register_allocator, 0u);
+    register_allocator.AllocateRegisters();
+    ASSERT_TRUE(register_allocator.HasBailedOut());
+  }
+
+  RegisterAllocator::ClearLivenessData(graph);
+  SsaLivenessAnalysis liveness(graph, &codegen, GetScopedAllocator());
+  liveness.Analyze();
+  RegisterAllocatorLinearScan register_allocator(GetScopedAllocator(), &codegen, liveness);
+  register_allocator.AllocateRegisters();
+  ASSERT_FALSE(register_allocator.HasBailedOut());
+  ASSERT_TRUE(register_allocator.Validate(false));
+}
+
 /**
  * Test that the TryAllocateFreeReg method works in the presence of inactive intervals
  * that share the same register. It should split the interval it is currently
@@ -886,4 +950,9 @@ TEST_F(RegisterAllocatorTest, SpillInactive) {
   ASSERT_TRUE(ValidateIntervals(intervals, codegen));
 }
 
+INSTANTIATE_TEST_SUITE_P(RegisterAllocatorTest,
+                         RegisterAllocatorStrategyTest,
+                         testing::Values(RegisterAllocator::kRegisterAllocatorLinearScan,
+                                         RegisterAllocator::kRegisterAllocatorGraphColor));
+
 }  // namespace art
@@ -0,0 +1,427 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scheduler_x86_64.h"
+
+#include "code_generator_utils.h"
+#include "mirror/array-inl.h"
+#include "mirror/string.h"
+
+namespace art HIDDEN {
+namespace x86_64 {
+
+// x86-64 instruction latency.
+// The values model a recent out-of-order core (roughly Skylake or Zen 2 class). Such cores hide
+// most short latencies by themselves, so what matters is to start long-latency operations
+// (loads, divides, vector multiplies) early enough for their users not to stall the pipeline.
+static constexpr uint32_t kX86_64MemoryLoadLatency = 5;
+// Includes store-to-load forwarding for a following load from the same location.
+static constexpr uint32_t kX86_64MemoryStoreLatency = 4;
+
+static constexpr uint32_t kX86_64CallInternalLatency = 10;
+static constexpr uint32_t kX86_64CallLatency = 5;
+
+static constexpr uint32_t kX86_64IntegerOpLatency = 1;
+static constexpr uint32_t kX86_64FloatingPointOpLatency = 4;
+
+static constexpr uint32_t kX86_64DivDoubleLatency = 14;
+static constexpr uint32_t kX86_64DivFloatLatency = 11;
+static constexpr uint32_t kX86_64DivIntegerLatency = 26;
+static constexpr uint32_t kX86_64DivLongLatency = 40;
+static constexpr uint32_t kX86_64LoadStringInternalLatency = 2;
+static constexpr uint32_t kX86_64MulFloatingPointLatency = 4;
+static constexpr uint32_t kX86_64MulIntegerLatency = 3;
+// Floating point remainder is computed with an x87 `fprem` loop going through the stack.
+static constexpr uint32_t kX86_64RemFloatingPointLatency = 40;
+static constexpr uint32_t kX86_64TypeConversionFloatingPointIntegerLatency = 6;
+static constexpr uint32_t kX86_64BranchLatency = kX86_64IntegerOpLatency;
+
+static constexpr uint32_t kX86_64SIMDFloatingPointOpLatency = 4;
+static constexpr uint32_t kX86_64SIMDIntegerOpLatency = 1;
+static constexpr uint32_t kX86_64SIMDMemoryLoadLatency = 7;
+static constexpr uint32_t kX86_64SIMDMemoryStoreLatency = 4;
+static constexpr uint32_t kX86_64SIMDMulFloatingPointLatency = 4;
+static constexpr uint32_t kX86_64SIMDMulIntegerLatency = 10;
+static constexpr uint32_t kX86_64SIMDReduceLatency = 6;
+static constexpr uint32_t kX86_64SIMDReplicateOpLatency = 4;
+static constexpr uint32_t kX86_64SIMDDivDoubleLatency = 14;
+static constexpr uint32_t kX86_64SIMDDivFloatLatency = 11;
+static constexpr uint32_t kX86_64SIMDTypeConversionInt2FPLatency = 4;
+
+class SchedulingLatencyVisitorX86_64 final : public SchedulingLatencyVisitor {
+ public:
+  // Default visitor for instructions not handled specifically below.
+  void VisitInstruction([[maybe_unused]] HInstruction*) override {
+    last_visited_latency_ = kX86_64IntegerOpLatency;
+  }
+
+// We add a second unused parameter to be able to use this macro like the others
+// defined in `nodes.h`.
+#define FOR_EACH_SCHEDULED_COMMON_INSTRUCTION(M)     \
+  M(ArrayGet             , unused)                   \
+  M(ArrayLength          , unused)                   \
+  M(ArraySet             , unused)                   \
+  M(BoundsCheck          , unused)                   \
+  M(Div                  , unused)                   \
+  M(InstanceFieldGet     , unused)                   \
+  M(InstanceOf           , unused)                   \
+  M(LoadString           , unused)                   \
+  M(Mul                  , unused)                   \
+  M(NewArray             , unused)                   \
+  M(NewInstance          , unused)                   \
+  M(Rem                  , unused)                   \
+  M(StaticFieldGet       , unused)                   \
+  M(SuspendCheck         , unused)                   \
+  M(TypeConversion       , unused)                   \
+  M(VecReplicateScalar   , unused)                   \
+  M(VecExtractScalar     , unused)                   \
+  M(VecReduce            , unused)                   \
+  M(VecCnv               , unused)                   \
+  M(VecNeg               , unused)                   \
+  M(VecAbs               , unused)                   \
+  M(VecNot               , unused)                   \
+  M(VecAdd               , unused)                   \
+  M(VecHalvingAdd        , unused)                   \
+  M(VecSub               , unused)                   \
+  M(VecMul               , unused)                   \
+  M(VecDiv               , unused)                   \
+  M(VecMin               , unused)                   \
+  M(VecMax               , unused)                   \
+  M(VecAnd               , unused)                   \
+  M(VecAndNot            , unused)                   \
+  M(VecOr                , unused)                   \
+  M(VecXor               , unused)                   \
+  M(VecShl               , unused)                   \
+  M(VecShr               , unused)                   \
+  M(VecUShr              , unused)                   \
+  M(VecSetScalars        , unused)                   \
+  M(VecLoad              , unused)                   \
+  M(VecStore             , unused)
+
+#define FOR_EACH_SCHEDULED_ABSTRACT_INSTRUCTION(M)   \
+  M(BinaryOperation      , unused)                   \
+  M(Invoke               , unused)
+
+#define DECLARE_VISIT_INSTRUCTION(type, unused)  \
+  void Visit##type(H##type* instruction) override;
+
+  FOR_EACH_SCHEDULED_COMMON_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_SCHEDULED_ABSTRACT_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+
+#undef DECLARE_VISIT_INSTRUCTION
+
+ private:
+  void HandleSimpleArithmeticSIMD(HVecOperation *instr);
+  void HandleDivRemByConstant(HBinaryOperation* instr);
+};
+
+void SchedulingLatencyVisitorX86_64::VisitBinaryOperation(HBinaryOperation* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? kX86_64FloatingPointOpLatency
+      : kX86_64IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitArrayGet(HArrayGet* instruction) {
+  // x86-64 addressing modes fold the index computation into the load.
+  if (mirror::kUseStringCompression && instruction->IsStringCharAt()) {
+    // Load the count field and test the compression flag before loading the character.
+    last_visited_internal_latency_ = kX86_64MemoryLoadLatency + kX86_64BranchLatency;
+  }
+  last_visited_latency_ = kX86_64MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitArrayLength([[maybe_unused]] HArrayLength*) {
+  last_visited_latency_ = kX86_64MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitArraySet([[maybe_unused]] HArraySet*) {
+  last_visited_latency_ = kX86_64MemoryStoreLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitBoundsCheck([[maybe_unused]] HBoundsCheck*) {
+  last_visited_internal_latency_ = kX86_64IntegerOpLatency;
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorX86_64::HandleDivRemByConstant(HBinaryOperation* instr) {
+  // Follow the code path used by code generation.
+  int64_t imm = Int64FromConstant(instr->GetRight()->AsConstant());
+  if (imm == 0) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = 0;
+  } else if (imm == 1 || imm == -1) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = kX86_64IntegerOpLatency;
+  } else if (IsPowerOfTwo(AbsOrMin(imm))) {
+    last_visited_internal_latency_ = 3 * kX86_64IntegerOpLatency;
+    last_visited_latency_ = kX86_64IntegerOpLatency;
+  } else {
+    DCHECK(imm <= -2 || imm >= 2);
+    last_visited_internal_latency_ = kX86_64MulIntegerLatency + 3 * kX86_64IntegerOpLatency;
+    last_visited_latency_ = kX86_64IntegerOpLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitDiv(HDiv* instr) {
+  DataType::Type type = instr->GetResultType();
+  switch (type) {
+    case DataType::Type::kFloat32:
+      last_visited_latency_ = kX86_64DivFloatLatency;
+      break;
+    case DataType::Type::kFloat64:
+      last_visited_latency_ = kX86_64DivDoubleLatency;
+      break;
+    default:
+      if (instr->GetRight()->IsConstant()) {
+        HandleDivRemByConstant(instr);
+      } else {
+        last_visited_latency_ = (type == DataType::Type::kInt64)
+            ? kX86_64DivLongLatency
+            : kX86_64DivIntegerLatency;
+      }
+      break;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitInstanceFieldGet([[maybe_unused]] HInstanceFieldGet*) {
+  last_visited_latency_ = kX86_64MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitInstanceOf([[maybe_unused]] HInstanceOf*) {
+  last_visited_internal_latency_ = kX86_64CallInternalLatency;
+  last_visited_latency_ = kX86_64IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitInvoke([[maybe_unused]] HInvoke*) {
+  last_visited_internal_latency_ = kX86_64CallInternalLatency;
+  last_visited_latency_ = kX86_64CallLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitLoadString([[maybe_unused]] HLoadString*) {
+  last_visited_internal_latency_ = kX86_64LoadStringInternalLatency;
+  last_visited_latency_ = kX86_64MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitMul(HMul* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? kX86_64MulFloatingPointLatency
+      : kX86_64MulIntegerLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitNewArray([[maybe_unused]] HNewArray*) {
+  last_visited_internal_latency_ = kX86_64IntegerOpLatency + kX86_64CallInternalLatency;
+  last_visited_latency_ = kX86_64CallLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitNewInstance(HNewInstance* instruction) {
+  if (instruction->IsStringAlloc()) {
+    last_visited_internal_latency_ = 2 + kX86_64MemoryLoadLatency + kX86_64CallInternalLatency;
+  } else {
+    last_visited_internal_latency_ = kX86_64CallInternalLatency;
+  }
+  last_visited_latency_ = kX86_64CallLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitRem(HRem* instruction) {
+  DataType::Type type = instruction->GetResultType();
+  if (DataType::IsFloatingPointType(type)) {
+    last_visited_internal_latency_ = 2 * kX86_64MemoryStoreLatency;
+    last_visited_latency_ = kX86_64RemFloatingPointLatency;
+  } else if (instruction->GetRight()->IsConstant()) {
+    HandleDivRemByConstant(instruction);
+    if (last_visited_latency_ != 0u) {
+      // The remainder is computed from the quotient with a multiply and a subtract.
+      last_visited_internal_latency_ += kX86_64MulIntegerLatency;
+    }
+  } else {
+    last_visited_latency_ = (type == DataType::Type::kInt64)
+        ? kX86_64DivLongLatency
+        : kX86_64DivIntegerLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitStaticFieldGet([[maybe_unused]] HStaticFieldGet*) {
+  last_visited_latency_ = kX86_64MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitSuspendCheck(HSuspendCheck* instruction) {
+  HBasicBlock* block = instruction->GetBlock();
+  DCHECK_IMPLIES(block->GetLoopInformation() == nullptr,
+                 block->IsEntryBlock() && instruction->GetNext()->IsGoto());
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitTypeConversion(HTypeConversion* instr) {
+  if (DataType::IsFloatingPointType(instr->GetResultType()) ||
+      DataType::IsFloatingPointType(instr->GetInputType())) {
+    last_visited_latency_ = kX86_64TypeConversionFloatingPointIntegerLatency;
+  } else {
+    last_visited_latency_ = kX86_64IntegerOpLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::HandleSimpleArithmeticSIMD(HVecOperation *instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = kX86_64SIMDFloatingPointOpLatency;
+  } else {
+    last_visited_latency_ = kX86_64SIMDIntegerOpLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecReplicateScalar(
+    [[maybe_unused]] HVecReplicateScalar* instr) {
+  last_visited_latency_ = kX86_64SIMDReplicateOpLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecExtractScalar(HVecExtractScalar* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecReduce([[maybe_unused]] HVecReduce* instr) {
+  // Horizontal reductions are a chain of shuffles and adds.
+  last_visited_latency_ = kX86_64SIMDReduceLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecCnv([[maybe_unused]] HVecCnv* instr) {
+  last_visited_latency_ = kX86_64SIMDTypeConversionInt2FPLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecNeg(HVecNeg* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecAbs(HVecAbs* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecNot([[maybe_unused]] HVecNot* instr) {
+  // Materializing the all-ones (or boolean one) mask takes an extra instruction.
+  last_visited_internal_latency_ = kX86_64SIMDIntegerOpLatency;
+  last_visited_latency_ = kX86_64SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecAdd(HVecAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecHalvingAdd(HVecHalvingAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecSub(HVecSub* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecMul(HVecMul* instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = kX86_64SIMDMulFloatingPointLatency;
+  } else {
+    last_visited_latency_ = kX86_64SIMDMulIntegerLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecDiv(HVecDiv* instr) {
+  if (instr->GetPackedType() == DataType::Type::kFloat32) {
+    last_visited_latency_ = kX86_64SIMDDivFloatLatency;
+  } else {
+    DCHECK(instr->GetPackedType() == DataType::Type::kFloat64);
+    last_visited_latency_ = kX86_64SIMDDivDoubleLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecMin(HVecMin* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecMax(HVecMax* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecAnd([[maybe_unused]] HVecAnd* instr) {
+  last_visited_latency_ = kX86_64SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecAndNot([[maybe_unused]] HVecAndNot* instr) {
+  last_visited_latency_ = kX86_64SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecOr([[maybe_unused]] HVecOr* instr) {
+  last_visited_latency_ = kX86_64SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecXor([[maybe_unused]] HVecXor* instr) {
+  last_visited_latency_ = kX86_64SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecShl(HVecShl* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecShr(HVecShr* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecUShr(HVecUShr* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecSetScalars(HVecSetScalars* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecLoad(HVecLoad* instr) {
+  last_visited_internal_latency_ = 0;
+  if (instr->GetPackedType() == DataType::Type::kUint16
+      && mirror::kUseStringCompression
+      && instr->IsStringCharAt()) {
+    // Set latencies for the uncompressed case.
+    last_visited_internal_latency_ = kX86_64MemoryLoadLatency + kX86_64BranchLatency;
+  }
+  last_visited_latency_ = kX86_64SIMDMemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecStore([[maybe_unused]] HVecStore* instr) {
+  last_visited_latency_ = kX86_64SIMDMemoryStoreLatency;
+}
+
+bool HSchedulerX86_64::IsSchedulable(const HInstruction* instruction) const {
+  switch (instruction->GetKind()) {
+#define SCHEDULABLE_CASE(type, unused)       \
+    case HInstruction::InstructionKind::k##type:  \
+      return true;
+    FOR_EACH_CONCRETE_INSTRUCTION_X86_COMMON(SCHEDULABLE_CASE)
+    FOR_EACH_SCHEDULED_COMMON_INSTRUCTION(SCHEDULABLE_CASE)
+#undef SCHEDULABLE_CASE
+
+    default:
+      return HScheduler::IsSchedulable(instruction);
+  }
+}
+
+std::pair<SchedulingGraph, ScopedArenaVector<SchedulingNode*>>
+HSchedulerX86_64::BuildSchedulingGraph(
+    HBasicBlock* block,
+    ScopedArenaAllocator* allocator,
+    const HeapLocationCollector* heap_location_collector) {
+  SchedulingLatencyVisitorX86_64 latency_visitor;
+  return HScheduler::BuildSchedulingGraph(
+      block, allocator, heap_location_collector, &latency_visitor);
+}
+
+}  // namespace x86_64
+}  // namespace art
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_SCHEDULER_X86_64_H_
+#define ART_COMPILER_OPTIMIZING_SCHEDULER_X86_64_H_
+
+#include "base/macros.h"
+#include "scheduler.h"
+
+namespace art HIDDEN {
+namespace x86_64 {
+
+class HSchedulerX86_64 : public HScheduler {
+ public:
+  explicit HSchedulerX86_64(SchedulingNodeSelector* selector)
+      : HScheduler(selector) {}
+  ~HSchedulerX86_64() override {}
+
+  bool IsSchedulable(const HInstruction* instruction) const override;
+
+  // Treat as scheduling barriers those vector instructions whose live ranges exceed the vectorized
+  // loop boundaries. As on ARM64, the compiler has no notion of SIMD registers and all live XMM
+  // registers have to be saved/restored around calls, so don't reorder such vector instructions.
+  bool IsSchedulingBarrier(const HInstruction* instr) const override {
+    return HScheduler::IsSchedulingBarrier(instr) ||
+           instr->IsVecReduce() ||
+           instr->IsVecExtractScalar() ||
+           instr->IsVecSetScalars() ||
+           instr->IsVecReplicateScalar();
+  }
+
+ protected:
+  std::pair<SchedulingGraph, ScopedArenaVector<SchedulingNode*>> BuildSchedulingGraph(
+      HBasicBlock* block,
+      ScopedArenaAllocator* allocator,
+      const HeapLocationCollector* heap_location_collector) override;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HSchedulerX86_64);
+};
+
+}  // namespace x86_64
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_SCHEDULER_X86_64_H_
@@ -32,6 +32,10 @@ std::ostream& operator<<(std::ostream& os, const XmmRegister& reg) {
   return os << reg.AsFloatRegister();
 }
 
+std::ostream& operator<<(std::ostream& os, const YmmRegister& reg) {
+  return os << "YMM" << static_cast<int>(reg.AsFloatRegister());
+}
+
 std::ostream& operator<<(std::ostream& os, const X87Register& reg) {
   return os << "ST" << static_cast<int>(reg);
 }
@@ -2131,6 +2135,17 @@ void X86_64Assembler::pmulld(XmmRegister dst, XmmRegister src) {
   EmitXmmRegisterOperand(dst.LowBits(), src);
 }
 
+void X86_64Assembler::pclmulqdq(XmmRegister dst, XmmRegister src, const Immediate& imm) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0x3A);
+  EmitUint8(0x44);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+  EmitUint8(imm.value());
+}
+
 void X86_64Assembler::vpmulld(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
   DCHECK(CpuHasAVXorAVX2FeatureFlag());
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
@@ -3510,6 +3525,15 @@ void X86_64Assembler::pcmpeqq(XmmRegister dst, XmmRegister src) {
   EmitXmmRegisterOperand(dst.LowBits(), src);
 }
 
+void X86_64Assembler::pmovmskb(CpuRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0xD7);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+}
+
 void X86_64Assembler::pcmpgtb(XmmRegister dst, XmmRegister src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x66);
@@ -3766,6 +3790,328 @@ void X86_64Assembler::psrldq(XmmRegister reg, const Immediate& shift_count) {
   EmitUint8(shift_count.value());
 }
 
+/** VEX.256.0F.WIG 28 /r VMOVAPS ymm1, ymm2 */
+void X86_64Assembler::vmovaps(YmmRegister dst, YmmRegister src) {
+  X86_64ManagedRegister no_vvvv = ManagedRegister::NoRegister().AsX86_64();
+  if (src.NeedsRex() && !dst.NeedsRex()) {
+    // Use the store form, VMOVAPS ymm2/m256, ymm1, which allows the two-byte VEX prefix.
+    EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x29, src.AsFloatRegister(),
+                                no_vvvv, dst);
+  } else {
+    EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x28, dst.AsFloatRegister(),
+                                no_vvvv, src);
+  }
+}
+
+/** VEX.256.0F.WIG 10 /r VMOVUPS ymm1, m256 */
+void X86_64Assembler::vmovups(YmmRegister dst, const Address& src) {
+  EmitVex256MemoryOperation(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x10, dst.AsFloatRegister(), src);
+}
+
+/** VEX.256.0F.WIG 11 /r VMOVUPS m256, ymm1 */
+void X86_64Assembler::vmovups(const Address& dst, YmmRegister src) {
+  EmitVex256MemoryOperation(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x11, src.AsFloatRegister(), dst);
+}
+
+/** VEX.256.66.0F.WIG 10 /r VMOVUPD ymm1, m256 */
+void X86_64Assembler::vmovupd(YmmRegister dst, const Address& src) {
+  EmitVex256MemoryOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0x10, dst.AsFloatRegister(), src);
+}
+
+/** VEX.256.66.0F.WIG 11 /r VMOVUPD m256, ymm1 */
+void X86_64Assembler::vmovupd(const Address& dst, YmmRegister src) {
+  EmitVex256MemoryOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0x11, src.AsFloatRegister(), dst);
+}
+
+/** VEX.256.F3.0F.WIG 6F /r VMOVDQU ymm1, m256 */
+void X86_64Assembler::vmovdqu(YmmRegister dst, const Address& src) {
+  EmitVex256MemoryOperation(SET_VEX_M_0F, SET_VEX_PP_F3, 0x6F, dst.AsFloatRegister(), src);
+}
+
+/** VEX.256.F3.0F.WIG 7F /r VMOVDQU m256, ymm1 */
+void X86_64Assembler::vmovdqu(const Address& dst, YmmRegister src) {
+  EmitVex256MemoryOperation(SET_VEX_M_0F, SET_VEX_PP_F3, 0x7F, src.AsFloatRegister(), dst);
+}
+
+/** VEX.256.66.0F38.W0 78 /r VPBROADCASTB ymm1, xmm2 */
+void X86_64Assembler::vpbroadcastb(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  EmitVex256RegisterOperation(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x78, dst.AsFloatRegister(),
+                              ManagedRegister::NoRegister().AsX86_64(), YmmRegister(src));
+}
+
+/** VEX.256.66.0F38.W0 79 /r VPBROADCASTW ymm1, xmm2 */
+void X86_64Assembler::vpbroadcastw(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  EmitVex256RegisterOperation(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x79, dst.AsFloatRegister(),
+                              ManagedRegister::NoRegister().AsX86_64(), YmmRegister(src));
+}
+
+/** VEX.256.66.0F38.W0 58 /r VPBROADCASTD ymm1, xmm2 */
+void X86_64Assembler::vpbroadcastd(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  EmitVex256RegisterOperation(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x58, dst.AsFloatRegister(),
+                              ManagedRegister::NoRegister().AsX86_64(), YmmRegister(src));
+}
+
+/** VEX.256.66.0F38.W0 59 /r VPBROADCASTQ ymm1, xmm2 */
+void X86_64Assembler::vpbroadcastq(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  EmitVex256RegisterOperation(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x59, dst.AsFloatRegister(),
+                              ManagedRegister::NoRegister().AsX86_64(), YmmRegister(src));
+}
+
+/** VEX.256.66.0F38.W0 18 /r VBROADCASTSS ymm1, xmm2 */
+void X86_64Assembler::vbroadcastss(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  EmitVex256RegisterOperation(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x18, dst.AsFloatRegister(),
+                              ManagedRegister::NoRegister().AsX86_64(), YmmRegister(src));
+}
+
+/** VEX.256.66.0F38.W0 19 /r VBROADCASTSD ymm1, xmm2 */
+void X86_64Assembler::vbroadcastsd(YmmRegister dst, XmmRegister src) {
+  DCHECK(has_AVX2_);
+  EmitVex256RegisterOperation(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x19, dst.AsFloatRegister(),
+                              ManagedRegister::NoRegister().AsX86_64(), YmmRegister(src));
+}
+
+/** VEX.256.66.0F.WIG FC /r VPADDB ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpaddb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0xFC, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG FD /r VPADDW ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpaddw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0xFD, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG FE /r VPADDD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpaddd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0xFE, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG D4 /r VPADDQ ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpaddq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0xD4, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG F8 /r VPSUBB ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpsubb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0xF8, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.66.0F.WIG F9 /r VPSUBW ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpsubw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0xF9, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.66.0F.WIG FA /r VPSUBD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpsubd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0xFA, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.66.0F.WIG FB /r VPSUBQ ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpsubq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0xFB, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.66.0F.WIG D5 /r VPMULLW ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpmullw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0xD5, dst, src1, src2);
+}
+
+/** VEX.256.66.0F38.WIG 40 /r VPMULLD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpmulld(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F_38, SET_VEX_PP_66, 0x40, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.0F.WIG 58 /r VADDPS ymm1, ymm2, ymm3 */
+void X86_64Assembler::vaddps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_NONE, 0x58, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG 58 /r VADDPD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vaddpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0x58, dst, src1, src2);
+}
+
+/** VEX.256.0F.WIG 5C /r VSUBPS ymm1, ymm2, ymm3 */
+void X86_64Assembler::vsubps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5C, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.66.0F.WIG 5C /r VSUBPD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vsubpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0x5C, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.0F.WIG 59 /r VMULPS ymm1, ymm2, ymm3 */
+void X86_64Assembler::vmulps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_NONE, 0x59, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG 59 /r VMULPD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vmulpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0x59, dst, src1, src2);
+}
+
+/** VEX.256.0F.WIG 5E /r VDIVPS ymm1, ymm2, ymm3 */
+void X86_64Assembler::vdivps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5E, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.66.0F.WIG 5E /r VDIVPD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vdivpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0x5E, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.66.0F.WIG DB /r VPAND ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpand(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0xDB, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG DF /r VPANDN ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpandn(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0xDF, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.66.0F.WIG EB /r VPOR ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpor(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0xEB, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG EF /r VPXOR ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpxor(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0xEF, dst, src1, src2);
+}
+
+/** VEX.256.0F.WIG 54 /r VANDPS ymm1, ymm2, ymm3 */
+void X86_64Assembler::vandps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_NONE, 0x54, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG 54 /r VANDPD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vandpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0x54, dst, src1, src2);
+}
+
+/** VEX.256.0F.WIG 55 /r VANDNPS ymm1, ymm2, ymm3 */
+void X86_64Assembler::vandnps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x55, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.66.0F.WIG 55 /r VANDNPD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vandnpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_66, 0x55, dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2);
+}
+
+/** VEX.256.0F.WIG 56 /r VORPS ymm1, ymm2, ymm3 */
+void X86_64Assembler::vorps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_NONE, 0x56, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG 56 /r VORPD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0x56, dst, src1, src2);
+}
+
+/** VEX.256.0F.WIG 57 /r VXORPS ymm1, ymm2, ymm3 */
+void X86_64Assembler::vxorps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_NONE, 0x57, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG 57 /r VXORPD ymm1, ymm2, ymm3 */
+void X86_64Assembler::vxorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0x57, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG 74 /r VPCMPEQB ymm1, ymm2, ymm3 */
+void X86_64Assembler::vpcmpeqb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256CommutativeOperation(SET_VEX_PP_66, 0x74, dst, src1, src2);
+}
+
+/** VEX.256.66.0F.WIG 71 /6 ib VPSLLW ymm1, ymm2, imm8 */
+void X86_64Assembler::vpsllw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  EmitVex256ShiftOperation(0x71, 6, dst, src, shift_count);
+}
+
+/** VEX.256.66.0F.WIG 72 /6 ib VPSLLD ymm1, ymm2, imm8 */
+void X86_64Assembler::vpslld(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  EmitVex256ShiftOperation(0x72, 6, dst, src, shift_count);
+}
+
+/** VEX.256.66.0F.WIG 73 /6 ib VPSLLQ ymm1, ymm2, imm8 */
+void X86_64Assembler::vpsllq(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  EmitVex256ShiftOperation(0x73, 6, dst, src, shift_count);
+}
+
+/** VEX.256.66.0F.WIG 71 /4 ib VPSRAW ymm1, ymm2, imm8 */
+void X86_64Assembler::vpsraw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  EmitVex256ShiftOperation(0x71, 4, dst, src, shift_count);
+}
+
+/** VEX.256.66.0F.WIG 72 /4 ib VPSRAD ymm1, ymm2, imm8 */
+void X86_64Assembler::vpsrad(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  EmitVex256ShiftOperation(0x72, 4, dst, src, shift_count);
+}
+
+/** VEX.256.66.0F.WIG 71 /2 ib VPSRLW ymm1, ymm2, imm8 */
+void X86_64Assembler::vpsrlw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  EmitVex256ShiftOperation(0x71, 2, dst, src, shift_count);
+}
+
+/** VEX.256.66.0F.WIG 72 /2 ib VPSRLD ymm1, ymm2, imm8 */
+void X86_64Assembler::vpsrld(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  EmitVex256ShiftOperation(0x72, 2, dst, src, shift_count);
+}
+
+/** VEX.256.66.0F.WIG 73 /2 ib VPSRLQ ymm1, ymm2, imm8 */
+void X86_64Assembler::vpsrlq(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  EmitVex256ShiftOperation(0x73, 2, dst, src, shift_count);
+}
+
+/** VEX.256.0F.WIG 5B /r VCVTDQ2PS ymm1, ymm2 */
+void X86_64Assembler::vcvtdq2ps(YmmRegister dst, YmmRegister src) {
+  EmitVex256RegisterOperation(SET_VEX_M_0F, SET_VEX_PP_NONE, 0x5B, dst.AsFloatRegister(),
+                              ManagedRegister::NoRegister().AsX86_64(), src);
+}
+
+/** VEX.128.0F.WIG 77 VZEROUPPER */
+void X86_64Assembler::vzeroupper() {
+  DCHECK(CpuHasAVXorAVX2FeatureFlag());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(EmitVexPrefixByteZero(/*is_twobyte_form=*/ true));
+  EmitUint8(EmitVexPrefixByteOne(/*R=*/ false,
+                                 ManagedRegister::NoRegister().AsX86_64(),
+                                 SET_VEX_L_128,
+                                 SET_VEX_PP_NONE));
+  EmitUint8(0x77);
+}
+
 
 void X86_64Assembler::fldl(const Address& src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
@@ -5846,5 +6192,90 @@ uint8_t X86_64Assembler::EmitVexPrefixByteTwo(bool W,
   return vex_prefix;
 }
 
+void X86_64Assembler::EmitVex256Prefix(int SET_VEX_M,
+                                       int SET_VEX_PP,
+                                       int reg,
+                                       X86_64ManagedRegister vvvv,
+                                       bool rex_x,
+                                       bool rex_b) {
+  DCHECK(CpuHasAVXorAVX2FeatureFlag());
+  bool rex_r = reg > 7;
+  // The two-byte form can only encode the 0F map and has no X and B bits.
+  bool is_twobyte_form = (SET_VEX_M == SET_VEX_M_0F) && !rex_x && !rex_b;
+  EmitUint8(EmitVexPrefixByteZero(is_twobyte_form));
+  if (is_twobyte_form) {
+    EmitUint8(EmitVexPrefixByteOne(rex_r, vvvv, SET_VEX_L_256, SET_VEX_PP));
+  } else {
+    EmitUint8(EmitVexPrefixByteOne(rex_r, rex_x, rex_b, SET_VEX_M));
+    EmitUint8(vvvv.IsNoRegister()
+                  ? EmitVexPrefixByteTwo(/*W=*/ false, SET_VEX_L_256, SET_VEX_PP)
+                  : EmitVexPrefixByteTwo(/*W=*/ false, vvvv, SET_VEX_L_256, SET_VEX_PP));
+  }
+}
+
+void X86_64Assembler::EmitVex256RegisterOperation(int SET_VEX_M,
+                                                  int SET_VEX_PP,
+                                                  uint8_t opcode,
+                                                  int reg,
+                                                  X86_64ManagedRegister vvvv,
+                                                  YmmRegister rm) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Prefix(SET_VEX_M, SET_VEX_PP, reg, vvvv, /*rex_x=*/ false, rm.NeedsRex());
+  EmitUint8(opcode);
+  EmitXmmRegisterOperand(reg & 7, rm.AsXmmRegister());
+}
+
+void X86_64Assembler::EmitVex256MemoryOperation(int SET_VEX_M,
+                                                int SET_VEX_PP,
+                                                uint8_t opcode,
+                                                int reg,
+                                                const Address& address) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  uint8_t rex = address.rex();
+  EmitVex256Prefix(SET_VEX_M,
+                   SET_VEX_PP,
+                   reg,
+                   ManagedRegister::NoRegister().AsX86_64(),
+                   rex & GET_REX_X,
+                   rex & GET_REX_B);
+  EmitUint8(opcode);
+  EmitOperand(reg & 7, address);
+}
+
+void X86_64Assembler::EmitVex256CommutativeOperation(int SET_VEX_PP,
+                                                     uint8_t opcode,
+                                                     YmmRegister dst,
+                                                     YmmRegister src1,
+                                                     YmmRegister src2) {
+  bool swap_sources = src2.NeedsRex() && !src1.NeedsRex();
+  YmmRegister vvvv = swap_sources ? src2 : src1;
+  YmmRegister rm = swap_sources ? src1 : src2;
+  EmitVex256RegisterOperation(SET_VEX_M_0F,
+                              SET_VEX_PP,
+                              opcode,
+                              dst.AsFloatRegister(),
+                              X86_64ManagedRegister::FromXmmRegister(vvvv.AsFloatRegister()),
+                              rm);
+}
+
+void X86_64Assembler::EmitVex256ShiftOperation(uint8_t opcode,
+                                               int opcode_extension,
+                                               YmmRegister dst,
+                                               YmmRegister src,
+                                               const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  // The destination is encoded in VEX.vvvv and the ModRM reg field extends the opcode.
+  EmitVex256Prefix(SET_VEX_M_0F,
+                   SET_VEX_PP_66,
+                   opcode_extension,
+                   X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+                   /*rex_x=*/ false,
+                   src.NeedsRex());
+  EmitUint8(opcode);
+  EmitXmmRegisterOperand(opcode_extension, src.AsXmmRegister());
+  EmitUint8(shift_count.value());
+}
+
 }  // namespace x86_64
 }  // namespace art
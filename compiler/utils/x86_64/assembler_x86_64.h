@@ -591,6 +591,7 @@ class X86_64Assembler final : public Assembler {
   void psubd(XmmRegister dst, XmmRegister src);
   void pmulld(XmmRegister dst, XmmRegister src);
   void vpmulld(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void pclmulqdq(XmmRegister dst, XmmRegister src, const Immediate& imm);
 
   void vpaddd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
 
@@ -717,6 +718,8 @@ class X86_64Assembler final : public Assembler {
   void pcmpeqd(XmmRegister dst, XmmRegister src);
   void pcmpeqq(XmmRegister dst, XmmRegister src);
 
+  void pmovmskb(CpuRegister dst, XmmRegister src);
+
   void pcmpgtb(XmmRegister dst, XmmRegister src);
   void pcmpgtw(XmmRegister dst, XmmRegister src);
   void pcmpgtd(XmmRegister dst, XmmRegister src);
@@ -749,6 +752,71 @@ class X86_64Assembler final : public Assembler {
   void psrlq(XmmRegister reg, const Immediate& shift_count);
   void psrldq(XmmRegister reg, const Immediate& shift_count);
 
+  // 256-bit AVX/AVX2 forms, used by the vectorized loops of graphs with wide SIMD.
+  void vmovaps(YmmRegister dst, YmmRegister src);     // move
+  void vmovups(YmmRegister dst, const Address& src);  // load unaligned
+  void vmovups(const Address& dst, YmmRegister src);  // store unaligned
+  void vmovupd(YmmRegister dst, const Address& src);  // load unaligned
+  void vmovupd(const Address& dst, YmmRegister src);  // store unaligned
+  void vmovdqu(YmmRegister dst, const Address& src);  // load unaligned
+  void vmovdqu(const Address& dst, YmmRegister src);  // store unaligned
+
+  void vpbroadcastb(YmmRegister dst, XmmRegister src);  // AVX2
+  void vpbroadcastw(YmmRegister dst, XmmRegister src);  // AVX2
+  void vpbroadcastd(YmmRegister dst, XmmRegister src);  // AVX2
+  void vpbroadcastq(YmmRegister dst, XmmRegister src);  // AVX2
+  void vbroadcastss(YmmRegister dst, XmmRegister src);  // AVX2
+  void vbroadcastsd(YmmRegister dst, XmmRegister src);  // AVX2
+
+  void vpaddb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpaddq(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpsubq(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmullw(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpmulld(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+
+  void vaddps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vaddpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vsubps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vsubpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmulps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vmulpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vdivps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vdivpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+
+  void vpand(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpandn(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpor(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpxor(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandnps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vandnpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vorps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vxorps(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vxorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+  void vpcmpeqb(YmmRegister dst, YmmRegister src1, YmmRegister src2);
+
+  void vpsllw(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpslld(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsllq(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsraw(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrad(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrlw(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrld(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+  void vpsrlq(YmmRegister dst, YmmRegister src, const Immediate& shift_count);
+
+  void vcvtdq2ps(YmmRegister dst, YmmRegister src);
+
+  // Zero the upper halves of all YMM registers, avoiding the AVX-SSE transition penalty
+  // when switching to code using the legacy SSE encodings.
+  void vzeroupper();
+
   void flds(const Address& src);
   void fstps(const Address& dst);
   void fsts(const Address& dst);
@@ -1179,6 +1247,38 @@ class X86_64Assembler final : public Assembler {
                                int SET_VEX_L,
                                int SET_VEX_PP);
 
+  // Helpers for the VEX.256 instructions. `reg` is the register number or opcode extension
+  // in the ModRM reg field, and `vvvv` the additional source register, if any.
+  void EmitVex256Prefix(int SET_VEX_M,
+                        int SET_VEX_PP,
+                        int reg,
+                        X86_64ManagedRegister vvvv,
+                        bool rex_x,
+                        bool rex_b);
+  void EmitVex256RegisterOperation(int SET_VEX_M,
+                                   int SET_VEX_PP,
+                                   uint8_t opcode,
+                                   int reg,
+                                   X86_64ManagedRegister vvvv,
+                                   YmmRegister rm);
+  void EmitVex256MemoryOperation(int SET_VEX_M,
+                                 int SET_VEX_PP,
+                                 uint8_t opcode,
+                                 int reg,
+                                 const Address& address);
+  // Emit a commutative VEX.256 operation of the 0F map, swapping the sources if that allows
+  // the shorter two-byte VEX prefix.
+  void EmitVex256CommutativeOperation(int SET_VEX_PP,
+                                      uint8_t opcode,
+                                      YmmRegister dst,
+                                      YmmRegister src1,
+                                      YmmRegister src2);
+  void EmitVex256ShiftOperation(uint8_t opcode,
+                                int opcode_extension,
+                                YmmRegister dst,
+                                YmmRegister src,
+                                const Immediate& shift_count);
+
   // Helper function to emit a shorter variant of XCHG if at least one operand is RAX/EAX/AX.
   bool try_xchg_rax(CpuRegister dst,
                     CpuRegister src,
@@ -1628,6 +1628,11 @@ TEST_F(AssemblerX86_64Test, Pmulld) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::pmulld, "pmulld %{reg2}, %{reg1}"), "pmulld");
 }
 
+TEST_F(AssemblerX86_64Test, Pclmulqdq) {
+  DriverStr(RepeatFFI(&x86_64::X86_64Assembler::pclmulqdq, /*imm_bytes*/ 1U,
+                      "pclmulqdq ${imm}, %{reg2}, %{reg1}"), "pclmulqdq");
+}
+
 TEST_F(AssemblerX86_64AVXTest, VPmulld) {
   DriverStr(
       RepeatFFF(&x86_64::X86_64Assembler::vpmulld, "vpmulld %{reg3}, %{reg2}, %{reg1}"), "vpmulld");
@@ -1901,6 +1906,162 @@ TEST_F(AssemblerX86_64AVXTest, VFmadd213sd) {
                       "vfmadd213sd %{reg3}, %{reg2}, %{reg1}"), "vfmadd213sd");
 }
 
+// Register combinations for the 256-bit AVX tests, covering both VEX prefix forms and
+// the source swap of commutative operations.
+static constexpr int kYmmTestRegisters[][3] = {
+    {0, 1, 2}, {8, 1, 2}, {1, 9, 2}, {1, 2, 9}, {8, 9, 15}
+};
+
+static std::string RepeatYYY(x86_64::X86_64Assembler* assembler,
+                             void (x86_64::X86_64Assembler::*f)(x86_64::YmmRegister,
+                                                                x86_64::YmmRegister,
+                                                                x86_64::YmmRegister),
+                             const char* name) {
+  std::ostringstream str;
+  for (const auto& regs : kYmmTestRegisters) {
+    (assembler->*f)(
+        x86_64::YmmRegister(regs[0]), x86_64::YmmRegister(regs[1]), x86_64::YmmRegister(regs[2]));
+    str << name << " %ymm" << regs[2] << ", %ymm" << regs[1] << ", %ymm" << regs[0] << "\n";
+  }
+  return str.str();
+}
+
+static std::string RepeatYYI(x86_64::X86_64Assembler* assembler,
+                             void (x86_64::X86_64Assembler::*f)(x86_64::YmmRegister,
+                                                                x86_64::YmmRegister,
+                                                                const x86_64::Immediate&),
+                             const char* name) {
+  std::ostringstream str;
+  for (const auto& regs : kYmmTestRegisters) {
+    (assembler->*f)(x86_64::YmmRegister(regs[0]), x86_64::YmmRegister(regs[1]), x86_64::Immediate(3));
+    str << name << " $3, %ymm" << regs[1] << ", %ymm" << regs[0] << "\n";
+  }
+  return str.str();
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovaps256) {
+  for (const auto& regs : kYmmTestRegisters) {
+    GetAssembler()->vmovaps(x86_64::YmmRegister(regs[0]), x86_64::YmmRegister(regs[1]));
+    GetAssembler()->vmovaps(x86_64::YmmRegister(regs[1]), x86_64::YmmRegister(regs[0]));
+  }
+  DriverStr("vmovaps %ymm1, %ymm0\n"
+            "vmovaps %ymm0, %ymm1\n"
+            "vmovaps %ymm1, %ymm8\n"
+            "vmovaps %ymm8, %ymm1\n"
+            "vmovaps %ymm9, %ymm1\n"
+            "vmovaps %ymm1, %ymm9\n"
+            "vmovaps %ymm2, %ymm1\n"
+            "vmovaps %ymm1, %ymm2\n"
+            "vmovaps %ymm9, %ymm8\n"
+            "vmovaps %ymm8, %ymm9\n", "vmovaps_256");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovLoadStore256) {
+  x86_64::Address addr1(x86_64::CpuRegister(x86_64::RSP), 32);
+  x86_64::Address addr2(x86_64::CpuRegister(x86_64::R9),
+                        x86_64::CpuRegister(x86_64::R10),
+                        x86_64::TIMES_4,
+                        12);
+  GetAssembler()->vmovups(x86_64::YmmRegister(x86_64::XMM0), addr1);
+  GetAssembler()->vmovups(addr2, x86_64::YmmRegister(x86_64::XMM9));
+  GetAssembler()->vmovupd(x86_64::YmmRegister(x86_64::XMM9), addr1);
+  GetAssembler()->vmovupd(addr2, x86_64::YmmRegister(x86_64::XMM0));
+  GetAssembler()->vmovdqu(x86_64::YmmRegister(x86_64::XMM15), addr2);
+  GetAssembler()->vmovdqu(addr1, x86_64::YmmRegister(x86_64::XMM7));
+  DriverStr("vmovups 32(%rsp), %ymm0\n"
+            "vmovups %ymm9, 12(%r9,%r10,4)\n"
+            "vmovupd 32(%rsp), %ymm9\n"
+            "vmovupd %ymm0, 12(%r9,%r10,4)\n"
+            "vmovdqu 12(%r9,%r10,4), %ymm15\n"
+            "vmovdqu %ymm7, 32(%rsp)\n", "vmov_load_store_256");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VBroadcast256) {
+  GetAssembler()->vpbroadcastb(x86_64::YmmRegister(x86_64::XMM0), x86_64::XmmRegister(x86_64::XMM1));
+  GetAssembler()->vpbroadcastw(x86_64::YmmRegister(x86_64::XMM8), x86_64::XmmRegister(x86_64::XMM1));
+  GetAssembler()->vpbroadcastd(x86_64::YmmRegister(x86_64::XMM1), x86_64::XmmRegister(x86_64::XMM8));
+  GetAssembler()->vpbroadcastq(x86_64::YmmRegister(x86_64::XMM9), x86_64::XmmRegister(x86_64::XMM15));
+  GetAssembler()->vbroadcastss(x86_64::YmmRegister(x86_64::XMM2), x86_64::XmmRegister(x86_64::XMM2));
+  GetAssembler()->vbroadcastsd(x86_64::YmmRegister(x86_64::XMM12), x86_64::XmmRegister(x86_64::XMM3));
+  DriverStr("vpbroadcastb %xmm1, %ymm0\n"
+            "vpbroadcastw %xmm1, %ymm8\n"
+            "vpbroadcastd %xmm8, %ymm1\n"
+            "vpbroadcastq %xmm15, %ymm9\n"
+            "vbroadcastss %xmm2, %ymm2\n"
+            "vbroadcastsd %xmm3, %ymm12\n", "vbroadcast_256");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VIntegerArithmetic256) {
+  std::string expected;
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpaddb, "vpaddb");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpaddw, "vpaddw");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpaddd, "vpaddd");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpaddq, "vpaddq");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpsubb, "vpsubb");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpsubw, "vpsubw");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpsubd, "vpsubd");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpsubq, "vpsubq");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpmullw, "vpmullw");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpmulld, "vpmulld");
+  DriverStr(expected, "vinteger_arithmetic_256");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VFloatArithmetic256) {
+  std::string expected;
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vaddps, "vaddps");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vaddpd, "vaddpd");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vsubps, "vsubps");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vsubpd, "vsubpd");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vmulps, "vmulps");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vmulpd, "vmulpd");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vdivps, "vdivps");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vdivpd, "vdivpd");
+  DriverStr(expected, "vfloat_arithmetic_256");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VLogical256) {
+  std::string expected;
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpand, "vpand");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpandn, "vpandn");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpor, "vpor");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpxor, "vpxor");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vandps, "vandps");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vandpd, "vandpd");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vandnps, "vandnps");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vandnpd, "vandnpd");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vorps, "vorps");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vorpd, "vorpd");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vxorps, "vxorps");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vxorpd, "vxorpd");
+  expected += RepeatYYY(GetAssembler(), &x86_64::X86_64Assembler::vpcmpeqb, "vpcmpeqb");
+  DriverStr(expected, "vlogical_256");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VShifts256) {
+  std::string expected;
+  expected += RepeatYYI(GetAssembler(), &x86_64::X86_64Assembler::vpsllw, "vpsllw");
+  expected += RepeatYYI(GetAssembler(), &x86_64::X86_64Assembler::vpslld, "vpslld");
+  expected += RepeatYYI(GetAssembler(), &x86_64::X86_64Assembler::vpsllq, "vpsllq");
+  expected += RepeatYYI(GetAssembler(), &x86_64::X86_64Assembler::vpsraw, "vpsraw");
+  expected += RepeatYYI(GetAssembler(), &x86_64::X86_64Assembler::vpsrad, "vpsrad");
+  expected += RepeatYYI(GetAssembler(), &x86_64::X86_64Assembler::vpsrlw, "vpsrlw");
+  expected += RepeatYYI(GetAssembler(), &x86_64::X86_64Assembler::vpsrld, "vpsrld");
+  expected += RepeatYYI(GetAssembler(), &x86_64::X86_64Assembler::vpsrlq, "vpsrlq");
+  DriverStr(expected, "vshifts_256");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VCvtdq2ps256) {
+  GetAssembler()->vcvtdq2ps(x86_64::YmmRegister(x86_64::XMM0), x86_64::YmmRegister(x86_64::XMM1));
+  GetAssembler()->vcvtdq2ps(x86_64::YmmRegister(x86_64::XMM8), x86_64::YmmRegister(x86_64::XMM9));
+  DriverStr("vcvtdq2ps %ymm1, %ymm0\n"
+            "vcvtdq2ps %ymm9, %ymm8\n", "vcvtdq2ps_256");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VZeroUpper) {
+  GetAssembler()->vzeroupper();
+  DriverStr("vzeroupper\n", "vzeroupper");
+}
+
 TEST_F(AssemblerX86_64Test, Phaddw) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::phaddw, "phaddw %{reg2}, %{reg1}"), "phaddw");
 }
@@ -2013,6 +2174,10 @@ TEST_F(AssemblerX86_64Test, PCmpeqq) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::pcmpeqq, "pcmpeqq %{reg2}, %{reg1}"), "pcmpeqq");
 }
 
+TEST_F(AssemblerX86_64Test, PMovmskb) {
+  DriverStr(RepeatrF(&x86_64::X86_64Assembler::pmovmskb, "pmovmskb %{reg2}, %{reg1}"), "pmovmskb");
+}
+
 TEST_F(AssemblerX86_64Test, PCmpgtb) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::pcmpgtb, "pcmpgtb %{reg2}, %{reg1}"), "pcmpgtb");
 }
@@ -70,6 +70,32 @@ class XmmRegister {
 };
 std::ostream& operator<<(std::ostream& os, const XmmRegister& reg);
 
+// 256-bit AVX register, whose lower half is the XMM register with the same number.
+class YmmRegister {
+ public:
+  explicit constexpr YmmRegister(FloatRegister r) : reg_(r) {}
+  explicit constexpr YmmRegister(XmmRegister r) : reg_(r.AsFloatRegister()) {}
+  explicit constexpr YmmRegister(int r) : reg_(FloatRegister(r)) {}
+  constexpr FloatRegister AsFloatRegister() const {
+    return reg_;
+  }
+  constexpr XmmRegister AsXmmRegister() const {
+    return XmmRegister(reg_);
+  }
+  constexpr uint8_t LowBits() const {
+    return reg_ & 7;
+  }
+  constexpr bool NeedsRex() const {
+    return reg_ > 7;
+  }
+  bool operator==(const YmmRegister& other) const {
+    return reg_ == other.reg_;
+  }
+ private:
+  const FloatRegister reg_;
+};
+std::ostream& operator<<(std::ostream& os, const YmmRegister& reg);
+
 enum X87Register {
   ST0 = 0,
   ST1 = 1,
@@ -721,6 +721,15 @@ DISASSEMBLER_ENTRY(cmp,
               src_reg_file = SSE;
               immediate_bytes = 1;
               break;
+            case 0x44:
+              opcode1 = "pclmulqdq";
+              prefix[2] = 0;
+              has_modrm = true;
+              load = true;
+              src_reg_file = SSE;
+              dst_reg_file = SSE;
+              immediate_bytes = 1;
+              break;
             default:
               opcode_tmp = StringPrintf("unknown opcode '0F 3A %02X'", *instr);
               opcode1 = opcode_tmp.c_str();
@@ -67,7 +67,26 @@
   METRIC(YoungGcDuration, MetricsCounter)                           \
   METRIC(FullGcScannedBytes, MetricsCounter)                        \
   METRIC(FullGcFreedBytes, MetricsCounter)                          \
-  METRIC(FullGcDuration, MetricsCounter)
+  METRIC(FullGcDuration, MetricsCounter)                            \
+  METRIC(GcSoftReferenceProcessingTime, MetricsCounter)             \
+  METRIC(GcWeakReferenceProcessingTime, MetricsCounter)             \
+  METRIC(GcFinalizerReferenceProcessingTime, MetricsCounter)        \
+  METRIC(GcPhantomReferenceProcessingTime, MetricsCounter)          \
+  METRIC(ClassUnloadingTime, MetricsCounter)                        \
+  METRIC(ClassUnloadingReclaimedBytes, MetricsCounter)              \
+  METRIC(JitCodeCacheCollectionTime, MetricsCounter)                \
+  METRIC(JitCodeCacheReclaimedBytes, MetricsCounter)                \
+  METRIC(JitBaselineQueueWaitTime, MetricsCounter)                  \
+  METRIC(JitOptimizedQueueWaitTime, MetricsCounter)                 \
+  METRIC(JitOsrQueueWaitTime, MetricsCounter)                       \
+  METRIC(JitActiveWorkersAvg, MetricsAverage)                       \
+  METRIC(JitThreadPoolGrowCount, MetricsCounter)                    \
+  METRIC(JitThreadPoolShrinkCount, MetricsCounter)                  \
+  METRIC(JitReoptimizationInlineCache, MetricsCounter)              \
+  METRIC(JitReoptimizationMegamorphic, MetricsCounter)              \
+  METRIC(JitReoptimizationBoundsCheck, MetricsCounter)              \
+  METRIC(JitReoptimizationOther, MetricsCounter)                    \
+  METRIC(JitReoptimizationCapReached, MetricsCounter)
 
 // Increasing counter metrics, reported as Value Metrics in delta increments.
 #define ART_VALUE_METRICS(METRIC)                              \
@@ -396,6 +396,30 @@ jvmtiError ExtensionUtil::GetExtensionFunctions(jvmtiEnv* env,
     return error;
   }
 
+  error = add_extension(
+      reinterpret_cast<jvmtiExtensionFunction>(HeapExtensions::GetGcEvents),
+      "com.android.art.gc.get_gc_events",
+      "Retrieve the GCs recorded in the GC event log (enabled with -XX:GcEventLogSize) with a"
+      " sequence number of at least first_sequence that are still in the log, oldest first."
+      " Returns the sequence number to pass to the next call, the number of events and the raw"
+      " event records. The record layout is art::gc::GcEvent, the same as in the file written"
+      " by -XX:GcEventStreamFile.",
+      {
+        { "first_sequence", JVMTI_KIND_IN, JVMTI_TYPE_JLONG, false },
+        { "next_sequence", JVMTI_KIND_OUT, JVMTI_TYPE_JLONG, false },
+        { "event_count", JVMTI_KIND_OUT, JVMTI_TYPE_JINT, false },
+        { "events", JVMTI_KIND_ALLOC_BUF, JVMTI_TYPE_JBYTE, false },
+      },
+      {
+         ERR(NULL_POINTER),
+         ERR(ILLEGAL_ARGUMENT),
+         ERR(NOT_AVAILABLE),
+         ERR(OUT_OF_MEMORY),
+      });
+  if (error != ERR(NONE)) {
+    return error;
+  }
+
   // These require index-ids and debuggable to function
   art::Runtime* runtime = art::Runtime::Current();
   if (runtime->GetJniIdType() == art::JniIdType::kIndices && IsFullJvmtiAvailable()) {
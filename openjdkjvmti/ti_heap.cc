@@ -34,6 +34,7 @@
 #include "events-inl.h"
 #include "gc/collector_type.h"
 #include "gc/gc_cause.h"
+#include "gc/gc_event_log.h"
 #include "gc/heap-visit-objects-inl.h"
 #include "gc/heap-inl.h"
 #include "gc/scoped_gc_critical_section.h"
@@ -1984,6 +1985,39 @@ jvmtiError HeapExtensions::ChangeArraySize(jvmtiEnv* env, jobject arr, jsize new
   return OK;
 }
 
+jvmtiError HeapExtensions::GetGcEvents(jvmtiEnv* env,
+                                       jlong first_sequence,
+                                       jlong* next_sequence,
+                                       jint* event_count,
+                                       jbyte** events) {
+  if (next_sequence == nullptr || event_count == nullptr || events == nullptr) {
+    return ERR(NULL_POINTER);
+  }
+  if (first_sequence < 0) {
+    return ERR(ILLEGAL_ARGUMENT);
+  }
+  art::gc::GcEventLog* log = art::Runtime::Current()->GetHeap()->GetGcEventLog();
+  if (log == nullptr) {
+    JVMTI_LOG(INFO, env) << "GC event log not enabled, use -XX:GcEventLogSize";
+    return ERR(NOT_AVAILABLE);
+  }
+  std::vector<art::gc::GcEvent> gc_events;
+  uint64_t next = log->GetEvents(static_cast<uint64_t>(first_sequence), &gc_events);
+  size_t size = gc_events.size() * sizeof(art::gc::GcEvent);
+  unsigned char* data = nullptr;
+  jvmtiError err = env->Allocate(size, &data);
+  if (err != OK) {
+    return err;
+  }
+  if (size != 0u) {
+    memcpy(data, gc_events.data(), size);
+  }
+  *next_sequence = static_cast<jlong>(next);
+  *event_count = static_cast<jint>(gc_events.size());
+  *events = reinterpret_cast<jbyte*>(data);
+  return OK;
+}
+
 void HeapExtensions::Register(EventHandler* eh) {
   gEventHandler = eh;
 }
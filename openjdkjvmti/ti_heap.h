@@ -91,6 +91,12 @@ class HeapExtensions {
 
   static jvmtiError JNICALL ChangeArraySize(jvmtiEnv* env, jobject arr, jsize new_size);
 
+  static jvmtiError JNICALL GetGcEvents(jvmtiEnv* env,
+                                        jlong first_sequence,
+                                        jlong* next_sequence,
+                                        jint* event_count,
+                                        jbyte** events);
+
   static void ReplaceReferences(
       art::Thread* self,
       const std::unordered_map<art::ObjPtr<art::mirror::Object>,
@@ -92,6 +92,17 @@ static constexpr const char* x86_variants_with_popcnt[] = {
     "tremont",
     "kabylake",
 };
+
+static constexpr const char* x86_variants_with_pclmulqdq[] = {
+    "sandybridge",
+    "silvermont",
+    "goldmont",
+    "goldmont-plus",
+    "goldmont-without-sha-xsaves",
+    "tremont",
+    "kabylake",
+};
+
 static constexpr const char* x86_variants_with_avx[] = {
     "kabylake",
 };
@@ -106,21 +117,24 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::Create(bool x86_64,
                                                        bool has_SSE4_2,
                                                        bool has_AVX,
                                                        bool has_AVX2,
-                                                       bool has_POPCNT) {
+                                                       bool has_POPCNT,
+                                                       bool has_PCLMULQDQ) {
   if (x86_64) {
     return X86FeaturesUniquePtr(new X86_64InstructionSetFeatures(has_SSSE3,
                                                                  has_SSE4_1,
                                                                  has_SSE4_2,
                                                                  has_AVX,
                                                                  has_AVX2,
-                                                                 has_POPCNT));
+                                                                 has_POPCNT,
+                                                                 has_PCLMULQDQ));
   } else {
     return X86FeaturesUniquePtr(new X86InstructionSetFeatures(has_SSSE3,
                                                               has_SSE4_1,
                                                               has_SSE4_2,
                                                               has_AVX,
                                                               has_AVX2,
-                                                              has_POPCNT));
+                                                              has_POPCNT,
+                                                              has_PCLMULQDQ));
   }
 }
 
@@ -150,6 +164,9 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromVariant(const std::string& v
   bool has_POPCNT = FindVariantInArray(x86_variants_with_popcnt,
                                        arraysize(x86_variants_with_popcnt),
                                        variant);
+  bool has_PCLMULQDQ = FindVariantInArray(x86_variants_with_pclmulqdq,
+                                          arraysize(x86_variants_with_pclmulqdq),
+                                          variant);
 
   // Verify that variant is known.
   bool known_variant = FindVariantInArray(x86_known_variants, arraysize(x86_known_variants),
@@ -162,7 +179,14 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromVariant(const std::string& v
     LOG(WARNING) << os.str();
   }
 
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+  return Create(x86_64,
+                has_SSSE3,
+                has_SSE4_1,
+                has_SSE4_2,
+                has_AVX,
+                has_AVX2,
+                has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 X86FeaturesUniquePtr X86InstructionSetFeatures::FromBitmap(uint32_t bitmap, bool x86_64) {
@@ -172,7 +196,15 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromBitmap(uint32_t bitmap, bool
   bool has_AVX = (bitmap & kAvxBitfield) != 0;
   bool has_AVX2 = (bitmap & kAvxBitfield) != 0;
   bool has_POPCNT = (bitmap & kPopCntBitfield) != 0;
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+  bool has_PCLMULQDQ = (bitmap & kPclmulqdqBitfield) != 0;
+  return Create(x86_64,
+                has_SSSE3,
+                has_SSE4_1,
+                has_SSE4_2,
+                has_AVX,
+                has_AVX2,
+                has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 X86FeaturesUniquePtr X86InstructionSetFeatures::FromCppDefines(bool x86_64) {
@@ -212,7 +244,20 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromCppDefines(bool x86_64) {
   const bool has_POPCNT = true;
 #endif
 
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+#ifndef __PCLMUL__
+  const bool has_PCLMULQDQ = false;
+#else
+  const bool has_PCLMULQDQ = true;
+#endif
+
+  return Create(x86_64,
+                has_SSSE3,
+                has_SSE4_1,
+                has_SSE4_2,
+                has_AVX,
+                has_AVX2,
+                has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 X86FeaturesUniquePtr X86InstructionSetFeatures::FromCpuInfo(bool x86_64) {
@@ -224,6 +269,7 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromCpuInfo(bool x86_64) {
   bool has_AVX = false;
   bool has_AVX2 = false;
   bool has_POPCNT = false;
+  bool has_PCLMULQDQ = false;
 
   std::ifstream in("/proc/cpuinfo");
   if (!in.fail()) {
@@ -252,6 +298,9 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromCpuInfo(bool x86_64) {
           if (line.find("popcnt") != std::string::npos) {
             has_POPCNT = true;
           }
+          if (line.find("pclmulqdq") != std::string::npos) {
+            has_PCLMULQDQ = true;
+          }
         }
       }
     }
@@ -259,7 +308,14 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromCpuInfo(bool x86_64) {
   } else {
     LOG(ERROR) << "Failed to open /proc/cpuinfo";
   }
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+  return Create(x86_64,
+                has_SSSE3,
+                has_SSE4_1,
+                has_SSE4_2,
+                has_AVX,
+                has_AVX2,
+                has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 X86FeaturesUniquePtr X86InstructionSetFeatures::FromHwcap(bool x86_64) {
@@ -282,7 +338,8 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromCpuFeatures(bool x86_64) {
     features.sse4_2,
     features.avx,
     features.avx2,
-    features.popcnt);
+    features.popcnt,
+    features.pclmulqdq);
 #else
   UNIMPLEMENTED(WARNING);
   return FromCppDefines(x86_64);
@@ -300,7 +357,8 @@ bool X86InstructionSetFeatures::Equals(const InstructionSetFeatures* other) cons
       (has_SSE4_2_ == other_as_x86->has_SSE4_2_) &&
       (has_AVX_ == other_as_x86->has_AVX_) &&
       (has_AVX2_ == other_as_x86->has_AVX2_) &&
-      (has_POPCNT_ == other_as_x86->has_POPCNT_);
+      (has_POPCNT_ == other_as_x86->has_POPCNT_) &&
+      (has_PCLMULQDQ_ == other_as_x86->has_PCLMULQDQ_);
 }
 
 bool X86InstructionSetFeatures::HasAtLeast(const InstructionSetFeatures* other) const {
@@ -313,7 +371,8 @@ bool X86InstructionSetFeatures::HasAtLeast(const InstructionSetFeatures* other)
       (has_SSE4_2_ || !other_as_x86->has_SSE4_2_) &&
       (has_AVX_ || !other_as_x86->has_AVX_) &&
       (has_AVX2_ || !other_as_x86->has_AVX2_) &&
-      (has_POPCNT_ || !other_as_x86->has_POPCNT_);
+      (has_POPCNT_ || !other_as_x86->has_POPCNT_) &&
+      (has_PCLMULQDQ_ || !other_as_x86->has_PCLMULQDQ_);
 }
 
 uint32_t X86InstructionSetFeatures::AsBitmap() const {
@@ -322,7 +381,8 @@ uint32_t X86InstructionSetFeatures::AsBitmap() const {
       (has_SSE4_2_ ? kSse4_2Bitfield : 0) |
       (has_AVX_ ? kAvxBitfield : 0) |
       (has_AVX2_ ? kAvx2Bitfield : 0) |
-      (has_POPCNT_ ? kPopCntBitfield : 0);
+      (has_POPCNT_ ? kPopCntBitfield : 0) |
+      (has_PCLMULQDQ_ ? kPclmulqdqBitfield : 0);
 }
 
 std::string X86InstructionSetFeatures::GetFeatureString() const {
@@ -357,6 +417,11 @@ std::string X86InstructionSetFeatures::GetFeatureString() const {
   } else {
     result += ",-popcnt";
   }
+  if (has_PCLMULQDQ_) {
+    result += ",pclmulqdq";
+  } else {
+    result += ",-pclmulqdq";
+  }
   return result;
 }
 
@@ -369,6 +434,7 @@ std::unique_ptr<const InstructionSetFeatures> X86InstructionSetFeatures::AddFeat
   bool has_AVX = has_AVX_;
   bool has_AVX2 = has_AVX2_;
   bool has_POPCNT = has_POPCNT_;
+  bool has_PCLMULQDQ = has_PCLMULQDQ_;
   for (const std::string& feature : features) {
     DCHECK_EQ(android::base::Trim(feature), feature)
         << "Feature name is not trimmed: '" << feature << "'";
@@ -396,12 +462,23 @@ std::unique_ptr<const InstructionSetFeatures> X86InstructionSetFeatures::AddFeat
       has_POPCNT = true;
     } else if (feature == "-popcnt") {
       has_POPCNT = false;
+    } else if (feature == "pclmulqdq") {
+      has_PCLMULQDQ = true;
+    } else if (feature == "-pclmulqdq") {
+      has_PCLMULQDQ = false;
     } else {
       *error_msg = StringPrintf("Unknown instruction set feature: '%s'", feature.c_str());
       return nullptr;
     }
   }
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+  return Create(x86_64,
+                has_SSSE3,
+                has_SSE4_1,
+                has_SSE4_2,
+                has_AVX,
+                has_AVX2,
+                has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 }  // namespace art
@@ -88,6 +88,7 @@
 #include "gc/scoped_gc_critical_section.h"
 #include "gc/space/image_space.h"
 #include "gc/space/space-inl.h"
+#include "gc/task_processor.h"
 #include "gc_root-inl.h"
 #include "handle_scope-inl.h"
 #include "hidden_api.h"
@@ -2683,16 +2684,20 @@ void ClassLinker::VisitClassesWithoutClassesLock(ClassVisitor* visitor) {
 
 ClassLinker::~ClassLinker() {
   Thread* const self = Thread::Current();
-  for (const ClassLoaderData& data : class_loaders_) {
-    // CHA unloading analysis is not needed. No negative consequences are expected because
-    // all the classloaders are deleted at the same time.
-    PrepareToDeleteClassLoader(self, data, /*cleanup_cha=*/false);
-  }
+  // CHA unloading analysis is not needed. No negative consequences are expected because
+  // all the classloaders are deleted at the same time.
+  PrepareToDeleteClassLoaders(self, class_loaders_, /*cleanup_cha=*/false);
   for (const ClassLoaderData& data : class_loaders_) {
     delete data.allocator;
     delete data.class_table;
   }
   class_loaders_.clear();
+  // Class loaders unloaded by the last GCs may not have been freed by the heap task yet.
+  for (const ClassLoaderData& data : unloaded_class_loaders_) {
+    delete data.allocator;
+    delete data.class_table;
+  }
+  unloaded_class_loaders_.clear();
   while (!running_visibly_initialized_callbacks_.empty()) {
     std::unique_ptr<VisiblyInitializedCallback> callback(
         std::addressof(running_visibly_initialized_callbacks_.front()));
@@ -2700,39 +2705,55 @@ ClassLinker::~ClassLinker() {
   }
 }
 
-void ClassLinker::PrepareToDeleteClassLoader(Thread* self,
-                                             const ClassLoaderData& data,
-                                             bool cleanup_cha) {
+size_t ClassLinker::PrepareToDeleteClassLoaders(Thread* self,
+                                                const std::list<ClassLoaderData>& loaders,
+                                                bool cleanup_cha) {
   Runtime* const runtime = Runtime::Current();
   JavaVMExt* const vm = runtime->GetJavaVM();
-  vm->DeleteWeakGlobalRef(self, data.weak_root);
-  // Notify the JIT that we need to remove the methods and/or profiling info.
+  std::vector<const LinearAlloc*> allocators;
+  allocators.reserve(loaders.size());
+  for (const ClassLoaderData& data : loaders) {
+    vm->DeleteWeakGlobalRef(self, data.weak_root);
+    allocators.push_back(data.allocator);
+  }
+  size_t freed_jit_bytes = 0u;
+  // Notify the JIT that we need to remove the methods and/or profiling info. This is done for
+  // all the class loaders at once so that the JIT maps are swept only once.
   if (runtime->GetJit() != nullptr) {
     jit::JitCodeCache* code_cache = runtime->GetJit()->GetCodeCache();
     if (code_cache != nullptr) {
       // For the JIT case, RemoveMethodsIn removes the CHA dependencies.
-      code_cache->RemoveMethodsIn(self, *data.allocator);
+      freed_jit_bytes =
+          code_cache->RemoveMethodsIn(self, ArrayRef<const LinearAlloc* const>(allocators));
     }
   } else if (cha_ != nullptr) {
     // If we don't have a JIT, we need to manually remove the CHA dependencies manually.
-    cha_->RemoveDependenciesForLinearAlloc(self, data.allocator);
+    for (const ClassLoaderData& data : loaders) {
+      cha_->RemoveDependenciesForLinearAlloc(self, data.allocator);
+    }
   }
   // Cleanup references to single implementation ArtMethods that will be deleted.
   if (cleanup_cha) {
-    CHAOnDeleteUpdateClassVisitor visitor(data.allocator);
-    data.class_table->Visit<kWithoutReadBarrier>(visitor);
+    for (const ClassLoaderData& data : loaders) {
+      CHAOnDeleteUpdateClassVisitor visitor(data.allocator);
+      data.class_table->Visit<kWithoutReadBarrier>(visitor);
+    }
   }
   {
     MutexLock lock(self, critical_native_code_with_clinit_check_lock_);
     auto end = critical_native_code_with_clinit_check_.end();
     for (auto it = critical_native_code_with_clinit_check_.begin(); it != end; ) {
-      if (data.allocator->ContainsUnsafe(it->first)) {
+      ArtMethod* method = it->first;
+      if (std::any_of(allocators.begin(), allocators.end(), [method](const LinearAlloc* alloc) {
+            return alloc->ContainsUnsafe(method);
+          })) {
         it = critical_native_code_with_clinit_check_.erase(it);
       } else {
         ++it;
       }
     }
   }
+  return freed_jit_bytes;
 }
 
 ObjPtr<mirror::PointerArray> ClassLinker::AllocPointerArray(Thread* self, size_t length) {
@@ -6688,9 +6709,11 @@ ArtMethod* ClassLinker::AddMethodToConflictTable(ObjPtr<mirror::Class> klass,
 
   // Allocate a new table. Note that we will leak this table at the next conflict,
   // but that's a tradeoff compared to making the table fixed size.
+  bool hashed = UseHashedImtConflictTable(current_table->NumEntries(image_pointer_size_) + 1u,
+                                          image_pointer_size_);
   void* data = linear_alloc->Alloc(
       Thread::Current(),
-      ImtConflictTable::ComputeSizeWithOneMoreEntry(current_table, image_pointer_size_),
+      ImtConflictTable::ComputeSizeWithOneMoreEntry(current_table, image_pointer_size_, hashed),
       LinearAllocKind::kNoGCRoots);
   if (data == nullptr) {
     LOG(ERROR) << "Failed to allocate conflict table";
@@ -6699,7 +6722,8 @@ ArtMethod* ClassLinker::AddMethodToConflictTable(ObjPtr<mirror::Class> klass,
   ImtConflictTable* new_table = new (data) ImtConflictTable(current_table,
                                                             interface_method,
                                                             method,
-                                                            image_pointer_size_);
+                                                            image_pointer_size_,
+                                                            hashed);
 
   // Do a fence to ensure threads see the data in the table before it is assigned
   // to the conflict method.
@@ -6801,13 +6825,25 @@ void ClassLinker::FillIMTAndConflictTables(ObjPtr<mirror::Class> klass) {
   }
 }
 
+// Whether to give a conflict table a hash index. Only the arm64 and x86-64 conflict
+// trampolines use it, and tables compiled into an image are kept linear.
+static bool UseHashedImtConflictTable(size_t count, PointerSize pointer_size) {
+  return (kRuntimeISA == InstructionSet::kArm64 || kRuntimeISA == InstructionSet::kX86_64) &&
+         pointer_size == kRuntimePointerSize &&
+         count >= ImtConflictTable::kHashedLookupThreshold &&
+         !Runtime::Current()->IsAotCompiler();
+}
+
 ImtConflictTable* ClassLinker::CreateImtConflictTable(size_t count,
                                                       LinearAlloc* linear_alloc,
                                                       PointerSize image_pointer_size) {
+  bool hashed = UseHashedImtConflictTable(count, image_pointer_size);
   void* data = linear_alloc->Alloc(Thread::Current(),
-                                   ImtConflictTable::ComputeSize(count, image_pointer_size),
+                                   ImtConflictTable::ComputeSize(count, image_pointer_size, hashed),
                                    LinearAllocKind::kNoGCRoots);
-  return (data != nullptr) ? new (data) ImtConflictTable(count, image_pointer_size) : nullptr;
+  return (data != nullptr)
+      ? new (data) ImtConflictTable(count, image_pointer_size, hashed)
+      : nullptr;
 }
 
 ImtConflictTable* ClassLinker::CreateImtConflictTable(size_t count, LinearAlloc* linear_alloc) {
@@ -6918,6 +6954,15 @@ void ClassLinker::FillIMTFromIfTable(ObjPtr<mirror::IfTable> if_table,
         table->SetImplementationMethod(num_entries, image_pointer_size_, implementation_method);
       }
     }
+
+    // Now that the tables are filled, index them.
+    for (size_t i = 0; i < ImTable::kSize; ++i) {
+      if (imt[i]->IsRuntimeMethod() &&
+          imt[i] != unimplemented_method &&
+          imt[i] != imt_conflict_method) {
+        imt[i]->GetImtConflictTable(image_pointer_size_)->UpdateHashIndex(image_pointer_size_);
+      }
+    }
   }
 }
 
@@ -10986,6 +11031,16 @@ void ClassLinker::InsertDexFileInToClassLoader(ObjPtr<mirror::Object> dex_file,
   }
 }
 
+class ClassLinker::FreeUnloadedClassLoadersTask final : public gc::HeapTask {
+ public:
+  explicit FreeUnloadedClassLoadersTask(uint64_t target_run_time)
+      : gc::HeapTask(target_run_time) {}
+
+  void Run(Thread* self) override {
+    Runtime::Current()->GetClassLinker()->FreeUnloadedClassLoaders(self);
+  }
+};
+
 void ClassLinker::CleanupClassLoaders() {
   Thread* const self = Thread::Current();
   std::list<ClassLoaderData> to_delete;
@@ -11008,6 +11063,7 @@ void ClassLinker::CleanupClassLoaders() {
   if (to_delete.empty()) {
     return;
   }
+  metrics::AutoTimer timer{GetMetrics()->ClassUnloadingTime()};
   std::set<const OatFile*> unregistered_oat_files;
   JavaVMExt* vm = self->GetJniEnv()->GetVm();
   {
@@ -11034,14 +11090,17 @@ void ClassLinker::CleanupClassLoaders() {
   }
   {
     ScopedDebugDisallowReadBarriers sddrb(self);
-    for (ClassLoaderData& data : to_delete) {
-      // CHA unloading analysis and SingleImplementaion cleanups are required.
-      PrepareToDeleteClassLoader(self, data, /*cleanup_cha=*/true);
-    }
-  }
-  for (const ClassLoaderData& data : to_delete) {
-    delete data.allocator;
-    delete data.class_table;
+    // CHA unloading analysis and SingleImplementaion cleanups are required.
+    // The freed JIT code is accounted with the rest of the code cache; ClassUnloadingReclaimedBytes
+    // only counts the linear allocs.
+    size_t freed_jit_bytes = PrepareToDeleteClassLoaders(self, to_delete, /*cleanup_cha=*/true);
+    GetMetrics()->JitCodeCacheReclaimedBytes()->Add(freed_jit_bytes);
+  }
+  // Nothing refers to the linear allocs and class tables of the class loaders any more, so
+  // freeing them does not need to hold up the GC. Leave it to a heap task when possible.
+  {
+    WriterMutexLock mu(self, *Locks::classlinker_classes_lock_);
+    unloaded_class_loaders_.splice(unloaded_class_loaders_.end(), to_delete);
   }
   Runtime* runtime = Runtime::Current();
   if (!unregistered_oat_files.empty()) {
@@ -11064,6 +11123,39 @@ void ClassLinker::CleanupClassLoaders() {
     StartupCompletedTask::DeleteStartupDexCaches(self, /* called_by_gc= */ true);
     DCHECK_EQ(runtime->GetStartupLinearAlloc(), nullptr);
   }
+  // FreeUnloadedClassLoaders() accounts for its own time.
+  timer.Stop();
+  if (gUseUserfaultfd) {
+    // The mark-compact collector updates the roots in all linear-alloc arenas in the compaction
+    // pause that follows in this cycle. The arenas of the unloaded class loaders refer to dead
+    // objects, so free them now.
+    FreeUnloadedClassLoaders(self);
+    return;
+  }
+  FreeUnloadedClassLoadersTask* task = new FreeUnloadedClassLoadersTask(NanoTime());
+  if (!runtime->GetHeap()->AddHeapTask(task)) {
+    delete task;
+    FreeUnloadedClassLoaders(self);
+  }
+}
+
+void ClassLinker::FreeUnloadedClassLoaders(Thread* self) {
+  // Free one class loader at a time so that the lock is not held while freeing.
+  while (true) {
+    std::list<ClassLoaderData> to_free;
+    {
+      WriterMutexLock mu(self, *Locks::classlinker_classes_lock_);
+      if (unloaded_class_loaders_.empty()) {
+        return;
+      }
+      to_free.splice(to_free.end(), unloaded_class_loaders_, unloaded_class_loaders_.begin());
+    }
+    metrics::AutoTimer timer{GetMetrics()->ClassUnloadingTime()};
+    const ClassLoaderData& data = to_free.front();
+    GetMetrics()->ClassUnloadingReclaimedBytes()->Add(data.allocator->GetUsedMemory());
+    delete data.allocator;
+    delete data.class_table;
+  }
 }
 
 class ClassLinker::FindVirtualMethodHolderVisitor : public ClassVisitor {
@@ -717,11 +717,17 @@ class ClassLinker {
   // entries are roots, but potentially not image classes.
   EXPORT void DropFindArrayClassCache() REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Clean up class loaders, this needs to happen after JNI weak globals are cleared.
+  // Clean up class loaders, this needs to happen after JNI weak globals are cleared. Only the
+  // work that must precede the sweep of the dead classes is done here; the class tables and
+  // linear allocs of the unloaded class loaders are freed later by a heap task, if possible.
   void CleanupClassLoaders()
       REQUIRES(!Locks::classlinker_classes_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Free the class tables and linear allocs of class loaders unloaded by CleanupClassLoaders(),
+  // one class loader at a time.
+  void FreeUnloadedClassLoaders(Thread* self) REQUIRES(!Locks::classlinker_classes_lock_);
+
   // Unlike GetOrCreateAllocatorForClassLoader, GetAllocatorForClassLoader asserts that the
   // allocator for this class loader is already created.
   EXPORT LinearAlloc* GetAllocatorForClassLoader(ObjPtr<mirror::ClassLoader> class_loader)
@@ -1002,6 +1008,7 @@ class ClassLinker {
   template <PointerSize kPointerSize>
   class LinkMethodsHelper;
   class MethodAnnotationsIterator;
+  class FreeUnloadedClassLoadersTask;
   class OatClassCodeIterator;
   class VisiblyInitializedCallback;
 
@@ -1025,11 +1032,14 @@ class ClassLinker {
       REQUIRES(!Locks::dex_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Prepare by removing dependencies on things allocated in data.allocator.
-  // Please note that the allocator and class_table are not deleted in this
+  // Prepare by removing dependencies on things allocated in the allocators of `loaders`.
+  // Please note that the allocators and class_tables are not deleted in this
   // function. They are to be deleted after preparing all the class-loaders that
-  // are to be deleted (see b/298575095).
-  void PrepareToDeleteClassLoader(Thread* self, const ClassLoaderData& data, bool cleanup_cha)
+  // are to be deleted (see b/298575095). Returns the number of bytes of JIT code
+  // and data freed.
+  size_t PrepareToDeleteClassLoaders(Thread* self,
+                                     const std::list<ClassLoaderData>& loaders,
+                                     bool cleanup_cha)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   void VisitClassesInternal(ClassVisitor* visitor)
@@ -1442,6 +1452,11 @@ class ClassLinker {
   std::list<ClassLoaderData> class_loaders_
       GUARDED_BY(Locks::classlinker_classes_lock_);
 
+  // Class loaders that have been unloaded and prepared for deletion, but whose class tables and
+  // linear allocs have not been freed yet.
+  std::list<ClassLoaderData> unloaded_class_loaders_
+      GUARDED_BY(Locks::classlinker_classes_lock_);
+
   // Boot class path table. Since the class loader for this is null.
   std::unique_ptr<ClassTable> boot_class_table_ GUARDED_BY(Locks::classlinker_classes_lock_);
 
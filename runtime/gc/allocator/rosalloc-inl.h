@@ -42,6 +42,9 @@ inline ALWAYS_INLINE void* RosAlloc::Alloc(Thread* self, size_t size, size_t* by
     m = AllocFromRunThreadUnsafe(self, size, bytes_allocated, usable_size,
                                  bytes_tl_bulk_allocated);
   }
+  if (m != nullptr) {
+    RecordRequestSize(size);
+  }
   // Check if the returned memory is really all zero.
   if (ShouldCheckZeroMemory() && m != nullptr) {
     uint8_t* bytes = reinterpret_cast<uint8_t*>(m);
@@ -95,6 +98,7 @@ inline void* RosAlloc::AllocFromThreadLocalRun(Thread* self, size_t size,
   void* slot_addr = thread_local_run->AllocSlot();
   if (LIKELY(slot_addr != nullptr)) {
     *bytes_allocated = bracket_size;
+    RecordRequestSize(size);
   }
   return slot_addr;
 }
@@ -16,13 +16,17 @@
 
 #include "rosalloc-inl.h"
 
+#include <algorithm>
+#include <limits>
 #include <list>
 #include <map>
 #include <sstream>
 #include <vector>
 
 #include "android-base/stringprintf.h"
+#include "android-base/strings.h"
 
+#include "base/casts.h"
 #include "base/logging.h"  // For VLOG
 #include "base/memory_tool.h"
 #include "base/mem_map.h"
@@ -48,6 +52,10 @@ size_t RosAlloc::bracketSizes[kNumOfSizeBrackets];
 size_t RosAlloc::numOfPages[kNumOfSizeBrackets];
 size_t RosAlloc::numOfSlots[kNumOfSizeBrackets];
 size_t RosAlloc::headerSizes[kNumOfSizeBrackets];
+uint8_t RosAlloc::sharedBracketIndexes[kNumSharedSizeQuanta];
+bool RosAlloc::has_custom_shared_bracket_sizes_ = false;
+size_t RosAlloc::customSharedBracketSizes[kNumSharedSizeBrackets];
+bool RosAlloc::record_bracket_stats_ = false;
 bool RosAlloc::initialized_ = false;
 size_t RosAlloc::dedicated_full_run_storage_[kMaxPageSize / sizeof(size_t)] = { 0 };
 RosAlloc::Run* RosAlloc::dedicated_full_run_ =
@@ -87,6 +95,11 @@ RosAlloc::RosAlloc(void* base, size_t capacity, size_t max_capacity,
     size_bracket_locks_[i] = new Mutex(size_bracket_lock_names_[i].c_str(), kRosAllocBracketLock);
     current_runs_[i] = dedicated_full_run_;
   }
+  if (record_bracket_stats_) {
+    bracket_allocated_slots_.reset(new Atomic<uint64_t>[kNumOfSizeBrackets]());
+    bracket_freed_slots_.reset(new Atomic<uint64_t>[kNumOfSizeBrackets]());
+    request_size_counts_.reset(new Atomic<uint64_t>[kNumRequestSizeClasses]());
+  }
   DCHECK_EQ(footprint_, capacity_);
   size_t num_of_pages = DivideByPageSize(footprint_);
   size_t max_num_of_pages = DivideByPageSize(max_capacity_);
@@ -643,6 +656,7 @@ void* RosAlloc::AllocFromRunThreadUnsafe(Thread* self, size_t size, size_t* byte
     *bytes_allocated = bracket_size;
     *usable_size = bracket_size;
     *bytes_tl_bulk_allocated = bracket_size;
+    RecordAllocatedSlots(idx, 1);
   }
   // Caller verifies that it is all 0.
   return slot_addr;
@@ -716,7 +730,9 @@ void* RosAlloc::AllocFromRun(Thread* self, size_t size, size_t* bytes_allocated,
       DCHECK(!thread_local_run->IsFull());
       DCHECK(thread_local_run->IsThreadLocal());
       // Account for all the free slots in the new or refreshed thread local run.
-      *bytes_tl_bulk_allocated = thread_local_run->NumberOfFreeSlots() * bracket_size;
+      size_t num_free_slots = thread_local_run->NumberOfFreeSlots();
+      *bytes_tl_bulk_allocated = num_free_slots * bracket_size;
+      RecordAllocatedSlots(idx, num_free_slots);
       slot_addr = thread_local_run->AllocSlot();
       // Must succeed now with a new run.
       DCHECK(slot_addr != nullptr);
@@ -747,6 +763,7 @@ void* RosAlloc::AllocFromRun(Thread* self, size_t size, size_t* bytes_allocated,
       *bytes_allocated = bracket_size;
       *usable_size = bracket_size;
       *bytes_tl_bulk_allocated = bracket_size;
+      RecordAllocatedSlots(idx, 1);
     }
   }
   // Caller verifies that it is all 0.
@@ -760,6 +777,7 @@ size_t RosAlloc::FreeFromRun(Thread* self, void* ptr, Run* run) {
   const size_t idx = run->size_bracket_idx_;
   const size_t bracket_size = bracketSizes[idx];
   bool run_was_full = false;
+  RecordFreedSlot(idx);
   MutexLock brackets_mu(self, *size_bracket_locks_[idx]);
   if (kIsDebugBuild) {
     run_was_full = run->IsFull();
@@ -1081,6 +1099,7 @@ size_t RosAlloc::BulkFree(Thread* self, void** ptrs, size_t num_ptrs) {
     DCHECK_EQ(run->magic_num_, kMagicNum);
     // Set the bit in the bulk free bit map.
     freed_bytes += run->AddToBulkFreeList(ptr);
+    RecordFreedSlot(run->size_bracket_idx_);
 #ifdef ART_TARGET_ANDROID
     if (!run->to_be_bulk_freed_) {
       run->to_be_bulk_freed_ = true;
@@ -1515,6 +1534,7 @@ size_t RosAlloc::RevokeThreadLocalRuns(Thread* thread) {
       // Count the number of free slots left.
       size_t num_free_slots = thread_local_run->NumberOfFreeSlots();
       free_bytes += num_free_slots * bracketSizes[idx];
+      RecordUnusedSlots(idx, num_free_slots);
       // The above bracket index lock guards thread local free list to avoid race condition
       // with unioning bulk free list to thread local free list by GC thread in BulkFree.
       // If thread local run is true, GC thread will help update thread local free list
@@ -1624,6 +1644,8 @@ void RosAlloc::Initialize() {
   for (size_t i = 0; i < kNumOfSizeBrackets; i++) {
     if (i < kNumThreadLocalSizeBrackets) {
       bracketSizes[i] = kThreadLocalBracketQuantumSize * (i + 1);
+    } else if (has_custom_shared_bracket_sizes_) {
+      bracketSizes[i] = customSharedBracketSizes[i - kNumThreadLocalSizeBrackets];
     } else if (i < kNumRegularSizeBrackets) {
       bracketSizes[i] = kBracketQuantumSize * (i - kNumThreadLocalSizeBrackets + 1) +
           (kThreadLocalBracketQuantumSize *  kNumThreadLocalSizeBrackets);
@@ -1637,18 +1659,23 @@ void RosAlloc::Initialize() {
       LOG(INFO) << "bracketSizes[" << i << "]=" << bracketSizes[i];
     }
   }
+  // sharedBracketIndexes.
+  for (size_t i = 0, idx = kNumThreadLocalSizeBrackets; i < kNumSharedSizeQuanta; i++) {
+    size_t size = kMaxThreadLocalBracketSize + (i + 1) * kBracketQuantumSize;
+    while (bracketSizes[idx] < size) {
+      idx++;
+    }
+    DCHECK_LT(idx, kNumOfSizeBrackets);
+    sharedBracketIndexes[i] = dchecked_integral_cast<uint8_t>(idx);
+  }
   // numOfPages.
   for (size_t i = 0; i < kNumOfSizeBrackets; i++) {
-    if (i < kNumThreadLocalSizeBrackets) {
+    if (bracketSizes[i] <= kMaxRegularBracketSize) {
       numOfPages[i] = 1;
-    } else if (i < (kNumThreadLocalSizeBrackets + kNumRegularSizeBrackets) / 2) {
-      numOfPages[i] = 1;
-    } else if (i < kNumRegularSizeBrackets) {
-      numOfPages[i] = 1;
-    } else if (i == kNumOfSizeBrackets - 2) {
+    } else if (bracketSizes[i] <= 1 * KB) {
       numOfPages[i] = 2;
     } else {
-      DCHECK_EQ(i, kNumOfSizeBrackets - 1);
+      DCHECK_LE(bracketSizes[i], 2 * KB);
       numOfPages[i] = 4;
     }
     if (kTraceRosAlloc) {
@@ -1711,7 +1738,160 @@ void RosAlloc::Initialize() {
   DCHECK_LE(sizeof(Slot), bracketSizes[0]) << "sizeof(Slot) <= the smallest bracket size";
   // Check the invariants between the max bracket sizes and the number of brackets.
   DCHECK_EQ(kMaxThreadLocalBracketSize, bracketSizes[kNumThreadLocalSizeBrackets - 1]);
-  DCHECK_EQ(kMaxRegularBracketSize, bracketSizes[kNumRegularSizeBrackets - 1]);
+  DCHECK_EQ(kLargeSizeThreshold, bracketSizes[kNumOfSizeBrackets - 1]);
+  DCHECK(has_custom_shared_bracket_sizes_ ||
+         kMaxRegularBracketSize == bracketSizes[kNumRegularSizeBrackets - 1]);
+}
+
+bool RosAlloc::SetSharedBracketSizes(const std::vector<int>& sizes, std::string* error_msg) {
+  if (sizes.size() != kNumSharedSizeBrackets) {
+    *error_msg = StringPrintf("Expected %zu bracket sizes but got %zu",
+                              kNumSharedSizeBrackets,
+                              sizes.size());
+    return false;
+  }
+  int prev_size = static_cast<int>(kMaxThreadLocalBracketSize);
+  for (int size : sizes) {
+    if (size <= prev_size || size % kBracketQuantumSize != 0) {
+      *error_msg = StringPrintf("Bracket size %d is not a multiple of %zu larger than %d",
+                                size,
+                                kBracketQuantumSize,
+                                prev_size);
+      return false;
+    }
+    prev_size = size;
+  }
+  if (static_cast<size_t>(prev_size) != kLargeSizeThreshold) {
+    *error_msg = StringPrintf("The last bracket size must be %zu", kLargeSizeThreshold);
+    return false;
+  }
+  // The bracket tables are shared by all the RosAllocs and must not change under existing ones.
+  CHECK(!initialized_) << "Shared bracket sizes set after the first RosAlloc was created";
+  std::copy(sizes.begin(), sizes.end(), customSharedBracketSizes);
+  has_custom_shared_bracket_sizes_ = true;
+  return true;
+}
+
+std::vector<size_t> RosAlloc::ComputeSharedBracketSizes(
+    const std::vector<uint64_t>& request_counts) {
+  DCHECK_EQ(request_counts.size(), kNumRequestSizeClasses);
+  // Candidate bracket c (1 <= c <= kNumSharedSizeQuanta) has the size
+  // kMaxThreadLocalBracketSize + c * kBracketQuantumSize. counts[c] and bytes[c] are the prefix
+  // sums of the requests that fit in candidate c and of their sizes (the upper bounds of their
+  // size classes).
+  constexpr size_t kN = kNumSharedSizeQuanta;
+  auto candidate_size = [](size_t c) {
+    return kMaxThreadLocalBracketSize + c * kBracketQuantumSize;
+  };
+  std::vector<uint64_t> counts(kN + 1, 0u);
+  std::vector<uint64_t> bytes(kN + 1, 0u);
+  constexpr size_t kClassesPerQuantum = kBracketQuantumSize / kThreadLocalBracketQuantumSize;
+  for (size_t c = 1; c <= kN; ++c) {
+    counts[c] = counts[c - 1];
+    bytes[c] = bytes[c - 1];
+    for (size_t k = 0; k < kClassesPerQuantum; ++k) {
+      size_t size_class =
+          (kMaxThreadLocalBracketSize + (c - 1) * kBracketQuantumSize) /
+              kThreadLocalBracketQuantumSize + k;
+      uint64_t count = request_counts[size_class];
+      counts[c] += count;
+      bytes[c] += count * (size_class + 1) * kThreadLocalBracketQuantumSize;
+    }
+  }
+  // The rounding waste of the requests between candidates i (exclusive) and j (inclusive) when
+  // they all use bracket j.
+  auto waste = [&](size_t i, size_t j) {
+    return (counts[j] - counts[i]) * candidate_size(j) - (bytes[j] - bytes[i]);
+  };
+  // best[b][j] is the minimum waste with b brackets, the largest one being candidate j. Then
+  // pick the kNumSharedSizeBrackets brackets ending with candidate kN (kLargeSizeThreshold).
+  constexpr uint64_t kInfinity = std::numeric_limits<uint64_t>::max();
+  constexpr size_t kB = kNumSharedSizeBrackets;
+  std::vector<std::vector<uint64_t>> best(kB + 1, std::vector<uint64_t>(kN + 1, kInfinity));
+  std::vector<std::vector<size_t>> prev(kB + 1, std::vector<size_t>(kN + 1, 0u));
+  best[0][0] = 0u;
+  for (size_t b = 1; b <= kB; ++b) {
+    for (size_t j = b; j <= kN; ++j) {
+      for (size_t i = b - 1; i < j; ++i) {
+        if (best[b - 1][i] == kInfinity) {
+          continue;
+        }
+        uint64_t total = best[b - 1][i] + waste(i, j);
+        if (total < best[b][j]) {
+          best[b][j] = total;
+          prev[b][j] = i;
+        }
+      }
+    }
+  }
+  std::vector<size_t> sizes(kB);
+  for (size_t b = kB, j = kN; b > 0; j = prev[b][j], --b) {
+    sizes[b - 1] = candidate_size(j);
+  }
+  return sizes;
+}
+
+void RosAlloc::DumpBracketStats(std::ostream& os) {
+  if (!IsRecordingBracketStats()) {
+    return;
+  }
+  size_t num_runs[kNumOfSizeBrackets] = {};
+  {
+    MutexLock mu(Thread::Current(), lock_);
+    for (size_t i = 0; i < page_map_size_; ++i) {
+      if (page_map_[i] == kPageMapRun) {
+        // The header of a run that is being set up may not be written yet. Only the index is
+        // needed so don't check the magic number, just make sure the index is in range.
+        Run* run = reinterpret_cast<Run*>(base_ + i * gPageSize);
+        size_t idx = std::min<size_t>(run->size_bracket_idx_, kNumOfSizeBrackets - 1);
+        ++num_runs[idx];
+      }
+    }
+  }
+  std::vector<uint64_t> request_counts(kNumRequestSizeClasses);
+  uint64_t bracket_requests[kNumOfSizeBrackets] = {};
+  uint64_t bracket_waste[kNumOfSizeBrackets] = {};
+  uint64_t total_shared_requests = 0u;
+  for (size_t k = 0; k < kNumRequestSizeClasses; ++k) {
+    request_counts[k] = request_size_counts_[k].load(std::memory_order_relaxed);
+    size_t size = (k + 1) * kThreadLocalBracketQuantumSize;
+    size_t bracket_size;
+    size_t idx = SizeToIndexAndBracketSize(size, &bracket_size);
+    bracket_requests[idx] += request_counts[k];
+    // The requests are counted as the largest size of their class, so this is a lower bound.
+    bracket_waste[idx] += request_counts[k] * (bracket_size - size);
+    if (idx >= kNumThreadLocalSizeBrackets) {
+      total_shared_requests += request_counts[k];
+    }
+  }
+  os << "RosAlloc size brackets:\n";
+  uint64_t total_live_bytes = 0u;
+  uint64_t total_run_bytes = 0u;
+  for (size_t i = 0; i < kNumOfSizeBrackets; ++i) {
+    uint64_t allocated = bracket_allocated_slots_[i].load(std::memory_order_relaxed);
+    uint64_t freed = bracket_freed_slots_[i].load(std::memory_order_relaxed);
+    if (allocated == 0u && num_runs[i] == 0u) {
+      continue;
+    }
+    // The counters are read without synchronization so clamp the difference.
+    uint64_t live_slots = allocated > freed ? allocated - freed : 0u;
+    uint64_t run_slots = static_cast<uint64_t>(num_runs[i]) * numOfSlots[i];
+    total_live_bytes += live_slots * bracketSizes[i];
+    total_run_bytes += static_cast<uint64_t>(num_runs[i]) * numOfPages[i] * gPageSize;
+    os << "Bracket " << i << " (" << bracketSizes[i] << "):"
+       << " #runs=" << num_runs[i]
+       << " #live_slots=" << live_slots << " (" << PrettySize(live_slots * bracketSizes[i]) << ")"
+       << " utilization="
+       << StringPrintf("%.1f%%", run_slots == 0u ? 0.0 : 100.0 * live_slots / run_slots)
+       << " #requests=" << bracket_requests[i]
+       << " rounding_waste>=" << PrettySize(bracket_waste[i]) << "\n";
+  }
+  os << "RosAlloc live bytes in runs " << PrettySize(total_live_bytes)
+     << " of " << PrettySize(total_run_bytes) << "\n";
+  if (total_shared_requests != 0u) {
+    std::vector<size_t> sizes = ComputeSharedBracketSizes(request_counts);
+    os << "Suggested -XX:RosAllocBracketSizes=" << android::base::Join(sizes, ',') << "\n";
+  }
 }
 
 void RosAlloc::BytesAllocatedCallback([[maybe_unused]] void* start,
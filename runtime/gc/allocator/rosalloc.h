@@ -29,6 +29,7 @@
 #include <android-base/logging.h>
 
 #include "base/allocator.h"
+#include "base/atomic.h"
 #include "base/bit_utils.h"
 #include "base/macros.h"
 #include "base/mem_map.h"
@@ -515,21 +516,13 @@ class RosAlloc {
   static size_t BracketSizeToIndex(size_t size) {
     DCHECK(8 <= size &&
            ((size <= kMaxThreadLocalBracketSize && size % kThreadLocalBracketQuantumSize == 0) ||
-            (size <= kMaxRegularBracketSize && size % kBracketQuantumSize == 0) ||
-            size == 1 * KB || size == 2 * KB));
+            (size <= kLargeSizeThreshold && size % kBracketQuantumSize == 0)));
     size_t idx;
-    if (UNLIKELY(size == 1 * KB)) {
-      idx = kNumOfSizeBrackets - 2;
-    } else if (UNLIKELY(size == 2 * KB)) {
-      idx = kNumOfSizeBrackets - 1;
-    } else if (LIKELY(size <= kMaxThreadLocalBracketSize)) {
+    if (LIKELY(size <= kMaxThreadLocalBracketSize)) {
       DCHECK_EQ(size % kThreadLocalBracketQuantumSize, 0U);
       idx = size / kThreadLocalBracketQuantumSize - 1;
     } else {
-      DCHECK(size <= kMaxRegularBracketSize);
-      DCHECK_EQ((size - kMaxThreadLocalBracketSize) % kBracketQuantumSize, 0U);
-      idx = ((size - kMaxThreadLocalBracketSize) / kBracketQuantumSize - 1)
-          + kNumThreadLocalSizeBrackets;
+      idx = SharedSizeToIndex(size);
     }
     DCHECK(bracketSizes[idx] == size);
     return idx;
@@ -541,18 +534,26 @@ class RosAlloc {
            (is_size_for_thread_local == (SizeToIndex(size) < kNumThreadLocalSizeBrackets)));
     return is_size_for_thread_local;
   }
+  // Returns the index of the smallest shared size bracket that fits the given size. The shared
+  // bracket sizes may be configured (see SetSharedBracketSizes()) so this uses a lookup table
+  // rather than arithmetic.
+  static size_t SharedSizeToIndex(size_t size) {
+    DCHECK_GT(size, kMaxThreadLocalBracketSize);
+    DCHECK_LE(size, kLargeSizeThreshold);
+    size_t idx =
+        sharedBracketIndexes[(size - kMaxThreadLocalBracketSize - 1) / kBracketQuantumSize];
+    DCHECK_GE(idx, kNumThreadLocalSizeBrackets);
+    DCHECK_LE(size, bracketSizes[idx]);
+    DCHECK(idx == kNumThreadLocalSizeBrackets || bracketSizes[idx - 1] < size);
+    return idx;
+  }
   // Rounds up the size up the nearest bracket size.
   static size_t RoundToBracketSize(size_t size) {
     DCHECK(size <= kLargeSizeThreshold);
     if (LIKELY(size <= kMaxThreadLocalBracketSize)) {
       return RoundUp(size, kThreadLocalBracketQuantumSize);
-    } else if (size <= kMaxRegularBracketSize) {
-      return RoundUp(size, kBracketQuantumSize);
-    } else if (UNLIKELY(size <= 1 * KB)) {
-      return 1 * KB;
     } else {
-      DCHECK_LE(size, 2 * KB);
-      return 2 * KB;
+      return bracketSizes[SharedSizeToIndex(size)];
     }
   }
   // Returns the size bracket index from the byte size with rounding.
@@ -560,14 +561,8 @@ class RosAlloc {
     DCHECK(size <= kLargeSizeThreshold);
     if (LIKELY(size <= kMaxThreadLocalBracketSize)) {
       return RoundUp(size, kThreadLocalBracketQuantumSize) / kThreadLocalBracketQuantumSize - 1;
-    } else if (size <= kMaxRegularBracketSize) {
-      return (RoundUp(size, kBracketQuantumSize) - kMaxThreadLocalBracketSize) / kBracketQuantumSize
-          - 1 + kNumThreadLocalSizeBrackets;
-    } else if (size <= 1 * KB) {
-      return kNumOfSizeBrackets - 2;
     } else {
-      DCHECK_LE(size, 2 * KB);
-      return kNumOfSizeBrackets - 1;
+      return SharedSizeToIndex(size);
     }
   }
   // A combination of SizeToIndex() and RoundToBracketSize().
@@ -578,26 +573,16 @@ class RosAlloc {
     if (LIKELY(size <= kMaxThreadLocalBracketSize)) {
       bracket_size = RoundUp(size, kThreadLocalBracketQuantumSize);
       idx = bracket_size / kThreadLocalBracketQuantumSize - 1;
-    } else if (size <= kMaxRegularBracketSize) {
-      bracket_size = RoundUp(size, kBracketQuantumSize);
-      idx = ((bracket_size - kMaxThreadLocalBracketSize) / kBracketQuantumSize - 1)
-          + kNumThreadLocalSizeBrackets;
-    } else if (size <= 1 * KB) {
-      bracket_size = 1 * KB;
-      idx = kNumOfSizeBrackets - 2;
     } else {
-      DCHECK(size <= 2 * KB);
-      bracket_size = 2 * KB;
-      idx = kNumOfSizeBrackets - 1;
+      idx = SharedSizeToIndex(size);
+      bracket_size = bracketSizes[idx];
     }
     DCHECK_EQ(idx, SizeToIndex(size)) << idx;
     DCHECK_EQ(bracket_size, IndexToBracketSize(idx)) << idx;
     DCHECK_EQ(bracket_size, bracketSizes[idx]) << idx;
     DCHECK_LE(size, bracket_size) << idx;
-    DCHECK(size > kMaxRegularBracketSize ||
-           (size <= kMaxThreadLocalBracketSize &&
-            bracket_size - size < kThreadLocalBracketQuantumSize) ||
-           (size <= kMaxRegularBracketSize && bracket_size - size < kBracketQuantumSize)) << idx;
+    DCHECK(size > kMaxThreadLocalBracketSize ||
+           bracket_size - size < kThreadLocalBracketQuantumSize) << idx;
     *bracket_size_out = bracket_size;
     return idx;
   }
@@ -690,7 +675,32 @@ class RosAlloc {
   // Equal to Log2(kBracketQuantumSize).
   static constexpr size_t kBracketQuantumSizeShift = 4;
 
+  // The number of size brackets that use shared (current) runs. Their sizes are multiples of
+  // kBracketQuantumSize, larger than kMaxThreadLocalBracketSize, and the largest one is
+  // kLargeSizeThreshold.
+  static constexpr size_t kNumSharedSizeBrackets = kNumOfSizeBrackets - kNumThreadLocalSizeBrackets;
+
+  // The number of kBracketQuantumSize steps between kMaxThreadLocalBracketSize and
+  // kLargeSizeThreshold, i.e. the number of possible shared bracket sizes.
+  static constexpr size_t kNumSharedSizeQuanta =
+      (kLargeSizeThreshold - kMaxThreadLocalBracketSize) / kBracketQuantumSize;
+
+  // The number of request size classes recorded by the bracket stats, one per
+  // kThreadLocalBracketQuantumSize up to kLargeSizeThreshold.
+  static constexpr size_t kNumRequestSizeClasses =
+      kLargeSizeThreshold / kThreadLocalBracketQuantumSize;
+
  private:
+  // Maps (size - kMaxThreadLocalBracketSize - 1) / kBracketQuantumSize to the index of the
+  // smallest shared size bracket that fits the size.
+  static uint8_t sharedBracketIndexes[kNumSharedSizeQuanta];
+  // Whether the shared bracket sizes were set by SetSharedBracketSizes().
+  static bool has_custom_shared_bracket_sizes_;
+  // The shared bracket sizes set by SetSharedBracketSizes().
+  static size_t customSharedBracketSizes[kNumSharedSizeBrackets];
+  // Whether the allocators created from now on record bracket stats.
+  static bool record_bracket_stats_;
+
   // The base address of the memory region that's managed by this allocator.
   uint8_t* base_;
 
@@ -769,6 +779,43 @@ class RosAlloc {
   // Whether this allocator is running on a memory tool.
   bool is_running_on_memory_tool_;
 
+  // Per size bracket counters, only allocated if record_bracket_stats_ was set when this
+  // allocator was created. The slots of a thread-local run are counted as allocated when the run
+  // is (re)filled and the unused ones are uncounted when it is revoked, the same way as the
+  // bytes_tl_bulk_allocated accounting.
+  std::unique_ptr<Atomic<uint64_t>[]> bracket_allocated_slots_;
+  std::unique_ptr<Atomic<uint64_t>[]> bracket_freed_slots_;
+  // Histogram of the requested sizes, in kThreadLocalBracketQuantumSize classes. Only covers the
+  // allocations that go through Alloc() and AllocFromThreadLocalRun(), not the ones made by the
+  // allocation entrypoints directly from the thread-local runs.
+  std::unique_ptr<Atomic<uint64_t>[]> request_size_counts_;
+
+  bool IsRecordingBracketStats() const {
+    return bracket_allocated_slots_ != nullptr;
+  }
+  ALWAYS_INLINE void RecordAllocatedSlots(size_t idx, size_t num_slots) {
+    if (UNLIKELY(IsRecordingBracketStats())) {
+      bracket_allocated_slots_[idx].fetch_add(num_slots, std::memory_order_relaxed);
+    }
+  }
+  ALWAYS_INLINE void RecordUnusedSlots(size_t idx, size_t num_slots) {
+    if (UNLIKELY(IsRecordingBracketStats())) {
+      bracket_allocated_slots_[idx].fetch_sub(num_slots, std::memory_order_relaxed);
+    }
+  }
+  ALWAYS_INLINE void RecordFreedSlot(size_t idx) {
+    if (UNLIKELY(IsRecordingBracketStats())) {
+      bracket_freed_slots_[idx].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  ALWAYS_INLINE void RecordRequestSize(size_t size) {
+    if (UNLIKELY(IsRecordingBracketStats())) {
+      DCHECK_LE(size, kLargeSizeThreshold);
+      size_t size_class = size == 0 ? 0 : (size - 1) / kThreadLocalBracketQuantumSize;
+      request_size_counts_[size_class].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
   // The base address of the memory region that's managed by this allocator.
   uint8_t* Begin() { return base_; }
   // The end address of the memory region that's managed by this allocator.
@@ -937,8 +984,31 @@ class RosAlloc {
   void DumpStats(std::ostream& os)
       REQUIRES(Locks::mutator_lock_) REQUIRES(!lock_) REQUIRES(!bulk_free_lock_);
 
+  // Use the given sizes for the size brackets that use shared (current) runs instead of the
+  // default ones (16-byte increments up to kMaxRegularBracketSize, then 1 KB and 2 KB). The sizes
+  // must be kNumSharedSizeBrackets increasing multiples of kBracketQuantumSize, larger than
+  // kMaxThreadLocalBracketSize and ending with kLargeSizeThreshold. Returns false and sets
+  // error_msg if the sizes are invalid. Valid sizes must be set before the first RosAlloc of the
+  // process is created, or this aborts.
+  static bool SetSharedBracketSizes(const std::vector<int>& sizes, std::string* error_msg);
+
+  // Record per size bracket allocation stats in the allocators created from now on.
+  static void SetRecordBracketStats(bool record) {
+    record_bracket_stats_ = record;
+  }
+
+  // Returns the shared bracket sizes that minimize the rounding waste of the requests in the
+  // given histogram of kNumRequestSizeClasses request size classes.
+  static std::vector<size_t> ComputeSharedBracketSizes(const std::vector<uint64_t>& request_counts);
+
+  // Dump the recorded per size bracket stats, if any: the live slots, the run utilization and the
+  // rounding waste of each bracket, and the shared bracket sizes suggested by the recorded request
+  // sizes. Doesn't need the mutator lock.
+  void DumpBracketStats(std::ostream& os) REQUIRES(!lock_);
+
  private:
   friend std::ostream& operator<<(std::ostream& os, RosAlloc::PageMapKind rhs);
+  friend class RosAllocTest;  // For resetting the bracket tables in a child process.
 
   DISALLOW_COPY_AND_ASSIGN(RosAlloc);
 };
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rosalloc.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/common_art_test.h"
+#include "base/mem_map.h"
+
+namespace art HIDDEN {
+namespace gc {
+namespace allocator {
+
+class RosAllocTest : public CommonArtTest {
+ protected:
+  static constexpr size_t kCapacity = 1 * MB;
+
+  // The bracket tables are process wide, and earlier tests may have created RosAllocs. Only
+  // called in child processes, where no RosAlloc exists.
+  static void ResetBracketTables() {
+    RosAlloc::initialized_ = false;
+    RosAlloc::has_custom_shared_bracket_sizes_ = false;
+  }
+
+  static std::unique_ptr<RosAlloc> CreateRosAlloc(MemMap* mem_map) {
+    std::string error_msg;
+    *mem_map = MemMap::MapAnonymous("rosalloc test",
+                                    kCapacity,
+                                    PROT_READ | PROT_WRITE,
+                                    /*low_4gb=*/ false,
+                                    &error_msg);
+    CHECK(mem_map->IsValid()) << error_msg;
+    return std::make_unique<RosAlloc>(mem_map->Begin(),
+                                      kCapacity,
+                                      kCapacity,
+                                      RosAlloc::kPageReleaseModeNone,
+                                      /*running_on_memory_tool=*/ false);
+  }
+
+  // The default sizes up to 480 bytes, then 640, 768, 1536 and 2048 bytes.
+  static std::vector<int> CustomSharedBracketSizes() {
+    std::vector<int> sizes;
+    for (int size = 144; size <= 480; size += 16) {
+      sizes.push_back(size);
+    }
+    sizes.insert(sizes.end(), {640, 768, 1536, 2048});
+    return sizes;
+  }
+};
+
+TEST_F(RosAllocTest, InvalidSharedBracketSizes) {
+  std::string error_msg;
+  // Too few brackets.
+  EXPECT_FALSE(RosAlloc::SetSharedBracketSizes({144, 160, 2048}, &error_msg));
+  EXPECT_FALSE(error_msg.empty());
+
+  // Not increasing.
+  std::vector<int> sizes = CustomSharedBracketSizes();
+  std::swap(sizes[0], sizes[1]);
+  error_msg.clear();
+  EXPECT_FALSE(RosAlloc::SetSharedBracketSizes(sizes, &error_msg));
+  EXPECT_FALSE(error_msg.empty());
+
+  // Not ending with the large object threshold.
+  sizes = CustomSharedBracketSizes();
+  sizes.back() = 1600;
+  error_msg.clear();
+  EXPECT_FALSE(RosAlloc::SetSharedBracketSizes(sizes, &error_msg));
+  EXPECT_FALSE(error_msg.empty());
+}
+
+TEST_F(RosAllocTest, CustomSharedBracketSizes) {
+  ASSERT_EXIT({
+    ResetBracketTables();
+    std::string error_msg;
+    if (!RosAlloc::SetSharedBracketSizes(CustomSharedBracketSizes(), &error_msg)) {
+      LOG(FATAL) << error_msg;
+    }
+    MemMap mem_map;
+    std::unique_ptr<RosAlloc> rosalloc = CreateRosAlloc(&mem_map);
+    // Thread-local brackets are not configurable.
+    CHECK_EQ(rosalloc->UsableSize(100u), 104u);
+    CHECK_EQ(rosalloc->UsableSize(480u), 480u);
+    CHECK_EQ(rosalloc->UsableSize(500u), 640u);
+    CHECK_EQ(rosalloc->UsableSize(700u), 768u);
+    CHECK_EQ(rosalloc->UsableSize(1100u), 1536u);
+    CHECK_EQ(rosalloc->UsableSize(1600u), 2048u);
+    exit(0);
+  }, ::testing::ExitedWithCode(0), "");
+}
+
+TEST_F(RosAllocTest, SharedBracketSizesAfterFirstRosAlloc) {
+  ASSERT_DEATH({
+    ResetBracketTables();
+    MemMap mem_map;
+    std::unique_ptr<RosAlloc> rosalloc = CreateRosAlloc(&mem_map);
+    std::string error_msg;
+    RosAlloc::SetSharedBracketSizes(CustomSharedBracketSizes(), &error_msg);
+  }, "Shared bracket sizes set after the first RosAlloc was created");
+}
+
+}  // namespace allocator
+}  // namespace gc
+}  // namespace art
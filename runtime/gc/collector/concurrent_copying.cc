@@ -24,6 +24,7 @@
 #include "base/quasi_atomic.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
+#include "base/time_utils.h"
 #include "class_root-inl.h"
 #include "debugger.h"
 #include "gc/accounting/atomic_stack.h"
@@ -45,6 +46,7 @@
 #include "scoped_thread_state_change-inl.h"
 #include "thread-inl.h"
 #include "thread_list.h"
+#include "thread_pool.h"
 #include "well_known_classes.h"
 
 namespace art HIDDEN {
@@ -66,6 +68,71 @@ static constexpr size_t kReadBarrierMarkStackSize = 512 * KB;
 static constexpr size_t kSweepArrayChunkFreeSize = 1024;
 // Verify that there are no missing card marks.
 static constexpr bool kVerifyNoMissingCardMarks = kIsDebugBuild;
+// Minimum size of the GC mark stack for processing it with parallel marking
+// workers. Below that the cost of waking up the workers isn't worth it.
+static constexpr size_t kMinimumParallelMarkStackSize = 128;
+// Number of references a parallel marking worker hands out at once to be
+// stolen by idle workers.
+static constexpr size_t kMarkingWorkStealBatchSize = 64;
+
+// State of a parallel marking worker. Only the owner pushes onto and pops from
+// `mark_stack`. When other workers are idle, the owner moves a batch of its
+// references to `steal_stack`, from which any worker may take them under `lock`.
+struct ConcurrentCopying::MarkingWorker {
+  explicit MarkingWorker(size_t worker_index)
+      : index(worker_index),
+        mark_stack(nullptr),
+        lock("concurrent copying marking worker lock", kMarkSweepMarkStackLock),
+        steal_stack(accounting::ObjectStack::Create("concurrent copying steal stack",
+                                                    kMarkingWorkStealBatchSize,
+                                                    kMarkingWorkStealBatchSize)),
+        steal_stack_size(0),
+        objects_processed(0),
+        bytes_scanned(0),
+        duration_ns(0),
+        cpu_time_ns(0) {}
+
+  const size_t index;
+  // For worker 0 this is the GC mark stack.
+  accounting::ObjectStack* mark_stack;
+  std::unique_ptr<accounting::ObjectStack> owned_mark_stack;
+  Mutex lock;
+  std::unique_ptr<accounting::ObjectStack> steal_stack GUARDED_BY(lock);
+  // Number of references in `steal_stack`, to check for work without the lock.
+  Atomic<size_t> steal_stack_size;
+  // Statistics of the ongoing GC cycle.
+  size_t objects_processed;
+  uint64_t bytes_scanned;
+  uint64_t duration_ns;
+  // Thread CPU time of the last run of a worker of the heap thread pool.
+  uint64_t cpu_time_ns;
+};
+
+class ConcurrentCopying::ParallelMarkTask : public Task {
+ public:
+  ParallelMarkTask(ConcurrentCopying* collector, MarkingWorker* worker)
+      : collector_(collector), worker_(worker) {}
+
+  // Scans objects the same way as the GC-running thread, which holds the
+  // mutator lock and waits for this task to complete.
+  void Run([[maybe_unused]] Thread* self) override NO_THREAD_SAFETY_ANALYSIS {
+    const uint64_t cpu_start_time = ThreadCpuNanoTime();
+    current_marking_worker_ = worker_;
+    collector_->RunMarkingWorker(worker_);
+    current_marking_worker_ = nullptr;
+    worker_->cpu_time_ns = ThreadCpuNanoTime() - cpu_start_time;
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  ConcurrentCopying* const collector_;
+  MarkingWorker* const worker_;
+};
+
+thread_local ConcurrentCopying::MarkingWorker* ConcurrentCopying::current_marking_worker_ = nullptr;
 
 ConcurrentCopying::ConcurrentCopying(Heap* heap,
                                      bool young_gen,
@@ -88,6 +155,10 @@ ConcurrentCopying::ConcurrentCopying(Heap* heap,
       rb_mark_bit_stack_full_(false),
       mark_stack_lock_("concurrent copying mark stack lock", kMarkSweepMarkStackLock),
       thread_running_gc_(nullptr),
+      num_marking_workers_(0),
+      num_active_marking_workers_(0),
+      marking_idle_lock_("concurrent copying marking idle lock", kMarkSweepMarkStackLock),
+      marking_idle_cond_("concurrent copying marking idle condition", marking_idle_lock_),
       is_marking_(false),
       is_using_read_barrier_entrypoints_(false),
       is_active_(false),
@@ -431,6 +502,11 @@ void ConcurrentCopying::InitializePhase() {
   bytes_moved_gc_thread_ = 0;
   objects_moved_gc_thread_ = 0;
   bytes_scanned_ = 0;
+  for (auto& worker : marking_workers_) {
+    worker->objects_processed = 0;
+    worker->bytes_scanned = 0;
+    worker->duration_ns = 0;
+  }
   GcCause gc_cause = GetCurrentIteration()->GetGcCause();
 
   force_evacuate_all_ = false;
@@ -1820,15 +1896,26 @@ void ConcurrentCopying::IssueEmptyCheckpoint() {
 }
 
 void ConcurrentCopying::ExpandGcMarkStack() {
-  DCHECK(gc_mark_stack_->IsFull());
-  const size_t new_size = gc_mark_stack_->Capacity() * 2;
-  std::vector<StackReference<mirror::Object>> temp(gc_mark_stack_->Begin(),
-                                                   gc_mark_stack_->End());
-  gc_mark_stack_->Resize(new_size);
+  ExpandMarkStack(gc_mark_stack_.get());
+}
+
+void ConcurrentCopying::ExpandMarkStack(accounting::ObjectStack* mark_stack) {
+  DCHECK(mark_stack->IsFull());
+  const size_t new_size = mark_stack->Capacity() * 2;
+  std::vector<StackReference<mirror::Object>> temp(mark_stack->Begin(), mark_stack->End());
+  mark_stack->Resize(new_size);
   for (auto& ref : temp) {
-    gc_mark_stack_->PushBack(ref.AsMirrorPtr());
+    mark_stack->PushBack(ref.AsMirrorPtr());
   }
-  DCHECK(!gc_mark_stack_->IsFull());
+  DCHECK(!mark_stack->IsFull());
+}
+
+void ConcurrentCopying::PushOntoWorkerMarkStack(MarkingWorker* worker, mirror::Object* to_ref) {
+  accounting::ObjectStack* mark_stack = worker->mark_stack;
+  if (UNLIKELY(mark_stack->IsFull())) {
+    ExpandMarkStack(mark_stack);
+  }
+  mark_stack->PushBack(to_ref);
 }
 
 void ConcurrentCopying::PushOntoMarkStack(Thread* const self, mirror::Object* to_ref) {
@@ -1845,6 +1932,13 @@ void ConcurrentCopying::PushOntoMarkStack(Thread* const self, mirror::Object* to
       }
       gc_mark_stack_->PushBack(to_ref);
     } else {
+      // A parallel marking worker uses its own mark stack.
+      MarkingWorker* worker = current_marking_worker_;
+      if (UNLIKELY(worker != nullptr)) {
+        DCHECK_EQ(self, Thread::Current());
+        PushOntoWorkerMarkStack(worker, to_ref);
+        return;
+      }
       // Otherwise, use a thread-local mark stack.
       accounting::AtomicStack<mirror::Object>* tl_mark_stack = self->GetThreadLocalMarkStack();
       if (UNLIKELY(tl_mark_stack == nullptr || tl_mark_stack->IsFull())) {
@@ -2139,7 +2233,29 @@ bool ConcurrentCopying::ProcessMarkStackOnce() {
   DCHECK(thread_running_gc_->GetThreadLocalMarkStack() == nullptr);
   size_t count = 0;
   MarkStackMode mark_stack_mode = mark_stack_mode_.load(std::memory_order_acquire);
-  if (mark_stack_mode == kMarkStackModeThreadLocal) {
+  const size_t marking_thread_count = GetParallelGcThreadCount();
+  if (mark_stack_mode == kMarkStackModeThreadLocal && marking_thread_count > 1) {
+    // Gather the thread-local mark stacks onto the GC mark stack and process it
+    // in parallel if it's large enough.
+    count += ProcessThreadLocalMarkStacks(/* disable_weak_ref_access= */ false,
+                                          /* checkpoint_callback= */ nullptr,
+                                          [this] (mirror::Object* ref)
+                                              REQUIRES_SHARED(Locks::mutator_lock_) {
+                                            if (UNLIKELY(gc_mark_stack_->IsFull())) {
+                                              ExpandGcMarkStack();
+                                            }
+                                            gc_mark_stack_->PushBack(ref);
+                                          });
+    if (gc_mark_stack_->Size() >= kMinimumParallelMarkStackSize) {
+      count += ProcessMarkStackParallel(marking_thread_count);
+    }
+    while (!gc_mark_stack_->IsEmpty()) {
+      mirror::Object* to_ref = gc_mark_stack_->PopBack();
+      ProcessMarkStackRef(to_ref);
+      ++count;
+    }
+    gc_mark_stack_->Reset();
+  } else if (mark_stack_mode == kMarkStackModeThreadLocal) {
     // Process the thread-local mark stacks and the GC mark stack.
     count += ProcessThreadLocalMarkStacks(/* disable_weak_ref_access= */ false,
                                           /* checkpoint_callback= */ nullptr,
@@ -2204,6 +2320,199 @@ bool ConcurrentCopying::ProcessMarkStackOnce() {
   return count == 0;
 }
 
+size_t ConcurrentCopying::GetParallelGcThreadCount() const {
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  // Use only the GC-running thread in a background state (non jank perceptible)
+  // to leave more CPU time for the foreground apps.
+  if (thread_pool == nullptr || !Runtime::Current()->InJankPerceptibleProcessState()) {
+    return 1;
+  }
+  return std::min(heap_->GetConcGCThreadCount(), thread_pool->GetThreadCount()) + 1;
+}
+
+bool ConcurrentCopying::IsGcMarkingThread(Thread* self) const {
+  DCHECK_EQ(self, Thread::Current());
+  return self == thread_running_gc_ || current_marking_worker_ != nullptr;
+}
+
+size_t ConcurrentCopying::ProcessMarkStackParallel(size_t thread_count) {
+  TimingLogger::ScopedTiming split("ProcessMarkStackParallel", GetTimings());
+  Thread* const self = thread_running_gc_;
+  DCHECK_EQ(Thread::Current(), self);
+  DCHECK_EQ(static_cast<uint32_t>(mark_stack_mode_.load(std::memory_order_relaxed)),
+            static_cast<uint32_t>(kMarkStackModeThreadLocal));
+  DCHECK_GT(thread_count, 1u);
+  if (marking_workers_.empty()) {
+    // Allocate all the workers at once, as workers look each other up in
+    // `marking_workers_` while stealing.
+    const size_t max_thread_count = heap_->GetThreadPool()->GetThreadCount() + 1;
+    for (size_t i = 0; i < max_thread_count; ++i) {
+      marking_workers_.emplace_back(new MarkingWorker(i));
+      if (i == 0) {
+        marking_workers_[i]->mark_stack = gc_mark_stack_.get();
+      } else {
+        marking_workers_[i]->owned_mark_stack.reset(
+            accounting::ObjectStack::Create("concurrent copying marking worker mark stack",
+                                            kDefaultGcMarkStackSize,
+                                            kDefaultGcMarkStackSize));
+        marking_workers_[i]->mark_stack = marking_workers_[i]->owned_mark_stack.get();
+      }
+    }
+  }
+  DCHECK_LE(thread_count, marking_workers_.size());
+  num_marking_workers_ = thread_count;
+  // Distribute the GC mark stack evenly over the workers.
+  const size_t refs_per_worker = gc_mark_stack_->Size() / thread_count;
+  std::vector<size_t> objects_processed_before(thread_count);
+  std::vector<uint64_t> bytes_scanned_before(thread_count);
+  for (size_t i = 0; i < thread_count; ++i) {
+    MarkingWorker* worker = marking_workers_[i].get();
+    DCHECK_EQ(worker->steal_stack_size.load(std::memory_order_relaxed), 0u);
+    objects_processed_before[i] = worker->objects_processed;
+    bytes_scanned_before[i] = worker->bytes_scanned;
+    if (i != 0) {
+      DCHECK(worker->mark_stack->IsEmpty());
+      for (size_t j = 0; j < refs_per_worker; ++j) {
+        PushOntoWorkerMarkStack(worker, gc_mark_stack_->PopBack());
+      }
+    }
+  }
+  num_active_marking_workers_.store(thread_count, std::memory_order_relaxed);
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  for (size_t i = 1; i < thread_count; ++i) {
+    thread_pool->AddTask(self, new ParallelMarkTask(this, marking_workers_[i].get()));
+  }
+  thread_pool->SetMaxActiveWorkers(thread_count - 1);
+  thread_pool->StartWorkers(self);
+  RunMarkingWorker(marking_workers_[0].get());
+  thread_pool->Wait(self, /* do_work= */ false, /* may_hold_locks= */ true);
+  thread_pool->StopWorkers(self);
+  size_t count = 0;
+  for (size_t i = 0; i < thread_count; ++i) {
+    MarkingWorker* worker = marking_workers_[i].get();
+    DCHECK(worker->mark_stack->IsEmpty());
+    count += worker->objects_processed - objects_processed_before[i];
+    if (i != 0) {
+      // Scan() accounts only for the objects scanned by the GC-running thread.
+      bytes_scanned_ += worker->bytes_scanned - bytes_scanned_before[i];
+      // GarbageCollector::Run() measures only the GC-running thread's CPU time.
+      total_thread_cpu_time_ns_ += worker->cpu_time_ns;
+      worker->cpu_time_ns = 0;
+    }
+  }
+  num_marking_workers_ = 0;
+  return count;
+}
+
+void ConcurrentCopying::RunMarkingWorker(MarkingWorker* worker) {
+  Thread* const self = Thread::Current();
+  const uint64_t start_time = NanoTime();
+  accounting::ObjectStack* const mark_stack = worker->mark_stack;
+  while (true) {
+    while (!mark_stack->IsEmpty()) {
+      ProcessMarkStackRef(mark_stack->PopBack(), worker);
+      ++worker->objects_processed;
+      if (mark_stack->Size() > kMarkingWorkStealBatchSize &&
+          num_active_marking_workers_.load(std::memory_order_relaxed) < num_marking_workers_ &&
+          worker->steal_stack_size.load(std::memory_order_relaxed) == 0) {
+        ShareMarkingWork(worker);
+      }
+    }
+    if (StealMarkingWork(worker)) {
+      continue;
+    }
+    // Out of work. Park until either all the workers are idle or there is
+    // something to steal. The active worker count only changes under
+    // `marking_idle_lock_`, so that no wake-up gets lost.
+    bool found_work = false;
+    {
+      MutexLock mu(self, marking_idle_lock_);
+      num_active_marking_workers_.fetch_sub(1, std::memory_order_relaxed);
+      while (num_active_marking_workers_.load(std::memory_order_relaxed) != 0) {
+        if (HasMarkingWorkToSteal()) {
+          // Become active again before stealing, so that the others keep waiting
+          // for the work this worker may produce.
+          num_active_marking_workers_.fetch_add(1, std::memory_order_relaxed);
+          found_work = true;
+          break;
+        }
+        marking_idle_cond_.WaitHoldingLocks(self);
+      }
+      if (!found_work) {
+        // Marking is complete. Let the other idle workers finish too.
+        marking_idle_cond_.Broadcast(self);
+      }
+    }
+    if (!found_work) {
+      break;
+    }
+  }
+  worker->duration_ns += NanoTime() - start_time;
+}
+
+void ConcurrentCopying::ShareMarkingWork(MarkingWorker* worker) {
+  Thread* const self = Thread::Current();
+  {
+    MutexLock mu(self, worker->lock);
+    accounting::ObjectStack* steal_stack = worker->steal_stack.get();
+    DCHECK(steal_stack->IsEmpty());
+    for (size_t i = 0; i < kMarkingWorkStealBatchSize; ++i) {
+      steal_stack->PushBack(worker->mark_stack->PopBack());
+    }
+    worker->steal_stack_size.store(kMarkingWorkStealBatchSize, std::memory_order_release);
+  }
+  // Wake up an idle worker to steal the batch.
+  MutexLock mu(self, marking_idle_lock_);
+  marking_idle_cond_.Signal(self);
+}
+
+bool ConcurrentCopying::StealMarkingWork(MarkingWorker* thief) {
+  Thread* const self = Thread::Current();
+  // Start with the references the thief itself has shared.
+  for (size_t i = 0; i < num_marking_workers_; ++i) {
+    MarkingWorker* victim = marking_workers_[(thief->index + i) % num_marking_workers_].get();
+    if (victim->steal_stack_size.load(std::memory_order_acquire) == 0) {
+      continue;
+    }
+    MutexLock mu(self, victim->lock);
+    accounting::ObjectStack* steal_stack = victim->steal_stack.get();
+    if (steal_stack->IsEmpty()) {
+      continue;
+    }
+    while (!steal_stack->IsEmpty()) {
+      PushOntoWorkerMarkStack(thief, steal_stack->PopBack());
+    }
+    victim->steal_stack_size.store(0, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+bool ConcurrentCopying::HasMarkingWorkToSteal() const {
+  for (size_t i = 0; i < num_marking_workers_; ++i) {
+    if (marking_workers_[i]->steal_stack_size.load(std::memory_order_relaxed) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ConcurrentCopying::ReportMarkingWorkerThroughput() {
+  if (!are_metrics_initialized_) {
+    return;
+  }
+  for (auto& worker : marking_workers_) {
+    if (worker->duration_ns == 0) {
+      continue;
+    }
+    // Throughput in MB/s. Add 1us to prevent possible division by 0.
+    uint64_t throughput = (worker->bytes_scanned * 1'000'000) / (NsToUs(worker->duration_ns) + 1);
+    gc_tracing_throughput_hist_->Add(throughput / MB);
+    VLOG(gc) << GetName() << " marking worker " << worker->index << " scanned "
+             << PrettySize(worker->bytes_scanned) << " in " << PrettyDuration(worker->duration_ns);
+  }
+}
+
 template <typename Processor>
 size_t ConcurrentCopying::ProcessThreadLocalMarkStacks(bool disable_weak_ref_access,
                                                        Closure* checkpoint_callback,
@@ -2248,8 +2557,10 @@ size_t ConcurrentCopying::ProcessThreadLocalMarkStacks(bool disable_weak_ref_acc
   return count;
 }
 
-inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
+inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref, MarkingWorker* worker) {
   DCHECK(!region_space_->IsInFromSpace(to_ref));
+  // Parallel marking workers share the mark bitmaps and live bytes.
+  const bool parallel = worker != nullptr;
   size_t obj_size = 0;
   space::RegionSpace::RegionType rtype = region_space_->GetRegionType(to_ref);
   if (kUseBakerReadBarrier) {
@@ -2270,7 +2581,9 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
   switch (rtype) {
     case space::RegionSpace::RegionType::kRegionTypeUnevacFromSpace:
       // Mark the bitmap only in the GC thread here so that we don't need a CAS.
-      if (!kUseBakerReadBarrier || !region_space_bitmap_->Set(to_ref)) {
+      if (!kUseBakerReadBarrier ||
+          !(parallel ? region_space_bitmap_->AtomicTestAndSet(to_ref)
+                     : region_space_bitmap_->Set(to_ref))) {
         // It may be already marked if we accidentally pushed the same object twice due to the racy
         // bitmap read in MarkUnevacFromSpaceRegion.
         if (use_generational_cc_ && young_gen_) {
@@ -2292,7 +2605,11 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
     case space::RegionSpace::RegionType::kRegionTypeToSpace:
       if (use_generational_cc_) {
         // Copied to to-space, set the bit so that the next GC can scan objects.
-        region_space_bitmap_->Set(to_ref);
+        if (parallel) {
+          region_space_bitmap_->AtomicTestAndSet(to_ref);
+        } else {
+          region_space_bitmap_->Set(to_ref);
+        }
       }
       perform_scan = true;
       break;
@@ -2323,12 +2640,14 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
               heap_->GetLargeObjectsSpace()->GetMarkBitmap();
           DCHECK(los_bitmap->HasAddress(to_ref));
           // Only the GC thread could be setting the LOS bit map hence doesn't
-          // need to be atomically done.
-          perform_scan = !los_bitmap->Set(to_ref);
+          // need to be atomically done, unless marking in parallel.
+          perform_scan = !(parallel ? los_bitmap->AtomicTestAndSet(to_ref)
+                                    : los_bitmap->Set(to_ref));
         } else {
           // Only the GC thread could be setting the non-moving space bit map
-          // hence doesn't need to be atomically done.
-          perform_scan = !mark_bitmap->Set(to_ref);
+          // hence doesn't need to be atomically done, unless marking in parallel.
+          perform_scan = !(parallel ? mark_bitmap->AtomicTestAndSet(to_ref)
+                                    : mark_bitmap->Set(to_ref));
         }
       } else {
         perform_scan = true;
@@ -2341,6 +2660,9 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
     } else {
       Scan<false>(to_ref, obj_size);
     }
+    if (parallel) {
+      worker->bytes_scanned += obj_size;
+    }
   }
   if (kUseBakerReadBarrier) {
     DCHECK(to_ref->GetReadBarrierState() == ReadBarrier::GrayState())
@@ -2380,12 +2702,16 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
 
   if (add_to_live_bytes) {
     // Add to the live bytes per unevacuated from-space. Note this code is always run by the
-    // GC-running thread (no synchronization required).
+    // GC-running thread (no synchronization required), unless marking in parallel.
     DCHECK(region_space_bitmap_->Test(to_ref));
     if (obj_size == 0) {
       obj_size = to_ref->SizeOf<kDefaultVerifyFlags>();
     }
-    region_space_->AddLiveBytes(to_ref, RoundUp(obj_size, space::RegionSpace::kAlignment));
+    if (parallel) {
+      region_space_->AtomicAddLiveBytes(to_ref, RoundUp(obj_size, space::RegionSpace::kAlignment));
+    } else {
+      region_space_->AddLiveBytes(to_ref, RoundUp(obj_size, space::RegionSpace::kAlignment));
+    }
   }
   if (ReadBarrier::kEnableToSpaceInvariantChecks) {
     CHECK(to_ref != nullptr);
@@ -2791,7 +3117,9 @@ void ConcurrentCopying::ReclaimPhase() {
       region_space_->ClearFromSpace(&cleared_bytes,
                                     &cleared_objects,
                                     /*clear_bitmap*/ !young_gen_,
-                                    should_eagerly_release_memory);
+                                    should_eagerly_release_memory,
+                                    heap_->GetThreadPool(),
+                                    GetParallelGcThreadCount());
       // `cleared_bytes` may be greater than the from space equivalents since
       // RegionSpace::ClearFromSpace may clear empty unevac regions.
       CHECK_GE(cleared_bytes, from_bytes);
@@ -3130,7 +3458,7 @@ void ConcurrentCopying::AssertToSpaceInvariantInNonMovingSpace(mirror::Object* o
     // Immune space case.
     if (kUseBakerReadBarrier) {
       // Immune object may not be gray if called from the GC.
-      if (Thread::Current() == thread_running_gc_ && !gc_grays_immune_objects_) {
+      if (IsGcMarkingThread(Thread::Current()) && !gc_grays_immune_objects_) {
         return;
       }
       bool updated_all_immune_objects = updated_all_immune_objects_.load(std::memory_order_seq_cst);
@@ -3171,7 +3499,7 @@ class ConcurrentCopying::RefFieldsVisitor {
   void operator()(mirror::Object* obj, MemberOffset offset, bool /* is_static */)
       const ALWAYS_INLINE REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES_SHARED(Locks::heap_bitmap_lock_) {
-    collector_->Process<kNoUnEvac>(obj, offset);
+    collector_->Process<kNoUnEvac>(thread_, obj, offset);
   }
 
   void operator()(ObjPtr<mirror::Class> klass, ObjPtr<mirror::Reference> ref) const
@@ -3203,37 +3531,43 @@ template <bool kNoUnEvac>
 inline void ConcurrentCopying::Scan(mirror::Object* to_ref, size_t obj_size) {
   // Cannot have `kNoUnEvac` when Generational CC collection is disabled.
   DCHECK_IMPLIES(kNoUnEvac, use_generational_cc_);
+  Thread* const self = Thread::Current();
   if (kDisallowReadBarrierDuringScan && !Runtime::Current()->IsActiveTransaction()) {
     // Avoid all read barriers during visit references to help performance.
     // Don't do this in transaction mode because we may read the old value of an field which may
     // trigger read barriers.
-    Thread::Current()->ModifyDebugDisallowReadBarrier(1);
+    self->ModifyDebugDisallowReadBarrier(1);
   }
   if (obj_size == 0) {
     obj_size = to_ref->SizeOf<kDefaultVerifyFlags>();
   }
-  bytes_scanned_ += obj_size;
+  if (LIKELY(self == thread_running_gc_)) {
+    // The bytes scanned by the parallel marking workers are added once they are done.
+    bytes_scanned_ += obj_size;
+  }
 
   DCHECK(!region_space_->IsInFromSpace(to_ref));
-  DCHECK_EQ(Thread::Current(), thread_running_gc_);
-  RefFieldsVisitor<kNoUnEvac> visitor(this, thread_running_gc_);
+  DCHECK(IsGcMarkingThread(self));
+  RefFieldsVisitor<kNoUnEvac> visitor(this, self);
   // Disable the read barrier for a performance reason.
   to_ref->VisitReferences</*kVisitNativeRoots=*/true, kDefaultVerifyFlags, kWithoutReadBarrier>(
       visitor, visitor);
   if (kDisallowReadBarrierDuringScan && !Runtime::Current()->IsActiveTransaction()) {
-    thread_running_gc_->ModifyDebugDisallowReadBarrier(-1);
+    self->ModifyDebugDisallowReadBarrier(-1);
   }
 }
 
 template <bool kNoUnEvac>
-inline void ConcurrentCopying::Process(mirror::Object* obj, MemberOffset offset) {
+inline void ConcurrentCopying::Process(Thread* const self,
+                                      mirror::Object* obj,
+                                      MemberOffset offset) {
   // Cannot have `kNoUnEvac` when Generational CC collection is disabled.
   DCHECK_IMPLIES(kNoUnEvac, use_generational_cc_);
-  DCHECK_EQ(Thread::Current(), thread_running_gc_);
+  DCHECK_EQ(Thread::Current(), self);
   mirror::Object* ref = obj->GetFieldObject<
       mirror::Object, kVerifyNone, kWithoutReadBarrier, false>(offset);
   mirror::Object* to_ref = Mark</*kGrayImmuneObject=*/false, kNoUnEvac, /*kFromGCThread=*/true>(
-      thread_running_gc_,
+      self,
       ref,
       /*holder=*/ obj,
       offset);
@@ -3757,6 +4091,7 @@ mirror::Object* ConcurrentCopying::MarkNonMoving(Thread* const self,
 
 void ConcurrentCopying::FinishPhase() {
   Thread* const self = Thread::Current();
+  ReportMarkingWorkerThroughput();
   {
     MutexLock mu(self, mark_stack_lock_);
     CHECK(revoked_mark_stacks_.empty());
@@ -168,6 +168,8 @@ class ConcurrentCopying : public GarbageCollector {
       REQUIRES_SHARED(Locks::mutator_lock_);
 
  private:
+  struct MarkingWorker;
+
   EXPORT void PushOntoMarkStack(Thread* const self, mirror::Object* obj)
       REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!mark_stack_lock_);
   // Returns a to-space copy of the from-space object from_ref, and atomically installs a
@@ -191,7 +193,7 @@ class ConcurrentCopying : public GarbageCollector {
       REQUIRES(!mark_stack_lock_);
   // Process a field.
   template <bool kNoUnEvac>
-  void Process(mirror::Object* obj, MemberOffset offset)
+  void Process(Thread* const self, mirror::Object* obj, MemberOffset offset)
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_ , !skipped_blocks_lock_, !immune_gray_stack_lock_);
   void VisitRoots(mirror::Object*** roots, size_t count, const RootInfo& info) override
@@ -212,8 +214,34 @@ class ConcurrentCopying : public GarbageCollector {
   void ProcessMarkStack() override REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_);
   bool ProcessMarkStackOnce() REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!mark_stack_lock_);
-  void ProcessMarkStackRef(mirror::Object* to_ref) REQUIRES_SHARED(Locks::mutator_lock_)
+  // `worker` is non-null if `to_ref` is processed by a parallel marking worker.
+  void ProcessMarkStackRef(mirror::Object* to_ref, MarkingWorker* worker = nullptr)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!mark_stack_lock_);
+  // Number of threads, including the GC-running thread, to process the GC mark
+  // stack and to clear the from-space with. Returns 1 if the heap thread pool
+  // is not to be used.
+  size_t GetParallelGcThreadCount() const;
+  // Process the GC mark stack with `thread_count` threads: the GC-running thread
+  // and workers of the heap thread pool. Each worker owns a mark stack; workers
+  // running out of work steal from the others. Returns the number of processed
+  // references.
+  size_t ProcessMarkStackParallel(size_t thread_count) REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!mark_stack_lock_);
+  void RunMarkingWorker(MarkingWorker* worker) REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_);
+  // Move a batch of references from the worker's mark stack to where idle
+  // workers can steal them from.
+  void ShareMarkingWork(MarkingWorker* worker) REQUIRES_SHARED(Locks::mutator_lock_);
+  // Returns true if `thief` stole some references onto its mark stack.
+  bool StealMarkingWork(MarkingWorker* thief) REQUIRES_SHARED(Locks::mutator_lock_);
+  bool HasMarkingWorkToSteal() const;
+  void PushOntoWorkerMarkStack(MarkingWorker* worker, mirror::Object* to_ref)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+  // Returns true if `self`, the current thread, is the GC-running thread or a
+  // parallel marking worker.
+  bool IsGcMarkingThread(Thread* self) const;
+  // Report the marking throughput of every parallel marking worker of this cycle.
+  void ReportMarkingWorkerThroughput();
   void GrayAllDirtyImmuneObjects()
       REQUIRES(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_);
@@ -298,6 +326,8 @@ class ConcurrentCopying : public GarbageCollector {
   void DisableMarking() REQUIRES_SHARED(Locks::mutator_lock_);
   void IssueDisableMarkingCheckpoint() REQUIRES_SHARED(Locks::mutator_lock_);
   void ExpandGcMarkStack() REQUIRES_SHARED(Locks::mutator_lock_);
+  static void ExpandMarkStack(accounting::ObjectStack* mark_stack)
+      REQUIRES_SHARED(Locks::mutator_lock_);
   EXPORT mirror::Object* MarkNonMoving(Thread* const self,
                                        mirror::Object* from_ref,
                                        mirror::Object* holder = nullptr,
@@ -382,6 +412,21 @@ class ConcurrentCopying : public GarbageCollector {
   std::vector<accounting::ObjectStack*> pooled_mark_stacks_
       GUARDED_BY(mark_stack_lock_);
   Thread* thread_running_gc_;
+  // Parallel marking workers (see ProcessMarkStackParallel()), allocated on the
+  // first use. Worker 0 is run by the GC-running thread and uses gc_mark_stack_.
+  std::vector<std::unique_ptr<MarkingWorker>> marking_workers_;
+  // Number of workers taking part in the ongoing parallel marking.
+  size_t num_marking_workers_;
+  // Number of workers which may still produce work. Parallel marking is
+  // complete once it drops to zero. Only changed with `marking_idle_lock_` held.
+  Atomic<size_t> num_active_marking_workers_;
+  // Idle workers wait on `marking_idle_cond_` for work to steal or for the
+  // end of parallel marking.
+  Mutex marking_idle_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  ConditionVariable marking_idle_cond_ GUARDED_BY(marking_idle_lock_);
+  // The parallel marking worker run by the current thread, if it is a worker of
+  // the heap thread pool. Null on all other threads.
+  static thread_local MarkingWorker* current_marking_worker_;
   bool is_marking_;                       // True while marking is ongoing.
   // True while we might dispatch on the read barrier entrypoints.
   bool is_using_read_barrier_entrypoints_;
@@ -517,6 +562,7 @@ class ConcurrentCopying : public GarbageCollector {
   template <bool kAtomicTestAndSet = false> class CaptureRootsForMarkingVisitor;
   class CaptureThreadRootsForMarkingAndCheckpoint;
   template <bool kHandleInterRegionRefs> class ComputeLiveBytesAndMarkRefFieldsVisitor;
+  class ParallelMarkTask;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(ConcurrentCopying);
 };
@@ -229,6 +229,7 @@ inline void MarkCompact::UpdateRef(mirror::Object* obj,
       mirror::Object, kVerifyNone, kWithoutReadBarrier, /*kIsVolatile*/false>(offset);
   if (kIsDebugBuild) {
     if (HasAddress(old_ref) &&
+        reinterpret_cast<uint8_t*>(old_ref) >= old_gen_end_ &&
         reinterpret_cast<uint8_t*>(old_ref) < black_allocations_begin_ &&
         !moving_space_bitmap_->Test(old_ref)) {
       mirror::Object* from_ref = GetFromSpaceAddr(old_ref);
@@ -272,7 +273,7 @@ inline bool MarkCompact::VerifyRootSingleUpdate(void* root,
   if (kIsDebugBuild && !kMemoryToolIsAvailable && !kHwAsanEnabled) {
     void* stack_low_addr = stack_low_addr_;
     void* stack_high_addr = stack_high_addr_;
-    if (!HasAddress(old_ref)) {
+    if (!HasAddress(old_ref, old_gen_end_, moving_space_end_)) {
       return false;
     }
     Thread* self = Thread::Current();
@@ -374,6 +375,10 @@ inline mirror::Object* MarkCompact::PostCompactOldObjAddr(mirror::Object* old_re
 }
 
 inline mirror::Object* MarkCompact::PostCompactAddressUnchecked(mirror::Object* old_ref) const {
+  if (reinterpret_cast<uint8_t*>(old_ref) < old_gen_end_) {
+    // Old generation isn't compacted.
+    return old_ref;
+  }
   if (reinterpret_cast<uint8_t*>(old_ref) >= black_allocations_begin_) {
     return PostCompactBlackObjAddr(old_ref);
   }
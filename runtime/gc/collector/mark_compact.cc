@@ -43,6 +43,7 @@
 #include "base/memfd.h"
 #include "base/quasi_atomic.h"
 #include "base/systrace.h"
+#include "base/time_utils.h"
 #include "base/utils.h"
 #include "gc/accounting/mod_union_table-inl.h"
 #include "gc/collector_type.h"
@@ -442,7 +443,7 @@ size_t MarkCompact::InitializeInfoMap(uint8_t* p, size_t moving_space_sz) {
   return total;
 }
 
-MarkCompact::MarkCompact(Heap* heap)
+MarkCompact::MarkCompact(Heap* heap, bool use_generational)
     : GarbageCollector(heap, "concurrent mark compact"),
       gc_barrier_(0),
       lock_("mark compact lock", kGenericBottomLock),
@@ -450,11 +451,20 @@ MarkCompact::MarkCompact(Heap* heap)
       moving_space_bitmap_(bump_pointer_space_->GetMarkBitmap()),
       moving_space_begin_(bump_pointer_space_->Begin()),
       moving_space_end_(bump_pointer_space_->Limit()),
+      old_gen_end_(moving_space_begin_),
+      old_gen_objects_(0),
+      full_gc_freed_bytes_(0),
+      full_gc_duration_ns_(0),
+      full_gc_count_(0),
+      gc_start_time_ns_(0),
       uffd_(kFdUnused),
       sigbus_in_progress_count_{kSigbusCounterCompactionDoneMask, kSigbusCounterCompactionDoneMask},
       compacting_(false),
       uffd_initialized_(false),
-      clamp_info_map_status_(ClampInfoStatus::kClampInfoNotDone) {
+      clamp_info_map_status_(ClampInfoStatus::kClampInfoNotDone),
+      use_generational_(use_generational),
+      young_gen_requested_(false),
+      young_gen_(false) {
   if (kIsDebugBuild) {
     updated_roots_.reset(new std::unordered_set<void*>());
   }
@@ -485,6 +495,23 @@ MarkCompact::MarkCompact(Heap* heap)
       DCHECK_EQ(total, info_map_.Size());
     }
   }
+  if (use_generational_) {
+    // Unlike info_map_, this is retained across GC cycles and hence needs its
+    // own mapping.
+    old_gen_first_objs_map_ =
+        MemMap::MapAnonymous("Concurrent mark-compact old-gen first-objects",
+                             DivideByPageSize(moving_space_size) * sizeof(ObjReference),
+                             PROT_READ | PROT_WRITE,
+                             /*low_4gb=*/false,
+                             &err_msg);
+    if (UNLIKELY(!old_gen_first_objs_map_.IsValid())) {
+      LOG(FATAL) << "Failed to allocate concurrent mark-compact old-gen first-objects: "
+                 << err_msg;
+    }
+    old_gen_first_objs_ = reinterpret_cast<ObjReference*>(old_gen_first_objs_map_.Begin());
+  } else {
+    old_gen_first_objs_ = nullptr;
+  }
 
   size_t moving_space_alignment = Heap::BestPageTableAlignment(moving_space_size);
   // The moving space is created at a fixed address, which is expected to be
@@ -524,9 +551,30 @@ MarkCompact::MarkCompact(Heap* heap)
   // In most of the cases, we don't expect more than one LinearAlloc space.
   linear_alloc_spaces_data_.reserve(1);
 
-  // Initialize GC metrics.
+  // Initialize GC metrics. They are switched to the young-generation ones in
+  // InitializePhase() for young collections.
+  SetMetrics(/*young_gen=*/false);
+  are_metrics_initialized_ = true;
+}
+
+void MarkCompact::SetMetrics(bool young_gen) {
   metrics::ArtMetrics* metrics = GetMetrics();
-  // The mark-compact collector supports only full-heap collections at the moment.
+  if (young_gen) {
+    gc_time_histogram_ = metrics->YoungGcCollectionTime();
+    metrics_gc_count_ = metrics->YoungGcCount();
+    metrics_gc_count_delta_ = metrics->YoungGcCountDelta();
+    gc_throughput_histogram_ = metrics->YoungGcThroughput();
+    gc_tracing_throughput_hist_ = metrics->YoungGcTracingThroughput();
+    gc_throughput_avg_ = metrics->YoungGcThroughputAvg();
+    gc_tracing_throughput_avg_ = metrics->YoungGcTracingThroughputAvg();
+    gc_scanned_bytes_ = metrics->YoungGcScannedBytes();
+    gc_scanned_bytes_delta_ = metrics->YoungGcScannedBytesDelta();
+    gc_freed_bytes_ = metrics->YoungGcFreedBytes();
+    gc_freed_bytes_delta_ = metrics->YoungGcFreedBytesDelta();
+    gc_duration_ = metrics->YoungGcDuration();
+    gc_duration_delta_ = metrics->YoungGcDurationDelta();
+    return;
+  }
   gc_time_histogram_ = metrics->FullGcCollectionTime();
   metrics_gc_count_ = metrics->FullGcCount();
   metrics_gc_count_delta_ = metrics->FullGcCountDelta();
@@ -540,7 +588,11 @@ MarkCompact::MarkCompact(Heap* heap)
   gc_freed_bytes_delta_ = metrics->FullGcFreedBytesDelta();
   gc_duration_ = metrics->FullGcDuration();
   gc_duration_delta_ = metrics->FullGcDurationDelta();
-  are_metrics_initialized_ = true;
+}
+
+uint64_t MarkCompact::GetEstimatedFullGcMeanThroughput() const {
+  // Add 1ms to prevent possible division by 0.
+  return (full_gc_freed_bytes_ * 1000) / (NsToMs(full_gc_duration_ns_) + 1);
 }
 
 void MarkCompact::AddLinearAllocSpaceData(uint8_t* begin, size_t len) {
@@ -647,16 +699,53 @@ void MarkCompact::PrepareCardTableForMarking(bool clear_alloc_space_cards) {
     } else if (clear_alloc_space_cards) {
       CHECK(!space->IsZygoteSpace());
       CHECK(!space->IsImageSpace());
-      // The card-table corresponding to bump-pointer and non-moving space can
-      // be cleared, because we are going to traverse all the reachable objects
-      // in these spaces. This card-table will eventually be used to track
-      // mutations while concurrent marking is going on.
-      card_table->ClearCardRange(space->Begin(), space->Limit());
+      if (young_gen_) {
+        // In a young collection the cards are the remembered set of the old
+        // generation and therefore can't be cleared. Age them instead: dirty
+        // cards become aged and are scanned during marking, whereas the aged
+        // ones from the previous cycle have already been taken care of.
+        card_table->ModifyCardsAtomic(
+            space->Begin(),
+            space->End(),
+            [](uint8_t card) {
+              return (card == gc::accounting::CardTable::kCardDirty) ?
+                         gc::accounting::CardTable::kCardAged :
+                         gc::accounting::CardTable::kCardClean;
+            },
+            /* card modified visitor */ VoidFunctor());
+      } else {
+        // The card-table corresponding to bump-pointer and non-moving space can
+        // be cleared, because we are going to traverse all the reachable objects
+        // in these spaces. This card-table will eventually be used to track
+        // mutations while concurrent marking is going on.
+        card_table->ClearCardRange(space->Begin(), space->Limit());
+      }
       if (space != bump_pointer_space_) {
         CHECK_EQ(space, heap_->GetNonMovingSpace());
         non_moving_space_ = space;
         non_moving_space_bitmap_ = space->GetMarkBitmap();
       }
+    } else if (young_gen_ && space == bump_pointer_space_) {
+      // Retain the aged cards of the old generation as the references in the
+      // corresponding objects are updated in the compaction pause.
+      card_table->ModifyCardsAtomic(
+          space->Begin(),
+          old_gen_end_,
+          [](uint8_t card) {
+            return (card == gc::accounting::CardTable::kCardDirty) ?
+                       gc::accounting::CardTable::kCardAged :
+                       card;
+          },
+          /* card modified visitor */ VoidFunctor());
+      card_table->ModifyCardsAtomic(
+          old_gen_end_,
+          space->End(),
+          [](uint8_t card) {
+            return (card == gc::accounting::CardTable::kCardDirty) ?
+                       gc::accounting::CardTable::kCardAged :
+                       gc::accounting::CardTable::kCardClean;
+          },
+          /* card modified visitor */ VoidFunctor());
     } else {
       card_table->ModifyCardsAtomic(
           space->Begin(),
@@ -713,6 +802,21 @@ void MarkCompact::InitializePhase() {
   // TODO: Would it suffice to read it once in the constructor, which is called
   // in zygote process?
   pointer_size_ = Runtime::Current()->GetClassLinker()->GetImagePointerSize();
+  if (use_generational_) {
+    // A young collection is pointless without an old generation.
+    bool young_gen = young_gen_requested_ && old_gen_end_ > moving_space_begin_;
+    if (young_gen != young_gen_) {
+      young_gen_ = young_gen;
+      SetMetrics(young_gen_);
+    }
+    if (!young_gen_) {
+      // Full collections compact the entire moving space.
+      old_gen_end_ = moving_space_begin_;
+      old_gen_objects_ = 0;
+    }
+    gc_start_time_ns_ = NanoTime();
+  }
+  DCHECK_ALIGNED_PARAM(old_gen_end_, gPageSize);
 }
 
 class MarkCompact::ThreadFlipVisitor : public Closure {
@@ -790,8 +894,10 @@ void MarkCompact::RunPhases() {
 }
 
 void MarkCompact::InitMovingSpaceFirstObjects(const size_t vec_len) {
-  // Find the first live word first.
-  size_t to_space_page_idx = 0;
+  // Find the first live word first. The old generation, if any, is not
+  // compacted and hence we start from the page right after it.
+  size_t to_space_page_idx = DivideByPageSize(old_gen_end_ - moving_space_begin_);
+  moving_first_objs_count_ = to_space_page_idx;
   uint32_t offset_in_chunk_word;
   uint32_t offset;
   mirror::Object* obj;
@@ -799,7 +905,9 @@ void MarkCompact::InitMovingSpaceFirstObjects(const size_t vec_len) {
 
   size_t chunk_idx;
   // Find the first live word in the space
-  for (chunk_idx = 0; chunk_info_vec_[chunk_idx] == 0; chunk_idx++) {
+  for (chunk_idx = (old_gen_end_ - moving_space_begin_) / kOffsetChunkSize;
+       chunk_info_vec_[chunk_idx] == 0;
+       chunk_idx++) {
     if (chunk_idx >= vec_len) {
       // We don't have any live data on the moving-space.
       return;
@@ -947,13 +1055,23 @@ void MarkCompact::PrepareForCompaction() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
   uint8_t* space_begin = bump_pointer_space_->Begin();
   size_t vector_len = (black_allocations_begin_ - space_begin) / kOffsetChunkSize;
+  const size_t old_gen_vector_len = (old_gen_end_ - space_begin) / kOffsetChunkSize;
   DCHECK_LE(vector_len, vector_length_);
-  for (size_t i = 0; i < vector_len; i++) {
+  DCHECK_LE(old_gen_vector_len, vector_len);
+  for (size_t i = old_gen_vector_len; i < vector_len; i++) {
     DCHECK_LE(chunk_info_vec_[i], kOffsetChunkSize);
     DCHECK_EQ(chunk_info_vec_[i], live_words_bitmap_->LiveBytesInBitmapWord(i));
   }
   InitMovingSpaceFirstObjects(vector_len);
   InitNonMovingSpaceFirstObjects();
+  // The old generation is retained as is in a young collection. Treating its
+  // chunks as fully live makes the post-compact addresses of the young objects
+  // start at old_gen_end_.
+  std::fill_n(chunk_info_vec_, old_gen_vector_len, kOffsetChunkSize);
+  if (use_generational_) {
+    // All the marked objects are promoted to the old generation.
+    old_gen_objects_ -= freed_objects_;
+  }
 
   // TODO: We can do a lot of neat tricks with this offset vector to tune the
   // compaction as we wish. Originally, the compaction algorithm slides all
@@ -1000,6 +1118,9 @@ void MarkCompact::PrepareForCompaction() {
   black_objs_slide_diff_ = black_allocations_begin_ - post_compact_end_;
   // We shouldn't be consuming more space after compaction than pre-compaction.
   CHECK_GE(black_objs_slide_diff_, 0);
+  if (use_generational_) {
+    UpdateOldGenFirstObjects();
+  }
   // How do we handle compaction of heap portion used for allocations after the
   // marking-pause?
   // All allocations after the marking-pause are considered black (reachable)
@@ -1016,6 +1137,19 @@ void MarkCompact::PrepareForCompaction() {
   }
 }
 
+void MarkCompact::UpdateOldGenFirstObjects() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  // The first-objects of the old generation's pages are retained from the
+  // previous cycles. Only the pages being compacted now need to be updated.
+  for (size_t i = DivideByPageSize(old_gen_end_ - moving_space_begin_);
+       i < moving_first_objs_count_;
+       i++) {
+    mirror::Object* first_obj = first_objs_moving_space_[i].AsMirrorPtr();
+    DCHECK(first_obj != nullptr);
+    old_gen_first_objs_[i].Assign(PostCompactOldObjAddr(first_obj));
+  }
+}
+
 class MarkCompact::VerifyRootMarkedVisitor : public SingleRootVisitor {
  public:
   explicit VerifyRootMarkedVisitor(MarkCompact* collector) : collector_(collector) { }
@@ -1069,7 +1203,14 @@ void MarkCompact::MarkingPause() {
     }
     // Fetch only the accumulated objects-allocated count as it is guaranteed to
     // be up-to-date after the TLAB revocation above.
-    freed_objects_ += bump_pointer_space_->GetAccumulatedObjectsAllocated();
+    int32_t objects_allocated = bump_pointer_space_->GetAccumulatedObjectsAllocated();
+    // Old-generation objects are neither marked nor freed in a young collection.
+    freed_objects_ += objects_allocated - old_gen_objects_;
+    if (use_generational_) {
+      // Once marking is finished, freed_objects_ is subtracted from this to get
+      // the number of objects in the next cycle's old generation.
+      old_gen_objects_ = objects_allocated;
+    }
     // Capture 'end' of moving-space at this point. Every allocation beyond this
     // point will be considered as black.
     // Align-up to page boundary so that black allocations happen from next page
@@ -1141,6 +1282,11 @@ void MarkCompact::Sweep(bool swap_bitmaps) {
         !immune_spaces_.ContainsSpace(space)) {
       space::ContinuousMemMapAllocSpace* alloc_space = space->AsContinuousMemMapAllocSpace();
       DCHECK(!alloc_space->IsZygoteSpace());
+      if (young_gen_) {
+        // Bitmaps are bound in a young collection. Nothing to sweep.
+        DCHECK(alloc_space->HasBoundBitmaps());
+        continue;
+      }
       TimingLogger::ScopedTiming split("SweepMallocSpace", GetTimings());
       RecordFree(alloc_space->Sweep(swap_bitmaps));
     }
@@ -2073,7 +2219,9 @@ void MarkCompact::CompactMovingSpace(uint8_t* page) {
   // Reserved page to be used if we can't find any reclaimable page for processing.
   uint8_t* reserve_page = page;
   size_t end_idx_for_mapping = idx;
-  while (idx > 0) {
+  // Pages of the old generation, if any, are not compacted.
+  const size_t old_gen_page_count = DivideByPageSize(old_gen_end_ - moving_space_begin_);
+  while (idx > old_gen_page_count) {
     idx--;
     to_space_end -= gPageSize;
     if (kMode == kFallbackMode) {
@@ -2110,14 +2258,14 @@ void MarkCompact::CompactMovingSpace(uint8_t* page) {
     }
   }
   // map one last time to finish anything left.
-  if (kMode == kCopyMode && end_idx_for_mapping > 0) {
+  if (kMode == kCopyMode && end_idx_for_mapping > idx) {
     MapMovingSpacePages(idx,
                         end_idx_for_mapping,
                         /*from_fault=*/false,
                         /*return_on_contention=*/false,
                         /*tolerate_enoent=*/false);
   }
-  DCHECK_EQ(to_space_end, bump_pointer_space_->Begin());
+  DCHECK_EQ(to_space_end, old_gen_end_);
 }
 
 size_t MarkCompact::MapMovingSpacePages(size_t start_idx,
@@ -2260,6 +2408,82 @@ void MarkCompact::UpdateNonMovingSpace() {
   }
 }
 
+template <typename Visitor>
+void MarkCompact::VisitOldGenObjectsOnCards(uint8_t minimum_age, Visitor&& visitor) {
+  accounting::CardTable* const card_table = heap_->GetCardTable();
+  uint8_t* const begin = moving_space_begin_;
+  uint8_t* const end = old_gen_end_;
+  uint8_t* const card_end = card_table->CardFromAddr(end);
+  // Address of the next object to be considered. As it only moves forward, an
+  // object is visited at most once.
+  uint8_t* obj_addr = begin;
+  for (uint8_t* card = card_table->CardFromAddr(begin); card < card_end; card++) {
+    if (*card < minimum_age) {
+      continue;
+    }
+    uint8_t* const card_addr = static_cast<uint8_t*>(card_table->AddrFromCard(card));
+    uint8_t* const card_addr_end = card_addr + accounting::CardTable::kCardSize;
+    if (obj_addr < card_addr) {
+      // Start from the object overlapping with the beginning of the card's page,
+      // unless we have already walked past it.
+      size_t page_idx = DivideByPageSize(card_addr - begin);
+      uint8_t* first_obj = reinterpret_cast<uint8_t*>(old_gen_first_objs_[page_idx].AsMirrorPtr());
+      DCHECK(first_obj != nullptr) << "page_idx=" << page_idx;
+      obj_addr = std::max(obj_addr, first_obj);
+    }
+    while (obj_addr < card_addr_end && obj_addr < end) {
+      mirror::Object* obj = reinterpret_cast<mirror::Object*>(obj_addr);
+      if (obj->GetClass<kVerifyNone, kWithoutReadBarrier>() == nullptr) {
+        // The unused tail of the last page of a compacted range. The next
+        // object, if any, starts on the next page.
+        obj_addr = AlignUp(obj_addr + kAlignment, gPageSize);
+        continue;
+      }
+      if (obj_addr >= card_addr) {
+        visitor(obj);
+      }
+      obj_addr += RoundUp(obj->SizeOf<kVerifyNone>(), kAlignment);
+    }
+  }
+}
+
+void MarkCompact::UpdateOldGenObjects(const std::vector<mirror::Object*>& objs) {
+  TimingLogger::ScopedTiming t("(Paused)UpdateOldGenObjects", GetTimings());
+  // Iterate in reverse for the same reason as in UpdateNonMovingSpace().
+  for (auto it = objs.rbegin(); it != objs.rend(); ++it) {
+    mirror::Object* obj = *it;
+    RefsUpdateVisitor</*kCheckBegin*/false, /*kCheckEnd*/false>
+            visitor(this, obj, /*begin=*/nullptr, /*end=*/nullptr);
+    obj->VisitRefsForCompaction</*kFetchObjSize*/false>(visitor, MemberOffset(0), MemberOffset(-1));
+  }
+}
+
+void MarkCompact::ClearPromotedObjectsCards() {
+  // The card table is the remembered set of the old generation: a young
+  // collection scans the objects on non-clean cards of the old generation for
+  // references into the young generation. Every marked object of this cycle is
+  // promoted, and the only objects left in the young generation are the black
+  // allocations. The cards of the promoted objects are recorded at their
+  // pre-compact addresses and hence are stale. But a promoted object may have
+  // been made to refer to a black allocation after the marking pause, which
+  // dirtied its card. Such cards are carried over to the post-compact
+  // addresses of their objects.
+  accounting::CardTable* const card_table = heap_->GetCardTable();
+  std::vector<mirror::Object*> objs;
+  card_table->Scan</*kClearCard*/false>(
+      moving_space_bitmap_,
+      old_gen_end_,
+      black_allocations_begin_,
+      [this, &objs](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+        objs.push_back(PostCompactOldObjAddr(obj));
+      },
+      accounting::CardTable::kCardAged);
+  card_table->ClearCardRange(old_gen_end_, moving_space_end_);
+  for (mirror::Object* obj : objs) {
+    card_table->MarkCard(obj);
+  }
+}
+
 void MarkCompact::UpdateMovingSpaceBlackAllocations() {
   // For sliding black pages, we need the first-object, which overlaps with the
   // first byte of the page. Additionally, we compute the size of first chunk of
@@ -2724,6 +2948,22 @@ void MarkCompact::CompactionPause() {
     // Start updating roots and system weaks now.
     heap_->GetReferenceProcessor()->UpdateRoots(this);
   }
+  // Old-generation objects which may refer to the objects being compacted.
+  std::vector<mirror::Object*> old_gen_objs;
+  if (use_generational_) {
+    TimingLogger::ScopedTiming t2("(Paused)UpdateGenerations", GetTimings());
+    WriterMutexLock wmu(thread_running_gc_, *Locks::heap_bitmap_lock_);
+    if (young_gen_) {
+      // Collect them now as walking the old generation requires the classes of
+      // its objects, which may be young, to not have been moved to from-space
+      // yet. They are updated after KernelPreparation() below.
+      VisitOldGenObjectsOnCards(accounting::CardTable::kCardAged,
+                                [&old_gen_objs](mirror::Object* obj) {
+                                  old_gen_objs.push_back(obj);
+                                });
+    }
+    ClearPromotedObjectsCards();
+  }
   {
     // TODO: Immune space updation has to happen either before or after
     // remapping pre-compact pages to from-space. And depending on when it's
@@ -2847,6 +3087,9 @@ void MarkCompact::CompactionPause() {
   }
 
   UpdateNonMovingSpace();
+  if (!old_gen_objs.empty()) {
+    UpdateOldGenObjects(old_gen_objs);
+  }
   // fallback mode
   if (uffd_ == kFallbackMode) {
     CompactMovingSpace<kFallbackMode>(nullptr);
@@ -2888,12 +3131,18 @@ void MarkCompact::KernelPrepareRangeForUffd(uint8_t* to_addr, uint8_t* from_addr
 
 void MarkCompact::KernelPreparation() {
   TimingLogger::ScopedTiming t("(Paused)KernelPreparation", GetTimings());
-  uint8_t* moving_space_begin = bump_pointer_space_->Begin();
-  size_t moving_space_size = bump_pointer_space_->Capacity();
-  size_t moving_space_register_sz = (moving_first_objs_count_ + black_page_count_) * gPageSize;
+  // The old generation, if any, is neither compacted nor moved to from-space.
+  // Pages of the remaining portion retain their offsets in the from-space so
+  // that from_space_slide_diff_ works for both.
+  uint8_t* moving_space_begin = old_gen_end_;
+  size_t old_gen_size = old_gen_end_ - bump_pointer_space_->Begin();
+  size_t moving_space_size = bump_pointer_space_->Capacity() - old_gen_size;
+  size_t moving_space_register_sz =
+      (moving_first_objs_count_ + black_page_count_) * gPageSize - old_gen_size;
   DCHECK_LE(moving_space_register_sz, moving_space_size);
 
-  KernelPrepareRangeForUffd(moving_space_begin, from_space_begin_, moving_space_size);
+  KernelPrepareRangeForUffd(
+      moving_space_begin, from_space_begin_ + old_gen_size, moving_space_size);
 
   if (IsValidFd(uffd_)) {
     if (moving_space_register_sz > 0) {
@@ -2908,7 +3157,9 @@ void MarkCompact::KernelPreparation() {
       // the vma-split in uffd-register. This ensures that when we unregister
       // the used portion after compaction, the two split vmas merge. This is
       // necessary for the mremap of the next GC cycle to not fail due to having
-      // more than one vma in the source range.
+      // more than one vma in the source range. In a young collection, the
+      // fault-in also lets the kernel reuse the old generation's 'anon_vma' so
+      // that the old and young portions merge back into a single vma.
       //
       // Fault in address aligned to PMD size so that in case THP is enabled,
       // we don't mistakenly fault a page in beginning portion that will be
@@ -3537,9 +3788,10 @@ void MarkCompact::CompactionPhase() {
 
   // Unregister moving-space
   size_t moving_space_size = bump_pointer_space_->Capacity();
-  size_t used_size = (moving_first_objs_count_ + black_page_count_) * gPageSize;
+  size_t used_size = (moving_first_objs_count_ + black_page_count_) * gPageSize -
+                     (old_gen_end_ - bump_pointer_space_->Begin());
   if (used_size > 0) {
-    UnregisterUffd(bump_pointer_space_->Begin(), used_size);
+    UnregisterUffd(old_gen_end_, used_size);
   }
   // Unregister linear-alloc spaces
   for (auto& data : linear_alloc_spaces_data_) {
@@ -3749,10 +4001,34 @@ void MarkCompact::UpdateAndMarkModUnion() {
 
 void MarkCompact::MarkReachableObjects() {
   UpdateAndMarkModUnion();
+  if (young_gen_) {
+    // The old generation isn't traced in a young collection. Instead, the
+    // objects on the cards dirtied since the last GC cycle, which are now aged,
+    // are scanned for references into the young generation.
+    ScanDirtyObjects(/*paused*/ false, accounting::CardTable::kCardAged);
+  }
   // Recursively mark all the non-image bits set in the mark bitmap.
   ProcessMarkStack();
 }
 
+void MarkCompact::MarkNonMovingSpaceNewObjects() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  // The objects allocated in the non-moving space since the last GC cycle are
+  // on the allocation stack and will be marked live in Sweep(). As the
+  // non-moving space isn't swept in a young collection, they must be traced to
+  // avoid ending up with live objects referring to reclaimed young objects.
+  // The allocation stack may be concurrently pushed to. The entries which are
+  // yet to be written are null and belong to black allocations anyways.
+  accounting::ObjectStack* alloc_stack = heap_->GetAllocationStack();
+  const StackReference<mirror::Object>* limit = alloc_stack->End();
+  for (StackReference<mirror::Object>* it = alloc_stack->Begin(); it != limit; ++it) {
+    mirror::Object* obj = it->AsMirrorPtr();
+    if (obj != nullptr && non_moving_space_bitmap_->HasAddress(obj)) {
+      MarkObjectNonNull(obj);
+    }
+  }
+}
+
 void MarkCompact::ScanDirtyObjects(bool paused, uint8_t minimum_age) {
   accounting::CardTable* card_table = heap_->GetCardTable();
   for (const auto& space : heap_->GetContinuousSpaces()) {
@@ -3769,8 +4045,14 @@ void MarkCompact::ScanDirtyObjects(bool paused, uint8_t minimum_age) {
       break;
     }
     TimingLogger::ScopedTiming t(name, GetTimings());
+    uint8_t* begin = space->Begin();
+    if (space == bump_pointer_space_ && old_gen_end_ > begin) {
+      // Objects in the old generation aren't marked in the mark-bitmap.
+      VisitOldGenObjectsOnCards(minimum_age, ScanObjectVisitor(this));
+      begin = old_gen_end_;
+    }
     card_table->Scan</*kClearCard*/ false>(
-        space->GetMarkBitmap(), space->Begin(), space->End(), ScanObjectVisitor(this), minimum_age);
+        space->GetMarkBitmap(), begin, space->End(), ScanObjectVisitor(this), minimum_age);
   }
 }
 
@@ -3819,8 +4101,23 @@ void MarkCompact::MarkingPhase() {
   DCHECK_EQ(thread_running_gc_, Thread::Current());
   WriterMutexLock mu(thread_running_gc_, *Locks::heap_bitmap_lock_);
   MaybeClampGcStructures();
+  if (young_gen_) {
+    // Everything that survived the previous GC cycle is considered live in a
+    // young collection. Binding the non-moving space's bitmaps ensures that it
+    // isn't swept, and copying the large-object space' live bitmap to the mark
+    // bitmap ensures that only the large objects allocated since are swept.
+    heap_->GetNonMovingSpace()->BindLiveToMarkBitmap();
+    space::LargeObjectSpace* los = heap_->GetLargeObjectsSpace();
+    if (los != nullptr) {
+      los->CopyLiveToMarked();
+    }
+  }
   PrepareCardTableForMarking(/*clear_alloc_space_cards*/ true);
-  MarkZygoteLargeObjects();
+  if (young_gen_) {
+    MarkNonMovingSpaceNewObjects();
+  } else {
+    MarkZygoteLargeObjects();
+  }
   MarkRoots(
         static_cast<VisitRootFlags>(kVisitRootFlagAllRoots | kVisitRootFlagStartLoggingNewRoots));
   MarkReachableObjects();
@@ -3973,6 +4270,10 @@ inline bool MarkCompact::MarkObjectNonNullNoPush(mirror::Object* obj,
   // We expect most of the referenes to be in bump-pointer space, so try that
   // first to keep the cost of this function minimal.
   if (LIKELY(HasAddress(obj))) {
+    if (reinterpret_cast<uint8_t*>(obj) < old_gen_end_) {
+      // Old-generation objects are implicitly marked in a young collection.
+      return false;
+    }
     return kParallel ? !moving_space_bitmap_->AtomicTestAndSet(obj)
                      : !moving_space_bitmap_->Set(obj);
   } else if (non_moving_space_bitmap_->HasAddress(obj)) {
@@ -4060,6 +4361,11 @@ void MarkCompact::VisitRoots(mirror::CompressedReference<mirror::Object>** roots
 
 mirror::Object* MarkCompact::IsMarked(mirror::Object* obj) {
   if (HasAddress(obj)) {
+    if (reinterpret_cast<uint8_t*>(obj) < old_gen_end_) {
+      // Old-generation objects are neither collected nor moved in a young
+      // collection.
+      return obj;
+    }
     const bool is_black = reinterpret_cast<uint8_t*>(obj) >= black_allocations_begin_;
     if (compacting_) {
       if (is_black) {
@@ -4142,6 +4448,19 @@ void MarkCompact::FinishPhase() {
   }
   class_after_obj_ordered_map_.clear();
   linear_alloc_arenas_.clear();
+  if (use_generational_) {
+    // Every marked object of this cycle has been compacted below
+    // post_compact_end_ and is now part of the old generation. The black
+    // allocations, which were slid right after it, remain in the young
+    // generation as they haven't been scanned.
+    old_gen_end_ = post_compact_end_;
+    if (!young_gen_) {
+      full_gc_count_++;
+      full_gc_freed_bytes_ +=
+          GetCurrentIteration()->GetFreedBytes() + GetCurrentIteration()->GetFreedLargeObjectBytes();
+      full_gc_duration_ns_ += NanoTime() - gc_start_time_ns_;
+    }
+  }
   {
     ReaderMutexLock mu(thread_running_gc_, *Locks::mutator_lock_);
     WriterMutexLock mu2(thread_running_gc_, *Locks::heap_bitmap_lock_);
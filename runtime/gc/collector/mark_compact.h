@@ -23,6 +23,7 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "barrier.h"
 #include "base/atomic.h"
@@ -68,7 +69,7 @@ class MarkCompact final : public GarbageCollector {
   static constexpr SigbusCounterType kSigbusCounterCompactionDoneMask =
       1u << (BitSizeOf<SigbusCounterType>() - 1);
 
-  explicit MarkCompact(Heap* heap);
+  MarkCompact(Heap* heap, bool use_generational);
 
   ~MarkCompact() {}
 
@@ -85,7 +86,27 @@ class MarkCompact final : public GarbageCollector {
   bool SigbusHandler(siginfo_t* info) REQUIRES(!lock_) NO_THREAD_SAFETY_ANALYSIS;
 
   GcType GetGcType() const override {
-    return kGcTypeFull;
+    return young_gen_ ? kGcTypeSticky : kGcTypeFull;
+  }
+
+  // Select whether the next GC cycle should be a young-generation (sticky) or a
+  // full one. Only honored if the collector was created in generational mode.
+  // Called by the heap before running the collector.
+  void SetYoungGen(bool young_gen) {
+    young_gen_requested_ = young_gen;
+  }
+  // Forget the old generation in the moving space. Called when all the objects
+  // are evacuated out of the moving space, like during zygote compaction.
+  void ResetGenerations() {
+    old_gen_end_ = moving_space_begin_;
+    old_gen_objects_ = 0;
+  }
+  // Throughput (bytes freed per second) and count of full-heap collections.
+  // Used by the heap to decide between young and full collections, as the same
+  // collector instance is used for both.
+  uint64_t GetEstimatedFullGcMeanThroughput() const;
+  size_t GetFullGcCount() const {
+    return full_gc_count_;
   }
 
   CollectorType GetCollectorType() const override {
@@ -132,7 +153,8 @@ class MarkCompact final : public GarbageCollector {
 
   mirror::Object* GetFromSpaceAddrFromBarrier(mirror::Object* old_ref) {
     CHECK(compacting_);
-    if (HasAddress(old_ref)) {
+    // Objects in the old generation are not moved in a young collection.
+    if (HasAddress(old_ref, old_gen_end_, moving_space_end_)) {
       return GetFromSpaceAddr(old_ref);
     }
     return old_ref;
@@ -264,6 +286,8 @@ class MarkCompact final : public GarbageCollector {
   // Check if the obj is within heap and has a klass which is likely to be valid
   // mirror::Class.
   bool IsValidObject(mirror::Object* obj) const REQUIRES_SHARED(Locks::mutator_lock_);
+  // Point the GC metrics to either young-generation or full collection ones.
+  void SetMetrics(bool young_gen);
   void InitializePhase();
   void FinishPhase() REQUIRES(!Locks::mutator_lock_, !Locks::heap_bitmap_lock_, !lock_);
   void MarkingPhase() REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!Locks::heap_bitmap_lock_);
@@ -360,6 +384,31 @@ class MarkCompact final : public GarbageCollector {
       REQUIRES_SHARED(Locks::mutator_lock_);
   // Update all the references in the non-moving space.
   void UpdateNonMovingSpace() REQUIRES_SHARED(Locks::mutator_lock_);
+  // Update the references in the given old-generation objects of the moving
+  // space. Used in young-generation collections, wherein only the objects on
+  // aged or dirty cards may hold references to the compacted objects.
+  void UpdateOldGenObjects(const std::vector<mirror::Object*>& objs)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+  // Visit every object in the old generation of the moving space that starts
+  // on a card which is at least 'minimum_age'. The old generation is densely
+  // packed, so objects are found by walking from the first object of the page
+  // containing the card.
+  template <typename Visitor>
+  void VisitOldGenObjectsOnCards(uint8_t minimum_age, Visitor&& visitor)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::heap_bitmap_lock_);
+  // Record, for every to-space page of the compacted portion, the post-compact
+  // address of the first object overlapping with it. This serves as the
+  // old-generation object index in the subsequent young collections.
+  void UpdateOldGenFirstObjects() REQUIRES_SHARED(Locks::mutator_lock_);
+  // Clear the stale cards of the objects being promoted to the old generation,
+  // and re-dirty the cards of the ones which may refer to black allocations.
+  void ClearPromotedObjectsCards()
+      REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+  // Mark the objects allocated in the non-moving space since the last GC. They
+  // are not in the bound mark-bitmap in a young collection and are promoted
+  // with it.
+  void MarkNonMovingSpaceNewObjects() REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_);
 
   // For all the pages in non-moving space, find the first object that overlaps
   // with the pages' start address, and store in first_objs_non_moving_space_ array.
@@ -612,6 +661,11 @@ class MarkCompact final : public GarbageCollector {
   // that double updation doesn't happen in the first place.
   std::unique_ptr<std::unordered_set<void*>> updated_roots_ GUARDED_BY(lock_);
   MemMap from_space_map_;
+  // For every page of the old generation in the moving space, the object which
+  // overlaps with the page's beginning. Unlike first_objs_moving_space_, the
+  // addresses here are post-compact and the array is retained across GC cycles.
+  MemMap old_gen_first_objs_map_;
+  ObjReference* old_gen_first_objs_;
   // Any array of live-bytes in logical chunks of kOffsetChunkSize size
   // in the 'to-be-compacted' space.
   MemMap info_map_;
@@ -768,6 +822,11 @@ class MarkCompact final : public GarbageCollector {
   // clamped.
   uint8_t* const moving_space_begin_;
   uint8_t* moving_space_end_;
+  // End of the old generation in the moving space. Objects in
+  // [moving_space_begin_, old_gen_end_) are neither marked nor moved in a
+  // young-generation collection. It's equal to moving_space_begin_ in full
+  // collections. Aligned to page size.
+  uint8_t* old_gen_end_;
   // moving-space's end pointer at the marking pause. All allocations beyond
   // this will be considered black in the current GC cycle. Aligned up to page
   // size.
@@ -795,6 +854,14 @@ class MarkCompact final : public GarbageCollector {
   // in MarkingPause(). It reaches the correct count only once the marking phase
   // is completed.
   int32_t freed_objects_;
+  // Number of objects in the old generation of the moving space. Required to
+  // compute freed_objects_ in young-generation collections.
+  int32_t old_gen_objects_;
+  // Bytes freed, time taken and number of full collections, in generational mode.
+  uint64_t full_gc_freed_bytes_;
+  uint64_t full_gc_duration_ns_;
+  size_t full_gc_count_;
+  uint64_t gc_start_time_ns_;
   // Userfault file descriptor, accessed only by the GC itself.
   // kFallbackMode value indicates that we are in the fallback mode.
   int uffd_;
@@ -823,6 +890,13 @@ class MarkCompact final : public GarbageCollector {
   // clamped but info_map_ is delayed, we set it to 'Pending'. Once 'info_map_'
   // is also clamped, then we set it to 'Finished'.
   ClampInfoStatus clamp_info_map_status_;
+  // True if the collector promotes the survivors of every GC cycle to an old
+  // generation and performs young-generation collections when asked to.
+  const bool use_generational_;
+  // Set by the heap to request a young-generation collection in the next cycle.
+  bool young_gen_requested_;
+  // True if the current GC cycle is a young-generation collection.
+  bool young_gen_;
 
   class FlipCallback;
   class ThreadFlipVisitor;
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gc_event_log.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "android-base/file.h"
+#include "base/logging.h"
+#include "base/timing_logger.h"
+#include "thread.h"
+
+namespace art HIDDEN {
+namespace gc {
+
+void GcEvent::SetPhases(const TimingLogger& timings) {
+  const std::vector<TimingLogger::Timing>& splits = timings.GetTimings();
+  TimingLogger::TimingData timing_data(timings.CalculateTimingData());
+  num_phases = 0;
+  size_t depth = 0;
+  for (size_t i = 0; i < splits.size(); ++i) {
+    if (!splits[i].IsStartTiming()) {
+      DCHECK_NE(depth, 0u);
+      --depth;
+      continue;
+    }
+    if (depth++ != 0u || num_phases == kMaxPhases) {
+      continue;
+    }
+    Phase& phase = phases[num_phases++];
+    strncpy(phase.name, splits[i].GetName(), kMaxPhaseNameLength - 1);
+    phase.name[kMaxPhaseNameLength - 1] = '\0';
+    phase.duration_ns = timing_data.GetTotalTime(i);
+  }
+}
+
+GcEventLog::GcEventLog(size_t capacity, const std::string& stream_file)
+    : capacity_(capacity),
+      slots_(new Slot[capacity]),
+      num_recorded_(0u),
+      stream_lock_("GC event stream lock", kDefaultMutexLevel),
+      stream_fd_(-1),
+      pending_lock_("GC event pending lock", kGenericBottomLock),
+      stream_enabled_(false),
+      flush_requested_(false),
+      num_dropped_events_(0u) {
+  DCHECK_NE(capacity, 0u);
+  for (size_t i = 0; i < capacity; ++i) {
+    slots_[i].sequence.store(0u, std::memory_order_relaxed);
+  }
+  if (stream_file.empty()) {
+    return;
+  }
+  Thread* self = Thread::Current();
+  MutexLock mu(self, stream_lock_);
+  stream_fd_ = TEMP_FAILURE_RETRY(
+      open(stream_file.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644));
+  if (stream_fd_ < 0) {
+    PLOG(WARNING) << "Could not open GC event stream " << stream_file;
+    return;
+  }
+  struct stat st;
+  if (fstat(stream_fd_, &st) != 0) {
+    PLOG(WARNING) << "Could not stat GC event stream " << stream_file;
+    close(stream_fd_);
+    stream_fd_ = -1;
+    return;
+  }
+  if (st.st_size == 0) {
+    GcEventStreamHeader header = {};
+    memcpy(header.magic, kStreamMagic, sizeof(header.magic));
+    header.version = kFormatVersion;
+    header.event_size = sizeof(GcEvent);
+    if (!WriteToStream(&header, sizeof(header))) {
+      return;
+    }
+  }
+  MutexLock mu2(self, pending_lock_);
+  stream_enabled_ = true;
+}
+
+GcEventLog::~GcEventLog() {
+  // Write out whatever the heap task did not get to.
+  Thread* self = Thread::Current();
+  FlushStream(self);
+  MutexLock mu(self, stream_lock_);
+  if (stream_fd_ >= 0) {
+    close(stream_fd_);
+  }
+}
+
+bool GcEventLog::Record(const GcEvent& event) {
+  uint64_t sequence = num_recorded_.load(std::memory_order_relaxed);
+  Slot& slot = slots_[sequence % capacity_];
+  // Mark the slot as being written before touching the event, so that readers which copied part
+  // of the previous event see the sequence change and drop it.
+  slot.sequence.store(2u * sequence + 1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.event = event;
+  slot.sequence.store(2u * (sequence + 1u), std::memory_order_release);
+  num_recorded_.store(sequence + 1u, std::memory_order_release);
+
+  MutexLock mu(Thread::Current(), pending_lock_);
+  if (!stream_enabled_) {
+    return false;
+  }
+  if (pending_events_.size() == kMaxPendingEvents) {
+    ++num_dropped_events_;
+  } else {
+    pending_events_.push_back(event);
+  }
+  if (flush_requested_) {
+    return false;
+  }
+  flush_requested_ = true;
+  return true;
+}
+
+void GcEventLog::CancelFlushRequest() {
+  MutexLock mu(Thread::Current(), pending_lock_);
+  flush_requested_ = false;
+}
+
+void GcEventLog::FlushStream(Thread* self) {
+  MutexLock mu(self, stream_lock_);
+  std::vector<GcEvent> events;
+  size_t num_dropped_events;
+  {
+    MutexLock mu2(self, pending_lock_);
+    events.swap(pending_events_);
+    flush_requested_ = false;
+    num_dropped_events = num_dropped_events_;
+    num_dropped_events_ = 0u;
+  }
+  if (num_dropped_events != 0u) {
+    LOG(WARNING) << "Dropped " << num_dropped_events << " GC events that were not streamed in time";
+  }
+  if (events.empty() || stream_fd_ < 0) {
+    return;
+  }
+  if (!WriteToStream(events.data(), events.size() * sizeof(GcEvent))) {
+    MutexLock mu2(self, pending_lock_);
+    stream_enabled_ = false;
+    pending_events_.clear();
+  }
+}
+
+uint64_t GcEventLog::GetEvents(uint64_t first_sequence, std::vector<GcEvent>* events) const {
+  uint64_t end = num_recorded_.load(std::memory_order_acquire);
+  uint64_t begin = std::max(first_sequence, end > capacity_ ? end - capacity_ : 0u);
+  for (uint64_t sequence = begin; sequence < end; ++sequence) {
+    const Slot& slot = slots_[sequence % capacity_];
+    uint64_t expected = 2u * (sequence + 1u);
+    if (slot.sequence.load(std::memory_order_acquire) != expected) {
+      continue;  // Already overwritten by a newer event.
+    }
+    GcEvent event;
+    memcpy(&event, &slot.event, sizeof(event));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+      continue;  // Overwritten while we were copying it.
+    }
+    events->push_back(event);
+  }
+  return end;
+}
+
+bool GcEventLog::WriteToStream(const void* data, size_t size) {
+  if (!android::base::WriteFully(stream_fd_, data, size)) {
+    PLOG(WARNING) << "Could not write to the GC event stream, disabling it";
+    close(stream_fd_);
+    stream_fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace gc
+}  // namespace art
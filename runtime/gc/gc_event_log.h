@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_GC_GC_EVENT_LOG_H_
+#define ART_RUNTIME_GC_GC_EVENT_LOG_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "base/atomic.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+
+namespace art HIDDEN {
+
+class Thread;
+class TimingLogger;
+
+namespace gc {
+
+// A finished GC, as kept by GcEventLog and written to the GC event stream. The layout is the
+// record format of the stream and of the JVMTI extension that reads the log, so new fields must
+// be appended and GcEventLog::kFormatVersion bumped.
+struct GcEvent {
+  static constexpr size_t kMaxPauses = 4;
+  static constexpr size_t kMaxPhases = 16;
+  static constexpr size_t kMaxPhaseNameLength = 40;
+
+  // A top level split of the GC's TimingLogger.
+  struct Phase {
+    char name[kMaxPhaseNameLength];  // Truncated and NUL terminated.
+    uint64_t duration_ns;
+  };
+
+  // Value of Heap::GetCurrentGcNum() once the GC finished.
+  uint64_t gc_num;
+  // CLOCK_MONOTONIC time at which the GC finished, and its duration.
+  uint64_t end_time_ns;
+  uint64_t duration_ns;
+  uint32_t cause;  // GcCause.
+  uint32_t collector_type;  // CollectorType.
+  uint32_t gc_type;  // collector::GcType.
+  // Number of pauses, of which the first kMaxPauses are in pause_ns.
+  uint32_t num_pauses;
+  uint64_t pause_ns[kMaxPauses];
+  uint64_t total_pause_ns;
+  uint64_t freed_objects;
+  int64_t freed_bytes;
+  uint64_t freed_large_objects;
+  int64_t freed_large_object_bytes;
+  // Bytes allocated in the heap before and after the GC, and the target footprint it set.
+  uint64_t heap_bytes_before;
+  uint64_t heap_bytes_after;
+  uint64_t target_footprint_after;
+  // Number of phases in phases, at most kMaxPhases.
+  uint32_t num_phases;
+  uint32_t padding;
+  Phase phases[kMaxPhases];
+
+  // Fill in phases from the top level splits of `timings`.
+  void SetPhases(const TimingLogger& timings);
+};
+
+static_assert(std::is_trivially_copyable_v<GcEvent>, "GcEvent is copied as raw bytes");
+
+// Header at the start of the GC event stream, followed by the GcEvent records.
+struct GcEventStreamHeader {
+  char magic[8];  // GcEventLog::kStreamMagic.
+  uint32_t version;  // GcEventLog::kFormatVersion.
+  uint32_t event_size;  // sizeof(GcEvent).
+};
+
+// Keeps the last GC events in a ring buffer that can be read without blocking the GC, and
+// optionally appends every event to a file. Recording an event never writes to the file: the
+// events are buffered until FlushStream() is called, so that the GC does not wait for the I/O.
+class GcEventLog {
+ public:
+  static constexpr char kStreamMagic[8] = "ARTGCEV";
+  static constexpr uint32_t kFormatVersion = 1;
+  // At most this many events are buffered for the stream. Events recorded while the buffer is
+  // full are dropped, which shows as a gap in the gc_num of the streamed events.
+  static constexpr size_t kMaxPendingEvents = 1024;
+
+  // Keep the last `capacity` events. If `stream_file` is not empty, also append each event to it.
+  GcEventLog(size_t capacity, const std::string& stream_file);
+  ~GcEventLog();
+
+  // Record a GC event. Only called by the thread that ran the GC, so there is a single writer.
+  // Returns true if the event was buffered for the stream and the caller should arrange for
+  // FlushStream() to be called; this is only requested once until the next flush, unless the
+  // caller gives up with CancelFlushRequest().
+  bool Record(const GcEvent& event) REQUIRES(!pending_lock_);
+  void CancelFlushRequest() REQUIRES(!pending_lock_);
+
+  // Append the buffered events to the stream file.
+  void FlushStream(Thread* self) REQUIRES(!stream_lock_, !pending_lock_);
+
+  // Append to `events` the events with a sequence number of at least `first_sequence` that are
+  // still in the ring buffer, oldest first. Events are numbered from 0 in the order they are
+  // recorded. Returns the sequence number of the next event to be recorded.
+  EXPORT uint64_t GetEvents(uint64_t first_sequence, std::vector<GcEvent>* events) const;
+
+  size_t GetCapacity() const {
+    return capacity_;
+  }
+
+ private:
+  // A seqlock protected slot. `sequence` is odd while the slot is being written, and
+  // 2 * (event sequence number + 1) once it holds that event.
+  struct Slot {
+    Atomic<uint64_t> sequence;
+    GcEvent event;
+  };
+
+  bool WriteToStream(const void* data, size_t size) REQUIRES(stream_lock_);
+
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  // Number of events recorded so far.
+  Atomic<uint64_t> num_recorded_;
+
+  // Serializes the writes to the stream, held across a whole flush so that the events are
+  // written in the order they were recorded.
+  Mutex stream_lock_ ACQUIRED_BEFORE(pending_lock_);
+  // File the events are streamed to, or -1.
+  int stream_fd_ GUARDED_BY(stream_lock_);
+
+  // Protects the events waiting to be written to the stream. Only held for short periods, so the
+  // GC does not block on a flush in progress.
+  Mutex pending_lock_ BOTTOM_MUTEX_ACQUIRED_AFTER;
+  // Whether events are still buffered for the stream. Cleared if the stream could not be opened
+  // or a write to it failed.
+  bool stream_enabled_ GUARDED_BY(pending_lock_);
+  // Whether Record() asked for a FlushStream() that has not run yet.
+  bool flush_requested_ GUARDED_BY(pending_lock_);
+  std::vector<GcEvent> pending_events_ GUARDED_BY(pending_lock_);
+  // Number of events dropped because pending_events_ was full, since the last flush.
+  size_t num_dropped_events_ GUARDED_BY(pending_lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(GcEventLog);
+};
+
+}  // namespace gc
+}  // namespace art
+
+#endif  // ART_RUNTIME_GC_GC_EVENT_LOG_H_
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gc_event_log.h"
+
+#include <string.h>
+
+#include "android-base/file.h"
+#include "base/common_art_test.h"
+#include "base/timing_logger.h"
+#include "thread.h"
+
+namespace art HIDDEN {
+namespace gc {
+
+class GcEventLogTest : public CommonArtTest {
+ protected:
+  static GcEvent MakeEvent(uint64_t gc_num) {
+    GcEvent event = {};
+    event.gc_num = gc_num;
+    event.freed_bytes = static_cast<int64_t>(gc_num * 100);
+    return event;
+  }
+};
+
+TEST_F(GcEventLogTest, GetEvents) {
+  GcEventLog log(4, "");
+  std::vector<GcEvent> events;
+  EXPECT_EQ(0u, log.GetEvents(0, &events));
+  EXPECT_TRUE(events.empty());
+  for (uint64_t i = 0; i < 3; ++i) {
+    log.Record(MakeEvent(i));
+  }
+  EXPECT_EQ(3u, log.GetEvents(0, &events));
+  ASSERT_EQ(3u, events.size());
+  for (uint64_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(i, events[i].gc_num);
+    EXPECT_EQ(static_cast<int64_t>(i * 100), events[i].freed_bytes);
+  }
+  events.clear();
+  EXPECT_EQ(3u, log.GetEvents(2, &events));
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ(2u, events[0].gc_num);
+  events.clear();
+  EXPECT_EQ(3u, log.GetEvents(3, &events));
+  EXPECT_TRUE(events.empty());
+}
+
+TEST_F(GcEventLogTest, WrapAround) {
+  GcEventLog log(4, "");
+  for (uint64_t i = 0; i < 10; ++i) {
+    log.Record(MakeEvent(i));
+  }
+  std::vector<GcEvent> events;
+  // Only the last four events are kept.
+  EXPECT_EQ(10u, log.GetEvents(0, &events));
+  ASSERT_EQ(4u, events.size());
+  for (uint64_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(6u + i, events[i].gc_num);
+  }
+  events.clear();
+  EXPECT_EQ(10u, log.GetEvents(8, &events));
+  ASSERT_EQ(2u, events.size());
+  EXPECT_EQ(8u, events[0].gc_num);
+  EXPECT_EQ(9u, events[1].gc_num);
+}
+
+TEST_F(GcEventLogTest, Phases) {
+  TimingLogger timings("GcEventLogTest", true, false);
+  timings.StartTiming("Marking");
+  timings.StartTiming("Nested");
+  timings.EndTiming();
+  timings.EndTiming();
+  timings.StartTiming("A phase name that is too long to fit in the event record");
+  timings.EndTiming();
+  GcEvent event = {};
+  event.SetPhases(timings);
+  ASSERT_EQ(2u, event.num_phases);
+  EXPECT_STREQ("Marking", event.phases[0].name);
+  EXPECT_EQ(GcEvent::kMaxPhaseNameLength - 1, strlen(event.phases[1].name));
+  EXPECT_EQ(0, strncmp("A phase name", event.phases[1].name, 12));
+}
+
+TEST_F(GcEventLogTest, Stream) {
+  ScratchFile file;
+  std::string contents;
+  {
+    GcEventLog log(2, file.GetFilename());
+    // Only the first event buffered since the last flush asks for a flush.
+    EXPECT_TRUE(log.Record(MakeEvent(0)));
+    EXPECT_FALSE(log.Record(MakeEvent(1)));
+    // Recording does not write to the stream.
+    ASSERT_TRUE(android::base::ReadFileToString(file.GetFilename(), &contents));
+    EXPECT_EQ(sizeof(GcEventStreamHeader), contents.size());
+    log.FlushStream(Thread::Current());
+    ASSERT_TRUE(android::base::ReadFileToString(file.GetFilename(), &contents));
+    EXPECT_EQ(sizeof(GcEventStreamHeader) + 2 * sizeof(GcEvent), contents.size());
+    // The last event is written when the log is destroyed.
+    EXPECT_TRUE(log.Record(MakeEvent(2)));
+  }
+  ASSERT_TRUE(android::base::ReadFileToString(file.GetFilename(), &contents));
+  ASSERT_EQ(sizeof(GcEventStreamHeader) + 3 * sizeof(GcEvent), contents.size());
+  GcEventStreamHeader header;
+  memcpy(&header, contents.data(), sizeof(header));
+  EXPECT_STREQ(GcEventLog::kStreamMagic, header.magic);
+  EXPECT_EQ(GcEventLog::kFormatVersion, header.version);
+  EXPECT_EQ(sizeof(GcEvent), header.event_size);
+  // Unlike the ring buffer, the stream keeps every event.
+  for (uint64_t i = 0; i < 3; ++i) {
+    GcEvent event;
+    memcpy(&event, contents.data() + sizeof(header) + i * sizeof(GcEvent), sizeof(event));
+    EXPECT_EQ(i, event.gc_num);
+  }
+}
+
+TEST_F(GcEventLogTest, StreamDropsEventsWhenFull) {
+  ScratchFile file;
+  std::string contents;
+  GcEventLog log(2, file.GetFilename());
+  EXPECT_TRUE(log.Record(MakeEvent(0)));
+  for (uint64_t i = 1; i < GcEventLog::kMaxPendingEvents + 10; ++i) {
+    EXPECT_FALSE(log.Record(MakeEvent(i)));
+  }
+  // Only the first kMaxPendingEvents events were buffered.
+  log.FlushStream(Thread::Current());
+  ASSERT_TRUE(android::base::ReadFileToString(file.GetFilename(), &contents));
+  ASSERT_EQ(sizeof(GcEventStreamHeader) + GcEventLog::kMaxPendingEvents * sizeof(GcEvent),
+            contents.size());
+  GcEvent event;
+  memcpy(&event, contents.data() + contents.size() - sizeof(GcEvent), sizeof(event));
+  EXPECT_EQ(GcEventLog::kMaxPendingEvents - 1u, event.gc_num);
+
+  // The buffer is empty again after the flush.
+  EXPECT_TRUE(log.Record(MakeEvent(GcEventLog::kMaxPendingEvents + 10)));
+  log.FlushStream(Thread::Current());
+  ASSERT_TRUE(android::base::ReadFileToString(file.GetFilename(), &contents));
+  ASSERT_EQ(sizeof(GcEventStreamHeader) + (GcEventLog::kMaxPendingEvents + 1) * sizeof(GcEvent),
+            contents.size());
+  memcpy(&event, contents.data() + contents.size() - sizeof(GcEvent), sizeof(event));
+  EXPECT_EQ(GcEventLog::kMaxPendingEvents + 10, event.gc_num);
+}
+
+}  // namespace gc
+}  // namespace art
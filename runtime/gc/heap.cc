@@ -19,6 +19,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <random>
@@ -60,6 +62,7 @@
 #include "gc/collector/partial_mark_sweep.h"
 #include "gc/collector/semi_space.h"
 #include "gc/collector/sticky_mark_sweep.h"
+#include "gc/gc_event_log.h"
 #include "gc/racing_check.h"
 #include "gc/reference_processor.h"
 #include "gc/scoped_gc_critical_section.h"
@@ -149,11 +152,19 @@ DEFINE_RUNTIME_DEBUG_FLAG(Heap, kStressCollectorTransition);
 // Minimum amount of remaining bytes before a concurrent GC is triggered.
 static constexpr size_t kMinConcurrentRemainingBytes = 128 * KB;
 static constexpr size_t kMaxConcurrentRemainingBytes = 512 * KB;
+// Bounds of the multipliers adjusted to meet the GC CPU and pause budgets.
+static constexpr double kMinBudgetGrowthMultiplier = 0.25;
+static constexpr double kMaxBudgetGrowthMultiplier = 4.0;
+static constexpr double kMaxBudgetConcurrentStartMultiplier = 8.0;
+// Largest factor by which a multiplier changes after a single GC, to avoid oscillating.
+static constexpr double kMaxBudgetStep = 1.5;
+// Weight of the latest GC in the smoothed GC CPU fraction.
+static constexpr double kBudgetCpuSmoothing = 0.5;
 // Sticky GC throughput adjustment, divided by 4. Increasing this causes sticky GC to occur more
 // relative to partial/full GC. This may be desirable since sticky GCs interfere less with mutator
 // threads (lower pauses, use less memory bandwidth).
-static double GetStickyGcThroughputAdjustment(bool use_generational_cc) {
-  return use_generational_cc ? 0.5 : 1.0;
+static double GetStickyGcThroughputAdjustment(bool use_generational) {
+  return use_generational ? 0.5 : 1.0;
 }
 // Whether or not we compact the zygote in PreZygoteFork.
 static constexpr bool kCompactZygote = kMovingCollector;
@@ -277,6 +288,8 @@ Heap::Heap(size_t initial_size,
            size_t max_free,
            double target_utilization,
            double foreground_heap_growth_multiplier,
+           double gc_cpu_budget,
+           uint64_t gc_pause_budget_ns,
            size_t stop_for_native_allocs,
            size_t capacity,
            size_t non_moving_space_capacity,
@@ -310,9 +323,13 @@ Heap::Heap(size_t initial_size,
            bool measure_gc_performance,
            bool use_homogeneous_space_compaction_for_oom,
            bool use_generational_cc,
+           bool use_generational_cmc,
+           bool use_numa_aware_allocation,
            uint64_t min_interval_homogeneous_space_compaction_by_oom,
            bool dump_region_info_before_gc,
-           bool dump_region_info_after_gc)
+           bool dump_region_info_after_gc,
+           size_t gc_event_log_size,
+           const std::string& gc_event_stream_file)
     : non_moving_space_(nullptr),
       rosalloc_space_(nullptr),
       dlmalloc_space_(nullptr),
@@ -391,6 +408,13 @@ Heap::Heap(size_t initial_size,
       max_free_(max_free),
       target_utilization_(target_utilization),
       foreground_heap_growth_multiplier_(foreground_heap_growth_multiplier),
+      gc_cpu_budget_(gc_cpu_budget),
+      gc_pause_budget_ns_(gc_pause_budget_ns),
+      budget_growth_multiplier_(1.0),
+      budget_concurrent_start_multiplier_(1.0),
+      budget_gc_cpu_fraction_(0.0),
+      budget_last_gc_cpu_time_ns_(0u),
+      budget_last_process_cpu_time_ns_(process_cpu_start_time_ns_),
       stop_for_native_allocs_(stop_for_native_allocs),
       total_wait_time_(0),
       verify_object_mode_(kVerifyObjectModeDisabled),
@@ -411,6 +435,7 @@ Heap::Heap(size_t initial_size,
       pending_heap_trim_(nullptr),
       use_homogeneous_space_compaction_for_oom_(use_homogeneous_space_compaction_for_oom),
       use_generational_cc_(use_generational_cc),
+      use_generational_cmc_(use_generational_cmc),
       running_collection_is_blocking_(false),
       blocking_gc_count_(0U),
       blocking_gc_time_(0U),
@@ -429,6 +454,9 @@ Heap::Heap(size_t initial_size,
       gc_disabled_for_shutdown_(false),
       dump_region_info_before_gc_(dump_region_info_before_gc),
       dump_region_info_after_gc_(dump_region_info_after_gc),
+      gc_event_log_(gc_event_log_size != 0u
+                        ? new GcEventLog(gc_event_log_size, gc_event_stream_file)
+                        : nullptr),
       boot_image_spaces_(),
       boot_images_start_address_(0u),
       boot_images_size_(0u),
@@ -651,8 +679,10 @@ Heap::Heap(size_t initial_size,
     MemMap region_space_mem_map =
         space::RegionSpace::CreateMemMap(kRegionSpaceName, capacity_ * 2, request_begin);
     CHECK(region_space_mem_map.IsValid()) << "No region space mem map";
-    region_space_ = space::RegionSpace::Create(
-        kRegionSpaceName, std::move(region_space_mem_map), use_generational_cc_);
+    region_space_ = space::RegionSpace::Create(kRegionSpaceName,
+                                               std::move(region_space_mem_map),
+                                               use_generational_cc_,
+                                               use_numa_aware_allocation);
     AddSpace(region_space_);
   } else if (IsMovingGc(foreground_collector_type_)) {
     // Create bump pointer spaces.
@@ -701,6 +731,13 @@ Heap::Heap(size_t initial_size,
   } else if (large_object_space_type == space::LargeObjectSpaceType::kMap) {
     large_object_space_ = space::LargeObjectMapSpace::Create("mem map large object space");
     CHECK(large_object_space_ != nullptr) << "Failed to create large object space";
+  } else if (large_object_space_type == space::LargeObjectSpaceType::kSizeClass ||
+             large_object_space_type == space::LargeObjectSpaceType::kSizeClassHugePages) {
+    large_object_space_ = space::SizeClassLargeObjectSpace::Create(
+        "size class large object space",
+        capacity_,
+        large_object_space_type == space::LargeObjectSpaceType::kSizeClassHugePages);
+    CHECK(large_object_space_ != nullptr) << "Failed to create large object space";
   } else {
     // Disable the large object space by making the cutoff excessively large.
     large_object_threshold_ = std::numeric_limits<size_t>::max();
@@ -796,7 +833,7 @@ Heap::Heap(size_t initial_size,
       garbage_collectors_.push_back(semi_space_collector_);
     }
     if (MayUseCollector(kCollectorTypeCMC)) {
-      mark_compact_ = new collector::MarkCompact(this);
+      mark_compact_ = new collector::MarkCompact(this, use_generational_cmc_);
       garbage_collectors_.push_back(mark_compact_);
     }
     if (MayUseCollector(kCollectorTypeCC)) {
@@ -1322,9 +1359,21 @@ void Heap::DumpGcPerformanceInfo(std::ostream& os) {
     }
   }
 
+  if (HasGcBudget()) {
+    MutexLock mu(Thread::Current(), process_state_update_lock_);
+    os << "GC budget: CPU " << gc_cpu_budget_ * 100.0 << "%"
+       << " pause " << PrettyDuration(gc_pause_budget_ns_)
+       << " measured GC CPU " << budget_gc_cpu_fraction_ * 100.0 << "%"
+       << " growth multiplier " << budget_growth_multiplier_
+       << " concurrent start multiplier " << budget_concurrent_start_multiplier_ << "\n";
+  }
+
   if (kDumpRosAllocStatsOnSigQuit && rosalloc_space_ != nullptr) {
     rosalloc_space_->DumpStats(os);
   }
+  if (rosalloc_space_ != nullptr) {
+    rosalloc_space_->DumpBracketStats(os);
+  }
 
   os << "Native bytes total: " << GetNativeBytes()
      << " registered: " << native_bytes_registered_.load(std::memory_order_relaxed) << "\n";
@@ -2325,6 +2374,9 @@ void Heap::ChangeCollector(CollectorType collector_type) {
         break;
       }
       case kCollectorTypeCMC: {
+        if (use_generational_cmc_) {
+          gc_plan_.push_back(collector::kGcTypeSticky);
+        }
         gc_plan_.push_back(collector::kGcTypeFull);
         if (use_tlab_) {
           ChangeAllocator(kAllocatorTypeTLAB);
@@ -2566,6 +2618,11 @@ void Heap::PreZygoteFork() {
         region_space_->GetMarkBitmap()->Clear();
       } else {
         bump_pointer_space_->GetMemMap()->Protect(PROT_READ | PROT_WRITE);
+        if (mark_compact_ != nullptr) {
+          // Everything was evacuated out of the moving space, so there is no
+          // old generation left in it.
+          mark_compact_->ResetGenerations();
+        }
       }
     }
     if (temp_space_ != nullptr) {
@@ -2853,6 +2910,7 @@ collector::GcType Heap::CollectGarbageInternal(collector::GcType gc_type,
           collector = semi_space_collector_;
           break;
         case kCollectorTypeCMC:
+          mark_compact_->SetYoungGen(use_generational_cmc_ && gc_type == collector::kGcTypeSticky);
           collector = mark_compact_;
           break;
         case kCollectorTypeCC:
@@ -2904,6 +2962,9 @@ collector::GcType Heap::CollectGarbageInternal(collector::GcType gc_type,
     GrowForUtilization(collector, bytes_allocated_before_gc);
     old_native_bytes_allocated_.store(GetNativeBytes());
     LogGC(gc_cause, collector);
+    if (gc_event_log_ != nullptr) {
+      RecordGcEvent(gc_cause, collector, bytes_allocated_before_gc);
+    }
     FinishGC(self, gc_type);
     // We're suspended up to this point.
   }
@@ -2969,6 +3030,53 @@ void Heap::LogGC(GcCause gc_cause, collector::GarbageCollector* collector) {
   }
 }
 
+class Heap::GcEventStreamFlushTask : public HeapTask {
+ public:
+  explicit GcEventStreamFlushTask(uint64_t target_time) : HeapTask(target_time) {}
+  void Run(Thread* self) override {
+    Runtime::Current()->GetHeap()->GetGcEventLog()->FlushStream(self);
+  }
+};
+
+void Heap::RecordGcEvent(GcCause gc_cause,
+                         collector::GarbageCollector* collector,
+                         size_t bytes_allocated_before_gc) {
+  collector::Iteration* iteration = GetCurrentGcIteration();
+  const std::vector<uint64_t>& pause_times = iteration->GetPauseTimes();
+  GcEvent event = {};
+  // The GC number is only incremented by FinishGC().
+  event.gc_num = GetCurrentGcNum() + 1u;
+  event.end_time_ns = NanoTime();
+  event.duration_ns = iteration->GetDurationNs();
+  event.cause = static_cast<uint32_t>(gc_cause);
+  event.collector_type = static_cast<uint32_t>(collector->GetCollectorType());
+  event.gc_type = static_cast<uint32_t>(collector->GetGcType());
+  event.num_pauses = pause_times.size();
+  for (size_t i = 0; i < pause_times.size(); ++i) {
+    if (i < GcEvent::kMaxPauses) {
+      event.pause_ns[i] = pause_times[i];
+    }
+    event.total_pause_ns += pause_times[i];
+  }
+  event.freed_objects = iteration->GetFreedObjects();
+  event.freed_bytes = iteration->GetFreedBytes();
+  event.freed_large_objects = iteration->GetFreedLargeObjects();
+  event.freed_large_object_bytes = iteration->GetFreedLargeObjectBytes();
+  event.heap_bytes_before = bytes_allocated_before_gc;
+  event.heap_bytes_after = GetBytesAllocated();
+  event.target_footprint_after = target_footprint_.load(std::memory_order_relaxed);
+  event.SetPhases(*iteration->GetTimings());
+  if (gc_event_log_->Record(event)) {
+    // Leave the file I/O to a heap task rather than doing it before the GC is finished.
+    GcEventStreamFlushTask* task = new GcEventStreamFlushTask(NanoTime());
+    if (!AddHeapTask(task)) {
+      // Keep the events buffered until a later GC can post the task, or the log is destroyed.
+      delete task;
+      gc_event_log_->CancelFlushRequest();
+    }
+  }
+}
+
 void Heap::FinishGC(Thread* self, collector::GcType gc_type) {
   MutexLock mu(self, *gc_complete_lock_);
   collector_type_running_ = kCollectorTypeNone;
@@ -3780,8 +3888,13 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
   uint64_t target_size, grow_bytes;
   collector::GcType gc_type = collector_ran->GetGcType();
   MutexLock mu(Thread::Current(), process_state_update_lock_);
+  if (HasGcBudget()) {
+    UpdateGcBudgetMultipliers();
+  }
   // Use the multiplier to grow more for foreground.
   const double multiplier = HeapGrowthMultiplier();
+  // Grow more or less to meet the GC budgets, if any.
+  const double growth_multiplier = multiplier * budget_growth_multiplier_;
   if (gc_type != collector::kGcTypeSticky) {
     // Grow the heap for non sticky GC.
     uint64_t delta = bytes_allocated * (1.0 / GetTargetHeapUtilization() - 1.0);
@@ -3789,19 +3902,32 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
         << " target_utilization_=" << target_utilization_;
     grow_bytes = std::min(delta, static_cast<uint64_t>(max_free_));
     grow_bytes = std::max(grow_bytes, static_cast<uint64_t>(min_free_));
-    target_size = bytes_allocated + static_cast<uint64_t>(grow_bytes * multiplier);
+    target_size = bytes_allocated + static_cast<uint64_t>(grow_bytes * growth_multiplier);
     next_gc_type_ = collector::kGcTypeSticky;
   } else {
     collector::GcType non_sticky_gc_type = NonStickyGcType();
-    // Find what the next non sticky collector will be.
-    collector::GarbageCollector* non_sticky_collector = FindCollectorByGcType(non_sticky_gc_type);
-    if (use_generational_cc_) {
-      if (non_sticky_collector == nullptr) {
-        non_sticky_collector = FindCollectorByGcType(collector::kGcTypePartial);
+    uint64_t non_sticky_gc_throughput;
+    size_t non_sticky_gc_iterations;
+    if (collector_ran == mark_compact_) {
+      // The same mark-compact collector instance performs both young and full
+      // collections. So use the statistics of its full collections only.
+      DCHECK(use_generational_cmc_);
+      non_sticky_gc_throughput = mark_compact_->GetEstimatedFullGcMeanThroughput();
+      non_sticky_gc_iterations = mark_compact_->GetFullGcCount();
+    } else {
+      // Find what the next non sticky collector will be.
+      collector::GarbageCollector* non_sticky_collector = FindCollectorByGcType(non_sticky_gc_type);
+      if (use_generational_cc_) {
+        if (non_sticky_collector == nullptr) {
+          non_sticky_collector = FindCollectorByGcType(collector::kGcTypePartial);
+        }
+        CHECK(non_sticky_collector != nullptr);
       }
-      CHECK(non_sticky_collector != nullptr);
+      non_sticky_gc_throughput = non_sticky_collector->GetEstimatedMeanThroughput();
+      non_sticky_gc_iterations = non_sticky_collector->NumberOfIterations();
     }
-    double sticky_gc_throughput_adjustment = GetStickyGcThroughputAdjustment(use_generational_cc_);
+    double sticky_gc_throughput_adjustment =
+        GetStickyGcThroughputAdjustment(use_generational_cc_ || use_generational_cmc_);
 
     // If the throughput of the current sticky GC >= throughput of the non sticky collector, then
     // do another sticky collection next.
@@ -3811,15 +3937,15 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
     // if the sticky GC throughput always remained >= the full/partial throughput.
     size_t target_footprint = target_footprint_.load(std::memory_order_relaxed);
     if (current_gc_iteration_.GetEstimatedThroughput() * sticky_gc_throughput_adjustment >=
-        non_sticky_collector->GetEstimatedMeanThroughput() &&
-        non_sticky_collector->NumberOfIterations() > 0 &&
+        non_sticky_gc_throughput &&
+        non_sticky_gc_iterations > 0 &&
         bytes_allocated <= (IsGcConcurrent() ? concurrent_start_bytes_ : target_footprint)) {
       next_gc_type_ = collector::kGcTypeSticky;
     } else {
       next_gc_type_ = non_sticky_gc_type;
     }
     // If we have freed enough memory, shrink the heap back down.
-    const size_t adjusted_max_free = static_cast<size_t>(max_free_ * multiplier);
+    const size_t adjusted_max_free = static_cast<size_t>(max_free_ * growth_multiplier);
     if (bytes_allocated + adjusted_max_free < target_footprint) {
       target_size = bytes_allocated + adjusted_max_free;
       grow_bytes = max_free_;
@@ -3841,9 +3967,10 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
     // process-state switch.
     min_foreground_target_footprint_ =
         (multiplier <= 1.0 && grow_bytes > 0)
-        ? std::min(
-          bytes_allocated + static_cast<size_t>(grow_bytes * foreground_heap_growth_multiplier_),
-          GetMaxMemory())
+        ? std::min(bytes_allocated + static_cast<size_t>(grow_bytes *
+                                                         foreground_heap_growth_multiplier_ *
+                                                         budget_growth_multiplier_),
+                   GetMaxMemory())
         : 0;
 
     if (IsGcConcurrent()) {
@@ -3860,9 +3987,8 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
           UnsignedDifference(bytes_allocated + freed_bytes, bytes_allocated_before_gc);
       // Calculate when to perform the next ConcurrentGC.
       // Estimate how many remaining bytes we will have when we need to start the next GC.
-      size_t remaining_bytes = bytes_allocated_during_gc;
-      remaining_bytes = std::min(remaining_bytes, kMaxConcurrentRemainingBytes);
-      remaining_bytes = std::max(remaining_bytes, kMinConcurrentRemainingBytes);
+      size_t remaining_bytes =
+          ConcurrentRemainingBytes(bytes_allocated_during_gc, budget_concurrent_start_multiplier_);
       size_t target_footprint = target_footprint_.load(std::memory_order_relaxed);
       if (UNLIKELY(remaining_bytes > target_footprint)) {
         // A never going to happen situation that from the estimated allocation rate we will exceed
@@ -3885,6 +4011,80 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
   }
 }
 
+size_t Heap::ConcurrentRemainingBytes(size_t bytes_allocated_during_gc,
+                                      double concurrent_start_multiplier) {
+  // Start earlier if GCs did not finish before the allocations caught up with them. Scale the
+  // estimate before clamping it, and the upper bound with it, so that the multiplier does not
+  // also raise the lower bound for low allocation rates.
+  size_t remaining_bytes =
+      static_cast<size_t>(bytes_allocated_during_gc * concurrent_start_multiplier);
+  size_t max_remaining_bytes =
+      static_cast<size_t>(kMaxConcurrentRemainingBytes * concurrent_start_multiplier);
+  return std::clamp(remaining_bytes, kMinConcurrentRemainingBytes, max_remaining_bytes);
+}
+
+void Heap::UpdateGcBudgetMultipliers() {
+  const uint64_t gc_cpu_time = GetTotalGcCpuTime();
+  const uint64_t process_cpu_time = ProcessCpuNanoTime();
+  // The GC CPU time goes back to zero when the GC performance info is reset; skip that sample.
+  if (gc_cpu_time >= budget_last_gc_cpu_time_ns_ &&
+      process_cpu_time > budget_last_process_cpu_time_ns_) {
+    double gc_cpu_fraction =
+        static_cast<double>(gc_cpu_time - budget_last_gc_cpu_time_ns_) /
+        static_cast<double>(process_cpu_time - budget_last_process_cpu_time_ns_);
+    gc_cpu_fraction = std::min(gc_cpu_fraction, 1.0);
+    budget_gc_cpu_fraction_ = kBudgetCpuSmoothing * gc_cpu_fraction +
+        (1.0 - kBudgetCpuSmoothing) * budget_gc_cpu_fraction_;
+  }
+  budget_last_gc_cpu_time_ns_ = gc_cpu_time;
+  budget_last_process_cpu_time_ns_ = process_cpu_time;
+
+  double growth = budget_growth_multiplier_;
+  double concurrent_start = budget_concurrent_start_multiplier_;
+  if (gc_cpu_budget_ > 0.0) {
+    // The GC CPU cost is roughly inversely proportional to the free space left after each GC, so
+    // grow proportionally more when over the budget and give memory back when well under it.
+    if (budget_gc_cpu_fraction_ > gc_cpu_budget_) {
+      growth *= std::min(budget_gc_cpu_fraction_ / gc_cpu_budget_, kMaxBudgetStep);
+    } else if (budget_gc_cpu_fraction_ < gc_cpu_budget_ / 2) {
+      growth /= std::min(gc_cpu_budget_ / 2 / std::max(budget_gc_cpu_fraction_, 1e-6),
+                         kMaxBudgetStep);
+    }
+  }
+  if (gc_pause_budget_ns_ > 0u) {
+    const collector::Iteration* iteration = GetCurrentGcIteration();
+    uint64_t max_pause_ns = 0u;
+    for (uint64_t pause_ns : iteration->GetPauseTimes()) {
+      max_pause_ns = std::max(max_pause_ns, pause_ns);
+    }
+    // A concurrent GC that had to run for an allocation made the allocating thread wait for the
+    // whole collection, which counts against the pause budget too.
+    bool waited_for_gc = IsGcConcurrent() && iteration->GetGcCause() == kGcCauseForAlloc;
+    if (max_pause_ns > gc_pause_budget_ns_ || waited_for_gc) {
+      if (IsGcConcurrent()) {
+        // Start concurrent GCs earlier so that they finish before the allocations need them.
+        concurrent_start *= kMaxBudgetStep;
+      } else {
+        // Pauses of non-concurrent GCs grow with the amount allocated since the last GC.
+        growth /= kMaxBudgetStep;
+      }
+    } else if (max_pause_ns < gc_pause_budget_ns_ / 2) {
+      concurrent_start /= std::sqrt(kMaxBudgetStep);
+    }
+  }
+  growth = std::clamp(growth, kMinBudgetGrowthMultiplier, kMaxBudgetGrowthMultiplier);
+  concurrent_start = std::clamp(concurrent_start, 1.0, kMaxBudgetConcurrentStartMultiplier);
+  if (growth != budget_growth_multiplier_ ||
+      concurrent_start != budget_concurrent_start_multiplier_) {
+    VLOG(heap) << "GC budget: GC CPU " << budget_gc_cpu_fraction_ * 100.0 << "%"
+               << ", growth multiplier " << budget_growth_multiplier_ << " -> " << growth
+               << ", concurrent start multiplier " << budget_concurrent_start_multiplier_
+               << " -> " << concurrent_start;
+  }
+  budget_growth_multiplier_ = growth;
+  budget_concurrent_start_multiplier_ = concurrent_start;
+}
+
 void Heap::ClampGrowthLimit() {
   // Use heap bitmap lock to guard against races with BindLiveToMarkBitmap.
   ScopedObjectAccess soa(Thread::Current());
@@ -72,6 +72,7 @@ namespace gc {
 
 class AllocationListener;
 class AllocRecordObjectMap;
+class GcEventLog;
 class GcPauseListener;
 class HeapTask;
 class ReferenceProcessor;
@@ -205,6 +206,8 @@ class Heap {
        size_t max_free,
        double target_utilization,
        double foreground_heap_growth_multiplier,
+       double gc_cpu_budget,
+       uint64_t gc_pause_budget_ns,
        size_t stop_for_native_allocs,
        size_t capacity,
        size_t non_moving_space_capacity,
@@ -238,9 +241,13 @@ class Heap {
        bool measure_gc_performance,
        bool use_homogeneous_space_compaction,
        bool use_generational_cc,
+       bool use_generational_cmc,
+       bool use_numa_aware_allocation,
        uint64_t min_interval_homogeneous_space_compaction_by_oom,
        bool dump_region_info_before_gc,
-       bool dump_region_info_after_gc);
+       bool dump_region_info_after_gc,
+       size_t gc_event_log_size,
+       const std::string& gc_event_stream_file);
 
   ~Heap();
 
@@ -574,6 +581,10 @@ class Heap {
     return use_generational_cc_;
   }
 
+  bool GetUseGenerationalCMC() const {
+    return use_generational_cmc_;
+  }
+
   // Returns the number of objects currently allocated.
   size_t GetObjectsAllocated() const
       REQUIRES(!Locks::heap_bitmap_lock_);
@@ -781,7 +792,7 @@ class Heap {
 
   // GC performance measuring
   void DumpGcPerformanceInfo(std::ostream& os)
-      REQUIRES(!*gc_complete_lock_);
+      REQUIRES(!*gc_complete_lock_, !process_state_update_lock_);
   void ResetGcPerformanceInfo() REQUIRES(!*gc_complete_lock_);
 
   // Thread pool. Create either the given number of threads, or as per the
@@ -881,6 +892,11 @@ class Heap {
     return gcs_completed_.load(std::memory_order_acquire);
   }
 
+  // The log of recent GC events, or null if it was not enabled with -XX:GcEventLogSize.
+  GcEventLog* GetGcEventLog() const {
+    return gc_event_log_.get();
+  }
+
   // Request asynchronous GC. Observed_gc_num is the value of GetCurrentGcNum() when we started to
   // evaluate the GC triggering condition. If a GC has been completed since then, we consider our
   // job done. If we return true, then we ensured that gcs_completed_ will eventually be
@@ -1033,6 +1049,7 @@ class Heap {
   class HeapTrimTask;
   class TriggerPostForkCCGcTask;
   class ReduceTargetFootprintTask;
+  class GcEventStreamFlushTask;
 
   // Compact source space to target space. Returns the collector used.
   collector::GarbageCollector* Compact(space::ContinuousMemMapAllocSpace* target_space,
@@ -1041,6 +1058,10 @@ class Heap {
       REQUIRES(Locks::mutator_lock_);
 
   void LogGC(GcCause gc_cause, collector::GarbageCollector* collector);
+  // Add the GC that just finished to the GC event log.
+  void RecordGcEvent(GcCause gc_cause,
+                     collector::GarbageCollector* collector,
+                     size_t bytes_allocated_before_gc);
   void StartGC(Thread* self, GcCause cause, CollectorType collector_type)
       REQUIRES(!*gc_complete_lock_);
   void StartGCRunnable(Thread* self, GcCause cause, CollectorType collector_type)
@@ -1237,6 +1258,18 @@ class Heap {
                           size_t bytes_allocated_before_gc = 0)
       REQUIRES(!process_state_update_lock_);
 
+  bool HasGcBudget() const {
+    return gc_cpu_budget_ > 0.0 || gc_pause_budget_ns_ > 0u;
+  }
+
+  // Update the budget multipliers from the CPU time and pauses of the GC that just finished.
+  void UpdateGcBudgetMultipliers() REQUIRES(process_state_update_lock_);
+
+  // Returns how many bytes before the target footprint the next concurrent GC starts, given the
+  // bytes allocated during the last one and the budget concurrent start multiplier.
+  static size_t ConcurrentRemainingBytes(size_t bytes_allocated_during_gc,
+                                         double concurrent_start_multiplier);
+
   size_t GetPercentFree();
 
   // Swap the allocation stack with the live stack.
@@ -1622,6 +1655,25 @@ class Heap {
   // How much more we grow the heap when we are a foreground app instead of background.
   double foreground_heap_growth_multiplier_;
 
+  // The fraction of the process CPU time that the GC may use, or 0 if there is no CPU budget.
+  const double gc_cpu_budget_;
+
+  // The longest GC pause we aim for, in nanoseconds, or 0 if there is no pause budget.
+  const uint64_t gc_pause_budget_ns_;
+
+  // With a CPU or pause budget, GrowForUtilization() adjusts these after each GC from the measured
+  // GC CPU time and pauses. The first one scales how much the heap grows after a GC, the second
+  // one how many bytes are left for allocation while a concurrent GC runs, i.e. how early it
+  // starts.
+  double budget_growth_multiplier_ GUARDED_BY(process_state_update_lock_);
+  double budget_concurrent_start_multiplier_ GUARDED_BY(process_state_update_lock_);
+
+  // Smoothed fraction of the process CPU time spent in GC, and the GC and process CPU times it was
+  // last measured at.
+  double budget_gc_cpu_fraction_ GUARDED_BY(process_state_update_lock_);
+  uint64_t budget_last_gc_cpu_time_ns_ GUARDED_BY(process_state_update_lock_);
+  uint64_t budget_last_process_cpu_time_ns_ GUARDED_BY(process_state_update_lock_);
+
   // The amount of native memory allocation since the last GC required to cause us to wait for a
   // collection as a result of native allocation. Very large values can cause the device to run
   // out of memory, due to lack of finalization to reclaim native memory.  Making it too small can
@@ -1693,6 +1745,11 @@ class Heap {
   // for major collections. Set in Heap constructor.
   const bool use_generational_cc_;
 
+  // Generational mark-compact collection (CMC) is used (i.e. young-generation
+  // collections of the recently allocated portion of the moving space for minor
+  // collections and full collections for major ones). Set in Heap constructor.
+  const bool use_generational_cmc_;
+
   // True if the currently running collection has made some thread wait.
   bool running_collection_is_blocking_ GUARDED_BY(gc_complete_lock_);
   // The number of blocking GC runs.
@@ -1742,6 +1799,9 @@ class Heap {
   bool dump_region_info_before_gc_;
   bool dump_region_info_after_gc_;
 
+  // Machine readable log of the recent GCs, enabled by -XX:GcEventLogSize.
+  std::unique_ptr<GcEventLog> gc_event_log_;
+
   // Boot image spaces.
   std::vector<space::ImageSpace*> boot_image_spaces_;
 
@@ -1760,6 +1820,8 @@ class Heap {
   std::unique_ptr<Verification> verification_;
 
   friend class CollectorTransitionTask;
+  friend class GenerationalCMCHeapTest;
+  friend class HeapTest;
   friend class collector::GarbageCollector;
   friend class collector::ConcurrentCopying;
   friend class collector::MarkCompact;
@@ -18,6 +18,7 @@
 
 #include "base/metrics/metrics.h"
 #include "class_linker-inl.h"
+#include "class_root-inl.h"
 #include "common_runtime_test.h"
 #include "gc/accounting/card_table-inl.h"
 #include "gc/accounting/space_bitmap-inl.h"
@@ -27,6 +28,7 @@
 #include "mirror/object_array-alloc-inl.h"
 #include "mirror/object_array-inl.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_pool.h"
 
 namespace art HIDDEN {
 namespace gc {
@@ -53,6 +55,20 @@ class HeapTest : public CommonRuntimeTest {
     CommonRuntimeTest::SetUp();
   }
 
+ protected:
+  static size_t ConcurrentRemainingBytes(size_t bytes_allocated_during_gc,
+                                         double concurrent_start_multiplier) {
+    return Heap::ConcurrentRemainingBytes(bytes_allocated_during_gc, concurrent_start_multiplier);
+  }
+
+  static size_t GetConcurrentStartBytes(Heap* heap) {
+    return heap->concurrent_start_bytes_;
+  }
+
+  static size_t GetTargetFootprint(Heap* heap) {
+    return heap->target_footprint_.load(std::memory_order_relaxed);
+  }
+
  private:
   MemMap reserved_;
 };
@@ -258,6 +274,32 @@ TEST_F(HeapTest, GCMetrics) {
   }
 }
 
+TEST_F(HeapTest, ConcurrentRemainingBytes) {
+  // Without a multiplier, the bytes allocated during the last GC are clamped to 128KB - 512KB.
+  EXPECT_EQ(128 * KB, ConcurrentRemainingBytes(0u, 1.0));
+  EXPECT_EQ(300 * KB, ConcurrentRemainingBytes(300 * KB, 1.0));
+  EXPECT_EQ(512 * KB, ConcurrentRemainingBytes(4 * MB, 1.0));
+  // The multiplier scales the estimate and the upper bound, but not the lower bound.
+  EXPECT_EQ(128 * KB, ConcurrentRemainingBytes(0u, 8.0));
+  EXPECT_EQ(128 * KB, ConcurrentRemainingBytes(10 * KB, 8.0));
+  EXPECT_EQ(400 * KB, ConcurrentRemainingBytes(100 * KB, 4.0));
+  EXPECT_EQ(2 * MB, ConcurrentRemainingBytes(512 * KB, 4.0));
+  EXPECT_EQ(4 * MB, ConcurrentRemainingBytes(64 * MB, 8.0));
+}
+
+TEST_F(HeapTest, ConcurrentStartBytes) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  if (!heap->IsGcConcurrent()) {
+    GTEST_SKIP() << "Only concurrent collectors have a concurrent start threshold";
+  }
+  heap->CollectGarbage(/* clear_soft_references= */ false);
+  // Without a GC budget, the next concurrent GC starts at most 512KB before the target
+  // footprint, or right away if the heap is already that close to it.
+  size_t target_footprint = GetTargetFootprint(heap);
+  size_t concurrent_start_bytes = GetConcurrentStartBytes(heap);
+  EXPECT_LE(target_footprint - std::min(concurrent_start_bytes, target_footprint), 512 * KB);
+}
+
 class ZygoteHeapTest : public CommonRuntimeTest {
  public:
   ZygoteHeapTest() {
@@ -275,5 +317,160 @@ TEST_F(ZygoteHeapTest, PreZygoteFork) {
   Runtime::Current()->GetHeap()->PreZygoteFork();
 }
 
+class GenerationalCMCHeapTest : public CommonRuntimeTest {
+ public:
+  GenerationalCMCHeapTest() {
+    use_boot_image_ = true;  // Make the Runtime creation cheaper.
+  }
+
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    CommonRuntimeTest::SetUpRuntimeOptions(options);
+    options->push_back(std::make_pair("-Xgc:CMC,generational_cmc", nullptr));
+  }
+
+  void CollectYoungGeneration(Heap* heap) {
+    heap->CollectGarbageInternal(collector::kGcTypeSticky,
+                                 kGcCauseExplicit,
+                                 /*clear_soft_references=*/ false,
+                                 Heap::GC_NUM_ANY);
+  }
+};
+
+TEST_F(GenerationalCMCHeapTest, BlackAllocationsSurviveYoungGc) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  if (!heap->GetUseGenerationalCMC()) {
+    GTEST_SKIP() << "Generational CMC is not supported";
+  }
+  constexpr size_t kLength = 4096;
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  StackHandleScope<2> hs(self);
+  Handle<mirror::Class> array_class =
+      hs.NewHandle(GetClassRoot<mirror::ObjectArray<mirror::Object>>());
+  Handle<mirror::ObjectArray<mirror::Object>> holder =
+      hs.NewHandle(mirror::ObjectArray<mirror::Object>::Alloc(self, array_class.Get(), kLength));
+  ASSERT_TRUE(holder != nullptr);
+  {
+    // Promote `holder` to the old generation.
+    ScopedThreadSuspension sts(self, ThreadState::kNative);
+    heap->CollectGarbage(/* clear_soft_references= */ false);
+  }
+
+  // Fill `holder` with objects allocated while a full collection runs on
+  // another thread. The ones allocated after its marking pause are black.
+  std::unique_ptr<ThreadPool> thread_pool(ThreadPool::Create("generational cmc test", 1U));
+  uint32_t gc_num = heap->GetCurrentGcNum();
+  thread_pool->AddTask(self, new FunctionTask([heap](Thread*) {
+    heap->CollectGarbage(/* clear_soft_references= */ false);
+  }));
+  thread_pool->StartWorkers(self);
+  size_t count = 0;
+  while (count < kLength && heap->GetCurrentGcNum() == gc_num) {
+    ObjPtr<mirror::ObjectArray<mirror::Object>> array =
+        mirror::ObjectArray<mirror::Object>::Alloc(self, array_class.Get(), 1);
+    ASSERT_TRUE(array != nullptr);
+    holder->Set<false>(count++, array);
+    self->AllowThreadSuspension();
+  }
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kNative);
+    thread_pool->Wait(self, /* do_work= */ false, /* may_hold_locks= */ false);
+  }
+
+  // Store young references into the objects, and check that a young
+  // collection keeps them reachable.
+  for (size_t i = 0; i < count; ++i) {
+    ObjPtr<mirror::String> string = mirror::String::AllocFromModifiedUtf8(self, "young");
+    ASSERT_TRUE(string != nullptr);
+    holder->Get(i)->AsObjectArray<mirror::Object>()->Set<false>(0, string);
+  }
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kNative);
+    CollectYoungGeneration(heap);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    ObjPtr<mirror::Object> array = holder->Get(i);
+    ASSERT_TRUE(array != nullptr);
+    ASSERT_EQ(array_class.Get(), array->GetClass());
+    ObjPtr<mirror::Object> string = array->AsObjectArray<mirror::Object>()->Get(0);
+    ASSERT_TRUE(string != nullptr);
+    ASSERT_TRUE(string->IsString());
+    EXPECT_TRUE(string->AsString()->Equals("young"));
+  }
+}
+
+class ParallelMarkingHeapTest : public CommonRuntimeTest {
+ public:
+  ParallelMarkingHeapTest() {
+    use_boot_image_ = true;  // Make the Runtime creation cheaper.
+  }
+
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    CommonRuntimeTest::SetUpRuntimeOptions(options);
+    options->push_back(std::make_pair("-XX:ConcGCThreads=4", nullptr));
+  }
+};
+
+TEST_F(ParallelMarkingHeapTest, MarkingTerminates) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  if (heap->CurrentCollectorType() != kCollectorTypeCC) {
+    GTEST_SKIP() << "Parallel marking is only done by the concurrent copying collector";
+  }
+  // Parallel marking uses the heap thread pool in a jank perceptible process state.
+  Runtime::Current()->UpdateProcessState(kProcessStateJankPerceptible);
+  bool created_thread_pool = heap->GetThreadPool() == nullptr;
+  if (created_thread_pool) {
+    heap->CreateThreadPool();
+  }
+  ASSERT_TRUE(heap->GetThreadPool() != nullptr);
+  ASSERT_GT(heap->GetThreadPool()->GetThreadCount(), 1u);
+
+  // A wide two-level tree gives the workers enough references to share and steal.
+  constexpr size_t kWidth = 256;
+  Thread* self = Thread::Current();
+  {
+    ScopedObjectAccess soa(self);
+    StackHandleScope<2> hs(self);
+    Handle<mirror::Class> array_class =
+        hs.NewHandle(GetClassRoot<mirror::ObjectArray<mirror::Object>>());
+    Handle<mirror::ObjectArray<mirror::Object>> root =
+        hs.NewHandle(mirror::ObjectArray<mirror::Object>::Alloc(self, array_class.Get(), kWidth));
+    ASSERT_TRUE(root != nullptr);
+    for (size_t i = 0; i < kWidth; ++i) {
+      ObjPtr<mirror::ObjectArray<mirror::Object>> child =
+          mirror::ObjectArray<mirror::Object>::Alloc(self, array_class.Get(), kWidth);
+      ASSERT_TRUE(child != nullptr);
+      root->Set<false>(i, child);
+      for (size_t j = 0; j < kWidth; ++j) {
+        ObjPtr<mirror::Object> leaf =
+            mirror::ObjectArray<mirror::Object>::Alloc(self, array_class.Get(), 1);
+        ASSERT_TRUE(leaf != nullptr);
+        root->Get(i)->AsObjectArray<mirror::Object>()->Set<false>(j, leaf);
+      }
+    }
+
+    // Each collection returns only once all the workers agreed that marking is complete.
+    for (size_t gc = 0; gc < 4; ++gc) {
+      ScopedThreadSuspension sts(self, ThreadState::kNative);
+      heap->CollectGarbage(/* clear_soft_references= */ false);
+    }
+
+    // No reference got lost on a worker's mark stack.
+    for (size_t i = 0; i < kWidth; ++i) {
+      ObjPtr<mirror::Object> child = root->Get(i);
+      ASSERT_TRUE(child != nullptr);
+      ASSERT_EQ(array_class.Get(), child->GetClass());
+      for (size_t j = 0; j < kWidth; ++j) {
+        ObjPtr<mirror::Object> leaf = child->AsObjectArray<mirror::Object>()->Get(j);
+        ASSERT_TRUE(leaf != nullptr);
+        ASSERT_EQ(array_class.Get(), leaf->GetClass());
+      }
+    }
+  }
+  if (created_thread_pool) {
+    heap->DeleteThreadPool();
+  }
+}
+
 }  // namespace gc
 }  // namespace art
@@ -23,6 +23,7 @@
 #include "base/systrace.h"
 #include "class_root-inl.h"
 #include "collector/garbage_collector.h"
+#include "heap.h"
 #include "jni/java_vm_ext.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
@@ -30,6 +31,7 @@
 #include "nativehelper/scoped_local_ref.h"
 #include "object_callbacks.h"
 #include "reflection.h"
+#include "runtime.h"
 #include "scoped_thread_state_change-inl.h"
 #include "task_processor.h"
 #include "thread-inl.h"
@@ -41,6 +43,10 @@ namespace gc {
 
 static constexpr bool kAsyncReferenceQueueAdd = false;
 
+// The minimum number of references per thread for ClearWhiteReferences to use
+// the heap thread pool.
+static constexpr size_t kMinReferencesPerThread = 4 * KB;
+
 ReferenceProcessor::ReferenceProcessor()
     : collector_(nullptr),
       condition_("reference processor condition", *Locks::reference_processor_lock_) ,
@@ -119,6 +125,22 @@ ObjPtr<mirror::Object> ReferenceProcessor::GetReferent(Thread* self,
   while (slow_path_required()) {
     DCHECK(collector_ != nullptr);
     const bool other_read_barrier = !kUseBakerReadBarrier && gUseReadBarrier;
+    if (rp_state_ == RpState::kStarting &&
+        !reference->IsFinalizerReferenceInstance() &&
+        !reference->IsPhantomReferenceInstance()) {
+      // It is too early to tell whether an unmarked referent will be cleared, but a marked one
+      // stays marked and will not be. Return it without waiting for the references to be
+      // processed. Re-load the referent, a Reference.clear() call may have intervened.
+      referent = reference->GetReferent<kWithoutReadBarrier>();
+      ObjPtr<mirror::Object> forwarded_ref =
+          referent.IsNull() ? nullptr : collector_->IsMarked(referent.Ptr());
+      if (forwarded_ref != nullptr || referent.IsNull()) {
+        if (started_trace) {
+          finish_trace(start_millis);
+        }
+        return forwarded_ref;
+      }
+    }
     if (UNLIKELY(reference->IsFinalizerReferenceInstance()
                  || rp_state_ == RpState::kStarting /* too early to determine mark state */
                  || (other_read_barrier && reference->IsPhantomReferenceInstance()))) {
@@ -201,6 +223,17 @@ void ReferenceProcessor::Setup(Thread* self,
 // We advance rp_state_ to signal partial completion for the benefit of GetReferent.
 void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings) {
   TimingLogger::ScopedTiming t(concurrent_ ? __FUNCTION__ : "(Paused)ProcessReferences", timings);
+  // Time spent on each kind of references, reported to the metrics when done.
+  uint64_t soft_reference_time_ns = 0;
+  uint64_t weak_reference_time_ns = 0;
+  uint64_t finalizer_reference_time_ns = 0;
+  uint64_t phantom_reference_time_ns = 0;
+  uint64_t start_time = NanoTime();
+  auto add_time = [&start_time](uint64_t* time_ns) {
+    uint64_t now = NanoTime();
+    *time_ns += now - start_time;
+    start_time = now;
+  };
   if (!clear_soft_references_) {
     // Forward any additional SoftReferences we discovered late, now that reference access has been
     // inhibited.
@@ -208,6 +241,7 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
       ForwardSoftReferences(timings);
     }
   }
+  add_time(&soft_reference_time_ns);
   {
     MutexLock mu(self, *Locks::reference_processor_lock_);
     if (!gUseReadBarrier) {
@@ -220,6 +254,7 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
     rp_state_ = RpState::kInitMarkingDone;
     condition_.Broadcast(self);
   }
+  start_time = NanoTime();
   if (kIsDebugBuild && collector_->IsTransactionActive()) {
     // In transaction mode, we shouldn't enqueue any Reference to the queues.
     // See DelayReferenceReferent().
@@ -230,8 +265,10 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
   }
   // Clear all remaining soft and weak references with white referents.
   // This misses references only reachable through finalizers.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+  ClearWhiteReferences(&soft_reference_queue_);
+  add_time(&soft_reference_time_ns);
+  ClearWhiteReferences(&weak_reference_queue_);
+  add_time(&weak_reference_time_ns);
   // Defer PhantomReference processing until we've finished marking through finalizers.
   {
     // TODO: Capture mark state of some system weaks here. If the referent was marked here,
@@ -265,6 +302,7 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
       collector_->ProcessMarkStack();
     }
   }
+  add_time(&finalizer_reference_time_ns);
 
   // Process all soft and weak references with white referents, where the references are reachable
   // only from finalizers. It is unclear that there is any way to do this without slightly
@@ -285,13 +323,14 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
   // finalized object containing pointers to native objects that have already been deallocated.
   // But it can be argued that this is just an instance of the broader rule that it is not safe
   // for finalizers to access otherwise inaccessible finalizable objects.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_,
-                                             /*report_cleared=*/ true);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_,
-                                             /*report_cleared=*/ true);
+  ClearWhiteReferences(&soft_reference_queue_, /*report_cleared=*/ true);
+  add_time(&soft_reference_time_ns);
+  ClearWhiteReferences(&weak_reference_queue_, /*report_cleared=*/ true);
+  add_time(&weak_reference_time_ns);
 
   // Clear all phantom references with white referents. It's fine to do this just once here.
-  phantom_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+  ClearWhiteReferences(&phantom_reference_queue_);
+  add_time(&phantom_reference_time_ns);
 
   // At this point all reference queues other than the cleared references should be empty.
   DCHECK(soft_reference_queue_.IsEmpty());
@@ -310,6 +349,34 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
       DisableSlowPath(self);
     }
   }
+
+  // Report the time spent in microseconds.
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  metrics->GcSoftReferenceProcessingTime()->Add(NsToUs(soft_reference_time_ns));
+  metrics->GcWeakReferenceProcessingTime()->Add(NsToUs(weak_reference_time_ns));
+  metrics->GcFinalizerReferenceProcessingTime()->Add(NsToUs(finalizer_reference_time_ns));
+  metrics->GcPhantomReferenceProcessingTime()->Add(NsToUs(phantom_reference_time_ns));
+}
+
+void ReferenceProcessor::ClearWhiteReferences(ReferenceQueue* queue, bool report_cleared) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  ThreadPool* thread_pool = heap->GetThreadPool();
+  if (thread_pool == nullptr || Runtime::Current()->IsActiveTransaction()) {
+    queue->ClearWhiteReferences(&cleared_references_, collector_, report_cleared);
+    return;
+  }
+  // Use at most as many threads as the collector is allowed to, and only if
+  // there are enough references to amortize the synchronization.
+  size_t thread_count = std::min(
+      concurrent_ ? heap->GetConcGCThreadCount() : heap->GetParallelGCThreadCount(),
+      thread_pool->GetThreadCount()) + 1;
+  thread_count = std::min(thread_count, queue->GetLength() / kMinReferencesPerThread);
+  if (thread_count <= 1) {
+    queue->ClearWhiteReferences(&cleared_references_, collector_, report_cleared);
+    return;
+  }
+  queue->ClearWhiteReferencesParallel(
+      &cleared_references_, collector_, thread_pool, thread_count, report_cleared);
 }
 
 // Process the "referent" field in a java.lang.ref.Reference.  If the referent has not yet been
@@ -101,6 +101,11 @@ class ReferenceProcessor {
   void WaitUntilDoneProcessingReferences(Thread* self)
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::reference_processor_lock_);
+  // Clear the references of `queue` with white referents and move them to
+  // cleared_references_. Uses the heap thread pool, if any, to check and clear
+  // the referents in parallel.
+  void ClearWhiteReferences(ReferenceQueue* queue, bool report_cleared = false)
+      REQUIRES_SHARED(Locks::mutator_lock_);
   // Collector which is clearing references, used by the GetReferent to return referents which are
   // already marked. Only updated by thread currently running GC.
   // Guarded by reference_processor_lock_ when not read by collector. Only the collector changes
@@ -28,7 +28,7 @@
 namespace art HIDDEN {
 namespace gc {
 
-ReferenceQueue::ReferenceQueue(Mutex* lock) : lock_(lock), list_(nullptr) {
+ReferenceQueue::ReferenceQueue(Mutex* lock) : lock_(lock), list_(nullptr), length_(0u) {
 }
 
 void ReferenceQueue::AtomicEnqueueIfNotEnqueued(Thread* self, ObjPtr<mirror::Reference> ref) {
@@ -54,6 +54,7 @@ void ReferenceQueue::EnqueueReference(ObjPtr<mirror::Reference> ref) {
   }
   // Add the reference in the middle to preserve the cycle.
   list_->SetPendingNext(ref);
+  ++length_;
 }
 
 ObjPtr<mirror::Reference> ReferenceQueue::DequeuePendingReference() {
@@ -69,6 +70,8 @@ ObjPtr<mirror::Reference> ReferenceQueue::DequeuePendingReference() {
     list_->SetPendingNext(next);
   }
   ref->SetPendingNext(nullptr);
+  DCHECK_NE(length_, 0u);
+  --length_;
   return ref;
 }
 
@@ -119,16 +122,31 @@ void ReferenceQueue::Dump(std::ostream& os) const {
   } while (cur != list_);
 }
 
-size_t ReferenceQueue::GetLength() const {
-  size_t count = 0;
-  ObjPtr<mirror::Reference> cur = list_;
-  if (cur != nullptr) {
-    do {
-      ++count;
-      cur = cur->GetPendingNext();
-    } while (cur != list_);
+static void ReportClearedFromFinalizer() {
+  static bool already_reported = false;
+  if (!already_reported) {
+    // TODO: Maybe do this only if the queue is non-null?
+    LOG(WARNING)
+        << "Cleared Reference was only reachable from finalizer (only reported once)";
+    already_reported = true;
   }
-  return count;
+}
+
+bool ReferenceQueue::ClearWhiteReferent(ObjPtr<mirror::Reference> ref,
+                                        collector::GarbageCollector* collector) {
+  mirror::HeapReference<mirror::Object>* referent_addr = ref->GetReferentReferenceAddr();
+  // do_atomic_update is false because this happens during the reference processing phase where
+  // Reference.clear() would block.
+  if (collector->IsNullOrMarkedHeapReference(referent_addr, /*do_atomic_update=*/false)) {
+    return false;
+  }
+  // Referent is white, clear it.
+  if (Runtime::Current()->IsActiveTransaction()) {
+    ref->ClearReferent<true>();
+  } else {
+    ref->ClearReferent<false>();
+  }
+  return true;
 }
 
 void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
@@ -136,25 +154,10 @@ void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
                                           bool report_cleared) {
   while (!IsEmpty()) {
     ObjPtr<mirror::Reference> ref = DequeuePendingReference();
-    mirror::HeapReference<mirror::Object>* referent_addr = ref->GetReferentReferenceAddr();
-    // do_atomic_update is false because this happens during the reference processing phase where
-    // Reference.clear() would block.
-    if (!collector->IsNullOrMarkedHeapReference(referent_addr, /*do_atomic_update=*/false)) {
-      // Referent is white, clear it.
-      if (Runtime::Current()->IsActiveTransaction()) {
-        ref->ClearReferent<true>();
-      } else {
-        ref->ClearReferent<false>();
-      }
+    if (ClearWhiteReferent(ref, collector)) {
       cleared_references->EnqueueReference(ref);
       if (report_cleared) {
-        static bool already_reported = false;
-        if (!already_reported) {
-          // TODO: Maybe do this only if the queue is non-null?
-          LOG(WARNING)
-              << "Cleared Reference was only reachable from finalizer (only reported once)";
-          already_reported = true;
-        }
+        ReportClearedFromFinalizer();
       }
     }
     // Delay disabling the read barrier until here so that the ClearReferent call above in
@@ -163,6 +166,60 @@ void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
   }
 }
 
+void ReferenceQueue::ClearWhiteReferencesParallel(ReferenceQueue* cleared_references,
+                                                  collector::GarbageCollector* collector,
+                                                  ThreadPool* thread_pool,
+                                                  size_t thread_count,
+                                                  bool report_cleared) {
+  // The number of references a thread checks at a time.
+  static constexpr size_t kChunkSize = 512;
+  DCHECK(!Runtime::Current()->IsActiveTransaction());
+  // Unlink the list. Raw pointers as the references are handed to other threads.
+  std::vector<mirror::Reference*> refs;
+  refs.reserve(GetLength());
+  while (!IsEmpty()) {
+    refs.push_back(DequeuePendingReference().Ptr());
+  }
+  thread_count = std::min(thread_count, RoundUp(refs.size(), kChunkSize) / kChunkSize);
+  // One byte per reference, set if its referent was cleared, so that threads
+  // never write to the same word.
+  std::unique_ptr<uint8_t[]> cleared(new uint8_t[refs.size()]);
+  std::atomic<size_t> next_chunk(0);
+  auto clear_chunks = [&]() NO_THREAD_SAFETY_ANALYSIS {
+    // The calling thread holds the mutator lock for the workers.
+    size_t begin;
+    while ((begin = next_chunk.fetch_add(kChunkSize, std::memory_order_relaxed)) < refs.size()) {
+      size_t end = std::min(begin + kChunkSize, refs.size());
+      for (size_t i = begin; i < end; ++i) {
+        cleared[i] = ClearWhiteReferent(refs[i], collector) ? 1u : 0u;
+        // Not in transaction mode, so the read barrier can be disabled right away.
+        DisableReadBarrierForReference(refs[i], std::memory_order_relaxed);
+      }
+    }
+  };
+  if (thread_pool == nullptr || thread_count <= 1) {
+    clear_chunks();
+  } else {
+    Thread* self = Thread::Current();
+    for (size_t i = 1; i < thread_count; ++i) {
+      thread_pool->AddTask(self, new FunctionTask([&clear_chunks](Thread*) { clear_chunks(); }));
+    }
+    thread_pool->SetMaxActiveWorkers(thread_count - 1);
+    thread_pool->StartWorkers(self);
+    clear_chunks();
+    thread_pool->Wait(self, /* do_work= */ true, /* may_hold_locks= */ true);
+    thread_pool->StopWorkers(self);
+  }
+  for (size_t i = 0; i < refs.size(); ++i) {
+    if (cleared[i] != 0u) {
+      cleared_references->EnqueueReference(refs[i]);
+      if (report_cleared) {
+        ReportClearedFromFinalizer();
+      }
+    }
+  }
+}
+
 FinalizerStats ReferenceQueue::EnqueueFinalizerReferences(ReferenceQueue* cleared_references,
                                                 collector::GarbageCollector* collector) {
   uint32_t num_refs(0), num_enqueued(0);
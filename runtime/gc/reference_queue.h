@@ -109,8 +109,22 @@ class ReferenceQueue {
                             bool report_cleared = false)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Same as ClearWhiteReferences, but the referents are checked and cleared in
+  // chunks by `thread_count` threads: the calling one and workers of
+  // `thread_pool`. The calling thread unlinks the list and enqueues the cleared
+  // references. Not for use in transaction mode.
+  void ClearWhiteReferencesParallel(ReferenceQueue* cleared_references,
+                                    collector::GarbageCollector* collector,
+                                    ThreadPool* thread_pool,
+                                    size_t thread_count,
+                                    bool report_cleared = false)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   void Dump(std::ostream& os) const REQUIRES_SHARED(Locks::mutator_lock_);
-  size_t GetLength() const REQUIRES_SHARED(Locks::mutator_lock_);
+
+  size_t GetLength() const {
+    return length_;
+  }
 
   bool IsEmpty() const {
     return list_ == nullptr;
@@ -119,6 +133,7 @@ class ReferenceQueue {
   // Clear this queue. Only safe after handing off the contents elsewhere for further processing.
   void Clear() {
     list_ = nullptr;
+    length_ = 0u;
   }
 
   mirror::Reference* GetList() REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -130,6 +145,11 @@ class ReferenceQueue {
       REQUIRES_SHARED(Locks::mutator_lock_);
 
  private:
+  // Clear the referent of `ref` if it is white. Returns true if it was cleared.
+  static bool ClearWhiteReferent(ObjPtr<mirror::Reference> ref,
+                                 collector::GarbageCollector* collector)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   // Lock, used for parallel GC reference enqueuing. It allows for multiple threads simultaneously
   // calling AtomicEnqueueIfNotEnqueued.
   Mutex* const lock_;
@@ -138,6 +158,8 @@ class ReferenceQueue {
   // is accessed from multiple threads.  Points to a singly-linked circular list
   // using the pendingNext field.
   mirror::Reference* list_;
+  // Number of references in `list_`, so that it need not be walked to size the work.
+  size_t length_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(ReferenceQueue);
 };
@@ -16,12 +16,17 @@
 
 #include <sstream>
 
+#include "class_root-inl.h"
 #include "common_runtime_test.h"
 #include "handle_scope-inl.h"
+#include "heap.h"
 #include "mirror/class-alloc-inl.h"
 #include "mirror/class-inl.h"
+#include "mirror/object_array-alloc-inl.h"
+#include "mirror/object_array-inl.h"
 #include "reference_queue.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_pool.h"
 
 namespace art HIDDEN {
 namespace gc {
@@ -100,5 +105,75 @@ TEST_F(ReferenceQueueTest, Dump) {
   LOG(INFO) << oss.str();
 }
 
+class ParallelReferenceClearingTest : public ReferenceQueueTest {
+ protected:
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    ReferenceQueueTest::SetUpRuntimeOptions(options);
+    options->push_back(std::make_pair("-XX:ParallelGCThreads=4", nullptr));
+    options->push_back(std::make_pair("-XX:ConcGCThreads=4", nullptr));
+  }
+};
+
+TEST_F(ParallelReferenceClearingTest, ClearWhiteReferences) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  // The references are cleared in parallel only when the heap thread pool exists.
+  bool created_thread_pool = heap->GetThreadPool() == nullptr;
+  if (created_thread_pool) {
+    heap->CreateThreadPool();
+  }
+  ASSERT_TRUE(heap->GetThreadPool() != nullptr);
+  ASSERT_GT(heap->GetThreadPool()->GetThreadCount(), 1u);
+
+  // Enough weak references for 4 threads of 4K references each.
+  constexpr size_t kNumReferences = 16 * KB;
+  Thread* self = Thread::Current();
+  {
+    ScopedObjectAccess soa(self);
+    StackHandleScope<3> hs(self);
+    Handle<mirror::Class> ref_class = hs.NewHandle(
+        Runtime::Current()->GetClassLinker()->FindClass(self, "Ljava/lang/ref/WeakReference;",
+                                                        ScopedNullHandle<mirror::ClassLoader>()));
+    ASSERT_TRUE(ref_class != nullptr);
+    ObjPtr<mirror::Class> array_class = GetClassRoot<mirror::ObjectArray<mirror::Object>>();
+    Handle<mirror::ObjectArray<mirror::Object>> refs = hs.NewHandle(
+        mirror::ObjectArray<mirror::Object>::Alloc(self, array_class, kNumReferences));
+    ASSERT_TRUE(refs != nullptr);
+    // Keeps the referents of the odd references alive.
+    Handle<mirror::ObjectArray<mirror::Object>> referents = hs.NewHandle(
+        mirror::ObjectArray<mirror::Object>::Alloc(self, array_class, kNumReferences));
+    ASSERT_TRUE(referents != nullptr);
+    for (size_t i = 0; i < kNumReferences; ++i) {
+      ObjPtr<mirror::Object> referent = GetClassRoot<mirror::Object>()->AllocObject(self);
+      ASSERT_TRUE(referent != nullptr);
+      if (i % 2u == 1u) {
+        referents->Set<false>(i, referent);
+      }
+      StackHandleScope<1> hs2(self);
+      HandleWrapperObjPtr<mirror::Object> h_referent(hs2.NewHandleWrapper(&referent));
+      ObjPtr<mirror::Reference> ref = ref_class->AllocObject(self)->AsReference();
+      ASSERT_TRUE(ref != nullptr);
+      ref->SetReferent<false>(referent);
+      refs->Set<false>(i, ref);
+    }
+
+    {
+      ScopedThreadSuspension sts(self, ThreadState::kNative);
+      heap->CollectGarbage(/* clear_soft_references= */ false);
+    }
+
+    for (size_t i = 0; i < kNumReferences; ++i) {
+      ObjPtr<mirror::Reference> ref = refs->Get(i)->AsReference();
+      if (i % 2u == 1u) {
+        ASSERT_EQ(referents->Get(i), ref->GetReferent()) << i;
+      } else {
+        ASSERT_TRUE(ref->GetReferent() == nullptr) << i;
+      }
+    }
+  }
+  if (created_thread_pool) {
+    heap->DeleteThreadPool();
+  }
+}
+
 }  // namespace gc
 }  // namespace art
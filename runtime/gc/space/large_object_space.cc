@@ -18,10 +18,12 @@
 
 #include <sys/mman.h>
 
+#include <algorithm>
 #include <memory>
 
 #include <android-base/logging.h>
 
+#include "base/bit_utils.h"
 #include "base/macros.h"
 #include "base/memory_tool.h"
 #include "base/mutex-inl.h"
@@ -692,6 +694,498 @@ std::pair<uint8_t*, uint8_t*> FreeListSpace::GetBeginEndAtomic() const {
   return std::make_pair(Begin(), End());
 }
 
+SizeClassLargeObjectSpace* SizeClassLargeObjectSpace::Create(const std::string& name,
+                                                             size_t capacity,
+                                                             bool use_huge_pages) {
+  CHECK_ALIGNED_PARAM(capacity, ObjectAlignment());
+  DCHECK_LE(gPageSize, ObjectAlignment())
+      << "MapAnonymousAligned() should be used if the large-object alignment is larger than the "
+         "runtime page size";
+  if (use_huge_pages) {
+    capacity = RoundUp(capacity, Heap::GetPMDSize());
+  }
+  const size_t num_pages = capacity / ObjectAlignment();
+  CHECK_LE(num_pages, kPagesMask);
+  std::string error_msg;
+  MemMap mem_map = use_huge_pages
+      ? MemMap::MapAnonymousAligned(name.c_str(),
+                                    capacity,
+                                    PROT_READ | PROT_WRITE,
+                                    /*low_4gb=*/true,
+                                    Heap::GetPMDSize(),
+                                    &error_msg)
+      : MemMap::MapAnonymous(name.c_str(),
+                             capacity,
+                             PROT_READ | PROT_WRITE,
+                             /*low_4gb=*/true,
+                             &error_msg);
+  CHECK(mem_map.IsValid()) << "Failed to allocate large object space mem map: " << error_msg;
+  MemMap block_info_map =
+      MemMap::MapAnonymous("large object size class space block info map",
+                           sizeof(BlockInfo) * num_pages,
+                           PROT_READ | PROT_WRITE,
+                           /*low_4gb=*/ false,
+                           &error_msg);
+  CHECK(block_info_map.IsValid()) << "Failed to allocate block info map" << error_msg;
+  return new SizeClassLargeObjectSpace(
+      name, std::move(mem_map), std::move(block_info_map), use_huge_pages);
+}
+
+SizeClassLargeObjectSpace::SizeClassLargeObjectSpace(const std::string& name,
+                                                     MemMap&& mem_map,
+                                                     MemMap&& block_info_map,
+                                                     bool use_huge_pages)
+    : LargeObjectSpace(name, mem_map.Begin(), mem_map.End(), "size class space lock"),
+      mem_map_(std::move(mem_map)),
+      block_info_map_(std::move(block_info_map)),
+      block_info_(reinterpret_cast<BlockInfo*>(block_info_map_.Begin())),
+      use_huge_pages_(use_huge_pages),
+      num_pages_(mem_map_.Size() / ObjectAlignment()),
+      num_size_classes_(0),
+      bounds_(MakeBounds(0, mem_map_.Size() / ObjectAlignment())),
+      pending_release_(0),
+      pending_release_bytes_(0),
+      bytes_allocated_(0),
+      objects_allocated_(0),
+      total_bytes_allocated_ever_(0),
+      total_objects_allocated_ever_(0) {
+  // Size classes of 1, 2, 3 and 4 pages, then four per doubling, which bounds the internal
+  // fragmentation to 20%.
+  const size_t max_size_class_bytes =
+      use_huge_pages_ ? std::min(Heap::GetPMDSize(), kMaxSizeClassBytes) : kMaxSizeClassBytes;
+  const size_t max_size_class_pages = std::max<size_t>(1, max_size_class_bytes / ObjectAlignment());
+  for (size_t pages = 1; pages <= max_size_class_pages;) {
+    CHECK_LT(num_size_classes_, kMaxSizeClasses);
+    size_class_pages_[num_size_classes_] = pages;
+    free_lists_[num_size_classes_].store(0, std::memory_order_relaxed);
+    ++num_size_classes_;
+    pages += std::max<size_t>(1, (size_t{1} << MostSignificantBit(pages)) / 4);
+  }
+}
+
+size_t SizeClassLargeObjectSpace::SizeClassForPages(size_t num_pages) const {
+  return std::lower_bound(size_class_pages_, size_class_pages_ + num_size_classes_, num_pages) -
+      size_class_pages_;
+}
+
+bool SizeClassLargeObjectSpace::PopFreeBlock(size_t size_class, /*out*/ size_t* page) {
+  Atomic<uint64_t>& head = free_lists_[size_class];
+  uint64_t old_head = head.load(std::memory_order_acquire);
+  while (true) {
+    const uint32_t first = static_cast<uint32_t>(old_head);
+    if (first == 0u) {
+      return false;
+    }
+    // The block may be popped and reused concurrently, in which case the tag makes the CAS fail.
+    const uint32_t next = block_info_[first - 1].next_free.load(std::memory_order_relaxed);
+    const uint64_t new_head = (((old_head >> 32) + 1) << 32) | next;
+    if (head.compare_exchange_strong(old_head, new_head, std::memory_order_acquire)) {
+      *page = first - 1;
+      return true;
+    }
+  }
+}
+
+void SizeClassLargeObjectSpace::PushFreeBlock(size_t size_class, size_t page) {
+  PushBlock(free_lists_[size_class], page);
+}
+
+void SizeClassLargeObjectSpace::PushBlock(Atomic<uint64_t>& head, size_t page) {
+  uint64_t old_head = head.load(std::memory_order_relaxed);
+  while (true) {
+    block_info_[page].next_free.store(static_cast<uint32_t>(old_head), std::memory_order_relaxed);
+    const uint64_t new_head = (((old_head >> 32) + 1) << 32) | (page + 1);
+    if (head.compare_exchange_strong(old_head, new_head, std::memory_order_release)) {
+      return;
+    }
+  }
+}
+
+bool SizeClassLargeObjectSpace::AllocFromBottom(size_t num_pages, /*out*/ size_t* page) {
+  uint64_t bounds = bounds_.load(std::memory_order_relaxed);
+  while (true) {
+    const size_t bottom = Bottom(bounds);
+    if (Top(bounds) - bottom < num_pages) {
+      return false;
+    }
+    const uint64_t new_bounds = MakeBounds(bottom + num_pages, Top(bounds));
+    if (bounds_.compare_exchange_strong(bounds, new_bounds, std::memory_order_relaxed)) {
+      *page = bottom;
+      return true;
+    }
+  }
+}
+
+bool SizeClassLargeObjectSpace::AllocFromTop(Thread* self,
+                                             /*inout*/ size_t* num_pages,
+                                             /*out*/ size_t* page) {
+  const size_t huge_page_pages = Heap::GetPMDSize() / ObjectAlignment();
+  if (use_huge_pages_) {
+    *num_pages = RoundUp(*num_pages, huge_page_pages);
+  }
+  MutexLock mu(self, lock_);
+  // Best fit from the free blocks, splitting off the remainder.
+  auto it = top_free_blocks_.lower_bound(*num_pages);
+  if (it != top_free_blocks_.end()) {
+    const size_t free_pages = it->first;
+    *page = it->second;
+    RemoveTopFreeBlock(*page, free_pages);
+    if (free_pages > *num_pages) {
+      AddTopFreeBlock(*page + *num_pages, free_pages - *num_pages);
+    }
+    return true;
+  }
+  uint64_t bounds = bounds_.load(std::memory_order_relaxed);
+  while (true) {
+    const size_t top = Top(bounds);
+    if (top - Bottom(bounds) < *num_pages) {
+      return false;
+    }
+    const uint64_t new_bounds = MakeBounds(Bottom(bounds), top - *num_pages);
+    if (bounds_.compare_exchange_strong(bounds, new_bounds, std::memory_order_relaxed)) {
+      *page = top - *num_pages;
+      break;
+    }
+  }
+#ifdef MADV_HUGEPAGE
+  if (use_huge_pages_) {
+    // The advice sticks to the range, so it only needs to be given when the range is first used.
+    madvise(PageAddress(*page), *num_pages * ObjectAlignment(), MADV_HUGEPAGE);
+  }
+#endif
+  return true;
+}
+
+void SizeClassLargeObjectSpace::AddTopFreeBlock(size_t page, size_t num_pages) {
+  block_info_[page].pages_and_flags.store(num_pages | kFlagFree, std::memory_order_relaxed);
+  block_info_[page + num_pages - 1].next_free.store(page + 1, std::memory_order_relaxed);
+  top_free_blocks_.emplace(num_pages, page);
+}
+
+void SizeClassLargeObjectSpace::RemoveTopFreeBlock(size_t page, size_t num_pages) {
+  auto range = top_free_blocks_.equal_range(num_pages);
+  auto it = std::find_if(range.first, range.second, [page](const auto& pair) {
+    return pair.second == page;
+  });
+  CHECK(it != range.second);
+  top_free_blocks_.erase(it);
+  block_info_[page + num_pages - 1].next_free.store(0, std::memory_order_relaxed);
+}
+
+void SizeClassLargeObjectSpace::AddFreeBlock(Thread* self, size_t page, size_t num_pages) {
+  if (page < Top(bounds_.load(std::memory_order_relaxed))) {
+    // Size class blocks are never carved from the end, and the end never grows past a block that
+    // is still allocated, so this block is a size class block.
+    const size_t size_class = SizeClassForPages(num_pages);
+    DCHECK_LT(size_class, num_size_classes_);
+    DCHECK_EQ(size_class_pages_[size_class], num_pages);
+    block_info_[page].pages_and_flags.store(num_pages | kFlagFree, std::memory_order_relaxed);
+    PushFreeBlock(size_class, page);
+    return;
+  }
+  MutexLock mu(self, lock_);
+  // Coalesce with the free neighbours.
+  const size_t next = page + num_pages;
+  if (next < num_pages_) {
+    const uint32_t next_info = block_info_[next].pages_and_flags.load(std::memory_order_relaxed);
+    if ((next_info & kFlagFree) != 0u) {
+      RemoveTopFreeBlock(next, next_info & kPagesMask);
+      num_pages += next_info & kPagesMask;
+    }
+  }
+  uint64_t bounds = bounds_.load(std::memory_order_relaxed);
+  if (page > Top(bounds)) {
+    // The boundary tag may be stale, so check that it names the free block just before this one.
+    const uint32_t prev = block_info_[page - 1].next_free.load(std::memory_order_relaxed);
+    if (prev != 0u) {
+      const uint32_t prev_info =
+          block_info_[prev - 1].pages_and_flags.load(std::memory_order_relaxed);
+      if ((prev_info & kFlagFree) != 0u && prev - 1 + (prev_info & kPagesMask) == page) {
+        RemoveTopFreeBlock(prev - 1, prev_info & kPagesMask);
+        page = prev - 1;
+        num_pages += prev_info & kPagesMask;
+      }
+    }
+  }
+  if (page == Top(bounds)) {
+    // Give the block back to the unused middle of the space. Clear its side table entries first
+    // since VisitBlocks() relies on the entry of a block being allocated from the bottom being
+    // zero until the allocation is done.
+    std::fill_n(reinterpret_cast<uint8_t*>(&block_info_[page]), num_pages * sizeof(BlockInfo), 0u);
+    while (!bounds_.compare_exchange_strong(bounds,
+                                            MakeBounds(Bottom(bounds), Top(bounds) + num_pages),
+                                            std::memory_order_relaxed)) {
+      DCHECK_EQ(Top(bounds), page);
+    }
+    return;
+  }
+  AddTopFreeBlock(page, num_pages);
+}
+
+size_t SizeClassLargeObjectSpace::AllocationSize(mirror::Object* obj, size_t* usable_size) {
+  DCHECK(Contains(obj));
+  const uint32_t info =
+      block_info_[PageIndex(obj)].pages_and_flags.load(std::memory_order_relaxed);
+  DCHECK_EQ(info & kFlagFree, 0u);
+  const size_t alloc_size = (info & kPagesMask) * ObjectAlignment();
+  if (usable_size != nullptr) {
+    *usable_size = alloc_size;
+  }
+  return alloc_size;
+}
+
+mirror::Object* SizeClassLargeObjectSpace::Alloc(Thread* self,
+                                                 size_t num_bytes,
+                                                 size_t* bytes_allocated,
+                                                 size_t* usable_size,
+                                                 size_t* bytes_tl_bulk_allocated) {
+  size_t num_pages = RoundUp(num_bytes, ObjectAlignment()) / ObjectAlignment();
+  const size_t size_class = SizeClassForPages(num_pages);
+  size_t page;
+  if (size_class < num_size_classes_) {
+    num_pages = size_class_pages_[size_class];
+    // Blocks of other size classes are not split, so when the middle of the space runs out fall
+    // back to the free blocks carved from the end.
+    if (!PopFreeBlock(size_class, &page) &&
+        !AllocFromBottom(num_pages, &page) &&
+        !AllocFromTop(self, &num_pages, &page)) {
+      // Blocks freed by Free() may be waiting for their memory to be released.
+      num_pages = size_class_pages_[size_class];
+      if (ReleasePendingBlocks() == 0u || !PopFreeBlock(size_class, &page)) {
+        return nullptr;
+      }
+    }
+  } else if (!AllocFromTop(self, &num_pages, &page)) {
+    return nullptr;
+  }
+  block_info_[page].pages_and_flags.store(num_pages, std::memory_order_release);
+  const size_t allocation_size = num_pages * ObjectAlignment();
+  DCHECK(bytes_allocated != nullptr);
+  *bytes_allocated = allocation_size;
+  if (usable_size != nullptr) {
+    *usable_size = allocation_size;
+  }
+  DCHECK(bytes_tl_bulk_allocated != nullptr);
+  *bytes_tl_bulk_allocated = allocation_size;
+  bytes_allocated_.fetch_add(allocation_size, std::memory_order_relaxed);
+  objects_allocated_.fetch_add(1, std::memory_order_relaxed);
+  total_bytes_allocated_ever_.fetch_add(allocation_size, std::memory_order_relaxed);
+  total_objects_allocated_ever_.fetch_add(1, std::memory_order_relaxed);
+  return reinterpret_cast<mirror::Object*>(PageAddress(page));
+}
+
+size_t SizeClassLargeObjectSpace::Free(Thread* self, mirror::Object* obj) {
+  DCHECK(Contains(obj)) << reinterpret_cast<void*>(Begin()) << " " << obj << " "
+                        << reinterpret_cast<void*>(End());
+  DCHECK_ALIGNED_PARAM(obj, ObjectAlignment());
+  const size_t page = PageIndex(obj);
+  const uint32_t info = block_info_[page].pages_and_flags.load(std::memory_order_relaxed);
+  DCHECK_EQ(info & kFlagFree, 0u);
+  const size_t num_pages = info & kPagesMask;
+  const size_t allocation_size = num_pages * ObjectAlignment();
+  if (page < Top(bounds_.load(std::memory_order_relaxed))) {
+    // A size class block. Defer releasing its memory so that one madvise() call covers the blocks
+    // freed in a row, which are often adjacent.
+    block_info_[page].pages_and_flags.store(num_pages | kFlagFree, std::memory_order_relaxed);
+    PushBlock(pending_release_, page);
+    const size_t pending_bytes =
+        pending_release_bytes_.fetch_add(allocation_size, std::memory_order_relaxed) +
+        allocation_size;
+    if (pending_bytes >= kReleaseBatchBytes) {
+      ReleasePendingBlocks();
+    }
+  } else {
+    madvise(obj, allocation_size, MADV_DONTNEED);
+    AddFreeBlock(self, page, num_pages);
+  }
+  DCHECK_LE(allocation_size, bytes_allocated_.load(std::memory_order_relaxed));
+  bytes_allocated_.fetch_sub(allocation_size, std::memory_order_relaxed);
+  objects_allocated_.fetch_sub(1, std::memory_order_relaxed);
+  return allocation_size;
+}
+
+size_t SizeClassLargeObjectSpace::FreeList(Thread* self, size_t num_ptrs, mirror::Object** ptrs) {
+  // The sweeper passes objects in address order, so neighbouring objects are often adjacent and
+  // their pages can be released together.
+  size_t total = 0;
+  uint8_t* run_begin = nullptr;
+  uint8_t* run_end = nullptr;
+  for (size_t i = 0; i < num_ptrs; ++i) {
+    if (kDebugSpaces) {
+      CHECK(Contains(ptrs[i]));
+    }
+    uint8_t* begin = reinterpret_cast<uint8_t*>(ptrs[i]);
+    const size_t allocation_size = AllocationSize(ptrs[i], nullptr);
+    if (begin != run_end) {
+      if (run_begin != run_end) {
+        madvise(run_begin, run_end - run_begin, MADV_DONTNEED);
+      }
+      run_begin = begin;
+    }
+    run_end = begin + allocation_size;
+    total += allocation_size;
+  }
+  if (run_begin != run_end) {
+    madvise(run_begin, run_end - run_begin, MADV_DONTNEED);
+  }
+  for (size_t i = 0; i < num_ptrs; ++i) {
+    const size_t page = PageIndex(ptrs[i]);
+    AddFreeBlock(
+        self, page, block_info_[page].pages_and_flags.load(std::memory_order_relaxed) & kPagesMask);
+  }
+  DCHECK_LE(total, bytes_allocated_.load(std::memory_order_relaxed));
+  bytes_allocated_.fetch_sub(total, std::memory_order_relaxed);
+  objects_allocated_.fetch_sub(num_ptrs, std::memory_order_relaxed);
+  return total;
+}
+
+size_t SizeClassLargeObjectSpace::ReleasePendingBlocks() {
+  // Take the whole list. Only pushes race with this, and the tag makes their CAS fail.
+  uint64_t head = pending_release_.load(std::memory_order_relaxed);
+  while (!pending_release_.compare_exchange_weak(
+             head, ((head >> 32) + 1) << 32, std::memory_order_acquire)) {
+  }
+  std::vector<size_t> pages;
+  for (uint32_t next = static_cast<uint32_t>(head);
+       next != 0u;
+       next = block_info_[next - 1].next_free.load(std::memory_order_relaxed)) {
+    pages.push_back(next - 1);
+  }
+  if (pages.empty()) {
+    return 0u;
+  }
+  std::sort(pages.begin(), pages.end());
+  size_t released_bytes = 0;
+  size_t run_begin = pages[0];
+  size_t run_end = pages[0];
+  for (size_t page : pages) {
+    const size_t num_pages =
+        block_info_[page].pages_and_flags.load(std::memory_order_relaxed) & kPagesMask;
+    if (page != run_end) {
+      madvise(PageAddress(run_begin), (run_end - run_begin) * ObjectAlignment(), MADV_DONTNEED);
+      run_begin = page;
+    }
+    run_end = page + num_pages;
+    released_bytes += num_pages * ObjectAlignment();
+  }
+  madvise(PageAddress(run_begin), (run_end - run_begin) * ObjectAlignment(), MADV_DONTNEED);
+  pending_release_bytes_.fetch_sub(released_bytes, std::memory_order_relaxed);
+  for (size_t page : pages) {
+    const size_t num_pages =
+        block_info_[page].pages_and_flags.load(std::memory_order_relaxed) & kPagesMask;
+    PushFreeBlock(SizeClassForPages(num_pages), page);
+  }
+  return released_bytes;
+}
+
+template <typename Visitor>
+void SizeClassLargeObjectSpace::VisitBlocks(const Visitor& visitor) const {
+  const uint64_t bounds = bounds_.load(std::memory_order_acquire);
+  for (size_t page = 0, bottom = Bottom(bounds); page < bottom;) {
+    const uint32_t info = block_info_[page].pages_and_flags.load(std::memory_order_acquire);
+    if (info == 0u) {
+      // The first page of a block being allocated concurrently. The entries of the other pages of
+      // a block are zero, so skip pages until the next block.
+      ++page;
+      continue;
+    }
+    visitor(page, info);
+    page += info & kPagesMask;
+  }
+  for (size_t page = Top(bounds); page < num_pages_;) {
+    const uint32_t info = block_info_[page].pages_and_flags.load(std::memory_order_relaxed);
+    DCHECK_NE(info, 0u);
+    visitor(page, info);
+    page += info & kPagesMask;
+  }
+}
+
+void SizeClassLargeObjectSpace::Walk(DlMallocSpace::WalkCallback callback, void* arg) {
+  MutexLock mu(Thread::Current(), lock_);
+  VisitBlocks([&](size_t page, uint32_t info) {
+    if ((info & kFlagFree) == 0u) {
+      const size_t alloc_size = (info & kPagesMask) * ObjectAlignment();
+      uint8_t* byte_start = PageAddress(page);
+      callback(byte_start, byte_start + alloc_size, alloc_size, arg);
+      callback(nullptr, nullptr, 0, arg);
+    }
+  });
+}
+
+void SizeClassLargeObjectSpace::Dump(std::ostream& os) const {
+  MutexLock mu(Thread::Current(), lock_);
+  const uint64_t bounds = bounds_.load(std::memory_order_relaxed);
+  os << GetName() << " -"
+     << " begin: " << reinterpret_cast<void*>(Begin())
+     << " end: " << reinterpret_cast<void*>(End())
+     << " size classes: " << num_size_classes_
+     << " huge pages: " << use_huge_pages_ << "\n";
+  VisitBlocks([&](size_t page, uint32_t info) {
+    const size_t size = (info & kPagesMask) * ObjectAlignment();
+    os << (((info & kFlagFree) != 0u) ? "Free block" : "Large object") << " at address: "
+       << reinterpret_cast<const void*>(PageAddress(page)) << " of length " << size << " bytes\n";
+  });
+  if (Top(bounds) > Bottom(bounds)) {
+    os << "Free block at address: " << reinterpret_cast<const void*>(PageAddress(Bottom(bounds)))
+       << " of length " << (Top(bounds) - Bottom(bounds)) * ObjectAlignment() << " bytes\n";
+  }
+}
+
+void SizeClassLargeObjectSpace::ForEachMemMap(std::function<void(const MemMap&)> func) const {
+  MutexLock mu(Thread::Current(), lock_);
+  func(block_info_map_);
+  func(mem_map_);
+}
+
+std::pair<uint8_t*, uint8_t*> SizeClassLargeObjectSpace::GetBeginEndAtomic() const {
+  MutexLock mu(Thread::Current(), lock_);
+  return std::make_pair(Begin(), End());
+}
+
+void SizeClassLargeObjectSpace::ClampGrowthLimit(size_t new_capacity) {
+  MutexLock mu(Thread::Current(), lock_);
+  new_capacity = RoundUp(new_capacity, use_huge_pages_ ? Heap::GetPMDSize() : ObjectAlignment());
+  CHECK_LE(new_capacity, Size());
+  uint64_t bounds = bounds_.load(std::memory_order_relaxed);
+  // Only the unused middle of the space can be given up, and only when nothing is allocated from
+  // the end.
+  if (Top(bounds) != num_pages_) {
+    return;
+  }
+  size_t new_num_pages;
+  do {
+    new_num_pages = std::max(new_capacity / ObjectAlignment(), Bottom(bounds));
+  } while (!bounds_.compare_exchange_strong(
+               bounds, MakeBounds(Bottom(bounds), new_num_pages), std::memory_order_relaxed));
+  const size_t diff = (num_pages_ - new_num_pages) * ObjectAlignment();
+  num_pages_ = new_num_pages;
+  block_info_map_.SetSize(sizeof(BlockInfo) * new_num_pages);
+  mem_map_.SetSize(new_num_pages * ObjectAlignment());
+  end_ -= diff;
+}
+
+bool SizeClassLargeObjectSpace::IsZygoteLargeObject([[maybe_unused]] Thread* self,
+                                                    mirror::Object* obj) const {
+  const uint32_t info =
+      block_info_[PageIndex(obj)].pages_and_flags.load(std::memory_order_relaxed);
+  return (info & kFlagZygote) != 0u;
+}
+
+void SizeClassLargeObjectSpace::SetAllLargeObjectsAsZygoteObjects(Thread* self,
+                                                                  bool set_mark_bit) {
+  MutexLock mu(self, lock_);
+  VisitBlocks([&](size_t page, uint32_t info) REQUIRES_SHARED(Locks::mutator_lock_) {
+    if ((info & kFlagFree) == 0u) {
+      block_info_[page].pages_and_flags.fetch_or(kFlagZygote, std::memory_order_relaxed);
+      if (set_mark_bit) {
+        ObjPtr<mirror::Object> obj = reinterpret_cast<mirror::Object*>(PageAddress(page));
+        bool success = obj->AtomicSetMarkBit(0, 1);
+        CHECK(success);
+      }
+    }
+  });
+}
+
 }  // namespace space
 }  // namespace gc
 }  // namespace art
@@ -18,12 +18,14 @@
 #define ART_RUNTIME_GC_SPACE_LARGE_OBJECT_SPACE_H_
 
 #include "base/allocator.h"
+#include "base/atomic.h"
 #include "base/safe_map.h"
 #include "base/tracking_safe_map.h"
 #include "dlmalloc_space.h"
 #include "space.h"
 #include "thread-current-inl.h"
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -37,6 +39,8 @@ enum class LargeObjectSpaceType {
   kDisabled,
   kMap,
   kFreeList,
+  kSizeClass,
+  kSizeClassHugePages,
 };
 
 // Abstraction implemented by all large object spaces.
@@ -58,11 +62,11 @@ class LargeObjectSpace : public DiscontinuousSpace, public AllocSpace {
     MutexLock mu(Thread::Current(), lock_);
     return num_objects_allocated_;
   }
-  uint64_t GetTotalBytesAllocated() const {
+  virtual uint64_t GetTotalBytesAllocated() const {
     MutexLock mu(Thread::Current(), lock_);
     return total_bytes_allocated_;
   }
-  uint64_t GetTotalObjectsAllocated() const {
+  virtual uint64_t GetTotalObjectsAllocated() const {
     MutexLock mu(Thread::Current(), lock_);
     return total_objects_allocated_;
   }
@@ -254,6 +258,150 @@ class FreeListSpace final : public LargeObjectSpace {
   FreeBlocks free_blocks_ GUARDED_BY(lock_);
 };
 
+// A continuous large object space that rounds allocations up to size classes, with a lock-free
+// free list per size class, so that allocating and freeing large objects of common sizes neither
+// takes a lock nor makes a mmap/munmap call. Size class blocks are carved upwards from the start
+// of the space. Larger allocations are carved downwards from the end of the space under lock_;
+// with huge pages they are rounded up to whole huge pages and backed by transparent huge pages.
+// Free() releases the memory of freed size class blocks in batches.
+class SizeClassLargeObjectSpace final : public LargeObjectSpace {
+ public:
+  ~SizeClassLargeObjectSpace() override {}
+  static SizeClassLargeObjectSpace* Create(const std::string& name,
+                                           size_t capacity,
+                                           bool use_huge_pages);
+  uint64_t GetBytesAllocated() override {
+    return bytes_allocated_.load(std::memory_order_relaxed);
+  }
+  uint64_t GetObjectsAllocated() override {
+    return objects_allocated_.load(std::memory_order_relaxed);
+  }
+  uint64_t GetTotalBytesAllocated() const override {
+    return total_bytes_allocated_ever_.load(std::memory_order_relaxed);
+  }
+  uint64_t GetTotalObjectsAllocated() const override {
+    return total_objects_allocated_ever_.load(std::memory_order_relaxed);
+  }
+  size_t AllocationSize(mirror::Object* obj, size_t* usable_size) override;
+  mirror::Object* Alloc(Thread* self, size_t num_bytes, size_t* bytes_allocated,
+                        size_t* usable_size, size_t* bytes_tl_bulk_allocated)
+      override REQUIRES(!lock_);
+  // Size class blocks are only reused once their memory is released, see ReleasePendingBlocks().
+  size_t Free(Thread* self, mirror::Object* obj) override REQUIRES(!lock_);
+  // Releases the memory of adjacent objects with a single madvise() call.
+  size_t FreeList(Thread* self, size_t num_ptrs, mirror::Object** ptrs) override
+      REQUIRES(!lock_);
+  // Objects being allocated concurrently may be missed.
+  void Walk(DlMallocSpace::WalkCallback callback, void* arg) override REQUIRES(!lock_);
+  void Dump(std::ostream& os) const override REQUIRES(!lock_);
+  void ForEachMemMap(std::function<void(const MemMap&)> func) const override REQUIRES(!lock_);
+  std::pair<uint8_t*, uint8_t*> GetBeginEndAtomic() const override REQUIRES(!lock_);
+  void ClampGrowthLimit(size_t capacity) override REQUIRES(!lock_);
+
+  // Allocations up to this size use the size classes, or up to the huge page size,
+  // Heap::GetPMDSize(), with huge pages if it is smaller.
+  static constexpr size_t kMaxSizeClassBytes = 4 * MB;
+  // Free() releases the memory of size class blocks once they add up to this many bytes.
+  static constexpr size_t kReleaseBatchBytes = 4 * MB;
+
+ protected:
+  bool IsZygoteLargeObject(Thread* self, mirror::Object* obj) const override;
+  void SetAllLargeObjectsAsZygoteObjects(Thread* self, bool set_mark_bit) override
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+ private:
+  // Side table entry, one per page. Only the entry of the first page of a block is used.
+  struct BlockInfo {
+    // The size of the block in pages, and kFlagFree / kFlagZygote.
+    Atomic<uint32_t> pages_and_flags;
+    // For a free size class block, the first page of the next block in the free list plus one,
+    // or zero at the end of the list. For the last page of a free block carved from the end of
+    // the space, the first page of that block plus one, used to coalesce with it.
+    Atomic<uint32_t> next_free;
+  };
+  static constexpr uint32_t kFlagFree = 0x80000000;
+  static constexpr uint32_t kFlagZygote = 0x40000000;
+  static constexpr uint32_t kPagesMask = ~(kFlagFree | kFlagZygote);
+  static constexpr size_t kMaxSizeClasses = 64;
+
+  SizeClassLargeObjectSpace(const std::string& name,
+                            MemMap&& mem_map,
+                            MemMap&& block_info_map,
+                            bool use_huge_pages);
+
+  size_t PageIndex(const void* address) const {
+    DCHECK(Contains(reinterpret_cast<const mirror::Object*>(address)));
+    return (reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(Begin())) /
+        ObjectAlignment();
+  }
+  uint8_t* PageAddress(size_t page) const {
+    return Begin() + page * ObjectAlignment();
+  }
+  // bounds_ holds the first page not carved from the start of the space in its low half, and the
+  // first page carved from the end in its high half.
+  static size_t Bottom(uint64_t bounds) {
+    return static_cast<uint32_t>(bounds);
+  }
+  static size_t Top(uint64_t bounds) {
+    return bounds >> 32;
+  }
+  static uint64_t MakeBounds(size_t bottom, size_t top) {
+    return (static_cast<uint64_t>(top) << 32) | bottom;
+  }
+
+  // Returns the smallest size class of at least num_pages, or num_size_classes_ if there is none.
+  size_t SizeClassForPages(size_t num_pages) const;
+  bool PopFreeBlock(size_t size_class, /*out*/ size_t* page);
+  void PushFreeBlock(size_t size_class, size_t page);
+  void PushBlock(Atomic<uint64_t>& list, size_t page);
+  // Releases the memory of the blocks freed by Free() with one madvise() call per run of adjacent
+  // blocks, and adds them to their free lists. Returns the number of bytes released.
+  size_t ReleasePendingBlocks();
+  bool AllocFromBottom(size_t num_pages, /*out*/ size_t* page);
+  // Allocate a block from the end of the space. Rounds num_pages up for huge pages.
+  bool AllocFromTop(Thread* self, /*inout*/ size_t* num_pages, /*out*/ size_t* page)
+      REQUIRES(!lock_);
+  // Add a released block to the free list it belongs to.
+  void AddFreeBlock(Thread* self, size_t page, size_t num_pages) REQUIRES(!lock_);
+  void AddTopFreeBlock(size_t page, size_t num_pages) REQUIRES(lock_);
+  void RemoveTopFreeBlock(size_t page, size_t num_pages) REQUIRES(lock_);
+
+  // Calls visitor(page, pages_and_flags) for each allocated or free block, skipping the blocks
+  // which are being allocated concurrently.
+  template <typename Visitor>
+  void VisitBlocks(const Visitor& visitor) const REQUIRES(lock_);
+
+  MemMap mem_map_;
+  MemMap block_info_map_;
+  BlockInfo* const block_info_;
+  const bool use_huge_pages_;
+  // The number of pages in the space. Only changes in ClampGrowthLimit().
+  size_t num_pages_ GUARDED_BY(lock_);
+
+  size_t num_size_classes_;
+  size_t size_class_pages_[kMaxSizeClasses];
+  // The heads of the free lists: an ABA tag in the high half and the first page of the first
+  // block plus one, or zero, in the low half.
+  Atomic<uint64_t> free_lists_[kMaxSizeClasses];
+  Atomic<uint64_t> bounds_;
+  // The size class blocks freed by Free() whose memory is not released yet, linked and tagged
+  // like the free lists.
+  Atomic<uint64_t> pending_release_;
+  Atomic<size_t> pending_release_bytes_;
+  // The free blocks carved from the end of the space, by size in pages.
+  std::multimap<size_t,
+                size_t,
+                std::less<size_t>,
+                TrackingAllocator<std::pair<const size_t, size_t>, kAllocatorTagLOSFreeList>>
+      top_free_blocks_ GUARDED_BY(lock_);
+
+  Atomic<uint64_t> bytes_allocated_;
+  Atomic<uint64_t> objects_allocated_;
+  Atomic<uint64_t> total_bytes_allocated_ever_;
+  Atomic<uint64_t> total_objects_allocated_ever_;
+};
+
 }  // namespace space
 }  // namespace gc
 }  // namespace art
@@ -36,13 +36,18 @@ class LargeObjectSpaceTest : public SpaceTest<CommonRuntimeTest> {
 void LargeObjectSpaceTest::LargeObjectTest() {
   size_t rand_seed = 0;
   Thread* const self = Thread::Current();
-  for (size_t i = 0; i < 2; ++i) {
+  for (size_t i = 0; i < 4; ++i) {
     LargeObjectSpace* los = nullptr;
-    const size_t capacity = 128 * MB;
+    // The size class space does not reuse the blocks of freed size class objects for the large
+    // allocation below, so give it room for both.
+    const size_t capacity = (i < 2) ? 128 * MB : 256 * MB;
     if (i == 0) {
       los = space::LargeObjectMapSpace::Create("large object space");
-    } else {
+    } else if (i == 1) {
       los = space::FreeListSpace::Create("large object space", capacity);
+    } else {
+      los = space::SizeClassLargeObjectSpace::Create(
+          "large object space", capacity, /*use_huge_pages=*/ i == 3);
     }
 
     // Make sure the bitmap is not empty and actually covers at least how much we expect.
@@ -152,12 +157,15 @@ class AllocRaceTask : public Task {
 };
 
 void LargeObjectSpaceTest::RaceTest() {
-  for (size_t los_type = 0; los_type < 2; ++los_type) {
+  for (size_t los_type = 0; los_type < 3; ++los_type) {
     LargeObjectSpace* los = nullptr;
     if (los_type == 0) {
       los = space::LargeObjectMapSpace::Create("large object space");
-    } else {
+    } else if (los_type == 1) {
       los = space::FreeListSpace::Create("large object space", 128 * MB);
+    } else {
+      los = space::SizeClassLargeObjectSpace::Create(
+          "large object space", 128 * MB, /*use_huge_pages=*/ false);
     }
 
     Thread* self = Thread::Current();
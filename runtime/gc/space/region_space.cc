@@ -13,16 +13,27 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <deque>
 
+#include "android-base/file.h"
+#include "android-base/parseint.h"
+#include "android-base/stringprintf.h"
+#include "android-base/strings.h"
 #include "bump_pointer_space-inl.h"
 #include "bump_pointer_space.h"
+#include "base/bit_utils.h"
 #include "base/dumpable.h"
 #include "base/logging.h"
 #include "gc/accounting/read_barrier_table.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
 #include "thread_list.h"
+#include "thread_pool.h"
 
 namespace art HIDDEN {
 namespace gc {
@@ -47,6 +58,76 @@ static constexpr uint32_t kPoisonDeadObject = 0xBADDB01D;  // "BADDROID"
 // Whether we check a region's live bytes count against the region bitmap.
 static constexpr bool kCheckLiveBytesAgainstRegionBitmap = kIsDebugBuild;
 
+// The largest number of NUMA nodes NUMA-aware allocation supports, so that a
+// node mask fits in a single word.
+static constexpr size_t kMaxNumaNodes = BitSizeOf<unsigned long>();  // NOLINT [runtime/int]
+
+// Returns the number of NUMA nodes of the host (one more than the highest
+// online node id), or 1 if it cannot be determined.
+static size_t GetNumaNodeCountFromSysfs() {
+  std::string online;
+  if (!android::base::ReadFileToString("/sys/devices/system/node/online", &online)) {
+    return 1u;
+  }
+  // The file lists node id ranges, e.g. "0-1" or "0,2-3".
+  size_t num_nodes = 1u;
+  for (const std::string& range : android::base::Split(android::base::Trim(online), ",")) {
+    size_t last_node;
+    if (!android::base::ParseUint(range.substr(range.find('-') + 1), &last_node)) {
+      return 1u;
+    }
+    num_nodes = std::max(num_nodes, last_node + 1);
+  }
+  return num_nodes;
+}
+
+// Fills `cpu_numa_nodes` with the NUMA node of each CPU, indexed by CPU
+// number, from the CPU lists of the first `num_nodes` nodes. CPUs which are
+// not listed map to `RegionSpace::kNoNumaNode`.
+static bool ReadCpuNumaNodesFromSysfs(size_t num_nodes, std::vector<size_t>* cpu_numa_nodes) {
+  for (size_t node = 0; node < num_nodes; ++node) {
+    std::string cpulist;
+    if (!android::base::ReadFileToString(
+            android::base::StringPrintf("/sys/devices/system/node/node%zu/cpulist", node),
+            &cpulist)) {
+      continue;  // The node is offline.
+    }
+    // The file lists CPU ranges, e.g. "0-3,8-11", and is empty for memory-only nodes.
+    for (const std::string& range : android::base::Split(android::base::Trim(cpulist), ",")) {
+      if (range.empty()) {
+        continue;
+      }
+      size_t first_cpu;
+      size_t last_cpu;
+      size_t dash = range.find('-');
+      if (!android::base::ParseUint(range.substr(0, dash), &first_cpu) ||
+          !android::base::ParseUint(dash == std::string::npos ? range : range.substr(dash + 1),
+                                    &last_cpu) ||
+          last_cpu < first_cpu) {
+        return false;
+      }
+      if (cpu_numa_nodes->size() <= last_cpu) {
+        cpu_numa_nodes->resize(last_cpu + 1, RegionSpace::kNoNumaNode);
+      }
+      std::fill(cpu_numa_nodes->begin() + first_cpu, cpu_numa_nodes->begin() + last_cpu + 1, node);
+    }
+  }
+  return !cpu_numa_nodes->empty();
+}
+
+// A thread's NUMA node is looked up again after it has allocated this many
+// TLABs. Threads rarely migrate between nodes, and a stale node only costs
+// some locality.
+static constexpr uint32_t kNumaNodeRefreshTlabCount = 64;
+
+// The NUMA node the thread last ran on, and the number of TLABs it may still
+// allocate before looking it up again.
+struct ThreadNumaNodeCache {
+  size_t node = RegionSpace::kNoNumaNode;
+  uint32_t tlabs_until_refresh = 0;
+};
+static thread_local ThreadNumaNodeCache gThreadNumaNodeCache;
+
 MemMap RegionSpace::CreateMemMap(const std::string& name,
                                  size_t capacity,
                                  uint8_t* requested_begin) {
@@ -94,12 +175,17 @@ MemMap RegionSpace::CreateMemMap(const std::string& name,
   return mem_map;
 }
 
-RegionSpace* RegionSpace::Create(
-    const std::string& name, MemMap&& mem_map, bool use_generational_cc) {
-  return new RegionSpace(name, std::move(mem_map), use_generational_cc);
+RegionSpace* RegionSpace::Create(const std::string& name,
+                                 MemMap&& mem_map,
+                                 bool use_generational_cc,
+                                 bool numa_aware) {
+  return new RegionSpace(name, std::move(mem_map), use_generational_cc, numa_aware);
 }
 
-RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_generational_cc)
+RegionSpace::RegionSpace(const std::string& name,
+                         MemMap&& mem_map,
+                         bool use_generational_cc,
+                         bool numa_aware)
     : ContinuousMemMapAllocSpace(name,
                                  std::move(mem_map),
                                  mem_map.Begin(),
@@ -117,7 +203,9 @@ RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_gen
       non_free_region_index_limit_(0U),
       current_region_(&full_region_),
       evac_region_(nullptr),
-      cyclic_alloc_region_index_(0U) {
+      cyclic_alloc_region_index_(0U),
+      num_numa_nodes_(1U),
+      regions_per_numa_node_(num_regions_) {
   CHECK_ALIGNED(mem_map_.Size(), kRegionSize);
   CHECK_ALIGNED(mem_map_.Begin(), kRegionSize);
   DCHECK_GT(num_regions_, 0U);
@@ -143,10 +231,69 @@ RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_gen
   DCHECK(full_region_.IsAllocated());
   size_t ignored;
   DCHECK(full_region_.Alloc(kAlignment, &ignored, nullptr, &ignored) == nullptr);
+  if (numa_aware) {
+    size_t num_nodes = GetNumaNodeCountFromSysfs();
+    if (num_nodes > kMaxNumaNodes || num_nodes > num_regions_) {
+      LOG(WARNING) << "NUMA-aware allocation not supported with " << num_nodes << " nodes";
+    } else if (num_nodes > 1u) {
+      if (!ReadCpuNumaNodesFromSysfs(num_nodes, &cpu_numa_nodes_)) {
+        LOG(WARNING) << "Cannot map CPUs to NUMA nodes, disabling NUMA-aware allocation";
+        cpu_numa_nodes_.clear();
+      } else {
+        num_numa_nodes_ = num_nodes;
+        regions_per_numa_node_ = RoundUp(num_regions_, num_nodes) / num_nodes;
+        BindRegionsToNumaNodes();
+      }
+    }
+  }
   // Protect the whole region space from the start.
   Protect();
 }
 
+void RegionSpace::BindRegionsToNumaNodes() {
+  DCHECK_GT(num_numa_nodes_, 1u);
+  for (size_t node = 0; node < num_numa_nodes_; ++node) {
+    size_t begin = node * regions_per_numa_node_;
+    size_t end = std::min(begin + regions_per_numa_node_, num_regions_);
+    if (begin >= end) {
+      break;
+    }
+    // Prefer rather than bind, so that an exhausted node falls back to the
+    // other nodes instead of failing the page fault.
+    unsigned long node_mask = 1UL << node;  // NOLINT [runtime/int]
+    if (syscall(__NR_mbind,
+                Begin() + begin * kRegionSize,
+                (end - begin) * kRegionSize,
+                MPOL_PREFERRED,
+                &node_mask,
+                kMaxNumaNodes,
+                /* flags= */ 0) != 0) {
+      PLOG(WARNING) << "Failed to bind regions [" << begin << ", " << end << ") to NUMA node "
+                    << node << ", disabling NUMA-aware allocation";
+      num_numa_nodes_ = 1u;
+      regions_per_numa_node_ = num_regions_;
+      cpu_numa_nodes_.clear();
+      return;
+    }
+  }
+  VLOG(heap) << "Split " << num_regions_ << " regions of " << GetName() << " into "
+             << num_numa_nodes_ << " NUMA node pools";
+}
+
+size_t RegionSpace::GetCurrentNumaNode() const {
+  ThreadNumaNodeCache& cache = gThreadNumaNodeCache;
+  if (cache.tlabs_until_refresh == 0) {
+    // sched_getcpu() doesn't enter the kernel where a vDSO provides it.
+    int cpu = sched_getcpu();
+    cache.node = (cpu >= 0 && static_cast<size_t>(cpu) < cpu_numa_nodes_.size())
+        ? cpu_numa_nodes_[cpu]
+        : kNoNumaNode;
+    cache.tlabs_until_refresh = kNumaNodeRefreshTlabCount;
+  }
+  --cache.tlabs_until_refresh;
+  return cache.node;
+}
+
 size_t RegionSpace::FromSpaceSize() {
   uint64_t num_regions = 0;
   MutexLock mu(Thread::Current(), region_lock_);
@@ -416,7 +563,9 @@ void RegionSpace::ReleaseFreeRegions() {
 void RegionSpace::ClearFromSpace(/* out */ uint64_t* cleared_bytes,
                                  /* out */ uint64_t* cleared_objects,
                                  const bool clear_bitmap,
-                                 const bool release_eagerly) {
+                                 const bool release_eagerly,
+                                 ThreadPool* thread_pool,
+                                 size_t thread_count) {
   DCHECK(cleared_bytes != nullptr);
   DCHECK(cleared_objects != nullptr);
   *cleared_bytes = 0;
@@ -495,19 +644,7 @@ void RegionSpace::ClearFromSpace(/* out */ uint64_t* cleared_bytes,
   }
 
   // Madvise the memory ranges.
-  uint64_t start_time = NanoTime();
-  for (const auto &iter : madvise_list) {
-    ZeroAndProtectRegion(iter.first, iter.second, release_eagerly);
-  }
-  madvise_time_ += NanoTime() - start_time;
-
-  for (const auto &iter : madvise_list) {
-    if (clear_bitmap) {
-      GetLiveBitmap()->ClearRange(
-          reinterpret_cast<mirror::Object*>(iter.first),
-          reinterpret_cast<mirror::Object*>(iter.second));
-    }
-  }
+  ZeroAndClearRanges(madvise_list, clear_bitmap, release_eagerly, thread_pool, thread_count);
   madvise_list.clear();
 
   // Iterate over regions again and actually make the from space regions
@@ -631,6 +768,75 @@ void RegionSpace::ClearFromSpace(/* out */ uint64_t* cleared_bytes,
   num_evac_regions_ = 0;
 }
 
+void RegionSpace::ZeroAndClearRanges(const std::deque<std::pair<uint8_t*, uint8_t*>>& ranges,
+                                     bool clear_bitmap,
+                                     bool release_eagerly,
+                                     ThreadPool* thread_pool,
+                                     size_t thread_count) {
+  auto zero_and_clear = [this, clear_bitmap, release_eagerly](uint8_t* begin, uint8_t* end) {
+    ZeroAndProtectRegion(begin, end, release_eagerly);
+    if (clear_bitmap) {
+      GetLiveBitmap()->ClearRange(reinterpret_cast<mirror::Object*>(begin),
+                                  reinterpret_cast<mirror::Object*>(end));
+    }
+  };
+  uint64_t start_time = NanoTime();
+  size_t num_cleared_regions = 0;
+  for (const auto& range : ranges) {
+    num_cleared_regions += (range.second - range.first) / kRegionSize;
+  }
+  if (thread_pool == nullptr || thread_count <= 1 || num_cleared_regions < thread_count) {
+    for (const auto& range : ranges) {
+      zero_and_clear(range.first, range.second);
+    }
+    madvise_time_ += NanoTime() - start_time;
+    return;
+  }
+  // Give each thread a contiguous (by region index) share of the cleared
+  // regions. A range is split only at a share boundary, so that the number of
+  // madvise calls, and hence the contention on the mmap lock, grows by at most
+  // `thread_count - 1`. The bitmap ranges being region aligned, the threads
+  // never clear the same bitmap word.
+  const size_t regions_per_thread = RoundUp(num_cleared_regions, thread_count) / thread_count;
+  std::vector<std::vector<std::pair<uint8_t*, uint8_t*>>> shares(thread_count);
+  size_t share_idx = 0;
+  size_t share_regions = 0;
+  for (const auto& range : ranges) {
+    uint8_t* begin = range.first;
+    while (begin < range.second) {
+      DCHECK_LT(share_idx, thread_count);
+      size_t regions = std::min(static_cast<size_t>(range.second - begin) / kRegionSize,
+                                regions_per_thread - share_regions);
+      uint8_t* end = begin + regions * kRegionSize;
+      shares[share_idx].push_back(std::pair(begin, end));
+      share_regions += regions;
+      if (share_regions == regions_per_thread) {
+        ++share_idx;
+        share_regions = 0;
+      }
+      begin = end;
+    }
+  }
+  Thread* const self = Thread::Current();
+  size_t num_tasks = 0;
+  for (size_t i = 1; i < thread_count && !shares[i].empty(); ++i) {
+    thread_pool->AddTask(self, new FunctionTask([&zero_and_clear, &share = shares[i]](Thread*) {
+      for (const auto& range : share) {
+        zero_and_clear(range.first, range.second);
+      }
+    }));
+    ++num_tasks;
+  }
+  thread_pool->SetMaxActiveWorkers(std::min(num_tasks, thread_pool->GetThreadCount()));
+  thread_pool->StartWorkers(self);
+  for (const auto& range : shares[0]) {
+    zero_and_clear(range.first, range.second);
+  }
+  thread_pool->Wait(self, /* do_work= */ true, /* may_hold_locks= */ true);
+  thread_pool->StopWorkers(self);
+  madvise_time_ += NanoTime() - start_time;
+}
+
 void RegionSpace::CheckLiveBytesAgainstRegionBitmap(Region* r) {
   if (r->LiveBytes() == static_cast<size_t>(-1)) {
     // Live bytes count is undefined for `r`; nothing to check here.
@@ -858,6 +1064,8 @@ void RegionSpace::RecordAlloc(mirror::Object* ref) {
 bool RegionSpace::AllocNewTlab(Thread* self,
                                const size_t tlab_size,
                                size_t* bytes_tl_bulk_allocated) {
+  // Look up the node before taking the lock.
+  const size_t numa_node = num_numa_nodes_ > 1 ? GetCurrentNumaNode() : kNoNumaNode;
   MutexLock mu(self, region_lock_);
   RevokeThreadLocalBuffersLocked(self, /*reuse=*/ gc::Heap::kUsePartialTlabs);
   Region* r = nullptr;
@@ -866,8 +1074,15 @@ bool RegionSpace::AllocNewTlab(Thread* self,
   // First attempt to get a partially used TLAB, if available.
   if (tlab_size < kRegionSize) {
     // Fetch the largest partial TLAB. The multimap is ordered in decreasing
-    // size.
+    // size. With NUMA-aware allocation, only consider the local node's ones.
     auto largest_partial_tlab = partial_tlabs_.begin();
+    if (numa_node != kNoNumaNode) {
+      while (largest_partial_tlab != partial_tlabs_.end() &&
+             largest_partial_tlab->first >= tlab_size &&
+             GetRegionNumaNode(largest_partial_tlab->second->Idx()) != numa_node) {
+        ++largest_partial_tlab;
+      }
+    }
     if (largest_partial_tlab != partial_tlabs_.end() && largest_partial_tlab->first >= tlab_size) {
       r = largest_partial_tlab->second;
       pos = r->End() - largest_partial_tlab->first;
@@ -880,7 +1095,7 @@ bool RegionSpace::AllocNewTlab(Thread* self,
   }
   if (r == nullptr) {
     // Fallback to allocating an entire region as TLAB.
-    r = AllocateRegion(/*for_evac=*/ false);
+    r = AllocateRegion(/*for_evac=*/ false, numa_node);
   }
   if (r != nullptr) {
     uint8_t* start = pos != nullptr ? pos : r->Begin();
@@ -1038,18 +1253,39 @@ void RegionSpace::TraceHeapSize() {
   heap->TraceHeapSize(heap->GetBytesAllocated() + EvacBytes());
 }
 
-RegionSpace::Region* RegionSpace::AllocateRegion(bool for_evac) {
+RegionSpace::Region* RegionSpace::AllocateRegion(bool for_evac, size_t numa_node) {
   if (!for_evac && (num_non_free_regions_ + 1) * 2 > num_regions_) {
     return nullptr;
   }
-  for (size_t i = 0; i < num_regions_; ++i) {
+  if (numa_node != kNoNumaNode && numa_node < num_numa_nodes_) {
+    // Try the pool of the requested node first.
+    size_t begin = numa_node * regions_per_numa_node_;
+    size_t end = std::min(begin + regions_per_numa_node_, num_regions_);
+    Region* r = AllocateRegionInRange(for_evac, begin, end);
+    if (r != nullptr) {
+      return r;
+    }
+  }
+  return AllocateRegionInRange(for_evac, 0, num_regions_);
+}
+
+RegionSpace::Region* RegionSpace::AllocateRegionInRange(bool for_evac, size_t begin, size_t end) {
+  DCHECK_LE(end, num_regions_);
+  // When using the cyclic region allocation strategy, start from the last
+  // cyclic allocated region marker if it is within the range.
+  size_t start = (kCyclicRegionAllocation &&
+                  cyclic_alloc_region_index_ >= begin &&
+                  cyclic_alloc_region_index_ < end)
+      ? cyclic_alloc_region_index_
+      : begin;
+  for (size_t i = 0; i < end - begin; ++i) {
     // When using the cyclic region allocation strategy, try to
     // allocate a region starting from the last cyclic allocated
     // region marker. Otherwise, try to allocate a region starting
-    // from the beginning of the region space.
+    // from the beginning of the range.
     size_t region_index = kCyclicRegionAllocation
-        ? ((cyclic_alloc_region_index_ + i) % num_regions_)
-        : i;
+        ? begin + (start - begin + i) % (end - begin)
+        : begin + i;
     Region* r = &regions_[region_index];
     if (r->IsFree()) {
       r->Unfree(this, time_);
@@ -22,10 +22,15 @@
 #include "space.h"
 #include "thread.h"
 
+#include <deque>
 #include <functional>
 #include <map>
+#include <vector>
 
 namespace art HIDDEN {
+
+class ThreadPool;
+
 namespace gc {
 
 namespace accounting {
@@ -62,7 +67,17 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // guaranteed to be granted, if it is required, the caller should call Begin on the returned
   // space to confirm the request was granted.
   static MemMap CreateMemMap(const std::string& name, size_t capacity, uint8_t* requested_begin);
-  static RegionSpace* Create(const std::string& name, MemMap&& mem_map, bool use_generational_cc);
+  // If `numa_aware` is true and the host has more than one NUMA node, the
+  // regions are split into one contiguous pool per node, whose pages are
+  // preferably backed by that node's memory, and new TLABs are handed out
+  // from the pool of the node the requesting thread runs on. Evacuation
+  // regions and the shared non-TLAB allocation region are taken from the
+  // whole space, so objects that survive a collection may move off their
+  // allocating thread's node.
+  static RegionSpace* Create(const std::string& name,
+                             MemMap&& mem_map,
+                             bool use_generational_cc,
+                             bool numa_aware = false);
 
   // Allocate `num_bytes`, returns null if the space is full.
   mirror::Object* Alloc(Thread* self,
@@ -234,6 +249,8 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   static constexpr size_t kAlignment = kObjectAlignment;
   // The region size.
   static constexpr size_t kRegionSize = 256 * KB;
+  // Value of `numa_node` arguments meaning no NUMA node preference.
+  static constexpr size_t kNoNumaNode = static_cast<size_t>(-1);
 
   bool IsInFromSpace(mirror::Object* ref) {
     if (HasAddress(ref)) {
@@ -311,10 +328,14 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   size_t FromSpaceSize() REQUIRES(!region_lock_);
   size_t UnevacFromSpaceSize() REQUIRES(!region_lock_);
   size_t ToSpaceSize() REQUIRES(!region_lock_);
+  // If `thread_pool` is non-null, the cleared regions are zeroed or released
+  // with `thread_count` threads, including the calling thread.
   void ClearFromSpace(/* out */ uint64_t* cleared_bytes,
                       /* out */ uint64_t* cleared_objects,
                       const bool clear_bitmap,
-                      const bool release_eagerly)
+                      const bool release_eagerly,
+                      ThreadPool* thread_pool = nullptr,
+                      size_t thread_count = 1)
       REQUIRES(!region_lock_);
 
   void AddLiveBytes(mirror::Object* ref, size_t alloc_size) {
@@ -322,6 +343,12 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     reg->AddLiveBytes(alloc_size);
   }
 
+  // Same as AddLiveBytes(), but safe to call from multiple threads.
+  void AtomicAddLiveBytes(mirror::Object* ref, size_t alloc_size) {
+    Region* reg = RefToRegionUnlocked(ref);
+    reg->AtomicAddLiveBytes(alloc_size);
+  }
+
   void AssertAllRegionLiveBytesZeroOrCleared() REQUIRES(!region_lock_) {
     if (kIsDebugBuild) {
       MutexLock mu(Thread::Current(), region_lock_);
@@ -373,6 +400,18 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   bool AllocNewTlab(Thread* self, const size_t tlab_size, size_t* bytes_tl_bulk_allocated)
       REQUIRES(!region_lock_);
 
+  // The number of NUMA node pools the regions are split into. 1 if
+  // NUMA-aware allocation is disabled.
+  size_t GetNumaNodeCount() const {
+    return num_numa_nodes_;
+  }
+
+  // The NUMA node whose pool the region at index `region_index` belongs to.
+  size_t GetRegionNumaNode(size_t region_index) const {
+    DCHECK_LT(region_index, num_regions_);
+    return region_index / regions_per_numa_node_;
+  }
+
   uint32_t Time() {
     return time_;
   }
@@ -388,7 +427,10 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   void ReleaseFreeRegions();
 
  private:
-  RegionSpace(const std::string& name, MemMap&& mem_map, bool use_generational_cc);
+  RegionSpace(const std::string& name,
+              MemMap&& mem_map,
+              bool use_generational_cc,
+              bool numa_aware);
 
   class Region {
    public:
@@ -568,6 +610,20 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
       DCHECK_LE(live_bytes_, BytesAllocated());
     }
 
+    void AtomicAddLiveBytes(size_t live_bytes) {
+      DCHECK(GetUseGenerationalCC() || IsInUnevacFromSpace());
+      DCHECK(!IsLargeTail());
+      if (IsLarge()) {
+        // Only the large object itself is in the region, and it is added at most once.
+        AddLiveBytes(live_bytes);
+        return;
+      }
+      size_t old_live_bytes = reinterpret_cast<Atomic<size_t>*>(&live_bytes_)->fetch_add(
+          live_bytes, std::memory_order_relaxed);
+      DCHECK_NE(old_live_bytes, static_cast<size_t>(-1));
+      DCHECK_LE(old_live_bytes + live_bytes, BytesAllocated());
+    }
+
     bool AllAllocatedBytesAreLive() const {
       return LiveBytes() == static_cast<size_t>(Top() - Begin());
     }
@@ -715,7 +771,16 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     }
   }
 
-  EXPORT Region* AllocateRegion(bool for_evac) REQUIRES(region_lock_);
+  // Allocate a free region, preferably from the pool of `numa_node` if it
+  // is not `kNoNumaNode`.
+  EXPORT Region* AllocateRegion(bool for_evac, size_t numa_node = kNoNumaNode)
+      REQUIRES(region_lock_);
+  // Find a free region in [`begin`, `end`) and mark it as allocated.
+  Region* AllocateRegionInRange(bool for_evac, size_t begin, size_t end) REQUIRES(region_lock_);
+  // Bind the pages of each NUMA node pool to that node. Called once at creation.
+  void BindRegionsToNumaNodes();
+  // Returns the NUMA node the calling thread runs on, as cached for the thread.
+  size_t GetCurrentNumaNode() const;
   void RevokeThreadLocalBuffersLocked(Thread* thread, bool reuse) REQUIRES(region_lock_);
 
   // Scan region range [`begin`, `end`) in increasing order to try to
@@ -745,6 +810,15 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // objects earlier in debug mode.
   void PoisonDeadObjectsInUnevacuatedRegion(Region* r);
 
+  // Zero (or release) the memory ranges cleared by ClearFromSpace(), and clear
+  // their live bits if `clear_bitmap` is true. The ranges are partitioned by
+  // region index over `thread_count` threads.
+  void ZeroAndClearRanges(const std::deque<std::pair<uint8_t*, uint8_t*>>& ranges,
+                          bool clear_bitmap,
+                          bool release_eagerly,
+                          ThreadPool* thread_pool,
+                          size_t thread_count) REQUIRES(!region_lock_);
+
   Mutex region_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
   // Cached version of Heap::use_generational_cc_.
@@ -785,9 +859,20 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // `kCyclicRegionAllocation` is true.
   size_t cyclic_alloc_region_index_ GUARDED_BY(region_lock_);
 
+  // The number of NUMA node pools, and the number of regions of each pool
+  // (the last one may be smaller). Pool `n` spans regions
+  // [n * regions_per_numa_node_, (n + 1) * regions_per_numa_node_).
+  size_t num_numa_nodes_;
+  size_t regions_per_numa_node_;
+  // The NUMA node of each CPU, indexed by CPU number. Empty if NUMA-aware
+  // allocation is disabled.
+  std::vector<size_t> cpu_numa_nodes_;
+
   // Mark bitmap used by the GC.
   accounting::ContinuousSpaceBitmap mark_bitmap_;
 
+  friend class RegionSpaceTest;
+
   DISALLOW_COPY_AND_ASSIGN(RegionSpace);
 };
 
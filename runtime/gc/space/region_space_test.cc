@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "region_space.h"
+
+#include <memory>
+
+#include "base/mutex-inl.h"
+#include "common_runtime_test.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+namespace gc {
+namespace space {
+
+class RegionSpaceTest : public CommonRuntimeTest {
+ protected:
+  static constexpr size_t kNoRegion = static_cast<size_t>(-1);
+
+  RegionSpaceTest() {
+    use_boot_image_ = true;  // Make the Runtime creation cheaper.
+  }
+
+  static std::unique_ptr<RegionSpace> CreateRegionSpace(size_t num_regions) {
+    MemMap mem_map = RegionSpace::CreateMemMap(
+        "region space test", num_regions * RegionSpace::kRegionSize, /*requested_begin=*/ nullptr);
+    CHECK(mem_map.IsValid());
+    return std::unique_ptr<RegionSpace>(RegionSpace::Create(
+        "region space test", std::move(mem_map), /*use_generational_cc=*/ false));
+  }
+
+  // Split the regions into `num_nodes` pools as NUMA-aware allocation does on a host with that
+  // many nodes, without binding their memory, so that the pools can be tested on any host.
+  static void SplitIntoNumaNodePools(RegionSpace* space, size_t num_nodes) {
+    space->num_numa_nodes_ = num_nodes;
+    space->regions_per_numa_node_ = RoundUp(space->num_regions_, num_nodes) / num_nodes;
+  }
+
+  // Returns the index of the allocated region, or kNoRegion.
+  static size_t AllocateRegion(RegionSpace* space, size_t numa_node) {
+    MutexLock mu(Thread::Current(), space->region_lock_);
+    RegionSpace::Region* r = space->AllocateRegion(/*for_evac=*/ false, numa_node);
+    return r != nullptr ? r->Idx() : kNoRegion;
+  }
+};
+
+TEST_F(RegionSpaceTest, NumaNodePools) {
+  static constexpr size_t kNumRegions = 32;
+  static constexpr size_t kNumNodes = 4;
+  static constexpr size_t kRegionsPerNode = kNumRegions / kNumNodes;
+  std::unique_ptr<RegionSpace> space = CreateRegionSpace(kNumRegions);
+  // Not NUMA-aware unless asked for.
+  EXPECT_EQ(1u, space->GetNumaNodeCount());
+  EXPECT_EQ(0u, space->GetRegionNumaNode(kNumRegions - 1));
+
+  SplitIntoNumaNodePools(space.get(), kNumNodes);
+  ASSERT_EQ(kNumNodes, space->GetNumaNodeCount());
+  for (size_t i = 0; i < kNumRegions; ++i) {
+    EXPECT_EQ(i / kRegionsPerNode, space->GetRegionNumaNode(i));
+  }
+
+  // Regions come from the pool of the requested node while it has free regions.
+  for (size_t i = 0; i < kRegionsPerNode; ++i) {
+    size_t region = AllocateRegion(space.get(), /*numa_node=*/ 2);
+    ASSERT_NE(kNoRegion, region);
+    EXPECT_EQ(2u, space->GetRegionNumaNode(region));
+  }
+  // Then from the other pools.
+  size_t region = AllocateRegion(space.get(), /*numa_node=*/ 2);
+  ASSERT_NE(kNoRegion, region);
+  EXPECT_NE(2u, space->GetRegionNumaNode(region));
+
+  // The other nodes keep using their own pools.
+  region = AllocateRegion(space.get(), /*numa_node=*/ 0);
+  ASSERT_NE(kNoRegion, region);
+  EXPECT_EQ(0u, space->GetRegionNumaNode(region));
+  region = AllocateRegion(space.get(), /*numa_node=*/ 3);
+  ASSERT_NE(kNoRegion, region);
+  EXPECT_EQ(3u, space->GetRegionNumaNode(region));
+
+  // No preference, or an unknown node, takes any free region.
+  EXPECT_NE(kNoRegion, AllocateRegion(space.get(), RegionSpace::kNoNumaNode));
+  EXPECT_NE(kNoRegion, AllocateRegion(space.get(), kNumNodes));
+}
+
+}  // namespace space
+}  // namespace gc
+}  // namespace art
@@ -158,6 +158,11 @@ class RosAllocSpace : public MallocSpace {
 
   void DumpStats(std::ostream& os);
 
+  // Dump the per size bracket stats recorded with -XX:RosAllocBracketStats.
+  void DumpBracketStats(std::ostream& os) {
+    rosalloc_->DumpBracketStats(os);
+  }
+
  protected:
   RosAllocSpace(MemMap&& mem_map,
                 size_t initial_size,
@@ -17,9 +17,12 @@
 #ifndef ART_RUNTIME_IMT_CONFLICT_TABLE_H_
 #define ART_RUNTIME_IMT_CONFLICT_TABLE_H_
 
+#include <algorithm>
 #include <cstddef>
 
+#include "base/bit_utils.h"
 #include "base/casts.h"
+#include "base/logging.h"
 #include "base/macros.h"
 #include "base/pointer_size.h"
 
@@ -32,6 +35,15 @@ class ArtMethod;
 // The table contains a list of pairs of { interface_method, implementation_method }
 // with the last entry being null to make an assembly implementation of a lookup
 // faster.
+//
+// Large tables can also have a hash index, for a constant time lookup in the
+// conflict trampoline. Such tables start with a { kHashedMarker, hash_index } pair,
+// which never matches an interface method in a linear lookup. The hash index
+// follows the null entry: a { mask, capacity } pair and then `mask + 1 + capacity`
+// buckets of { interface_method, implementation_method } pairs. An interface
+// method is in the first empty or matching bucket, starting at
+// `(interface_method >> kHashShift) & mask`. Probing never wraps around, hence the
+// extra buckets, the last of which is always empty.
 class ImtConflictTable {
   enum MethodIndex {
     kMethodInterface,
@@ -40,13 +52,22 @@ class ImtConflictTable {
   };
 
  public:
+  // Value of the first interface method of tables that have a hash index.
+  static constexpr size_t kHashedMarker = 1u;
+  // Shift applied to the interface method before masking it into a bucket index.
+  static constexpr size_t kHashShift = 3u;
+  // Tables with at least this many entries may get a hash index.
+  static constexpr size_t kHashedLookupThreshold = 8u;
+
   // Build a new table copying `other` and adding the new entry formed of
   // the pair { `interface_method`, `implementation_method` }
   ImtConflictTable(ImtConflictTable* other,
                    ArtMethod* interface_method,
                    ArtMethod* implementation_method,
-                   PointerSize pointer_size) {
+                   PointerSize pointer_size,
+                   bool hashed = false) {
     const size_t count = other->NumEntries(pointer_size);
+    InitializeHeader(count + 1, pointer_size, hashed);
     for (size_t i = 0; i < count; ++i) {
       SetInterfaceMethod(i, pointer_size, other->GetInterfaceMethod(i, pointer_size));
       SetImplementationMethod(i, pointer_size, other->GetImplementationMethod(i, pointer_size));
@@ -56,37 +77,45 @@ class ImtConflictTable {
     // Add the null marker.
     SetInterfaceMethod(count + 1, pointer_size, nullptr);
     SetImplementationMethod(count + 1, pointer_size, nullptr);
+    UpdateHashIndex(pointer_size);
   }
 
-  // num_entries excludes the header.
-  ImtConflictTable(size_t num_entries, PointerSize pointer_size) {
+  // num_entries excludes the header. If `hashed`, the entries must be followed by
+  // a call to `UpdateHashIndex`.
+  ImtConflictTable(size_t num_entries, PointerSize pointer_size, bool hashed = false) {
+    InitializeHeader(num_entries, pointer_size, hashed);
     SetInterfaceMethod(num_entries, pointer_size, nullptr);
     SetImplementationMethod(num_entries, pointer_size, nullptr);
   }
 
   // Set an entry at an index.
   void SetInterfaceMethod(size_t index, PointerSize pointer_size, ArtMethod* method) {
-    SetMethod(index * kMethodCount + kMethodInterface, pointer_size, method);
+    SetMethod(EntryIndex(index, pointer_size) + kMethodInterface, pointer_size, method);
   }
 
   void SetImplementationMethod(size_t index, PointerSize pointer_size, ArtMethod* method) {
-    SetMethod(index * kMethodCount + kMethodImplementation, pointer_size, method);
+    SetMethod(EntryIndex(index, pointer_size) + kMethodImplementation, pointer_size, method);
   }
 
   ArtMethod* GetInterfaceMethod(size_t index, PointerSize pointer_size) const {
-    return GetMethod(index * kMethodCount + kMethodInterface, pointer_size);
+    return GetMethod(EntryIndex(index, pointer_size) + kMethodInterface, pointer_size);
   }
 
   ArtMethod* GetImplementationMethod(size_t index, PointerSize pointer_size) const {
-    return GetMethod(index * kMethodCount + kMethodImplementation, pointer_size);
+    return GetMethod(EntryIndex(index, pointer_size) + kMethodImplementation, pointer_size);
   }
 
   void** AddressOfInterfaceMethod(size_t index, PointerSize pointer_size) {
-    return AddressOfMethod(index * kMethodCount + kMethodInterface, pointer_size);
+    return AddressOfMethod(EntryIndex(index, pointer_size) + kMethodInterface, pointer_size);
   }
 
   void** AddressOfImplementationMethod(size_t index, PointerSize pointer_size) {
-    return AddressOfMethod(index * kMethodCount + kMethodImplementation, pointer_size);
+    return AddressOfMethod(EntryIndex(index, pointer_size) + kMethodImplementation, pointer_size);
+  }
+
+  // Whether the table has a hash index.
+  bool IsHashed(PointerSize pointer_size) const {
+    return GetWord(kMethodInterface, pointer_size) == kHashedMarker;
   }
 
   // Return true if two conflict tables are the same.
@@ -111,6 +140,7 @@ class ImtConflictTable {
   template<typename Visitor>
   void Visit(const Visitor& visitor, PointerSize pointer_size) NO_THREAD_SAFETY_ANALYSIS {
     uint32_t table_index = 0;
+    bool updated_any = false;
     for (;;) {
       ArtMethod* interface_method = GetInterfaceMethod(table_index, pointer_size);
       if (interface_method == nullptr) {
@@ -121,17 +151,35 @@ class ImtConflictTable {
       std::pair<ArtMethod*, ArtMethod*> updated = visitor(input);
       if (input.first != updated.first) {
         SetInterfaceMethod(table_index, pointer_size, updated.first);
+        updated_any = true;
       }
       if (input.second != updated.second) {
         SetImplementationMethod(table_index, pointer_size, updated.second);
+        updated_any = true;
       }
       ++table_index;
     }
+    if (updated_any) {
+      UpdateHashIndex(pointer_size);
+    }
   }
 
   // Lookup the implementation ArtMethod associated to `interface_method`. Return null
   // if not found.
   ArtMethod* Lookup(ArtMethod* interface_method, PointerSize pointer_size) const {
+    if (IsHashed(pointer_size)) {
+      size_t index = HashIndexStart(pointer_size) + kMethodCount +
+          Bucket(interface_method, pointer_size) * kMethodCount;
+      for (;; index += kMethodCount) {
+        ArtMethod* current_interface_method = GetMethod(index + kMethodInterface, pointer_size);
+        if (current_interface_method == nullptr) {
+          return nullptr;
+        }
+        if (current_interface_method == interface_method) {
+          return GetMethod(index + kMethodImplementation, pointer_size);
+        }
+      }
+    }
     uint32_t table_index = 0;
     for (;;) {
       ArtMethod* current_interface_method = GetInterfaceMethod(table_index, pointer_size);
@@ -157,18 +205,28 @@ class ImtConflictTable {
 
   // Compute the size in bytes taken by this table.
   size_t ComputeSize(PointerSize pointer_size) const {
+    if (IsHashed(pointer_size)) {
+      return ComputeSize(GetHashCapacityEntries(pointer_size), pointer_size, /*hashed=*/ true);
+    }
     // Add the end marker.
     return ComputeSize(NumEntries(pointer_size), pointer_size);
   }
 
   // Compute the size in bytes needed for copying the given `table` and add
   // one more entry.
-  static size_t ComputeSizeWithOneMoreEntry(ImtConflictTable* table, PointerSize pointer_size) {
-    return table->ComputeSize(pointer_size) + EntrySize(pointer_size);
+  static size_t ComputeSizeWithOneMoreEntry(ImtConflictTable* table,
+                                            PointerSize pointer_size,
+                                            bool hashed = false) {
+    return ComputeSize(table->NumEntries(pointer_size) + 1u, pointer_size, hashed);
   }
 
   // Compute size with a fixed number of entries.
-  static size_t ComputeSize(size_t num_entries, PointerSize pointer_size) {
+  static size_t ComputeSize(size_t num_entries, PointerSize pointer_size, bool hashed = false) {
+    if (hashed) {
+      // Marker, entries, null terminator, hash index header and buckets.
+      size_t num_buckets = HashMask(num_entries) + 1u + num_entries;
+      return (1u + num_entries + 1u + 1u + num_buckets) * EntrySize(pointer_size);
+    }
     return (num_entries + 1) * EntrySize(pointer_size);  // Add one for null terminator.
   }
 
@@ -176,7 +234,78 @@ class ImtConflictTable {
     return static_cast<size_t>(pointer_size) * static_cast<size_t>(kMethodCount);
   }
 
+  // Rebuild the hash index from the entries, if the table has one.
+  void UpdateHashIndex(PointerSize pointer_size) {
+    if (!IsHashed(pointer_size)) {
+      return;
+    }
+    const size_t capacity_entries = GetHashCapacityEntries(pointer_size);
+    const size_t mask = HashMask(capacity_entries);
+    const size_t buckets_start = HashIndexStart(pointer_size) + kMethodCount;
+    for (size_t i = 0, e = (mask + 1u + capacity_entries) * kMethodCount; i < e; ++i) {
+      SetMethod(buckets_start + i, pointer_size, nullptr);
+    }
+    for (size_t i = 0; i < capacity_entries; ++i) {
+      ArtMethod* interface_method = GetInterfaceMethod(i, pointer_size);
+      if (interface_method == nullptr) {
+        break;
+      }
+      size_t index = buckets_start + Bucket(interface_method, pointer_size) * kMethodCount;
+      while (GetMethod(index + kMethodInterface, pointer_size) != nullptr) {
+        index += kMethodCount;
+      }
+      SetMethod(index + kMethodInterface, pointer_size, interface_method);
+      SetMethod(index + kMethodImplementation,
+                pointer_size,
+                GetImplementationMethod(i, pointer_size));
+    }
+  }
+
  private:
+  static size_t HashMask(size_t num_entries) {
+    // Keep the load factor at or below 1/2.
+    return RoundUpToPowerOfTwo(std::max<size_t>(2u * num_entries, 2u)) - 1u;
+  }
+
+  void InitializeHeader(size_t num_entries, PointerSize pointer_size, bool hashed) {
+    if (!hashed) {
+      // Make sure `IsHashed` is false, even if the table has no entry yet.
+      SetWord(kMethodInterface, pointer_size, 0u);
+      return;
+    }
+    SetWord(kMethodInterface, pointer_size, kHashedMarker);
+    // The hash index goes after the marker, the entries and the null terminator.
+    size_t hash_index_start = (1u + num_entries + 1u) * kMethodCount;
+    SetWord(kMethodImplementation,
+            pointer_size,
+            reinterpret_cast<uintptr_t>(AddressOfMethod(hash_index_start, pointer_size)));
+    SetWord(hash_index_start + kMethodInterface, pointer_size, HashMask(num_entries));
+    // Record the number of entries the index was sized for.
+    SetWord(hash_index_start + kMethodImplementation, pointer_size, num_entries);
+  }
+
+  // Index of the first word of the entry `index`.
+  size_t EntryIndex(size_t index, PointerSize pointer_size) const {
+    return (index + (IsHashed(pointer_size) ? 1u : 0u)) * kMethodCount;
+  }
+
+  // Index of the first word of the hash index.
+  size_t HashIndexStart(PointerSize pointer_size) const {
+    DCHECK(IsHashed(pointer_size));
+    uintptr_t hash_index = GetWord(kMethodImplementation, pointer_size);
+    return (hash_index - reinterpret_cast<uintptr_t>(this)) / static_cast<size_t>(pointer_size);
+  }
+
+  // The number of entries the hash index was sized for.
+  size_t GetHashCapacityEntries(PointerSize pointer_size) const {
+    return GetWord(HashIndexStart(pointer_size) + kMethodImplementation, pointer_size);
+  }
+
+  size_t Bucket(ArtMethod* interface_method, PointerSize pointer_size) const {
+    size_t mask = GetWord(HashIndexStart(pointer_size) + kMethodInterface, pointer_size);
+    return (reinterpret_cast<uintptr_t>(interface_method) >> kHashShift) & mask;
+  }
+
   void** AddressOfMethod(size_t index, PointerSize pointer_size) {
     if (pointer_size == PointerSize::k64) {
       return reinterpret_cast<void**>(&data64_[index]);
@@ -201,6 +330,22 @@ class ImtConflictTable {
     }
   }
 
+  size_t GetWord(size_t index, PointerSize pointer_size) const {
+    if (pointer_size == PointerSize::k64) {
+      return dchecked_integral_cast<size_t>(data64_[index]);
+    } else {
+      return data32_[index];
+    }
+  }
+
+  void SetWord(size_t index, PointerSize pointer_size, size_t value) {
+    if (pointer_size == PointerSize::k64) {
+      data64_[index] = value;
+    } else {
+      data32_[index] = dchecked_integral_cast<uint32_t>(value);
+    }
+  }
+
   // Array of entries that the assembly stubs will iterate over. Note that this is
   // not fixed size, and we allocate data prior to calling the constructor
   // of ImtConflictTable.
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "imt_conflict_table.h"
+
+#include <vector>
+
+#include "base/common_art_test.h"
+
+namespace art HIDDEN {
+
+class ImtConflictTableTest : public CommonArtTest {
+ protected:
+  static ArtMethod* FakeMethod(size_t index) {
+    // Spaced like methods in an ArtMethod array.
+    return reinterpret_cast<ArtMethod*>(0x10000u + index * 40u);
+  }
+
+  static ArtMethod* FakeImplementation(size_t index) {
+    return reinterpret_cast<ArtMethod*>(0x80000u + index * 40u);
+  }
+
+  ImtConflictTable* Allocate(size_t size) {
+    storage_.emplace_back(RoundUp(size, sizeof(uint64_t)) / sizeof(uint64_t), 0u);
+    return reinterpret_cast<ImtConflictTable*>(storage_.back().data());
+  }
+
+  // Grow a table one entry at a time, like `ClassLinker::AddMethodToConflictTable`.
+  ImtConflictTable* CreateTable(size_t num_entries) {
+    ImtConflictTable* table =
+        new (Allocate(ImtConflictTable::ComputeSize(0u, kRuntimePointerSize)))
+            ImtConflictTable(0u, kRuntimePointerSize);
+    for (size_t i = 0; i < num_entries; ++i) {
+      bool hashed = (i + 1u) >= ImtConflictTable::kHashedLookupThreshold;
+      size_t size =
+          ImtConflictTable::ComputeSizeWithOneMoreEntry(table, kRuntimePointerSize, hashed);
+      table = new (Allocate(size)) ImtConflictTable(
+          table, FakeMethod(i), FakeImplementation(i), kRuntimePointerSize, hashed);
+      EXPECT_EQ(size, table->ComputeSize(kRuntimePointerSize));
+    }
+    return table;
+  }
+
+  std::vector<std::vector<uint64_t>> storage_;
+};
+
+TEST_F(ImtConflictTableTest, Linear) {
+  ImtConflictTable* table = CreateTable(ImtConflictTable::kHashedLookupThreshold - 1u);
+  EXPECT_FALSE(table->IsHashed(kRuntimePointerSize));
+  EXPECT_EQ(ImtConflictTable::kHashedLookupThreshold - 1u,
+            table->NumEntries(kRuntimePointerSize));
+  for (size_t i = 0; i < ImtConflictTable::kHashedLookupThreshold - 1u; ++i) {
+    EXPECT_EQ(FakeImplementation(i), table->Lookup(FakeMethod(i), kRuntimePointerSize));
+  }
+  EXPECT_EQ(nullptr, table->Lookup(FakeMethod(100u), kRuntimePointerSize));
+}
+
+TEST_F(ImtConflictTableTest, Hashed) {
+  for (size_t num_entries : {8u, 32u, 128u}) {
+    ImtConflictTable* table = CreateTable(num_entries);
+    EXPECT_TRUE(table->IsHashed(kRuntimePointerSize));
+    EXPECT_EQ(num_entries, table->NumEntries(kRuntimePointerSize));
+    for (size_t i = 0; i < num_entries; ++i) {
+      EXPECT_EQ(FakeMethod(i), table->GetInterfaceMethod(i, kRuntimePointerSize));
+      EXPECT_EQ(FakeImplementation(i), table->GetImplementationMethod(i, kRuntimePointerSize));
+      EXPECT_EQ(FakeImplementation(i), table->Lookup(FakeMethod(i), kRuntimePointerSize));
+    }
+    EXPECT_EQ(nullptr, table->Lookup(FakeMethod(num_entries), kRuntimePointerSize));
+  }
+}
+
+TEST_F(ImtConflictTableTest, FillThenIndex) {
+  // Like `ClassLinker::FillIMTAndConflictTables`, the capacity can exceed the number of entries.
+  static constexpr size_t kCapacity = 20u;
+  static constexpr size_t kNumEntries = 12u;
+  ImtConflictTable* table = new (Allocate(
+      ImtConflictTable::ComputeSize(kCapacity, kRuntimePointerSize, /*hashed=*/ true)))
+          ImtConflictTable(kCapacity, kRuntimePointerSize, /*hashed=*/ true);
+  for (size_t i = 0; i < kNumEntries; ++i) {
+    size_t index = table->NumEntries(kRuntimePointerSize);
+    table->SetInterfaceMethod(index, kRuntimePointerSize, FakeMethod(i));
+    table->SetImplementationMethod(index, kRuntimePointerSize, FakeImplementation(i));
+  }
+  table->UpdateHashIndex(kRuntimePointerSize);
+  EXPECT_EQ(kNumEntries, table->NumEntries(kRuntimePointerSize));
+  for (size_t i = 0; i < kNumEntries; ++i) {
+    EXPECT_EQ(FakeImplementation(i), table->Lookup(FakeMethod(i), kRuntimePointerSize));
+  }
+  EXPECT_EQ(nullptr, table->Lookup(FakeMethod(kNumEntries), kRuntimePointerSize));
+}
+
+TEST_F(ImtConflictTableTest, VisitUpdatesIndex) {
+  ImtConflictTable* table = CreateTable(16u);
+  table->Visit([&](const std::pair<ArtMethod*, ArtMethod*>& entry) {
+    return (entry.first == FakeMethod(3u))
+        ? std::make_pair(FakeMethod(50u), FakeImplementation(50u))
+        : entry;
+  }, kRuntimePointerSize);
+  EXPECT_EQ(nullptr, table->Lookup(FakeMethod(3u), kRuntimePointerSize));
+  EXPECT_EQ(FakeImplementation(50u), table->Lookup(FakeMethod(50u), kRuntimePointerSize));
+  EXPECT_EQ(FakeImplementation(4u), table->Lookup(FakeMethod(4u), kRuntimePointerSize));
+}
+
+}  // namespace art
@@ -18,6 +18,9 @@
 
 #include <dlfcn.h>
 #include <sys/resource.h>
+#include <unistd.h>
+
+#include <cmath>
 
 #include "art_method-inl.h"
 #include "base/file_utils.h"
@@ -39,6 +42,7 @@
 #include "jit-inl.h"
 #include "jit_code_cache.h"
 #include "jit_create.h"
+#include "jit_warm_cache.h"
 #include "jni/java_vm_ext.h"
 #include "mirror/method_handle_impl.h"
 #include "mirror/var_handle.h"
@@ -70,6 +74,7 @@ JitCompilerInterface* Jit::jit_compiler_ = nullptr;
 void Jit::DumpInfo(std::ostream& os) {
   code_cache_->Dump(os);
   cumulative_timings_.Dump(os);
+  compile_report_.Dump(os);
   MutexLock mu(Thread::Current(), lock_);
   memory_use_.PrintMemoryUse(os);
 }
@@ -126,6 +131,17 @@ std::unique_ptr<Jit> Jit::Create(JitCodeCache* code_cache, JitOptions* options)
     }
   }
 
+  if (!options->GetWarmCachePath().empty()) {
+    if (Runtime::Current()->IsZygote()) {
+      LOG(WARNING) << "Ignoring -Xjitwarmcache in the zygote";
+    } else {
+      // Methods compiled against another boot class path may no longer be hot or even exist.
+      std::string key = std::string(GetInstructionSetString(kRuntimeISA)) + ":" +
+          Runtime::Current()->GetBootClassPathChecksums();
+      jit->warm_cache_ = JitWarmCache::Create(options->GetWarmCachePath(), key);
+    }
+  }
+
   // Notify native debugger about the classes already loaded before the creation of the jit.
   jit->DumpTypeInfoForLoadedTypes(Runtime::Current()->GetClassLinker());
 
@@ -231,6 +247,14 @@ bool Jit::CompileMethodInternal(ArtMethod* method,
     VLOG(jit) << "Failed to compile method "
               << ArtMethod::PrettyMethod(method_to_compile)
               << " kind=" << compilation_kind;
+  } else if (warm_cache_ != nullptr &&
+             compilation_kind == CompilationKind::kOptimized &&
+             !method_to_compile->GetDeclaringClass()->IsBootStrapClassLoaded()) {
+    // Boot class path methods are not looked up in the cache, see RegisterDexFiles.
+    const DexFile* dex_file = method_to_compile->GetDexFile();
+    warm_cache_->AddMethod(dex_file->GetLocation(),
+                           dex_file->GetLocationChecksum(),
+                           method_to_compile->GetDexMethodIndex());
   }
   if (kIsDebugBuild) {
     if (self->IsExceptionPending()) {
@@ -306,6 +330,9 @@ Jit::~Jit() {
     Runtime::Current()->DumpDeoptimizations(LOG_STREAM(INFO));
   }
   DeleteThreadPool();
+  if (warm_cache_ != nullptr) {
+    warm_cache_->MaybeSave(/*force=*/ true);
+  }
   if (jit_compiler_ != nullptr) {
     delete jit_compiler_;
     jit_compiler_ = nullptr;
@@ -677,6 +704,11 @@ class JitCompileTask final : public Task {
       }
     }
     ProfileSaver::NotifyJitActivity();
+    // Write the warm cache outside of the mutator lock.
+    JitWarmCache* warm_cache = Runtime::Current()->GetJit()->warm_cache_.get();
+    if (warm_cache != nullptr) {
+      warm_cache->MaybeSave(/*force=*/ false);
+    }
   }
 
   void Finalize() override {
@@ -743,6 +775,49 @@ static bool IsAddressKnownBackedByFileOrShared(const void* addr) {
   return (flags & (1LL << 61)) != 0;
 }
 
+// Prime the methods the JIT warm cache recorded for newly loaded dex files.
+class JitWarmCacheTask final : public Task {
+ public:
+  JitWarmCacheTask(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+                   jobject class_loader) {
+    ScopedObjectAccess soa(Thread::Current());
+    StackHandleScope<1> hs(soa.Self());
+    Handle<mirror::ClassLoader> h_loader(hs.NewHandle(
+        soa.Decode<mirror::ClassLoader>(class_loader)));
+    ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+    for (const auto& dex_file : dex_files) {
+      dex_files_.push_back(dex_file.get());
+      // Register the dex file so that we can guarantee it doesn't get deleted
+      // while reading it during the task.
+      class_linker->RegisterDexFile(*dex_file.get(), h_loader.Get());
+    }
+    class_loader_ = soa.Vm()->AddGlobalRef(soa.Self(), h_loader.Get());
+  }
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    StackHandleScope<1> hs(self);
+    Handle<mirror::ClassLoader> loader = hs.NewHandle<mirror::ClassLoader>(
+        soa.Decode<mirror::ClassLoader>(class_loader_));
+    Runtime::Current()->GetJit()->PrimeMethodsFromWarmCache(self, dex_files_, loader);
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+  ~JitWarmCacheTask() {
+    ScopedObjectAccess soa(Thread::Current());
+    soa.Vm()->DeleteGlobalRef(soa.Self(), class_loader_);
+  }
+
+ private:
+  std::vector<const DexFile*> dex_files_;
+  jobject class_loader_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitWarmCacheTask);
+};
+
 /**
  * A JIT task to run after all profile compilation is done.
  */
@@ -1086,7 +1161,11 @@ void Jit::CreateThreadPool() {
   // There is a DCHECK in the 'AddSamples' method to ensure the tread pool
   // is not null when we instrument.
 
-  thread_pool_.reset(JitThreadPool::Create("Jit thread pool", 1));
+  size_t max_threads = options_->GetThreadPoolMaxThreads();
+  thread_pool_.reset(JitThreadPool::Create("Jit thread pool", max_threads));
+  if (max_threads > 1u) {
+    thread_pool_->EnableAdaptiveSizing();
+  }
 
   Runtime* runtime = Runtime::Current();
   thread_pool_->SetPthreadPriority(
@@ -1194,6 +1273,9 @@ void Jit::RegisterDexFiles(const std::vector<std::unique_ptr<const DexFile>>& de
     return;
   }
   Runtime* runtime = Runtime::Current();
+  if (warm_cache_ != nullptr && UseJitCompilation() && !runtime->IsJavaDebuggable()) {
+    thread_pool_->AddTask(Thread::Current(), new JitWarmCacheTask(dex_files, class_loader));
+  }
   // If the runtime is debuggable, don't bother precompiling methods.
   // If system server is being profiled, don't precompile as we are going to use
   // the JIT to count hotness. Note that --count-hotness-in-compiled-code is
@@ -1309,6 +1391,48 @@ uint32_t Jit::CompileMethodsFromBootProfile(
   return added_to_queue;
 }
 
+uint32_t Jit::PrimeMethodsFromWarmCache(Thread* self,
+                                        const std::vector<const DexFile*>& dex_files,
+                                        Handle<mirror::ClassLoader> class_loader) {
+  DCHECK(warm_cache_ != nullptr);
+  StackHandleScope<1> hs(self);
+  MutableHandle<mirror::DexCache> dex_cache = hs.NewHandle<mirror::DexCache>(nullptr);
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  uint32_t primed = 0u;
+  for (const DexFile* dex_file : dex_files) {
+    std::vector<uint32_t> methods =
+        warm_cache_->GetMethods(dex_file->GetLocation(), dex_file->GetLocationChecksum());
+    if (methods.empty()) {
+      continue;
+    }
+    dex_cache.Assign(class_linker->FindDexCache(self, *dex_file));
+    CHECK(dex_cache != nullptr) << "Could not find dex cache for " << dex_file->GetLocation();
+    for (uint32_t method_idx : methods) {
+      if (method_idx >= dex_file->NumMethodIds()) {
+        continue;
+      }
+      ArtMethod* method = class_linker->ResolveMethodWithoutInvokeType(
+          method_idx, dex_cache, class_loader);
+      if (method == nullptr) {
+        self->ClearException();
+        continue;
+      }
+      if (method->IsAbstract() ||
+          !method->IsInvokable() ||
+          method->IsMemorySharedMethod() ||
+          IgnoreSamplesForMethod(method)) {
+        continue;
+      }
+      // The class is most likely not initialized yet, so the method cannot be compiled now.
+      // Instead, request its compilation the first time it runs.
+      method->SetHotCounter();
+      ++primed;
+    }
+  }
+  VLOG(jit) << "Marked " << primed << " methods from the JIT warm cache as hot";
+  return primed;
+}
+
 uint32_t Jit::CompileMethodsFromProfile(
     Thread* self,
     const std::vector<const DexFile*>& dex_files,
@@ -1410,6 +1534,20 @@ void Jit::EnqueueOptimizedCompilation(ArtMethod* method, Thread* self) {
     return;
   }
 
+  // Methods whose optimized code kept deoptimizing stay in baseline code.
+  uint32_t max_reoptimizations = options_->GetMaxReoptimizations();
+  if (max_reoptimizations != 0u &&
+      GetCodeCache()->GetReoptimizationCount(method, self) > max_reoptimizations) {
+    return;
+  }
+
+  // Methods whose optimized compilation went over the compile time budget stay in baseline
+  // code, rather than being recompiled on every hotness trigger.
+  if (GetCodeCache()->GetAbandonedCompilationCount(method, self) >=
+          kJitMaxAbandonedCompilations) {
+    return;
+  }
+
   // We arrive here after a baseline compiled code has reached its baseline
   // hotness threshold. If we're not only using the baseline compiler, enqueue a compilation
   // task that will compile optimize the method.
@@ -1418,6 +1556,73 @@ void Jit::EnqueueOptimizedCompilation(ArtMethod* method, Thread* self) {
   }
 }
 
+void Jit::NotifyDeoptimization(ArtMethod* method,
+                               const OatQuickMethodHeader* header,
+                               DeoptimizationKind kind,
+                               bool megamorphic,
+                               Thread* self) {
+  uint32_t max_reoptimizations = options_->GetMaxReoptimizations();
+  if (max_reoptimizations == 0u || thread_pool_ == nullptr) {
+    return;
+  }
+  // Only optimized JIT code speculates on the profile.
+  if (header == nullptr ||
+      !GetCodeCache()->ContainsPc(header->GetCode()) ||
+      CodeInfo::IsBaseline(header->GetOptimizedCodeInfoPtr())) {
+    return;
+  }
+
+  // A single deoptimization can be a one-off, for example a type only seen during startup, so
+  // only re-optimize right away when the optimized code keeps deoptimizing.
+  uint16_t count = GetCodeCache()->RecordDeoptimization(
+      method, kJitDeoptimizationsBeforeReoptimization, self);
+  if (count == 0u) {
+    // Not deoptimized often enough yet, or no profiling info: the method will get compiled
+    // again once hot.
+    return;
+  }
+  metrics::ArtMetrics* metrics = GetMetrics();
+  if (count > max_reoptimizations) {
+    if (count == max_reoptimizations + 1u) {
+      VLOG(jit) << "Keeping " << method->PrettyMethod() << " in baseline code after "
+                << max_reoptimizations << " re-optimizations";
+      metrics->JitReoptimizationCapReached()->AddOne();
+    }
+    return;
+  }
+
+  if (megamorphic) {
+    metrics->JitReoptimizationMegamorphic()->AddOne();
+  } else {
+    switch (kind) {
+      case DeoptimizationKind::kJitInlineCache:
+      case DeoptimizationKind::kJitSameTarget:
+        metrics->JitReoptimizationInlineCache()->AddOne();
+        break;
+      case DeoptimizationKind::kLoopBoundsBCE:
+      case DeoptimizationKind::kLoopNullBCE:
+      case DeoptimizationKind::kBlockBCE:
+        metrics->JitReoptimizationBoundsCheck()->AddOne();
+        break;
+      default:
+        metrics->JitReoptimizationOther()->AddOne();
+        break;
+    }
+  }
+  VLOG(jit) << "Re-optimizing " << method->PrettyMethod() << " (" << count << "/"
+            << max_reoptimizations << ") after deoptimization: " << GetDeoptimizationKindName(kind)
+            << (megamorphic ? ", megamorphic inline cache" : "");
+
+  // The profiling info is kept, so baseline code resumes collecting inline caches and
+  // branches on top of what led to the previous optimized code, and enqueues the optimized
+  // compilation once hot.
+  if (GetCodeCache()->CanAllocateProfilingInfo()) {
+    AddCompileTask(self, method, CompilationKind::kBaseline);
+  } else {
+    AddCompileTask(self, method, CompilationKind::kOptimized);
+  }
+}
+
 class ScopedSetRuntimeThread {
  public:
   explicit ScopedSetRuntimeThread(Thread* self)
@@ -1806,29 +2011,35 @@ void JitThreadPool::AddTask(Thread* self, ArtMethod* method, CompilationKind kin
   if (!started_) {
     return;
   }
+  std::set<ArtMethod*>* enqueued_methods = nullptr;
+  MethodQueue* queue = nullptr;
   switch (kind) {
     case CompilationKind::kOsr:
-      if (ContainsElement(osr_enqueued_methods_, method)) {
-        return;
-      }
-      osr_enqueued_methods_.insert(method);
-      osr_queue_.push_back(method);
+      enqueued_methods = &osr_enqueued_methods_;
+      queue = &osr_queue_;
       break;
     case CompilationKind::kBaseline:
-      if (ContainsElement(baseline_enqueued_methods_, method)) {
-        return;
-      }
-      baseline_enqueued_methods_.insert(method);
-      baseline_queue_.push_back(method);
+      enqueued_methods = &baseline_enqueued_methods_;
+      queue = &baseline_queue_;
       break;
     case CompilationKind::kOptimized:
-      if (ContainsElement(optimized_enqueued_methods_, method)) {
-        return;
-      }
-      optimized_enqueued_methods_.insert(method);
-      optimized_queue_.push_back(method);
+      enqueued_methods = &optimized_enqueued_methods_;
+      queue = &optimized_queue_;
       break;
   }
+  uint64_t now_ns = NanoTime();
+  if (ContainsElement(*enqueued_methods, method)) {
+    // The method is either waiting or being compiled. If it is waiting, the new request
+    // makes it hotter.
+    auto it = queue->find(method);
+    if (it != queue->end()) {
+      AddRequest(&it->second, now_ns);
+    }
+    return;
+  }
+  enqueued_methods->insert(method);
+  queue->emplace(method, QueuedMethod{now_ns, now_ns, 1.0});
+  MaybeResizeLocked(self);
   // If we have any waiters, signal one.
   if (waiting_count_ != 0) {
     task_queue_condition_.Signal(self);
@@ -1855,18 +2066,138 @@ Task* JitThreadPool::TryGetTaskLocked() {
       task = FetchFrom(optimized_queue_, CompilationKind::kOptimized);
     }
   }
+  // Give back the workers that the remaining tasks don't need.
+  MaybeResizeLocked(Thread::Current());
   return task;
 }
 
-Task* JitThreadPool::FetchFrom(std::deque<ArtMethod*>& methods, CompilationKind kind) {
-  if (!methods.empty()) {
-    ArtMethod* method = methods.front();
-    methods.pop_front();
-    JitCompileTask* task = new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, kind);
-    current_compilations_.insert(task);
-    return task;
+void JitThreadPool::EnableAdaptiveSizing() {
+  Thread* self = Thread::Current();
+  MutexLock mu(self, task_queue_lock_);
+  adaptive_sizing_ = true;
+  last_resize_time_ns_ = NanoTime();
+  last_resize_process_cpu_time_ns_ = ProcessCpuNanoTime();
+  SetMaxActiveWorkersLocked(self, 1u);
+}
+
+void JitThreadPool::MaybeResizeLocked(Thread* self) {
+  if (!adaptive_sizing_) {
+    return;
   }
-  return nullptr;
+  uint64_t now_ns = NanoTime();
+  if (now_ns - last_resize_time_ns_ < kAdaptiveSizingIntervalNs) {
+    return;
+  }
+  uint64_t process_cpu_time_ns = ProcessCpuNanoTime();
+  // The number of CPUs the process kept busy since the last decision, JIT threads included.
+  double busy_cpus = static_cast<double>(process_cpu_time_ns - last_resize_process_cpu_time_ns_) /
+      static_cast<double>(now_ns - last_resize_time_ns_);
+  last_resize_time_ns_ = now_ns;
+  last_resize_process_cpu_time_ns_ = process_cpu_time_ns;
+
+  size_t pending = generic_queue_.size() +
+      osr_queue_.size() +
+      baseline_queue_.size() +
+      optimized_queue_.size();
+  size_t current = max_active_workers_;
+  size_t wanted = std::clamp<size_t>(RoundUp(pending, kTasksPerActiveWorker) /
+                                         kTasksPerActiveWorker,
+                                     1u,
+                                     num_threads_);
+  if (wanted > current) {
+    // Only take CPUs the process leaves idle, so that compiling does not slow down the app.
+    static const size_t num_cpus = static_cast<size_t>(sysconf(_SC_NPROCESSORS_ONLN));
+    double idle_cpus = static_cast<double>(num_cpus) - busy_cpus;
+    size_t extra = idle_cpus >= 1.0 ? static_cast<size_t>(idle_cpus) : 0u;
+    wanted = std::min(wanted, current + extra);
+  }
+  metrics::ArtMetrics* metrics = GetMetrics();
+  if (wanted != current) {
+    VLOG(jit) << "Adjusting active JIT workers from " << current << " to " << wanted
+              << ", " << pending << " pending tasks, " << busy_cpus << " busy CPUs";
+    if (wanted > current) {
+      metrics->JitThreadPoolGrowCount()->AddOne();
+    } else {
+      metrics->JitThreadPoolShrinkCount()->AddOne();
+    }
+    SetMaxActiveWorkersLocked(self, wanted);
+  }
+  metrics->JitActiveWorkersAvg()->Add(wanted);
+}
+
+void JitThreadPool::AddRequest(QueuedMethod* queued, uint64_t now_ns) {
+  queued->requests = queued->requests *
+      exp2(-static_cast<double>(now_ns - queued->last_request_time_ns) / kRequestHalfLifeNs) +
+      1.0;
+  queued->last_request_time_ns = now_ns;
+}
+
+double JitThreadPool::GetRequestPriority(const QueuedMethod& queued, uint64_t now_ns) {
+  double decayed_requests = queued.requests *
+      exp2(-static_cast<double>(now_ns - queued.last_request_time_ns) / kRequestHalfLifeNs);
+  return decayed_requests + static_cast<double>(now_ns - queued.enqueue_time_ns) / kAgingPeriodNs;
+}
+
+double JitThreadPool::GetPriority(ArtMethod* method,
+                                  const QueuedMethod& queued,
+                                  CompilationKind kind,
+                                  uint64_t now_ns) {
+  double priority = GetRequestPriority(queued, now_ns);
+  // The interpreter and nterp keep counting down the method's hotness counter from the warmup
+  // threshold it was reset to when requesting the compilation, so count the samples taken since
+  // the last request as a fraction of a request. Compiled code counts in its ProfilingInfo
+  // instead, and only shows up as new requests.
+  uint16_t warmup_threshold = Runtime::Current()->GetJITOptions()->GetWarmupThreshold();
+  if (kind != CompilationKind::kOptimized &&
+      warmup_threshold != 0u &&
+      !method->IsMemorySharedMethod()) {
+    uint16_t counter = method->GetCounter();
+    if (counter <= warmup_threshold) {
+      priority += static_cast<double>(warmup_threshold - counter) / warmup_threshold;
+    }
+  }
+  return priority;
+}
+
+Task* JitThreadPool::FetchFrom(MethodQueue& methods, CompilationKind kind) {
+  if (methods.empty()) {
+    return nullptr;
+  }
+  // The queues only hold methods that crossed a hotness threshold. They can still reach a few
+  // hundred methods during startup, which is what makes adaptive sizing add workers (one per
+  // kTasksPerActiveWorker queued tasks), but a linear scan of that many entries remains cheap
+  // compared to the compilation that follows.
+  uint64_t now_ns = NanoTime();
+  auto best = methods.end();
+  double best_priority = 0.0;
+  for (auto it = methods.begin(); it != methods.end(); ++it) {
+    double priority = GetPriority(it->first, it->second, kind, now_ns);
+    if (best == methods.end() ||
+        priority > best_priority ||
+        (priority == best_priority &&
+         it->second.enqueue_time_ns < best->second.enqueue_time_ns)) {
+      best = it;
+      best_priority = priority;
+    }
+  }
+  ArtMethod* method = best->first;
+  uint64_t wait_time_us = NsToUs(now_ns - best->second.enqueue_time_ns);
+  methods.erase(best);
+  metrics::ArtMetrics* metrics = GetMetrics();
+  switch (kind) {
+    case CompilationKind::kOsr:
+      metrics->JitOsrQueueWaitTime()->Add(wait_time_us);
+      break;
+    case CompilationKind::kBaseline:
+      metrics->JitBaselineQueueWaitTime()->Add(wait_time_us);
+      break;
+    case CompilationKind::kOptimized:
+      metrics->JitOptimizedQueueWaitTime()->Add(wait_time_us);
+      break;
+  }
+  JitCompileTask* task = new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, kind);
+  current_compilations_.insert(task);
+  return task;
 }
 
 void JitThreadPool::Remove(JitCompileTask* task) {
@@ -1909,9 +2240,11 @@ void JitThreadPool::VisitRoots(RootVisitor* visitor) {
     // - Generic tasks like `ZygoteVerificationTask` which don't hold any root.
     // - `JitCompileTask` for precompiled methods, which we know are live, being
     //   part of the boot classpath or system server classpath.
-    methods.insert(methods.end(), osr_queue_.begin(), osr_queue_.end());
-    methods.insert(methods.end(), baseline_queue_.begin(), baseline_queue_.end());
-    methods.insert(methods.end(), optimized_queue_.begin(), optimized_queue_.end());
+    for (const MethodQueue* queue : {&osr_queue_, &baseline_queue_, &optimized_queue_}) {
+      for (const auto& entry : *queue) {
+        methods.push_back(entry.first);
+      }
+    }
     for (JitCompileTask* task : current_compilations_) {
       methods.push_back(task->GetArtMethod());
     }
@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_JIT_JIT_H_
 #define ART_RUNTIME_JIT_JIT_H_
 
+#include <unordered_map>
 #include <unordered_set>
 
 #include <android-base/unique_fd.h>
@@ -24,12 +25,15 @@
 #include "base/histogram-inl.h"
 #include "base/macros.h"
 #include "base/mutex.h"
+#include "base/time_utils.h"
 #include "base/timing_logger.h"
 #include "compilation_kind.h"
+#include "deoptimization_kind.h"
 #include "handle.h"
 #include "offsets.h"
 #include "interpreter/mterp/nterp.h"
 #include "jit/debugger_interface.h"
+#include "jit/jit_compile_report.h"
 #include "jit_options.h"
 #include "obj_ptr.h"
 #include "thread_pool.h"
@@ -40,6 +44,7 @@ class ArtMethod;
 class ClassLinker;
 class DexFile;
 class OatDexFile;
+class OatQuickMethodHeader;
 class RootVisitor;
 struct RuntimeArgumentMap;
 union JValue;
@@ -58,6 +63,7 @@ class JitCodeCache;
 class JitCompileTask;
 class JitMemoryRegion;
 class JitOptions;
+class JitWarmCache;
 
 static constexpr int16_t kJitCheckForOSR = -1;
 static constexpr int16_t kJitHotnessDisabled = -2;
@@ -131,12 +137,18 @@ class JitThreadPool : public AbstractThreadPool {
   // Remove the task from the list of compiling tasks.
   void Remove(JitCompileTask* task) REQUIRES(!task_queue_lock_);
 
-  // Add a custom compilation task in the right queue.
+  // Add a custom compilation task in the right queue. If the method is already waiting in that
+  // queue, this counts as another request and makes it hotter.
   void AddTask(Thread* self, ArtMethod* method, CompilationKind kind) REQUIRES(!task_queue_lock_);
 
   // Visit the ArtMethods stored in the various queues.
   void VisitRoots(RootVisitor* visitor);
 
+  // Start with one active worker, and from then on grow and shrink the number of active
+  // workers, up to the number of threads of the pool, following the queue depth and the idle
+  // CPUs of the process.
+  void EnableAdaptiveSizing() REQUIRES(!task_queue_lock_);
+
  protected:
   Task* TryGetTaskLocked() REQUIRES(task_queue_lock_) override;
 
@@ -155,14 +167,59 @@ class JitThreadPool : public AbstractThreadPool {
       // We need peers as we may report the JIT thread, e.g., in the debugger.
       : AbstractThreadPool(name, num_threads, /* create_peers= */ true, worker_stack_size) {}
 
-  // Try to fetch an entry from `methods`. Return null if `methods` is empty.
-  Task* FetchFrom(std::deque<ArtMethod*>& methods, CompilationKind kind) REQUIRES(task_queue_lock_);
+  // A method waiting in one of the compilation queues.
+  struct QueuedMethod {
+    // When the method was added to the queue.
+    uint64_t enqueue_time_ns;
+    // When the method was last requested to be compiled, and the number of requests
+    // so far, halved every kRequestHalfLifeNs.
+    uint64_t last_request_time_ns;
+    double requests;
+  };
+  using MethodQueue = std::unordered_map<ArtMethod*, QueuedMethod>;
+
+  // Requests made this long ago count half as much as new ones, so that a method that was hot
+  // once does not keep precedence over the methods that are hot now.
+  static constexpr uint64_t kRequestHalfLifeNs = MsToNs(1000);
+  // A method waiting for that long gets the priority of one more request, so that lukewarm
+  // methods still get compiled eventually.
+  static constexpr uint64_t kAgingPeriodNs = MsToNs(200);
+
+  // Count one more compilation request for `queued`, made at `now_ns`.
+  static void AddRequest(QueuedMethod* queued, uint64_t now_ns);
+
+  // Return the part of the priority of `queued` that comes from its decayed compilation requests
+  // and from the time it has been waiting.
+  static double GetRequestPriority(const QueuedMethod& queued, uint64_t now_ns);
+
+  // Return the priority of `method` in the queue of `kind`. Higher is compiled first.
+  static double GetPriority(ArtMethod* method,
+                            const QueuedMethod& queued,
+                            CompilationKind kind,
+                            uint64_t now_ns);
+
+  // Try to fetch the entry with the highest priority from `methods`. Return null if `methods`
+  // is empty.
+  Task* FetchFrom(MethodQueue& methods, CompilationKind kind) REQUIRES(task_queue_lock_);
+
+  // With adaptive sizing, adjust the number of active workers, at most every
+  // kAdaptiveSizingIntervalNs.
+  void MaybeResizeLocked(Thread* self) REQUIRES(task_queue_lock_);
+
+  // Queued tasks per active worker that adaptive sizing aims for.
+  static constexpr size_t kTasksPerActiveWorker = 16;
+  static constexpr uint64_t kAdaptiveSizingIntervalNs = MsToNs(50);
+
+  bool adaptive_sizing_ GUARDED_BY(task_queue_lock_) = false;
+  // Time and process CPU time of the last adaptive sizing decision.
+  uint64_t last_resize_time_ns_ GUARDED_BY(task_queue_lock_) = 0u;
+  uint64_t last_resize_process_cpu_time_ns_ GUARDED_BY(task_queue_lock_) = 0u;
 
   std::deque<Task*> generic_queue_ GUARDED_BY(task_queue_lock_);
 
-  std::deque<ArtMethod*> osr_queue_ GUARDED_BY(task_queue_lock_);
-  std::deque<ArtMethod*> baseline_queue_ GUARDED_BY(task_queue_lock_);
-  std::deque<ArtMethod*> optimized_queue_ GUARDED_BY(task_queue_lock_);
+  MethodQueue osr_queue_ GUARDED_BY(task_queue_lock_);
+  MethodQueue baseline_queue_ GUARDED_BY(task_queue_lock_);
+  MethodQueue optimized_queue_ GUARDED_BY(task_queue_lock_);
 
   // We track the methods that are currently enqueued to avoid
   // adding them to the queue multiple times, which could bloat the
@@ -175,6 +232,8 @@ class JitThreadPool : public AbstractThreadPool {
   // will be removed when JitCompileTask->Finalize is called.
   std::unordered_set<JitCompileTask*> current_compilations_ GUARDED_BY(task_queue_lock_);
 
+  friend class JitThreadPoolTest;
+
   DISALLOW_COPY_AND_ASSIGN(JitThreadPool);
 };
 
@@ -217,6 +276,11 @@ class Jit {
   // Add a timing logger to cumulative_timings_.
   void AddTimingLogger(const TimingLogger& logger);
 
+  // Compile time per method and per optimizing pass, filled in by the compiler.
+  JitCompileReport* GetCompileReport() {
+    return &compile_report_;
+  }
+
   void AddMemoryUsage(ArtMethod* method, size_t bytes)
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -362,6 +426,13 @@ class Jit {
                                          Handle<mirror::ClassLoader> class_loader,
                                          bool add_to_queue);
 
+  // Mark the methods recorded in the -Xjitwarmcache file for the given dex files as hot, so that
+  // they get compiled the first time they run. Return the number of methods marked.
+  uint32_t PrimeMethodsFromWarmCache(Thread* self,
+                                     const std::vector<const DexFile*>& dex_files,
+                                     Handle<mirror::ClassLoader> class_loader)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   // Register the dex files to the JIT. This is to perform any compilation/optimization
   // at the point of loading the dex files.
   void RegisterDexFiles(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
@@ -387,6 +458,18 @@ class Jit {
 
   EXPORT void EnqueueOptimizedCompilation(ArtMethod* method, Thread* self);
 
+  // Called after optimized code `header` of `method` deoptimized and got invalidated. Every
+  // kJitDeoptimizationsBeforeReoptimization such deoptimizations, and until the method reaches
+  // its re-optimization cap, compile it baseline again to collect fresh inline cache and branch
+  // data for the next optimized compilation. `megamorphic` tells whether the
+  // deoptimization made an inline cache megamorphic.
+  void NotifyDeoptimization(ArtMethod* method,
+                            const OatQuickMethodHeader* header,
+                            DeoptimizationKind kind,
+                            bool megamorphic,
+                            Thread* self)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   EXPORT void MaybeEnqueueCompilation(ArtMethod* method, Thread* self)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -439,6 +522,7 @@ class Jit {
 
   // Performance monitoring.
   CumulativeLogger cumulative_timings_;
+  JitCompileReport compile_report_;
   Histogram<uint64_t> memory_use_ GUARDED_BY(lock_);
   Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
@@ -466,6 +550,9 @@ class Jit {
   // between the zygote and apps.
   std::map<ArtMethod*, uint16_t> shared_method_counters_;
 
+  // The methods compiled by this and previous runs, if -Xjitwarmcache is set.
+  std::unique_ptr<JitWarmCache> warm_cache_;
+
   friend class art::jit::JitCompileTask;
 
   DISALLOW_COPY_AND_ASSIGN(Jit);
@@ -25,6 +25,7 @@
 #include "base/histogram-inl.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/membarrier.h"
+#include "base/metrics/metrics.h"
 #include "base/memfd.h"
 #include "base/mem_map.h"
 #include "base/pointer_size.h"
@@ -55,6 +56,7 @@
 #include "oat/oat_quick_method_header.h"
 #include "object_callbacks.h"
 #include "profile/profile_compilation_info.h"
+#include "runtime.h"
 #include "scoped_thread_state_change-inl.h"
 #include "stack.h"
 #include "thread-current-inl.h"
@@ -68,6 +70,16 @@ namespace jit {
 static constexpr size_t kCodeSizeLogThreshold = 50 * KB;
 static constexpr size_t kStackMapSizeLogThreshold = 50 * KB;
 
+// Number of unmarked code entries freed between releasing the JIT locks.
+static constexpr size_t kSweepBatchSize = 256;
+
+// Returns whether `ptr` was allocated by one of `allocs`.
+static bool IsInAnyOf(ArrayRef<const LinearAlloc* const> allocs, void* ptr) {
+  return std::any_of(allocs.begin(), allocs.end(), [ptr](const LinearAlloc* alloc) {
+    return alloc->ContainsUnsafe(ptr);
+  });
+}
+
 class JitCodeCache::JniStubKey {
  public:
   explicit JniStubKey(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_)
@@ -165,11 +177,12 @@ class JitCodeCache::JniStubData {
     return methods_;
   }
 
-  void RemoveMethodsIn(const LinearAlloc& alloc) REQUIRES_SHARED(Locks::mutator_lock_) {
+  void RemoveMethodsIn(ArrayRef<const LinearAlloc* const> allocs)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
     auto kept_end = std::partition(
         methods_.begin(),
         methods_.end(),
-        [&alloc](ArtMethod* method) { return !alloc.ContainsUnsafe(method); });
+        [allocs](ArtMethod* method) { return !IsInAnyOf(allocs, method); });
     for (auto it = kept_end; it != methods_.end(); it++) {
       VLOG(jit) << "JIT removed (JNI) " << (*it)->PrettyMethod() << ": " << code_;
     }
@@ -544,7 +557,7 @@ void JitCodeCache::FreeAllMethodHeaders(
   }
 }
 
-void JitCodeCache::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
+size_t JitCodeCache::RemoveMethodsIn(Thread* self, ArrayRef<const LinearAlloc* const> allocs) {
   ScopedTrace trace(__PRETTY_FUNCTION__);
   ScopedDebugDisallowReadBarriers sddrb(self);
   // We use a set to first collect all method_headers whose code need to be
@@ -557,9 +570,10 @@ void JitCodeCache::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
     WriterMutexLock mu2(self, *Locks::jit_mutator_lock_);
     // We do not check if a code cache GC is in progress, as this method comes
     // with the classlinker_classes_lock_ held, and suspending ourselves could
-    // lead to a deadlock.
+    // lead to a deadlock. For the same reason, the maps are swept in one go: releasing
+    // jit_lock_ in between would let a code cache GC start and wait for this thread.
     for (auto it = jni_stubs_map_.begin(); it != jni_stubs_map_.end();) {
-      it->second.RemoveMethodsIn(alloc);
+      it->second.RemoveMethodsIn(allocs);
       if (it->second.GetMethods().empty()) {
         method_headers.insert(OatQuickMethodHeader::FromCodePointer(it->second.GetCode()));
         it = jni_stubs_map_.erase(it);
@@ -569,27 +583,31 @@ void JitCodeCache::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
       }
     }
     for (auto it = zombie_jni_code_.begin(); it != zombie_jni_code_.end();) {
-      if (alloc.ContainsUnsafe(*it)) {
+      if (IsInAnyOf(allocs, *it)) {
         it = zombie_jni_code_.erase(it);
       } else {
         ++it;
       }
     }
     for (auto it = method_code_map_.begin(); it != method_code_map_.end();) {
-      if (alloc.ContainsUnsafe(it->second)) {
+      if (IsInAnyOf(allocs, it->second)) {
         method_headers.insert(OatQuickMethodHeader::FromCodePointer(it->first));
         VLOG(jit) << "JIT removed " << it->second->PrettyMethod() << ": " << it->first;
         zombie_code_.erase(it->first);
         processed_zombie_code_.erase(it->first);
         method_code_map_reversed_.erase(it->second);
         it = method_code_map_.erase(it);
+        code_index_.Invalidate();
       } else {
         ++it;
       }
     }
+    if (!code_index_.IsUpToDate()) {
+      RebuildCodeIndex();
+    }
     for (auto it = osr_code_map_.begin(); it != osr_code_map_.end();) {
       DCHECK(!ContainsElement(zombie_code_, it->second));
-      if (alloc.ContainsUnsafe(it->first)) {
+      if (IsInAnyOf(allocs, it->first)) {
         // Note that the code has already been pushed to method_headers in the loop
         // above and is going to be removed in FreeCode() below.
         it = osr_code_map_.erase(it);
@@ -600,16 +618,17 @@ void JitCodeCache::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
   }
 
   for (auto it = processed_zombie_jni_code_.begin(); it != processed_zombie_jni_code_.end();) {
-    if (alloc.ContainsUnsafe(*it)) {
+    if (IsInAnyOf(allocs, *it)) {
       it = processed_zombie_jni_code_.erase(it);
     } else {
       ++it;
     }
   }
 
+  const size_t used_memory_before = PrivateRegionUsedMemoryLocked();
   for (auto it = profiling_infos_.begin(); it != profiling_infos_.end();) {
     ProfilingInfo* info = it->second;
-    if (alloc.ContainsUnsafe(info->GetMethod())) {
+    if (IsInAnyOf(allocs, info->GetMethod())) {
       private_region_.FreeWritableData(reinterpret_cast<uint8_t*>(info));
       it = profiling_infos_.erase(it);
     } else {
@@ -617,6 +636,7 @@ void JitCodeCache::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
     }
   }
   FreeAllMethodHeaders(method_headers);
+  return used_memory_before - PrivateRegionUsedMemoryLocked();
 }
 
 bool JitCodeCache::IsWeakAccessEnabled(Thread* self) const {
@@ -789,6 +809,7 @@ bool JitCodeCache::Commit(Thread* self,
         ScopedDebugDisallowReadBarriers sddrb(self);
         WriterMutexLock mu2(self, *Locks::jit_mutator_lock_);
         method_code_map_.Put(code_ptr, method);
+        code_index_.Add(MakeCodeIndexEntry(code_ptr, method));
 
         // Searching for MethodType-s in roots. They need to be treated as strongly reachable while
         // the corresponding ArtMethod is not removed.
@@ -909,6 +930,9 @@ bool JitCodeCache::RemoveMethodLocked(ArtMethod* method, bool release_memory) {
         ++it;
       }
     }
+    if (in_cache) {
+      RebuildCodeIndex();
+    }
     method_code_map_reversed_.erase(method);
 
     auto osr_it = osr_code_map_.find(method);
@@ -950,11 +974,16 @@ void JitCodeCache::MoveObsoleteMethod(ArtMethod* old_method, ArtMethod* new_meth
   }
 
   // Update method_code_map_ to point to the new method.
+  bool moved = false;
   for (auto& it : method_code_map_) {
     if (it.second == old_method) {
       it.second = new_method;
+      moved = true;
     }
   }
+  if (moved) {
+    RebuildCodeIndex();
+  }
   // Update osr_code_map_ to point to the new method.
   auto code_map = osr_code_map_.find(old_method);
   if (code_map != osr_code_map_.end()) {
@@ -1013,6 +1042,10 @@ size_t JitCodeCache::DataCacheSizeLocked() {
   return GetCurrentRegion()->GetUsedMemoryForData();
 }
 
+size_t JitCodeCache::PrivateRegionUsedMemoryLocked() {
+  return private_region_.GetUsedMemoryForCode() + private_region_.GetUsedMemoryForData();
+}
+
 bool JitCodeCache::Reserve(Thread* self,
                            JitMemoryRegion* region,
                            size_t code_size,
@@ -1152,19 +1185,33 @@ void JitCodeCache::IncreaseCodeCacheCapacity(Thread* self) {
   private_region_.IncreaseCodeCacheCapacity();
 }
 
-void JitCodeCache::RemoveUnmarkedCode(Thread* self) {
+size_t JitCodeCache::RemoveUnmarkedCode(Thread* self) {
   ScopedTrace trace(__FUNCTION__);
-  std::unordered_set<OatQuickMethodHeader*> method_headers;
   ScopedDebugDisallowReadBarriers sddrb(self);
-  MutexLock mu(self, *Locks::jit_lock_);
-  // Iterate over all zombie code and remove entries that are not marked.
-  for (auto it = processed_zombie_code_.begin(); it != processed_zombie_code_.end();) {
-    const void* code_ptr = *it;
-    uintptr_t allocation = FromCodeToAllocation(code_ptr);
-    DCHECK(!IsInZygoteExecSpace(code_ptr));
-    if (GetLiveBitmap()->Test(allocation)) {
-      ++it;
-    } else {
+  std::vector<const void*> unmarked_code;
+  {
+    MutexLock mu(self, *Locks::jit_lock_);
+    // Collect the zombie code that hasn't been marked.
+    for (const void* code_ptr : processed_zombie_code_) {
+      DCHECK(!IsInZygoteExecSpace(code_ptr));
+      if (!GetLiveBitmap()->Test(FromCodeToAllocation(code_ptr))) {
+        unmarked_code.push_back(code_ptr);
+      }
+    }
+  }
+  // Free it in batches, letting mutators update inline caches and compiler threads commit code
+  // in between.
+  size_t freed_bytes = 0;
+  for (size_t begin = 0; begin < unmarked_code.size(); begin += kSweepBatchSize) {
+    const size_t end = std::min(begin + kSweepBatchSize, unmarked_code.size());
+    std::unordered_set<OatQuickMethodHeader*> method_headers;
+    MutexLock mu(self, *Locks::jit_lock_);
+    for (size_t i = begin; i != end; ++i) {
+      const void* code_ptr = unmarked_code[i];
+      if (processed_zombie_code_.erase(code_ptr) == 0u) {
+        // Class unloading removed and freed the code while the lock was released.
+        continue;
+      }
       OatQuickMethodHeader* header = OatQuickMethodHeader::FromCodePointer(code_ptr);
       method_headers.insert(header);
       {
@@ -1186,11 +1233,23 @@ void JitCodeCache::RemoveUnmarkedCode(Thread* self) {
         }
 
         method_code_map_.erase(header->GetCode());
+        code_index_.Invalidate();
       }
-      VLOG(jit) << "JIT removed " << *it;
-      it = processed_zombie_code_.erase(it);
+      VLOG(jit) << "JIT removed " << code_ptr;
+    }
+    const size_t used_memory_before = PrivateRegionUsedMemoryLocked();
+    FreeAllMethodHeaders(method_headers);
+    freed_bytes += used_memory_before - PrivateRegionUsedMemoryLocked();
+  }
+  {
+    WriterMutexLock mu(self, *Locks::jit_mutator_lock_);
+    if (!code_index_.IsUpToDate()) {
+      RebuildCodeIndex();
     }
   }
+
+  std::unordered_set<OatQuickMethodHeader*> method_headers;
+  MutexLock mu(self, *Locks::jit_lock_);
   for (auto it = processed_zombie_jni_code_.begin(); it != processed_zombie_jni_code_.end();) {
     WriterMutexLock mu2(self, *Locks::jit_mutator_lock_);
     ArtMethod* method = *it;
@@ -1223,7 +1282,10 @@ void JitCodeCache::RemoveUnmarkedCode(Thread* self) {
       ++it;
     }
   }
+  const size_t used_memory_before = PrivateRegionUsedMemoryLocked();
   FreeAllMethodHeaders(method_headers);
+  freed_bytes += used_memory_before - PrivateRegionUsedMemoryLocked();
+  return freed_bytes;
 }
 
 class JitGcTask final : public Task {
@@ -1299,7 +1361,7 @@ ProfilingInfo* JitCodeCache::GetProfilingInfo(ArtMethod* method, Thread* self) {
   return it->second;
 }
 
-void JitCodeCache::MaybeUpdateInlineCache(ArtMethod* method,
+bool JitCodeCache::MaybeUpdateInlineCache(ArtMethod* method,
                                           uint32_t dex_pc,
                                           ObjPtr<mirror::Class> cls,
                                           Thread* self) {
@@ -1307,11 +1369,50 @@ void JitCodeCache::MaybeUpdateInlineCache(ArtMethod* method,
   MutexLock mu(self, *Locks::jit_lock_);
   auto it = profiling_infos_.find(method);
   if (it == profiling_infos_.end()) {
-    return;
+    return false;
   }
   ProfilingInfo* info = it->second;
   ScopedAssertNoThreadSuspension sants("ProfilingInfo");
-  info->AddInvokeInfo(dex_pc, cls.Ptr());
+  return info->AddInvokeInfo(dex_pc, cls.Ptr());
+}
+
+uint16_t JitCodeCache::RecordDeoptimization(ArtMethod* method, uint16_t threshold, Thread* self) {
+  ScopedDebugDisallowReadBarriers sddrb(self);
+  MutexLock mu(self, *Locks::jit_lock_);
+  auto it = profiling_infos_.find(method);
+  if (it == profiling_infos_.end() || !it->second->AddDeoptimization(threshold)) {
+    return 0u;
+  }
+  return it->second->IncrementReoptimizationCount();
+}
+
+uint16_t JitCodeCache::GetReoptimizationCount(ArtMethod* method, Thread* self) {
+  ScopedDebugDisallowReadBarriers sddrb(self);
+  MutexLock mu(self, *Locks::jit_lock_);
+  auto it = profiling_infos_.find(method);
+  if (it == profiling_infos_.end()) {
+    return 0u;
+  }
+  return it->second->GetReoptimizationCount();
+}
+
+void JitCodeCache::RecordAbandonedCompilation(ArtMethod* method, Thread* self) {
+  ScopedDebugDisallowReadBarriers sddrb(self);
+  MutexLock mu(self, *Locks::jit_lock_);
+  auto it = profiling_infos_.find(method);
+  if (it != profiling_infos_.end()) {
+    it->second->IncrementAbandonedCompilationCount();
+  }
+}
+
+uint16_t JitCodeCache::GetAbandonedCompilationCount(ArtMethod* method, Thread* self) {
+  ScopedDebugDisallowReadBarriers sddrb(self);
+  MutexLock mu(self, *Locks::jit_lock_);
+  auto it = profiling_infos_.find(method);
+  if (it == profiling_infos_.end()) {
+    return 0u;
+  }
+  return it->second->GetAbandonedCompilationCount();
 }
 
 void JitCodeCache::DoCollection(Thread* self) {
@@ -1349,6 +1450,7 @@ void JitCodeCache::DoCollection(Thread* self) {
   TimingLogger logger("JIT code cache timing logger", true, VLOG_IS_ON(jit));
   {
     TimingLogger::ScopedTiming st("Code cache collection", &logger);
+    metrics::AutoTimer timer{GetMetrics()->JitCodeCacheCollectionTime()};
 
     {
       ScopedObjectAccess soa(self);
@@ -1356,7 +1458,7 @@ void JitCodeCache::DoCollection(Thread* self) {
       MarkCompiledCodeOnThreadStacks(self);
 
       // Remove zombie code which hasn't been marked.
-      RemoveUnmarkedCode(self);
+      GetMetrics()->JitCodeCacheReclaimedBytes()->Add(RemoveUnmarkedCode(self));
     }
 
     gc_task_scheduled_ = false;
@@ -1410,7 +1512,15 @@ OatQuickMethodHeader* JitCodeCache::LookupMethodHeader(uintptr_t pc, ArtMethod*
         return OatQuickMethodHeader::FromCodePointer(code_ptr);
       }
     }
-    {
+    // Only runnable threads use the index, see `MaybeFreeRetiredIndexTables`.
+    const void* index_code_ptr = nullptr;
+    if (self->GetState() == ThreadState::kRunnable &&
+        code_index_.Lookup(pc, &index_code_ptr, &found_method)) {
+      if (index_code_ptr != nullptr) {
+        method_header = OatQuickMethodHeader::FromCodePointer(index_code_ptr);
+        DCHECK(method_header->Contains(pc));
+      }
+    } else {
       ReaderMutexLock mu(self, *Locks::jit_mutator_lock_);
       auto it = method_code_map_.lower_bound(pc_ptr);
       if ((it == method_code_map_.end() || it->first != pc_ptr) &&
@@ -1748,6 +1858,45 @@ void JitCodeCache::DoneCompiling(ArtMethod* method, Thread* self) {
       jni_stubs_map_.erase(it);  // Remove the entry added in NotifyCompilationOf().
     }  // else Commit() updated entrypoints of all methods in the JniStubData.
   }
+  MaybeFreeRetiredIndexTables(self);
+}
+
+JitCodeIndex::Entry JitCodeCache::MakeCodeIndexEntry(const void* code_ptr, ArtMethod* method) {
+  // Same range as `OatQuickMethodHeader::Contains`.
+  uintptr_t code_begin = reinterpret_cast<uintptr_t>(code_ptr);
+  if (kRuntimeISA == InstructionSet::kArm) {
+    // On Thumb-2, the pc is offset by one.
+    code_begin++;
+  }
+  uintptr_t code_end = code_begin + OatQuickMethodHeader::FromCodePointer(code_ptr)->GetCodeSize();
+  return JitCodeIndex::Entry{code_begin, code_end, code_ptr, method};
+}
+
+void JitCodeCache::RebuildCodeIndex() {
+  std::vector<JitCodeIndex::Entry> entries;
+  entries.reserve(method_code_map_.size());
+  for (const auto& [code_ptr, method] : method_code_map_) {
+    entries.push_back(MakeCodeIndexEntry(code_ptr, method));
+  }
+  code_index_.Rebuild(std::move(entries));
+}
+
+void JitCodeCache::MaybeFreeRetiredIndexTables(Thread* self) {
+  std::vector<JitCodeIndex::Table*> retired_tables;
+  {
+    WriterMutexLock mu(self, *Locks::jit_mutator_lock_);
+    if (!code_index_.ShouldFreeRetiredTables()) {
+      return;
+    }
+    retired_tables = code_index_.TakeRetiredTables();
+  }
+  // Lookups in the index are done by runnable threads, without suspend points. Once every
+  // runnable thread has run an empty checkpoint, none of them can still use a retired table.
+  {
+    ScopedThreadSuspension sts(self, ThreadState::kWaitingForCheckPointsToRun);
+    Runtime::Current()->GetThreadList()->RunEmptyCheckpoint();
+  }
+  JitCodeIndex::FreeTables(retired_tables);
 }
 
 void JitCodeCache::InvalidateAllCompiledCode() {
@@ -35,6 +35,7 @@
 #include "base/mutex.h"
 #include "base/safe_map.h"
 #include "compilation_kind.h"
+#include "jit_code_index.h"
 #include "jit_memory_region.h"
 #include "profiling_info.h"
 
@@ -310,8 +311,9 @@ class JitCodeCache {
       REQUIRES(!Locks::jit_lock_)
       REQUIRES(Locks::mutator_lock_);
 
-  // Remove all methods in our cache that were allocated by 'alloc'.
-  void RemoveMethodsIn(Thread* self, const LinearAlloc& alloc)
+  // Remove all methods in our cache that were allocated by one of `allocs`. Returns the
+  // number of bytes of code and data freed.
+  size_t RemoveMethodsIn(Thread* self, ArrayRef<const LinearAlloc* const> allocs)
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -420,12 +422,27 @@ class JitCodeCache {
   }
 
   ProfilingInfo* GetProfilingInfo(ArtMethod* method, Thread* self);
-  void MaybeUpdateInlineCache(ArtMethod* method,
+  // Returns whether the inline cache is megamorphic.
+  bool MaybeUpdateInlineCache(ArtMethod* method,
                               uint32_t dex_pc,
                               ObjPtr<mirror::Class> cls,
                               Thread* self)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Records that optimized code of `method` got thrown away after a deoptimization. Every
+  // `threshold` deoptimizations, counts a re-optimization and returns the updated re-optimization
+  // count. Otherwise, or if `method` has no profiling info, returns 0.
+  uint16_t RecordDeoptimization(ArtMethod* method, uint16_t threshold, Thread* self)
+      REQUIRES(!Locks::jit_lock_);
+  uint16_t GetReoptimizationCount(ArtMethod* method, Thread* self) REQUIRES(!Locks::jit_lock_);
+
+  // Records that an optimized compilation of `method` went over the compile time budget and
+  // got abandoned. Does nothing if `method` has no profiling info.
+  EXPORT void RecordAbandonedCompilation(ArtMethod* method, Thread* self)
+      REQUIRES(!Locks::jit_lock_);
+  EXPORT uint16_t GetAbandonedCompilationCount(ArtMethod* method, Thread* self)
+      REQUIRES(!Locks::jit_lock_);
+
   // NO_THREAD_SAFETY_ANALYSIS because we may be called with the JIT lock held
   // or not. The implementation of this method handles the two cases.
   void AddZombieCode(ArtMethod* method, const void* code_ptr) NO_THREAD_SAFETY_ANALYSIS;
@@ -463,6 +480,17 @@ class JitCodeCache {
       REQUIRES(Locks::jit_lock_)
       REQUIRES(Locks::mutator_lock_);
 
+  static JitCodeIndex::Entry MakeCodeIndexEntry(const void* code_ptr, ArtMethod* method);
+
+  // Rebuild `code_index_` from `method_code_map_`.
+  void RebuildCodeIndex() REQUIRES(Locks::jit_mutator_lock_);
+
+  // Free the tables retired from `code_index_` once they use enough memory. Needs to suspend
+  // `self` to wait for the other threads.
+  void MaybeFreeRetiredIndexTables(Thread* self)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::jit_mutator_lock_);
+
   // Call given callback for every compiled method in the code cache.
   void VisitAllMethods(const std::function<void(const void*, ArtMethod*)>& cb)
       REQUIRES_SHARED(Locks::jit_mutator_lock_);
@@ -483,10 +511,14 @@ class JitCodeCache {
   // Number of bytes allocated in the data cache.
   size_t DataCacheSizeLocked() REQUIRES(Locks::jit_lock_);
 
+  // Number of bytes of code and data allocated in the private region.
+  size_t PrivateRegionUsedMemoryLocked() REQUIRES(Locks::jit_lock_);
+
   // Return whether the code cache's capacity is at its maximum.
   bool IsAtMaxCapacity() const REQUIRES(Locks::jit_lock_);
 
-  void RemoveUnmarkedCode(Thread* self)
+  // Free the zombie code which was not marked, in batches. Returns the number of bytes freed.
+  size_t RemoveUnmarkedCode(Thread* self)
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -553,6 +585,9 @@ class JitCodeCache {
 
   // Holds compiled code associated to the ArtMethod.
   SafeMap<const void*, ArtMethod*> method_code_map_ GUARDED_BY(Locks::jit_mutator_lock_);
+  // Index of `method_code_map_` for lookups without taking a lock. Updated with
+  // `Locks::jit_mutator_lock_` held exclusively.
+  JitCodeIndex code_index_;
   // Subset of `method_code_map_`, but keyed by `ArtMethod*`. Used to treat certain
   // objects (like `MethodType`-s) as strongly reachable from the corresponding ArtMethod.
   SafeMap<ArtMethod*, std::vector<const void*>> method_code_map_reversed_
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit_code_index.h"
+
+#include <algorithm>
+
+#include "android-base/logging.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+struct JitCodeIndex::Table {
+  // Sorted by `code_begin`. Not modified once the table is published.
+  std::vector<Entry> entries;
+  // Entries added after the table was published, in the order they were added. The first
+  // `num_recent_entries` are not modified anymore.
+  Entry recent_entries[kMaxRecentEntries];
+  std::atomic<size_t> num_recent_entries{0u};
+  // Cleared when the indexed code changes without publishing a new table.
+  std::atomic<bool> up_to_date{true};
+};
+
+static bool CompareEntries(const JitCodeIndex::Entry& lhs, const JitCodeIndex::Entry& rhs) {
+  return lhs.code_begin < rhs.code_begin;
+}
+
+static size_t TableBytes(const JitCodeIndex::Table* table) {
+  return sizeof(JitCodeIndex::Table) + table->entries.capacity() * sizeof(JitCodeIndex::Entry);
+}
+
+JitCodeIndex::JitCodeIndex() : table_(new Table()), retired_bytes_(0u) {}
+
+JitCodeIndex::~JitCodeIndex() {
+  FreeTables(retired_tables_);
+  delete table_.load(std::memory_order_relaxed);
+}
+
+bool JitCodeIndex::Lookup(uintptr_t pc,
+                          /*out*/ const void** code_ptr,
+                          /*out*/ ArtMethod** method) const {
+  const Table* table = table_.load(std::memory_order_acquire);
+  if (!table->up_to_date.load(std::memory_order_acquire)) {
+    return false;
+  }
+  size_t num_recent_entries = table->num_recent_entries.load(std::memory_order_acquire);
+  for (size_t i = 0; i != num_recent_entries; ++i) {
+    const Entry& entry = table->recent_entries[i];
+    if (entry.code_begin <= pc && pc <= entry.code_end) {
+      *code_ptr = entry.code_ptr;
+      *method = entry.method;
+      return true;
+    }
+  }
+  // Find the last entry starting at or before `pc`.
+  auto it = std::upper_bound(table->entries.begin(),
+                             table->entries.end(),
+                             pc,
+                             [](uintptr_t value, const Entry& entry) {
+                               return value < entry.code_begin;
+                             });
+  if (it != table->entries.begin() && pc <= (it - 1)->code_end) {
+    *code_ptr = (it - 1)->code_ptr;
+    *method = (it - 1)->method;
+  } else {
+    *code_ptr = nullptr;
+  }
+  return true;
+}
+
+void JitCodeIndex::Add(const Entry& entry) {
+  Table* table = table_.load(std::memory_order_relaxed);
+  if (!table->up_to_date.load(std::memory_order_relaxed)) {
+    // The next `Rebuild` adds the entry.
+    return;
+  }
+  if (kIsDebugBuild) {
+    auto it = std::upper_bound(
+        table->entries.begin(), table->entries.end(), entry, CompareEntries);
+    DCHECK(it == table->entries.begin() || (it - 1)->code_end < entry.code_begin);
+    DCHECK(it == table->entries.end() || entry.code_end < it->code_begin);
+  }
+  size_t num_recent_entries = table->num_recent_entries.load(std::memory_order_relaxed);
+  if (num_recent_entries != kMaxRecentEntries) {
+    // Readers only look at the entries below `num_recent_entries`.
+    table->recent_entries[num_recent_entries] = entry;
+    table->num_recent_entries.store(num_recent_entries + 1u, std::memory_order_release);
+    return;
+  }
+  // Merge the recent entries and the new one into a new sorted table.
+  std::vector<Entry> recent_entries(table->recent_entries,
+                                    table->recent_entries + kMaxRecentEntries);
+  recent_entries.push_back(entry);
+  std::sort(recent_entries.begin(), recent_entries.end(), CompareEntries);
+  std::unique_ptr<Table> new_table(new Table());
+  new_table->entries.resize(table->entries.size() + recent_entries.size());
+  std::merge(table->entries.begin(),
+             table->entries.end(),
+             recent_entries.begin(),
+             recent_entries.end(),
+             new_table->entries.begin(),
+             CompareEntries);
+  Publish(std::move(new_table));
+}
+
+void JitCodeIndex::Invalidate() {
+  table_.load(std::memory_order_relaxed)->up_to_date.store(false, std::memory_order_release);
+}
+
+void JitCodeIndex::Rebuild(std::vector<Entry>&& entries) {
+  DCHECK(std::is_sorted(entries.begin(), entries.end(), CompareEntries));
+  std::unique_ptr<Table> new_table(new Table());
+  new_table->entries = std::move(entries);
+  Publish(std::move(new_table));
+}
+
+bool JitCodeIndex::IsUpToDate() const {
+  return table_.load(std::memory_order_relaxed)->up_to_date.load(std::memory_order_relaxed);
+}
+
+bool JitCodeIndex::ShouldFreeRetiredTables() const {
+  size_t table_bytes = TableBytes(table_.load(std::memory_order_relaxed));
+  return retired_bytes_ >=
+      std::max(kMinRetiredBytesBeforeFree, kRetiredBytesPerTableByte * table_bytes);
+}
+
+std::vector<JitCodeIndex::Table*> JitCodeIndex::TakeRetiredTables() {
+  std::vector<Table*> tables;
+  tables.swap(retired_tables_);
+  retired_bytes_ = 0u;
+  return tables;
+}
+
+void JitCodeIndex::FreeTables(const std::vector<Table*>& tables) {
+  for (Table* table : tables) {
+    delete table;
+  }
+}
+
+void JitCodeIndex::Publish(std::unique_ptr<Table> table) {
+  Table* old_table = table_.exchange(table.release(), std::memory_order_acq_rel);
+  retired_tables_.push_back(old_table);
+  retired_bytes_ += TableBytes(old_table);
+}
+
+}  // namespace jit
+}  // namespace art
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_JIT_CODE_INDEX_H_
+#define ART_RUNTIME_JIT_JIT_CODE_INDEX_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "base/globals.h"
+#include "base/macros.h"
+
+namespace art HIDDEN {
+
+class ArtMethod;
+
+namespace jit {
+
+// Sorted index of the JIT code ranges, for looking up the code containing a pc without taking
+// a lock. Added entries go to a small unsorted array of the current table. Once it is full, the
+// next update publishes a new sorted table and retires the previous one. Retired tables are freed
+// by the owner once no reader can still use them, see
+// `JitCodeCache::MaybeFreeRetiredIndexTables`.
+//
+// Lookups can run concurrently with updates. All other methods must be called with the lock
+// protecting the indexed code held exclusively.
+class EXPORT JitCodeIndex {
+ public:
+  struct Entry {
+    // Range of pcs in the code, `code_end` included.
+    uintptr_t code_begin;
+    uintptr_t code_end;
+    const void* code_ptr;
+    ArtMethod* method;
+  };
+
+  struct Table;
+
+  // Number of entries added to a table before they are merged into a new sorted table.
+  static constexpr size_t kMaxRecentEntries = 64u;
+  // Retired tables should be freed once they hold this many times the bytes of the current
+  // table, and at least `kMinRetiredBytesBeforeFree`. Scaling with the table keeps the number of
+  // frees, each of which needs a checkpoint, per added entry from growing with the table.
+  static constexpr size_t kRetiredBytesPerTableByte = 4u;
+  static constexpr size_t kMinRetiredBytesBeforeFree = 1 * MB;
+
+  JitCodeIndex();
+  ~JitCodeIndex();
+
+  // Look up the code containing `pc`. Return false if the index is not up to date, in which case
+  // the caller needs to look up the indexed code under lock. Otherwise, set `code_ptr` and
+  // `method` to the code found, or `code_ptr` to null if no code contains `pc`.
+  bool Lookup(uintptr_t pc, /*out*/ const void** code_ptr, /*out*/ ArtMethod** method) const;
+
+  // Add an entry, which must not overlap existing entries. Does nothing if the index is not up
+  // to date.
+  void Add(const Entry& entry);
+
+  // Mark the index as not up to date until the next call to `Rebuild`. Used when removing
+  // code, which is done in batches.
+  void Invalidate();
+
+  // Replace the content of the index with `entries`, sorted by `code_begin`.
+  void Rebuild(std::vector<Entry>&& entries);
+
+  bool IsUpToDate() const;
+
+  bool ShouldFreeRetiredTables() const;
+
+  // Take ownership of the retired tables. The caller must ensure that no lookup still uses them
+  // before passing them to `FreeTables`.
+  std::vector<Table*> TakeRetiredTables();
+
+  static void FreeTables(const std::vector<Table*>& tables);
+
+ private:
+  void Publish(std::unique_ptr<Table> table);
+
+  std::atomic<Table*> table_;
+  std::vector<Table*> retired_tables_;
+  size_t retired_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitCodeIndex);
+};
+
+}  // namespace jit
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_JIT_CODE_INDEX_H_
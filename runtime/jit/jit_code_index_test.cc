@@ -0,0 +1,193 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit/jit_code_index.h"
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+static ArtMethod* const kMethod1 = reinterpret_cast<ArtMethod*>(0x1000);
+static ArtMethod* const kMethod2 = reinterpret_cast<ArtMethod*>(0x2000);
+
+static JitCodeIndex::Entry MakeEntry(uintptr_t code_begin, size_t code_size, ArtMethod* method) {
+  return JitCodeIndex::Entry{
+      code_begin, code_begin + code_size, reinterpret_cast<const void*>(code_begin), method};
+}
+
+static const void* LookupCode(const JitCodeIndex& index,
+                              uintptr_t pc,
+                              /*out*/ ArtMethod** method = nullptr) {
+  const void* code_ptr = nullptr;
+  ArtMethod* found_method = nullptr;
+  EXPECT_TRUE(index.Lookup(pc, &code_ptr, &found_method));
+  if (method != nullptr) {
+    *method = found_method;
+  }
+  return code_ptr;
+}
+
+TEST(JitCodeIndexTest, Lookup) {
+  JitCodeIndex index;
+  EXPECT_EQ(nullptr, LookupCode(index, 0x100));
+
+  index.Add(MakeEntry(0x200, 0x40, kMethod2));
+  index.Add(MakeEntry(0x100, 0x40, kMethod1));
+
+  ArtMethod* method = nullptr;
+  EXPECT_EQ(reinterpret_cast<const void*>(0x100), LookupCode(index, 0x100, &method));
+  EXPECT_EQ(kMethod1, method);
+  // The end of the code is included, for return pcs of calls ending the code.
+  EXPECT_EQ(reinterpret_cast<const void*>(0x100), LookupCode(index, 0x140));
+  EXPECT_EQ(reinterpret_cast<const void*>(0x200), LookupCode(index, 0x220, &method));
+  EXPECT_EQ(kMethod2, method);
+
+  EXPECT_EQ(nullptr, LookupCode(index, 0xff));
+  EXPECT_EQ(nullptr, LookupCode(index, 0x141));
+  EXPECT_EQ(nullptr, LookupCode(index, 0x241));
+}
+
+TEST(JitCodeIndexTest, InvalidateAndRebuild) {
+  JitCodeIndex index;
+  index.Add(MakeEntry(0x100, 0x40, kMethod1));
+  index.Add(MakeEntry(0x200, 0x40, kMethod2));
+
+  index.Invalidate();
+  EXPECT_FALSE(index.IsUpToDate());
+  const void* code_ptr = nullptr;
+  ArtMethod* method = nullptr;
+  EXPECT_FALSE(index.Lookup(0x100, &code_ptr, &method));
+  // Entries added before the rebuild are ignored.
+  index.Add(MakeEntry(0x300, 0x40, kMethod1));
+  EXPECT_FALSE(index.Lookup(0x300, &code_ptr, &method));
+
+  index.Rebuild({MakeEntry(0x200, 0x40, kMethod2), MakeEntry(0x300, 0x40, kMethod1)});
+  EXPECT_TRUE(index.IsUpToDate());
+  EXPECT_EQ(nullptr, LookupCode(index, 0x100));
+  EXPECT_EQ(reinterpret_cast<const void*>(0x200), LookupCode(index, 0x200));
+  EXPECT_EQ(reinterpret_cast<const void*>(0x300), LookupCode(index, 0x320));
+}
+
+TEST(JitCodeIndexTest, RetiredTables) {
+  JitCodeIndex index;
+  size_t num_adds = 0u;
+  while (!index.ShouldFreeRetiredTables()) {
+    index.Add(MakeEntry(0x100 * (num_adds + 1u), 0x40, kMethod1));
+    ++num_adds;
+  }
+  std::vector<JitCodeIndex::Table*> tables = index.TakeRetiredTables();
+  // Only adding to a full table retires it.
+  EXPECT_EQ(num_adds / (JitCodeIndex::kMaxRecentEntries + 1u), tables.size());
+  EXPECT_FALSE(index.ShouldFreeRetiredTables());
+  JitCodeIndex::FreeTables(tables);
+
+  EXPECT_EQ(reinterpret_cast<const void*>(0x100), LookupCode(index, 0x100));
+  EXPECT_EQ(reinterpret_cast<const void*>(0x100 * num_adds),
+            LookupCode(index, 0x100 * num_adds + 0x40));
+}
+
+TEST(JitCodeIndexTest, RecentEntries) {
+  JitCodeIndex index;
+  index.Rebuild({MakeEntry(0x100, 0x40, kMethod1)});
+  JitCodeIndex::FreeTables(index.TakeRetiredTables());
+  // Entries are added in decreasing order, so that merging them has to sort them.
+  uintptr_t code_begin = 0x100 * (JitCodeIndex::kMaxRecentEntries + 2u);
+  for (size_t i = 0; i != JitCodeIndex::kMaxRecentEntries; ++i) {
+    index.Add(MakeEntry(code_begin, 0x40, kMethod2));
+    code_begin -= 0x100;
+  }
+  // Filling the recent entries does not publish a new table.
+  EXPECT_TRUE(index.TakeRetiredTables().empty());
+  EXPECT_EQ(reinterpret_cast<const void*>(0x100), LookupCode(index, 0x140));
+  for (size_t i = 0; i != JitCodeIndex::kMaxRecentEntries; ++i) {
+    uintptr_t pc = 0x100 * (i + 3u);
+    EXPECT_EQ(reinterpret_cast<const void*>(pc), LookupCode(index, pc + 0x20));
+  }
+
+  index.Add(MakeEntry(code_begin, 0x40, kMethod2));
+  std::vector<JitCodeIndex::Table*> tables = index.TakeRetiredTables();
+  EXPECT_EQ(1u, tables.size());
+  JitCodeIndex::FreeTables(tables);
+  for (size_t i = 0; i != JitCodeIndex::kMaxRecentEntries + 2u; ++i) {
+    uintptr_t pc = 0x100 * (i + 1u);
+    EXPECT_EQ(reinterpret_cast<const void*>(pc), LookupCode(index, pc + 0x20));
+  }
+  const void* code_ptr = nullptr;
+  ArtMethod* method = nullptr;
+  EXPECT_FALSE(index.Lookup(0x100 * (JitCodeIndex::kMaxRecentEntries + 3u), &code_ptr, &method));
+}
+
+TEST(JitCodeIndexTest, RetiredBytesScaleWithTable) {
+  static constexpr size_t kNumEntries = 4 * JitCodeIndex::kMinRetiredBytesBeforeFree /
+                                        sizeof(JitCodeIndex::Entry);
+  std::vector<JitCodeIndex::Entry> entries;
+  for (size_t i = 0; i != kNumEntries; ++i) {
+    entries.push_back(MakeEntry(0x100 * (i + 1u), 0x40, kMethod1));
+  }
+  JitCodeIndex index;
+  index.Rebuild(std::move(entries));
+  JitCodeIndex::FreeTables(index.TakeRetiredTables());
+  // Merging the recent entries retires a table larger than `kMinRetiredBytesBeforeFree`, but
+  // about the size of the current table.
+  for (size_t i = 0; i != JitCodeIndex::kMaxRecentEntries + 1u; ++i) {
+    index.Add(MakeEntry(0x100 * (kNumEntries + i + 1u), 0x40, kMethod2));
+  }
+  EXPECT_FALSE(index.ShouldFreeRetiredTables());
+  std::vector<JitCodeIndex::Table*> tables = index.TakeRetiredTables();
+  EXPECT_EQ(1u, tables.size());
+  JitCodeIndex::FreeTables(tables);
+}
+
+TEST(JitCodeIndexTest, ConcurrentLookups) {
+  static constexpr size_t kNumEntries = 1000u;
+  static constexpr size_t kNumReaders = 4u;
+  JitCodeIndex index;
+  // Entries that readers look up while others are added.
+  index.Add(MakeEntry(0x100, 0x40, kMethod1));
+  std::atomic<bool> done(false);
+  std::atomic<size_t> num_errors(0u);
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i != kNumReaders; ++i) {
+    readers.emplace_back([&]() {
+      while (!done.load(std::memory_order_relaxed)) {
+        const void* code_ptr = nullptr;
+        ArtMethod* method = nullptr;
+        if (!index.Lookup(0x120, &code_ptr, &method) ||
+            code_ptr != reinterpret_cast<const void*>(0x100) ||
+            method != kMethod1) {
+          num_errors.fetch_add(1u, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (size_t i = 1; i != kNumEntries; ++i) {
+    index.Add(MakeEntry(0x100 * (i + 1u), 0x40, kMethod2));
+  }
+  done.store(true, std::memory_order_relaxed);
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(0u, num_errors.load());
+  // The readers have stopped, so the retired tables can be freed.
+  JitCodeIndex::FreeTables(index.TakeRetiredTables());
+}
+
+}  // namespace jit
+}  // namespace art
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit_compile_report.h"
+
+#include <algorithm>
+#include <ostream>
+#include <sstream>
+
+#include "base/time_utils.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+JitCompileReport::JitCompileReport()
+    : lock_("JIT compile report lock"),
+      num_compilations_(0u),
+      num_over_budget_(0u),
+      total_ns_(0u) {}
+
+void JitCompileReport::AddCompilation(CompilationKind kind,
+                                      uint64_t duration_ns,
+                                      bool over_budget,
+                                      ArrayRef<const PassTiming> passes,
+                                      const std::function<std::string()>& get_method_name) {
+  const PassTiming* slowest_pass = nullptr;
+  for (const PassTiming& pass : passes) {
+    if (slowest_pass == nullptr || pass.duration_ns > slowest_pass->duration_ns) {
+      slowest_pass = &pass;
+    }
+  }
+
+  MutexLock mu(Thread::Current(), lock_);
+  ++num_compilations_;
+  if (over_budget) {
+    ++num_over_budget_;
+  }
+  total_ns_ += duration_ns;
+  for (const PassTiming& pass : passes) {
+    PassStats& stats = passes_[pass.name];
+    ++stats.count;
+    stats.total_ns += pass.duration_ns;
+    stats.max_ns = std::max(stats.max_ns, pass.duration_ns);
+  }
+
+  if (slow_compilations_.size() == kMaxSlowCompilations &&
+      duration_ns <= slow_compilations_.back().duration_ns) {
+    return;
+  }
+  if (slow_compilations_.size() == kMaxSlowCompilations) {
+    slow_compilations_.pop_back();
+  }
+  auto it = std::find_if(slow_compilations_.begin(),
+                         slow_compilations_.end(),
+                         [=](const SlowCompilation& c) { return c.duration_ns < duration_ns; });
+  slow_compilations_.insert(it,
+                            SlowCompilation{get_method_name(),
+                                            kind,
+                                            duration_ns,
+                                            over_budget,
+                                            slowest_pass != nullptr ? slowest_pass->name : "",
+                                            slowest_pass != nullptr ? slowest_pass->duration_ns
+                                                                    : 0u});
+}
+
+void JitCompileReport::Dump(std::ostream& os) {
+  MutexLock mu(Thread::Current(), lock_);
+  if (num_compilations_ == 0u) {
+    return;
+  }
+  os << "JIT compile time: " << PrettyDuration(total_ns_) << " in " << num_compilations_
+     << " compilations, " << num_over_budget_ << " over budget\n";
+  os << "Slowest JIT compilations:\n";
+  for (const SlowCompilation& c : slow_compilations_) {
+    os << "  " << PrettyDuration(c.duration_ns) << " " << c.kind << " " << c.method_name;
+    if (!c.slowest_pass.empty()) {
+      os << " (slowest pass " << c.slowest_pass << ": " << PrettyDuration(c.slowest_pass_ns)
+         << ")";
+    }
+    if (c.over_budget) {
+      os << " over budget";
+    }
+    os << "\n";
+  }
+
+  std::vector<std::pair<std::string, PassStats>> passes(passes_.begin(), passes_.end());
+  std::sort(passes.begin(), passes.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second.total_ns > rhs.second.total_ns;
+  });
+  os << "JIT compile time per pass:\n";
+  for (const auto& [name, stats] : passes) {
+    os << "  " << name << ": total=" << PrettyDuration(stats.total_ns)
+       << " count=" << stats.count
+       << " max=" << PrettyDuration(stats.max_ns) << "\n";
+  }
+}
+
+std::vector<std::string> JitCompileReport::GetSlowCompilations() {
+  MutexLock mu(Thread::Current(), lock_);
+  std::vector<std::string> result;
+  for (const SlowCompilation& c : slow_compilations_) {
+    std::ostringstream oss;
+    oss << c.method_name << " " << c.kind;
+    result.push_back(oss.str());
+  }
+  return result;
+}
+
+}  // namespace jit
+}  // namespace art
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_JIT_COMPILE_REPORT_H_
+#define ART_RUNTIME_JIT_JIT_COMPILE_REPORT_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/array_ref.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "compilation_kind.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+// Attribution of the JIT compile time to methods and optimizing compiler passes, dumped on
+// SIGQUIT. Times are thread CPU times of the JIT thread.
+class EXPORT JitCompileReport {
+ public:
+  // Number of slowest compilations kept.
+  static constexpr size_t kMaxSlowCompilations = 10;
+
+  struct PassTiming {
+    const char* name;
+    uint64_t duration_ns;
+  };
+
+  JitCompileReport();
+
+  // Record a compilation taking `duration_ns`, of which `passes` lists the time spent in each
+  // pass. `get_method_name` is only called if the compilation is among the slowest ones.
+  void AddCompilation(CompilationKind kind,
+                      uint64_t duration_ns,
+                      bool over_budget,
+                      ArrayRef<const PassTiming> passes,
+                      const std::function<std::string()>& get_method_name) REQUIRES(!lock_);
+
+  void Dump(std::ostream& os) REQUIRES(!lock_);
+
+  // Return the slowest compilations recorded, slowest first, as "method_name kind".
+  std::vector<std::string> GetSlowCompilations() REQUIRES(!lock_);
+
+ private:
+  struct SlowCompilation {
+    std::string method_name;
+    CompilationKind kind;
+    uint64_t duration_ns;
+    bool over_budget;
+    std::string slowest_pass;
+    uint64_t slowest_pass_ns;
+  };
+
+  struct PassStats {
+    size_t count = 0u;
+    uint64_t total_ns = 0u;
+    uint64_t max_ns = 0u;
+  };
+
+  Mutex lock_;
+  size_t num_compilations_ GUARDED_BY(lock_);
+  size_t num_over_budget_ GUARDED_BY(lock_);
+  uint64_t total_ns_ GUARDED_BY(lock_);
+  // Sorted by decreasing duration.
+  std::vector<SlowCompilation> slow_compilations_ GUARDED_BY(lock_);
+  std::map<std::string, PassStats> passes_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(JitCompileReport);
+};
+
+}  // namespace jit
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_JIT_COMPILE_REPORT_H_
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit/jit_compile_report.h"
+
+#include <sstream>
+
+#include "android-base/stringprintf.h"
+#include "common_runtime_test.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+class JitCompileReportTest : public CommonRuntimeTest {};
+
+TEST_F(JitCompileReportTest, KeepsSlowestCompilations) {
+  JitCompileReport report;
+  size_t names_built = 0u;
+  for (size_t i = 0; i != 2 * JitCompileReport::kMaxSlowCompilations; ++i) {
+    // Fill the list, then alternate between fast and slow compilations.
+    uint64_t duration_ns = (i < JitCompileReport::kMaxSlowCompilations)
+        ? 10u * (i + 1u)
+        : ((i % 2u == 0u) ? 1u : 1000u + i);
+    report.AddCompilation(CompilationKind::kOptimized,
+                          duration_ns,
+                          /*over_budget=*/ false,
+                          ArrayRef<const JitCompileReport::PassTiming>(),
+                          [&]() {
+                            ++names_built;
+                            return android::base::StringPrintf("m%zu", i);
+                          });
+  }
+  std::vector<std::string> slow = report.GetSlowCompilations();
+  ASSERT_EQ(JitCompileReport::kMaxSlowCompilations, slow.size());
+  EXPECT_EQ("m19 Optimized", slow[0]);
+  EXPECT_EQ("m17 Optimized", slow[1]);
+  EXPECT_EQ("m9 Optimized", slow[5]);
+  EXPECT_EQ("m5 Optimized", slow[9]);
+  // The fast compilations after the list was full did not need a name.
+  EXPECT_EQ(15u, names_built);
+}
+
+TEST_F(JitCompileReportTest, AttributesPasses) {
+  JitCompileReport report;
+  const JitCompileReport::PassTiming passes[] = {
+      {"inliner", 3000u},
+      {"GVN", 5000u},
+      {"register", 1000u},
+  };
+  report.AddCompilation(CompilationKind::kOsr,
+                        10000u,
+                        /*over_budget=*/ true,
+                        ArrayRef<const JitCompileReport::PassTiming>(passes),
+                        []() { return std::string("void Main.loop()"); });
+  report.AddCompilation(CompilationKind::kBaseline,
+                        1000u,
+                        /*over_budget=*/ false,
+                        ArrayRef<const JitCompileReport::PassTiming>(passes, 1u),
+                        []() { return std::string("void Main.small()"); });
+
+  std::ostringstream oss;
+  report.Dump(oss);
+  std::string dump = oss.str();
+  EXPECT_NE(std::string::npos, dump.find("2 compilations, 1 over budget")) << dump;
+  EXPECT_NE(std::string::npos, dump.find("void Main.loop() (slowest pass GVN")) << dump;
+  EXPECT_NE(std::string::npos, dump.find("inliner: total=4us count=2")) << dump;
+  // Passes are listed by decreasing total time.
+  EXPECT_LT(dump.find("GVN: total"), dump.find("inliner: total")) << dump;
+  EXPECT_LT(dump.find("inliner: total"), dump.find("register: total")) << dump;
+}
+
+}  // namespace jit
+}  // namespace art
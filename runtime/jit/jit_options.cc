@@ -61,6 +61,13 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
       options.GetOrDefault(RuntimeArgumentMap::JITPoolThreadPthreadPriority);
   jit_options->zygote_thread_pool_pthread_priority_ =
       options.GetOrDefault(RuntimeArgumentMap::JITZygotePoolThreadPthreadPriority);
+  jit_options->warm_cache_path_ = options.GetOrDefault(RuntimeArgumentMap::JITWarmCache);
+  jit_options->thread_pool_max_threads_ =
+      options.GetOrDefault(RuntimeArgumentMap::JITPoolMaxThreads);
+  jit_options->max_reoptimizations_ =
+      options.GetOrDefault(RuntimeArgumentMap::JITMaxReoptimizations);
+  jit_options->compile_budget_ms_ =
+      options.GetOrDefault(RuntimeArgumentMap::JITCompileBudget);
 
   // Set default optimize threshold to aid with checking defaults.
   jit_options->optimize_threshold_ = kIsDebugBuild
@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_JIT_JIT_OPTIONS_H_
 #define ART_RUNTIME_JIT_JIT_OPTIONS_H_
 
+#include "base/globals.h"
 #include "base/macros.h"
 #include "base/runtime_debug.h"
 #include "profile_saver_options.h"
@@ -34,6 +35,19 @@ static constexpr int kJitPoolThreadPthreadDefaultPriority = 9;
 // 19 is the lowest background priority on device.
 // See android/os/Process.java.
 static constexpr int kJitZygotePoolThreadPthreadDefaultPriority = 19;
+// How many times optimized code of a method may deoptimize and be recompiled with fresh
+// profiling data before the method is kept in baseline code.
+static constexpr uint32_t kJitDefaultMaxReoptimizations = 4;
+// How many times optimized code of a method must deoptimize before the method is re-optimized
+// right away rather than after warming up again in the interpreter.
+static constexpr uint16_t kJitDeoptimizationsBeforeReoptimization = 2;
+// Thread CPU time, in milliseconds, after which the JIT stops running expensive optimizations
+// of a method. Off by default: skipping optimizations trades code quality for compile time,
+// which only some apps want.
+static constexpr uint32_t kJitDefaultCompileBudgetMs = 0u;
+// How many optimized compilations of a method may go over the compile time budget before the
+// method is kept in baseline code for the rest of the run.
+static constexpr uint16_t kJitMaxAbandonedCompilations = 1u;
 
 class JitOptions {
  public:
@@ -85,6 +99,28 @@ class JitOptions {
     return zygote_thread_pool_pthread_priority_;
   }
 
+  // The maximum number of JIT threads. If above 1, the number of active threads is adaptive.
+  size_t GetThreadPoolMaxThreads() const {
+    return thread_pool_max_threads_;
+  }
+
+  // The number of times a method can be re-optimized after its optimized code deoptimized.
+  // 0 disables re-optimization.
+  uint32_t GetMaxReoptimizations() const {
+    return max_reoptimizations_;
+  }
+
+  // The compile time budget of a method in milliseconds, see kJitDefaultCompileBudgetMs.
+  // 0 means no budget.
+  uint32_t GetCompileBudgetMs() const {
+    return compile_budget_ms_;
+  }
+
+  // The file given with -Xjitwarmcache, or empty.
+  const std::string& GetWarmCachePath() const {
+    return warm_cache_path_;
+  }
+
   bool UseJitCompilation() const {
     return use_jit_compilation_;
   }
@@ -136,6 +172,10 @@ class JitOptions {
   int thread_pool_pthread_priority_;
   int zygote_thread_pool_pthread_priority_;
   ProfileSaverOptions profile_saver_options_;
+  std::string warm_cache_path_;
+  size_t thread_pool_max_threads_;
+  uint32_t max_reoptimizations_;
+  uint32_t compile_budget_ms_;
 
   JitOptions()
       : use_jit_compilation_(false),
@@ -149,7 +189,10 @@ class JitOptions {
         invoke_transition_weight_(0),
         dump_info_on_shutdown_(false),
         thread_pool_pthread_priority_(kJitPoolThreadPthreadDefaultPriority),
-        zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority) {}
+        zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority),
+        thread_pool_max_threads_(1u),
+        max_reoptimizations_(kJitDefaultMaxReoptimizations),
+        compile_budget_ms_(kJitDefaultCompileBudgetMs) {}
 
   DISALLOW_COPY_AND_ASSIGN(JitOptions);
 };
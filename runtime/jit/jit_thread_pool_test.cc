@@ -0,0 +1,87 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit/jit.h"
+
+#include "base/common_art_test.h"
+#include "base/time_utils.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+class JitThreadPoolTest : public CommonArtTest {
+ protected:
+  using QueuedMethod = JitThreadPool::QueuedMethod;
+
+  static constexpr uint64_t kHalfLifeNs = JitThreadPool::kRequestHalfLifeNs;
+  static constexpr uint64_t kAgingPeriodNs = JitThreadPool::kAgingPeriodNs;
+
+  // A method queued at `enqueue_time_ns` and requested `num_requests` times at that time.
+  static QueuedMethod MakeQueued(uint64_t enqueue_time_ns, size_t num_requests) {
+    QueuedMethod queued{enqueue_time_ns, enqueue_time_ns, 1.0};
+    for (size_t i = 1; i < num_requests; ++i) {
+      AddRequest(&queued, enqueue_time_ns);
+    }
+    return queued;
+  }
+
+  static void AddRequest(QueuedMethod* queued, uint64_t now_ns) {
+    JitThreadPool::AddRequest(queued, now_ns);
+  }
+
+  static double GetPriority(const QueuedMethod& queued, uint64_t now_ns) {
+    return JitThreadPool::GetRequestPriority(queued, now_ns);
+  }
+};
+
+TEST_F(JitThreadPoolTest, RepeatedRequestsComeFirst) {
+  // A method queued later but requested more often is compiled first.
+  QueuedMethod early = MakeQueued(/*enqueue_time_ns=*/ 0u, /*num_requests=*/ 1u);
+  QueuedMethod hot = MakeQueued(/*enqueue_time_ns=*/ MsToNs(10), /*num_requests=*/ 3u);
+  uint64_t now_ns = MsToNs(20);
+  EXPECT_GT(GetPriority(hot, now_ns), GetPriority(early, now_ns));
+}
+
+TEST_F(JitThreadPoolTest, RequestsDecay) {
+  // Both methods waited for three half-lives, but the four requests of `old` were all made when
+  // it was queued and now count as half a request.
+  uint64_t now_ns = 3u * kHalfLifeNs;
+  double aging = static_cast<double>(now_ns) / kAgingPeriodNs;
+  QueuedMethod old = MakeQueued(/*enqueue_time_ns=*/ 0u, /*num_requests=*/ 4u);
+  QueuedMethod recent{/*enqueue_time_ns=*/ 0u,
+                      /*last_request_time_ns=*/ now_ns,
+                      /*requests=*/ 1.0};
+  EXPECT_DOUBLE_EQ(0.5 + aging, GetPriority(old, now_ns));
+  EXPECT_DOUBLE_EQ(1.0 + aging, GetPriority(recent, now_ns));
+
+  // A new request adds to the decayed ones.
+  AddRequest(&old, now_ns);
+  EXPECT_DOUBLE_EQ(1.5, old.requests);
+  EXPECT_EQ(now_ns, old.last_request_time_ns);
+}
+
+TEST_F(JitThreadPoolTest, WaitingMethodsAge) {
+  // A method requested once that has been waiting for ten aging periods goes before a method
+  // that was just requested five times.
+  uint64_t now_ns = 10u * kAgingPeriodNs;
+  QueuedMethod lukewarm = MakeQueued(/*enqueue_time_ns=*/ 0u, /*num_requests=*/ 1u);
+  QueuedMethod hot = MakeQueued(now_ns, /*num_requests=*/ 5u);
+  EXPECT_DOUBLE_EQ(5.0, GetPriority(hot, now_ns));
+  EXPECT_GT(GetPriority(lukewarm, now_ns), GetPriority(hot, now_ns));
+}
+
+}  // namespace jit
+}  // namespace art
@@ -0,0 +1,238 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit_warm_cache.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "android-base/file.h"
+#include "base/logging.h"  // For VLOG.
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+namespace {
+
+void AppendU32(std::string* out, uint32_t value) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendString(std::string* out, const std::string& value) {
+  AppendU32(out, value.size());
+  out->append(value);
+}
+
+// Reads the values written by AppendU32() and AppendString(), checking for truncation.
+class Reader {
+ public:
+  explicit Reader(const std::string& data) : data_(data), pos_(0u) {}
+
+  bool ReadBytes(void* out, size_t size) {
+    if (data_.size() - pos_ < size) {
+      return false;
+    }
+    memcpy(out, data_.data() + pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  bool ReadU32(uint32_t* value) {
+    return ReadBytes(value, sizeof(*value));
+  }
+
+  bool ReadString(std::string* value) {
+    uint32_t size;
+    if (!ReadU32(&size) || data_.size() - pos_ < size) {
+      return false;
+    }
+    value->assign(data_, pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  bool AtEnd() const {
+    return pos_ == data_.size();
+  }
+
+ private:
+  const std::string& data_;
+  size_t pos_;
+};
+
+}  // namespace
+
+JitWarmCache::JitWarmCache(const std::string& path, const std::string& key)
+    : path_(path),
+      key_(key),
+      save_lock_("JIT warm cache save lock", kDefaultMutexLevel),
+      lock_("JIT warm cache lock", kGenericBottomLock),
+      dirty_(false),
+      last_save_time_ns_(0u) {}
+
+std::unique_ptr<JitWarmCache> JitWarmCache::Create(const std::string& path,
+                                                   const std::string& key) {
+  std::unique_ptr<JitWarmCache> cache(new JitWarmCache(path, key));
+  std::string contents;
+  if (!android::base::ReadFileToString(path, &contents)) {
+    if (errno != ENOENT) {
+      PLOG(WARNING) << "Could not read JIT warm cache " << path;
+    }
+    return cache;
+  }
+  if (contents.empty()) {
+    return cache;
+  }
+  MutexLock mu(Thread::Current(), cache->lock_);
+  if (!cache->Parse(contents)) {
+    LOG(WARNING) << "Discarding stale or corrupt JIT warm cache " << path;
+    cache->dex_files_.clear();
+    // Overwrite it at the next save even if nothing gets compiled.
+    cache->dirty_ = true;
+    return cache;
+  }
+  VLOG(jit) << "Loaded JIT warm cache " << path << " for " << cache->dex_files_.size()
+            << " dex files";
+  return cache;
+}
+
+bool JitWarmCache::Parse(const std::string& contents) {
+  Reader reader(contents);
+  uint8_t magic[sizeof(kMagic)];
+  uint8_t version[sizeof(kVersion)];
+  std::string key;
+  uint32_t num_dex_files;
+  if (!reader.ReadBytes(magic, sizeof(magic)) ||
+      memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !reader.ReadBytes(version, sizeof(version)) ||
+      memcmp(version, kVersion, sizeof(kVersion)) != 0 ||
+      !reader.ReadString(&key) ||
+      key != key_ ||
+      !reader.ReadU32(&num_dex_files)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < num_dex_files; ++i) {
+    std::string location;
+    DexFileMethods methods;
+    uint32_t num_methods;
+    if (!reader.ReadString(&location) ||
+        !reader.ReadU32(&methods.checksum) ||
+        !reader.ReadU32(&num_methods)) {
+      return false;
+    }
+    for (uint32_t j = 0; j < num_methods; ++j) {
+      uint32_t method_idx;
+      if (!reader.ReadU32(&method_idx)) {
+        return false;
+      }
+      methods.methods.insert(method_idx);
+    }
+    dex_files_.emplace(std::move(location), std::move(methods));
+  }
+  return reader.AtEnd();
+}
+
+std::string JitWarmCache::Serialize() {
+  std::string out;
+  out.append(reinterpret_cast<const char*>(kMagic), sizeof(kMagic));
+  out.append(reinterpret_cast<const char*>(kVersion), sizeof(kVersion));
+  AppendString(&out, key_);
+  AppendU32(&out, dex_files_.size());
+  for (const auto& [location, methods] : dex_files_) {
+    AppendString(&out, location);
+    AppendU32(&out, methods.checksum);
+    AppendU32(&out, methods.methods.size());
+    for (uint32_t method_idx : methods.methods) {
+      AppendU32(&out, method_idx);
+    }
+  }
+  return out;
+}
+
+void JitWarmCache::AddMethod(const std::string& location,
+                             uint32_t checksum,
+                             uint32_t method_idx) {
+  MutexLock mu(Thread::Current(), lock_);
+  DexFileMethods& methods = dex_files_[location];
+  if (methods.checksum != checksum) {
+    methods.checksum = checksum;
+    methods.methods.clear();
+  }
+  dirty_ = methods.methods.insert(method_idx).second || dirty_;
+}
+
+std::vector<uint32_t> JitWarmCache::GetMethods(const std::string& location, uint32_t checksum) {
+  MutexLock mu(Thread::Current(), lock_);
+  auto it = dex_files_.find(location);
+  if (it == dex_files_.end()) {
+    return {};
+  }
+  if (it->second.checksum != checksum) {
+    VLOG(jit) << "Dex file " << location << " changed, discarding its JIT warm cache entries";
+    dex_files_.erase(it);
+    dirty_ = true;
+    return {};
+  }
+  return std::vector<uint32_t>(it->second.methods.begin(), it->second.methods.end());
+}
+
+bool JitWarmCache::MaybeSave(bool force) {
+  Thread* self = Thread::Current();
+  // Serialize the saves, which share the temporary file, but do not hold `lock_` during the I/O:
+  // AddMethod() is called by JIT threads that hold the mutator lock.
+  MutexLock save_mu(self, save_lock_);
+  std::string contents;
+  {
+    MutexLock mu(self, lock_);
+    uint64_t now_ns = NanoTime();
+    if (!dirty_ || (!force && now_ns - last_save_time_ns_ < kMinSaveIntervalNs)) {
+      return false;
+    }
+    last_save_time_ns_ = now_ns;
+    contents = Serialize();
+    // Methods added from now on make the cache dirty again.
+    dirty_ = false;
+  }
+  std::string temp_path = path_ + ".tmp";
+  bool success = android::base::WriteStringToFile(contents, temp_path);
+  if (!success) {
+    PLOG(WARNING) << "Could not write JIT warm cache " << temp_path;
+  } else if (rename(temp_path.c_str(), path_.c_str()) != 0) {
+    PLOG(WARNING) << "Could not rename JIT warm cache to " << path_;
+    unlink(temp_path.c_str());
+    success = false;
+  }
+  if (!success) {
+    MutexLock mu(self, lock_);
+    dirty_ = true;
+  }
+  return success;
+}
+
+size_t JitWarmCache::GetNumberOfMethods() {
+  MutexLock mu(Thread::Current(), lock_);
+  size_t count = 0u;
+  for (const auto& entry : dex_files_) {
+    count += entry.second.methods.size();
+  }
+  return count;
+}
+
+}  // namespace jit
+}  // namespace art
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_JIT_WARM_CACHE_H_
+#define ART_RUNTIME_JIT_JIT_WARM_CACHE_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "base/time_utils.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+// On-disk record of the methods compiled by the optimizing JIT, enabled with -Xjitwarmcache.
+// When the dex files of a later run are loaded, the methods recorded for them are marked hot, so
+// that they are queued for compilation the first time they run instead of after warming up again.
+//
+// The cache holds method indices rather than the compiled code: JIT code embeds the addresses
+// of ArtMethods, classes and strings of the current process, and the assumptions it was
+// compiled with (class hierarchy analysis, initialized classes) need to hold in the new
+// process. Recompiling re-establishes both.
+//
+// The cache is only valid for the boot class path and instruction set it was recorded with,
+// given as `key`; any other key discards the whole file. The methods of a dex file are
+// discarded when the checksum of the dex file changes.
+class JitWarmCache {
+ public:
+  // Load the cache at `path`. If it does not exist, is corrupt or was recorded with another
+  // `key`, start with an empty cache.
+  static std::unique_ptr<JitWarmCache> Create(const std::string& path, const std::string& key);
+
+  // Record that `method_idx` of the dex file at `location` was compiled.
+  void AddMethod(const std::string& location, uint32_t checksum, uint32_t method_idx)
+      REQUIRES(!lock_);
+
+  // Return the recorded methods of the dex file at `location`. If the dex file was recorded
+  // with another checksum, forget its methods and return none.
+  std::vector<uint32_t> GetMethods(const std::string& location, uint32_t checksum)
+      REQUIRES(!lock_);
+
+  // Write the cache if it changed and, unless `force` is set, it was last written more than
+  // kMinSaveIntervalNs ago. The file is replaced atomically. Return whether it was written.
+  bool MaybeSave(bool force) REQUIRES(!save_lock_, !lock_);
+
+  size_t GetNumberOfMethods() REQUIRES(!lock_);
+
+ private:
+  static constexpr uint8_t kMagic[4] = { 'j', 'w', 'c', '\0' };
+  static constexpr uint8_t kVersion[4] = { '0', '0', '1', '\0' };
+
+  // Avoid rewriting the file after every compilation while the app is warming up.
+  static constexpr uint64_t kMinSaveIntervalNs = MsToNs(10 * 1000);
+
+  struct DexFileMethods {
+    uint32_t checksum;
+    std::set<uint32_t> methods;
+  };
+
+  JitWarmCache(const std::string& path, const std::string& key);
+
+  // Parse the cache file contents. Return false if they are corrupt or for another key.
+  bool Parse(const std::string& contents) REQUIRES(lock_);
+  std::string Serialize() REQUIRES(lock_);
+
+  const std::string path_;
+  const std::string key_;
+
+  // Held for the whole of MaybeSave(), including the file I/O.
+  Mutex save_lock_ ACQUIRED_BEFORE(lock_);
+  Mutex lock_ BOTTOM_MUTEX_ACQUIRED_AFTER;
+  // Recorded methods, by dex file location.
+  std::map<std::string, DexFileMethods> dex_files_ GUARDED_BY(lock_);
+  // Whether dex_files_ changed since it was last written.
+  bool dirty_ GUARDED_BY(lock_);
+  uint64_t last_save_time_ns_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(JitWarmCache);
+};
+
+}  // namespace jit
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_JIT_WARM_CACHE_H_
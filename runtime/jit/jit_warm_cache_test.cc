@@ -0,0 +1,90 @@
+/*
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit/jit_warm_cache.h"
+
+#include "android-base/file.h"
+#include "common_runtime_test.h"
+
+namespace art HIDDEN {
+namespace jit {
+
+class JitWarmCacheTest : public CommonRuntimeTest {
+ protected:
+  static constexpr const char* kKey = "x86_64:checksums";
+  static constexpr const char* kLocation = "/data/app/base.apk";
+};
+
+TEST_F(JitWarmCacheTest, SaveAndLoad) {
+  ScratchFile file;
+  std::unique_ptr<JitWarmCache> cache = JitWarmCache::Create(file.GetFilename(), kKey);
+  EXPECT_EQ(0u, cache->GetNumberOfMethods());
+  cache->AddMethod(kLocation, 0x1234u, 3u);
+  cache->AddMethod(kLocation, 0x1234u, 1u);
+  cache->AddMethod(kLocation, 0x1234u, 3u);
+  cache->AddMethod("/data/app/split.apk", 0x5678u, 7u);
+  EXPECT_EQ(3u, cache->GetNumberOfMethods());
+  ASSERT_TRUE(cache->MaybeSave(/*force=*/ true));
+  // Nothing changed since the last save.
+  EXPECT_FALSE(cache->MaybeSave(/*force=*/ true));
+
+  cache = JitWarmCache::Create(file.GetFilename(), kKey);
+  EXPECT_EQ(3u, cache->GetNumberOfMethods());
+  EXPECT_EQ(std::vector<uint32_t>({1u, 3u}), cache->GetMethods(kLocation, 0x1234u));
+  EXPECT_EQ(std::vector<uint32_t>({7u}), cache->GetMethods("/data/app/split.apk", 0x5678u));
+  EXPECT_TRUE(cache->GetMethods("/data/app/other.apk", 0x1234u).empty());
+}
+
+TEST_F(JitWarmCacheTest, DexFileChanged) {
+  ScratchFile file;
+  std::unique_ptr<JitWarmCache> cache = JitWarmCache::Create(file.GetFilename(), kKey);
+  cache->AddMethod(kLocation, 0x1234u, 3u);
+  ASSERT_TRUE(cache->MaybeSave(/*force=*/ true));
+
+  cache = JitWarmCache::Create(file.GetFilename(), kKey);
+  EXPECT_TRUE(cache->GetMethods(kLocation, 0x4321u).empty());
+  // The entries for the old dex file are gone.
+  EXPECT_TRUE(cache->GetMethods(kLocation, 0x1234u).empty());
+  EXPECT_EQ(0u, cache->GetNumberOfMethods());
+}
+
+TEST_F(JitWarmCacheTest, KeyChanged) {
+  ScratchFile file;
+  std::unique_ptr<JitWarmCache> cache = JitWarmCache::Create(file.GetFilename(), kKey);
+  cache->AddMethod(kLocation, 0x1234u, 3u);
+  ASSERT_TRUE(cache->MaybeSave(/*force=*/ true));
+
+  cache = JitWarmCache::Create(file.GetFilename(), "x86_64:other-checksums");
+  EXPECT_EQ(0u, cache->GetNumberOfMethods());
+  EXPECT_TRUE(cache->GetMethods(kLocation, 0x1234u).empty());
+}
+
+TEST_F(JitWarmCacheTest, Corrupt) {
+  ScratchFile file;
+  std::unique_ptr<JitWarmCache> cache = JitWarmCache::Create(file.GetFilename(), kKey);
+  cache->AddMethod(kLocation, 0x1234u, 3u);
+  ASSERT_TRUE(cache->MaybeSave(/*force=*/ true));
+
+  std::string contents;
+  ASSERT_TRUE(android::base::ReadFileToString(file.GetFilename(), &contents));
+  contents.resize(contents.size() - 1u);
+  ASSERT_TRUE(android::base::WriteStringToFile(contents, file.GetFilename()));
+  cache = JitWarmCache::Create(file.GetFilename(), kKey);
+  EXPECT_EQ(0u, cache->GetNumberOfMethods());
+}
+
+}  // namespace jit
+}  // namespace art
@@ -32,7 +32,10 @@ ProfilingInfo::ProfilingInfo(ArtMethod* method,
         method_(method),
         number_of_inline_caches_(inline_cache_entries.size()),
         number_of_branch_caches_(branch_cache_entries.size()),
-        current_inline_uses_(0) {
+        current_inline_uses_(0),
+        reoptimization_count_(0),
+        deoptimization_count_(0),
+        abandoned_compilation_count_(0) {
   InlineCache* inline_caches = GetInlineCaches();
   memset(inline_caches, 0, number_of_inline_caches_ * sizeof(InlineCache));
   for (size_t i = 0; i < number_of_inline_caches_; ++i) {
@@ -112,17 +115,17 @@ BranchCache* ProfilingInfo::GetBranchCache(uint32_t dex_pc) {
   return nullptr;
 }
 
-void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
+bool ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
   InlineCache* cache = GetInlineCache(dex_pc);
   if (cache == nullptr) {
-    return;
+    return false;
   }
   for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
     mirror::Class* existing = cache->classes_[i].Read<kWithoutReadBarrier>();
     mirror::Class* marked = ReadBarrier::IsMarked(existing);
     if (marked == cls) {
       // Receiver type is already in the cache, nothing else to do.
-      return;
+      return false;
     } else if (marked == nullptr) {
       // Cache entry is empty, try to put `cls` in it.
       // Note: it's ok to spin on 'existing' here: if 'existing' is not null, that means
@@ -137,12 +140,13 @@ void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
         --i;
       } else {
         // We successfully set `cls`, just return.
-        return;
+        return false;
       }
     }
   }
   // Unsuccessfull - cache is full, making it megamorphic. We do not DCHECK it though,
   // as the garbage collector might clear the entries concurrently.
+  return true;
 }
 
 ScopedProfilingInfoUse::ScopedProfilingInfoUse(jit::Jit* jit, ArtMethod* method, Thread* self)
@@ -117,8 +117,9 @@ class ProfilingInfo {
                                       const std::vector<uint32_t>& inline_cache_entries)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Add information from an executed INVOKE instruction to the profile.
-  void AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls)
+  // Add information from an executed INVOKE instruction to the profile. Returns whether
+  // the inline cache is megamorphic, that is `cls` did not fit in it.
+  bool AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls)
       // Method should not be interruptible, as it manipulates the ProfilingInfo
       // which can be concurrently collected.
       REQUIRES(Roles::uninterruptible_)
@@ -177,6 +178,41 @@ class ProfilingInfo {
 
   static uint16_t GetOptimizeThreshold();
 
+  // Number of times optimized code compiled with this profile deoptimized and got
+  // thrown away.
+  uint16_t GetReoptimizationCount() const {
+    return reoptimization_count_;
+  }
+
+  uint16_t IncrementReoptimizationCount() {
+    if (reoptimization_count_ != std::numeric_limits<uint16_t>::max()) {
+      reoptimization_count_++;
+    }
+    return reoptimization_count_;
+  }
+
+  // Count a deoptimization of optimized code compiled with this profile. Returns true, and
+  // starts counting again, once `threshold` deoptimizations have been counted.
+  bool AddDeoptimization(uint16_t threshold) {
+    if (++deoptimization_count_ < threshold) {
+      return false;
+    }
+    deoptimization_count_ = 0;
+    return true;
+  }
+
+  // Number of optimized compilations of the method that went over the JIT compile time
+  // budget and got abandoned in favor of the baseline code.
+  uint16_t GetAbandonedCompilationCount() const {
+    return abandoned_compilation_count_;
+  }
+
+  void IncrementAbandonedCompilationCount() {
+    if (abandoned_compilation_count_ != std::numeric_limits<uint16_t>::max()) {
+      abandoned_compilation_count_++;
+    }
+  }
+
  private:
   ProfilingInfo(ArtMethod* method,
                 const std::vector<uint32_t>& inline_cache_entries,
@@ -202,6 +238,15 @@ class ProfilingInfo {
   // it updates this counter so that the GC does not try to clear the inline caches.
   uint16_t current_inline_uses_;
 
+  // See `GetReoptimizationCount`.
+  uint16_t reoptimization_count_;
+
+  // Deoptimizations since the last re-optimization. See `AddDeoptimization`.
+  uint16_t deoptimization_count_;
+
+  // See `GetAbandonedCompilationCount`.
+  uint16_t abandoned_compilation_count_;
+
   // Memory following the object:
   // - Dynamically allocated array of `InlineCache` of size `number_of_inline_caches_`.
   // - Dynamically allocated array of `BranchCache of size `number_of_branch_caches_`.
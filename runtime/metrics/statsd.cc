@@ -195,6 +195,27 @@ constexpr std::optional<int32_t> EncodeDatumId(DatumId datum_id) {
     case DatumId::kTimeElapsedDelta:
       return std::make_optional(
           statsd::ART_DATUM_DELTA_REPORTED__KIND__ART_DATUM_DELTA_TIME_ELAPSED_MS);
+    // Not reported to statsd (no atoms yet).
+    case DatumId::kGcSoftReferenceProcessingTime:
+    case DatumId::kGcWeakReferenceProcessingTime:
+    case DatumId::kGcFinalizerReferenceProcessingTime:
+    case DatumId::kGcPhantomReferenceProcessingTime:
+    case DatumId::kClassUnloadingTime:
+    case DatumId::kClassUnloadingReclaimedBytes:
+    case DatumId::kJitCodeCacheCollectionTime:
+    case DatumId::kJitCodeCacheReclaimedBytes:
+    case DatumId::kJitBaselineQueueWaitTime:
+    case DatumId::kJitOptimizedQueueWaitTime:
+    case DatumId::kJitOsrQueueWaitTime:
+    case DatumId::kJitActiveWorkersAvg:
+    case DatumId::kJitThreadPoolGrowCount:
+    case DatumId::kJitThreadPoolShrinkCount:
+    case DatumId::kJitReoptimizationInlineCache:
+    case DatumId::kJitReoptimizationMegamorphic:
+    case DatumId::kJitReoptimizationBoundsCheck:
+    case DatumId::kJitReoptimizationOther:
+    case DatumId::kJitReoptimizationCapReached:
+      return std::nullopt;
   }
 }
 
@@ -62,6 +62,10 @@ class MANAGED String final : public Object {
     return OFFSET_OF_OBJECT_MEMBER(String, count_);
   }
 
+  static constexpr MemberOffset HashCodeOffset() {
+    return OFFSET_OF_OBJECT_MEMBER(String, hash_code_);
+  }
+
   static constexpr MemberOffset ValueOffset() {
     return OFFSET_OF_OBJECT_MEMBER(String, value_);
   }
@@ -164,6 +164,12 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XX:HeapTargetUtilization=_")
           .WithType<double>().WithRange(0.1, 0.9)
           .IntoKey(M::HeapTargetUtilization)
+      .Define("-XX:GcCpuBudget=_")  // in percent of the process CPU time
+          .WithType<double>().WithRange(0.1, 100.0)
+          .IntoKey(M::GcCpuBudget)
+      .Define("-XX:GcPauseBudget=_")  // in ms
+          .WithType<MillisecondsToNanoseconds>()  // store as ns
+          .IntoKey(M::GcPauseBudget)
       .Define("-XX:ForegroundHeapGrowthMultiplier=_")
           .WithType<double>().WithRange(0.1, 5.0)
           .IntoKey(M::ForegroundHeapGrowthMultiplier)
@@ -230,6 +236,23 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
           .IntoKey(M::DumpRegionInfoBeforeGC)
       .Define("-XX:DumpRegionInfoAfterGC")
           .IntoKey(M::DumpRegionInfoAfterGC)
+      .Define("-XX:GcEventLogSize=_")
+          .WithType<unsigned int>()
+          .WithHelp("Keep a machine readable log of the last N GCs, with their phase timings.")
+          .IntoKey(M::GcEventLogSize)
+      .Define("-XX:GcEventStreamFile=_")
+          .WithType<std::string>()
+          .WithHelp("Also append every GC event logged by -XX:GcEventLogSize to this file.")
+          .IntoKey(M::GcEventStreamFile)
+      .Define("-XX:RosAllocBracketStats")
+          .WithHelp("Record per size bracket RosAlloc stats and dump them with the GC performance"
+                    " info.")
+          .IntoKey(M::RosAllocBracketStats)
+      .Define("-XX:RosAllocBracketSizes=_")
+          .WithHelp("Comma separated sizes of the RosAlloc brackets above 128 bytes, as suggested"
+                    " by the -XX:RosAllocBracketStats dump.")
+          .WithType<ParseIntList<','>>()
+          .IntoKey(M::RosAllocBracketSizes)
       .Define("-XX:DumpJITInfoOnShutdown")
           .IntoKey(M::DumpJITInfoOnShutdown)
       .Define("-XX:IgnoreMaxFootprint")
@@ -292,6 +315,29 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xjitzygotepthreadpriority:_")
           .WithType<int>()
           .IntoKey(M::JITZygotePoolThreadPthreadPriority)
+      .Define("-Xjitmaxthreads:_")
+          .WithType<unsigned int>().WithRange(1u, 64u)
+          .WithHelp("Maximum number of JIT threads. Above 1, the number of active JIT threads"
+                    " follows the compilation queue depth and the idle CPUs of the process.")
+          .IntoKey(M::JITPoolMaxThreads)
+      .Define("-Xjitmaxreoptimizations:_")
+          .WithType<unsigned int>()
+          .WithHelp("Maximum number of times optimized JIT code of a method can deoptimize and be"
+                    " recompiled with fresh profiling data. Past that, the method is kept in"
+                    " baseline code. 0 disables re-optimization.")
+          .IntoKey(M::JITMaxReoptimizations)
+      .Define("-Xjitcompilebudget:_")
+          .WithType<unsigned int>()
+          .WithHelp("Thread CPU time in milliseconds after which the JIT skips the expensive"
+                    " optimizations of a method. At twice that, a method that has baseline code"
+                    " keeps running it. 0, the default, disables the budget.")
+          .IntoKey(M::JITCompileBudget)
+      .Define("-Xjitwarmcache:_")
+          .WithType<std::string>()
+          .WithHelp("Record the methods compiled by the optimizing JIT in this file, and compile"
+                    " them at their first use in the next runs. Ignored, with a warning, in the"
+                    " zygote.")
+          .IntoKey(M::JITWarmCache)
       .Define("-Xjitsaveprofilinginfo")
           .WithType<ProfileSaverOptions>()
           .AppendValues()
@@ -332,7 +378,9 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
           .WithType<gc::space::LargeObjectSpaceType>()
           .WithValueMap({{"disabled", gc::space::LargeObjectSpaceType::kDisabled},
                          {"freelist", gc::space::LargeObjectSpaceType::kFreeList},
-                         {"map",      gc::space::LargeObjectSpaceType::kMap}})
+                         {"map",      gc::space::LargeObjectSpaceType::kMap},
+                         {"sizeclass", gc::space::LargeObjectSpaceType::kSizeClass},
+                         {"sizeclass_thp", gc::space::LargeObjectSpaceType::kSizeClassHugePages}})
           .IntoKey(M::LargeObjectSpace)
       .Define("-XX:LargeObjectThreshold=_")
           .WithType<Memory<1>>()
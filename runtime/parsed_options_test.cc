@@ -20,6 +20,7 @@
 
 #include "arch/instruction_set.h"
 #include "base/common_art_test.h"
+#include "jit/jit_options.h"
 
 namespace art HIDDEN {
 
@@ -64,6 +65,10 @@ TEST_F(ParsedOptionsTest, ParsedOptions) {
   options.push_back(std::make_pair("-Xmx4k", nullptr));
   options.push_back(std::make_pair("-Xss1m", nullptr));
   options.push_back(std::make_pair("-XX:HeapTargetUtilization=0.75", nullptr));
+  options.push_back(std::make_pair("-XX:GcCpuBudget=5", nullptr));
+  options.push_back(std::make_pair("-XX:GcPauseBudget=10", nullptr));
+  options.push_back(std::make_pair("-XX:GcEventLogSize=64", nullptr));
+  options.push_back(std::make_pair("-XX:GcEventStreamFile=/tmp/gc-events", nullptr));
   options.push_back(std::make_pair("-XX:StopForNativeAllocs=200m", nullptr));
   options.push_back(std::make_pair("-Dfoo=bar", nullptr));
   options.push_back(std::make_pair("-Dbaz=qux", nullptr));
@@ -95,6 +100,10 @@ TEST_F(ParsedOptionsTest, ParsedOptions) {
   EXPECT_PARSED_EQ(1 * MB, Opt::StackSize);
   EXPECT_PARSED_EQ(200 * MB, Opt::StopForNativeAllocs);
   EXPECT_DOUBLE_EQ(0.75, map.GetOrDefault(Opt::HeapTargetUtilization));
+  EXPECT_DOUBLE_EQ(5.0, map.GetOrDefault(Opt::GcCpuBudget));
+  EXPECT_EQ(MsToNs(10), map.GetOrDefault(Opt::GcPauseBudget).GetNanoseconds());
+  EXPECT_PARSED_EQ(64u, Opt::GcEventLogSize);
+  EXPECT_PARSED_EQ(std::string("/tmp/gc-events"), Opt::GcEventStreamFile);
   EXPECT_TRUE(reinterpret_cast<void*>(test_vfprintf) == map.GetOrDefault(Opt::HookVfprintf));
   EXPECT_TRUE(reinterpret_cast<void*>(test_exit) == map.GetOrDefault(Opt::HookExit));
   EXPECT_TRUE(reinterpret_cast<void*>(test_abort) == map.GetOrDefault(Opt::HookAbort));
@@ -152,6 +161,84 @@ TEST_F(ParsedOptionsTest, ParsedOptionsGenerationalCC) {
   ASSERT_TRUE(xgc.generational_cc);
 }
 
+TEST_F(ParsedOptionsTest, ParsedOptionsGenerationalCMC) {
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xgc:CMC,generational_cmc", nullptr));
+
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  ASSERT_NE(0u, map.Size());
+
+  using Opt = RuntimeArgumentMap;
+
+  EXPECT_TRUE(map.Exists(Opt::GcOption));
+
+  XGcOption xgc = map.GetOrDefault(Opt::GcOption);
+  ASSERT_EQ(gc::kCollectorTypeCMC, xgc.collector_type_);
+  ASSERT_TRUE(xgc.generational_cmc);
+}
+
+TEST_F(ParsedOptionsTest, ParsedOptionsNumaAware) {
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xgc:CC,numa_aware", nullptr));
+
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  ASSERT_NE(0u, map.Size());
+
+  using Opt = RuntimeArgumentMap;
+
+  EXPECT_TRUE(map.Exists(Opt::GcOption));
+
+  XGcOption xgc = map.GetOrDefault(Opt::GcOption);
+  ASSERT_EQ(gc::kCollectorTypeCC, xgc.collector_type_);
+  ASSERT_TRUE(xgc.numa_aware_);
+}
+
+TEST_F(ParsedOptionsTest, ParsedOptionsRosAllocBracketSizes) {
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-XX:RosAllocBracketStats", nullptr));
+  options.push_back(std::make_pair("-XX:RosAllocBracketSizes=144,160,2048", nullptr));
+
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+
+  using Opt = RuntimeArgumentMap;
+
+  EXPECT_TRUE(map.Exists(Opt::RosAllocBracketStats));
+  std::vector<int> sizes = map.GetOrDefault(Opt::RosAllocBracketSizes);
+  EXPECT_EQ((std::vector<int>{144, 160, 2048}), sizes);
+}
+
+TEST_F(ParsedOptionsTest, ParsedOptionsJitWarmCache) {
+  using Opt = RuntimeArgumentMap;
+
+  {
+    // Nothing set, no warm cache.
+    RuntimeOptions options;
+    RuntimeArgumentMap map;
+    bool parsed = ParsedOptions::Parse(options, false, &map);
+    ASSERT_TRUE(parsed);
+    EXPECT_FALSE(map.Exists(Opt::JITWarmCache));
+    std::unique_ptr<jit::JitOptions> jit_options(
+        jit::JitOptions::CreateFromRuntimeArguments(map));
+    EXPECT_TRUE(jit_options->GetWarmCachePath().empty());
+  }
+
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xjitwarmcache:/data/misc/jit/warm.cache", nullptr));
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  EXPECT_TRUE(map.Exists(Opt::JITWarmCache));
+  EXPECT_EQ("/data/misc/jit/warm.cache", map.GetOrDefault(Opt::JITWarmCache));
+  std::unique_ptr<jit::JitOptions> jit_options(jit::JitOptions::CreateFromRuntimeArguments(map));
+  EXPECT_EQ("/data/misc/jit/warm.cache", jit_options->GetWarmCachePath());
+}
+
 TEST_F(ParsedOptionsTest, ParsedOptionsInstructionSet) {
   using Opt = RuntimeArgumentMap;
 
@@ -752,6 +752,7 @@ void QuickExceptionHandler::DeoptimizeSingleFrame(DeoptimizationKind kind) {
   // If the deoptimization is due to an inline cache, update it with the type
   // that made us deoptimize. This avoids pathological cases of never seeing
   // that type while executing baseline generated code.
+  bool megamorphic = false;
   if (kind == DeoptimizationKind::kJitInlineCache || kind == DeoptimizationKind::kJitSameTarget) {
     DCHECK(runtime->UseJitCompilation());
     ShadowFrame* shadow_frame = visitor.GetBottomShadowFrame();
@@ -770,7 +771,7 @@ void QuickExceptionHandler::DeoptimizeSingleFrame(DeoptimizationKind kind) {
             runtime->GetJit()->GetJitCompiler()->GetInlineMaxCodeUnits());
         if (encoded_dex_pc != static_cast<uint32_t>(-1)) {
           // The inline cache comes from the top-level method.
-          runtime->GetJit()->GetCodeCache()->MaybeUpdateInlineCache(
+          megamorphic = runtime->GetJit()->GetCodeCache()->MaybeUpdateInlineCache(
               visitor.GetSingleFrameDeoptMethod(),
               encoded_dex_pc,
               shadow_frame->GetVRegReference(inst->VRegC())->GetClass(),
@@ -778,7 +779,7 @@ void QuickExceptionHandler::DeoptimizeSingleFrame(DeoptimizationKind kind) {
         } else {
           // If the top-level inline cache did not exist, update the one for the
           // bottom method, we know it's the one that was used for compilation.
-          runtime->GetJit()->GetCodeCache()->MaybeUpdateInlineCache(
+          megamorphic = runtime->GetJit()->GetCodeCache()->MaybeUpdateInlineCache(
               shadow_frame->GetMethod(),
               dex_pc,
               shadow_frame->GetVRegReference(inst->VRegC())->GetClass(),
@@ -792,6 +793,16 @@ void QuickExceptionHandler::DeoptimizeSingleFrame(DeoptimizationKind kind) {
     }
   }
 
+  // Now that the profile knows about what made us deoptimize, give the JIT a chance
+  // to recompile the method with it.
+  if (runtime->UseJitCompilation() && (kind != DeoptimizationKind::kDebugging)) {
+    runtime->GetJit()->NotifyDeoptimization(deopt_method,
+                                            visitor.GetSingleFrameDeoptQuickMethodHeader(),
+                                            kind,
+                                            megamorphic,
+                                            self_);
+  }
+
   PrepareForLongJumpToInvokeStubOrInterpreterBridge();
 }
 
@@ -81,6 +81,7 @@
 #include "experimental_flags.h"
 #include "fault_handler.h"
 #include "gc/accounting/card_table-inl.h"
+#include "gc/allocator/rosalloc.h"
 #include "gc/heap.h"
 #include "gc/scoped_gc_critical_section.h"
 #include "gc/space/image_space.h"
@@ -1273,6 +1274,16 @@ void Runtime::InitNonZygoteOrPostFork(
     thread_pool_->StartWorkers(Thread::Current());
   }
 
+  // Create the heap thread pool for the parallel marking workers of the concurrent copying
+  // collector, if requested with -XX:ConcGCThreads. It can't be created before the zygote
+  // forks, which requires the zygote to be single-threaded.
+  if (heap_->CurrentCollectorType() == gc::kCollectorTypeCC &&
+      heap_->GetConcGCThreadCount() > 0 &&
+      heap_->GetThreadPool() == nullptr) {
+    ScopedTrace timing("CreateHeapThreadPool");
+    heap_->CreateThreadPool(heap_->GetConcGCThreadCount());
+  }
+
   // Reset the gc performance data and metrics at zygote fork so that the events from
   // before fork aren't attributed to an app.
   heap_->ResetGcPerformanceInfo();
@@ -1743,6 +1754,8 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
 
   // Generational CC collection is currently only compatible with Baker read barriers.
   bool use_generational_cc = kUseBakerReadBarrier && xgc_option.generational_cc;
+  // Generational CMC collection requires the userfaultfd based mark-compact collector.
+  bool use_generational_cmc = gUseUserfaultfd && xgc_option.generational_cmc;
 
   // Cache the apex versions.
   InitializeApexVersions();
@@ -1752,12 +1765,23 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
                         (gUseUserfaultfd ? BackgroundGcOption(gc::kCollectorTypeCMCBackground) :
                                            runtime_options.GetOrDefault(Opt::BackgroundGc));
 
+  gc::allocator::RosAlloc::SetRecordBracketStats(runtime_options.Exists(Opt::RosAllocBracketStats));
+  if (runtime_options.Exists(Opt::RosAllocBracketSizes)) {
+    std::string error_msg;
+    if (!gc::allocator::RosAlloc::SetSharedBracketSizes(
+            runtime_options.ReleaseOrDefault(Opt::RosAllocBracketSizes), &error_msg)) {
+      LOG(WARNING) << "Ignoring -XX:RosAllocBracketSizes: " << error_msg;
+    }
+  }
+
   heap_ = new gc::Heap(runtime_options.GetOrDefault(Opt::MemoryInitialSize),
                        runtime_options.GetOrDefault(Opt::HeapGrowthLimit),
                        runtime_options.GetOrDefault(Opt::HeapMinFree),
                        runtime_options.GetOrDefault(Opt::HeapMaxFree),
                        runtime_options.GetOrDefault(Opt::HeapTargetUtilization),
                        foreground_heap_growth_multiplier,
+                       runtime_options.GetOrDefault(Opt::GcCpuBudget) / 100.0,
+                       runtime_options.GetOrDefault(Opt::GcPauseBudget),
                        runtime_options.GetOrDefault(Opt::StopForNativeAllocs),
                        runtime_options.GetOrDefault(Opt::MemoryMaximumSize),
                        runtime_options.GetOrDefault(Opt::NonMovingSpaceCapacity),
@@ -1792,9 +1816,13 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
                        xgc_option.measure_,
                        runtime_options.GetOrDefault(Opt::EnableHSpaceCompactForOOM),
                        use_generational_cc,
+                       use_generational_cmc,
+                       xgc_option.numa_aware_,
                        runtime_options.GetOrDefault(Opt::HSpaceCompactForOOMMinIntervalsMs),
                        runtime_options.Exists(Opt::DumpRegionInfoBeforeGC),
-                       runtime_options.Exists(Opt::DumpRegionInfoAfterGC));
+                       runtime_options.Exists(Opt::DumpRegionInfoAfterGC),
+                       runtime_options.GetOrDefault(Opt::GcEventLogSize),
+                       runtime_options.GetOrDefault(Opt::GcEventStreamFile));
 
   dump_gc_performance_on_shutdown_ = runtime_options.Exists(Opt::DumpGCPerformanceOnShutdown);
 
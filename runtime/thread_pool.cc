@@ -205,6 +205,7 @@ AbstractThreadPool::AbstractThreadPool(const char* name,
     total_wait_time_(0),
     creation_barier_(0),
     max_active_workers_(num_threads),
+    num_threads_(num_threads),
     create_peers_(create_peers),
     worker_stack_size_(worker_stack_size) {}
 
@@ -215,8 +216,8 @@ void AbstractThreadPool::CreateThreads() {
     MutexLock mu(self, task_queue_lock_);
     shutting_down_ = false;
     // Add one since the caller of constructor waits on the barrier too.
-    creation_barier_.Init(self, max_active_workers_);
-    while (GetThreadCount() < max_active_workers_) {
+    creation_barier_.Init(self, num_threads_);
+    while (GetThreadCount() < num_threads_) {
       const std::string worker_name = StringPrintf("%s worker thread %zu", name_.c_str(),
                                                    GetThreadCount());
       threads_.push_back(
@@ -252,8 +253,17 @@ void AbstractThreadPool::DeleteThreads() {
 }
 
 void AbstractThreadPool::SetMaxActiveWorkers(size_t max_workers) {
-  MutexLock mu(Thread::Current(), task_queue_lock_);
-  CHECK_LE(max_workers, GetThreadCount());
+  Thread* self = Thread::Current();
+  MutexLock mu(self, task_queue_lock_);
+  SetMaxActiveWorkersLocked(self, max_workers);
+}
+
+void AbstractThreadPool::SetMaxActiveWorkersLocked(Thread* self, size_t max_workers) {
+  CHECK_LE(max_workers, num_threads_);
+  if (max_workers > max_active_workers_ && waiting_count_ != 0) {
+    // Workers may be waiting because of the previous limit.
+    task_queue_condition_.Broadcast(self);
+  }
   max_active_workers_ = max_workers;
 }
 
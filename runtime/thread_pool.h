@@ -183,6 +183,10 @@ class AbstractThreadPool {
 
   virtual bool HasOutstandingTasks() const REQUIRES(task_queue_lock_) = 0;
 
+  // Same as SetMaxActiveWorkers(), with the lock held. Wakes up waiting workers if the
+  // limit grows.
+  void SetMaxActiveWorkersLocked(Thread* self, size_t threads) REQUIRES(task_queue_lock_);
+
   EXPORT AbstractThreadPool(const char* name,
                             size_t num_threads,
                             bool create_peers,
@@ -202,6 +206,8 @@ class AbstractThreadPool {
   uint64_t total_wait_time_;
   Barrier creation_barier_;
   size_t max_active_workers_ GUARDED_BY(task_queue_lock_);
+  // The number of threads created by CreateThreads(), an upper bound for max_active_workers_.
+  const size_t num_threads_;
   const bool create_peers_;
   const size_t worker_stack_size_;
 
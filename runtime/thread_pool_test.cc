@@ -101,6 +101,59 @@ TEST_F(ThreadPoolTest, StopStart) {
   thread_pool->Wait(self, false, false);
 }
 
+class ConcurrencyTask : public Task {
+ public:
+  ConcurrencyTask(AtomicInteger* running, AtomicInteger* max_running, AtomicInteger* count)
+      : running_(running), max_running_(max_running), count_(count) {}
+
+  void Run([[maybe_unused]] Thread* self) override {
+    int32_t running = ++*running_;
+    int32_t max_running = max_running_->load(std::memory_order_seq_cst);
+    while (running > max_running &&
+           !max_running_->compare_exchange_weak(max_running, running)) {}
+    usleep(100);
+    --*running_;
+    ++*count_;
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  AtomicInteger* const running_;
+  AtomicInteger* const max_running_;
+  AtomicInteger* const count_;
+};
+
+// Check that the number of active workers can be lowered and raised again.
+TEST_F(ThreadPoolTest, MaxActiveWorkers) {
+  Thread* self = Thread::Current();
+  std::unique_ptr<ThreadPool> thread_pool(
+      ThreadPool::Create("Thread pool test thread pool", num_threads));
+  thread_pool->SetMaxActiveWorkers(1);
+  AtomicInteger running(0);
+  AtomicInteger max_running(0);
+  AtomicInteger count(0);
+  static const int32_t num_tasks = num_threads * 4;
+  for (int32_t i = 0; i < num_tasks; ++i) {
+    thread_pool->AddTask(self, new ConcurrencyTask(&running, &max_running, &count));
+  }
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, false, false);
+  EXPECT_EQ(num_tasks, count.load(std::memory_order_seq_cst));
+  EXPECT_EQ(1, max_running.load(std::memory_order_seq_cst));
+
+  // Raising the limit lets the waiting workers run tasks again.
+  thread_pool->SetMaxActiveWorkers(num_threads);
+  for (int32_t i = 0; i < num_tasks; ++i) {
+    thread_pool->AddTask(self, new ConcurrencyTask(&running, &max_running, &count));
+  }
+  thread_pool->Wait(self, false, false);
+  EXPECT_EQ(2 * num_tasks, count.load(std::memory_order_seq_cst));
+  EXPECT_LE(max_running.load(std::memory_order_seq_cst), num_threads);
+}
+
 TEST_F(ThreadPoolTest, StopWait) {
   Thread* self = Thread::Current();
   std::unique_ptr<ThreadPool> thread_pool(
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+  int threshold;
+  int count;
+
+  static int calls;
+
+  static class Listener {
+    void onValue$noinline$(int value) {
+      calls++;
+    }
+  }
+
+  // Only loaded once `sumWithListener` got compiled with the assumption that
+  // `Listener.onValue$noinline$` has a single implementation.
+  static class ResettingListener extends Listener {
+    private final Main main;
+
+    ResettingListener(Main main) {
+      this.main = main;
+    }
+
+    @Override
+    void onValue$noinline$(int value) {
+      main.threshold = 0;
+    }
+  }
+
+  /// CHECK-START: int Main.sumBelowThreshold(int[]) licm (before)
+  /// CHECK-DAG: InstanceFieldGet field_name:Main.threshold loop:{{B\d+}}
+  /// CHECK-DAG: InstanceFieldSet field_name:Main.count loop:{{B\d+}}
+
+  /// CHECK-START: int Main.sumBelowThreshold(int[]) licm (after)
+  /// CHECK-DAG: InstanceFieldGet field_name:Main.threshold loop:none
+  /// CHECK-DAG: InstanceFieldSet field_name:Main.count loop:{{B\d+}}
+
+  int sumBelowThreshold(int[] values) {
+    int sum = 0;
+    for (int value : values) {
+      // The write of `count` does not prevent hoisting the load of `threshold`,
+      // although both fields have the same type.
+      if (value < threshold) {
+        sum += value;
+        count++;
+      }
+    }
+    return sum;
+  }
+
+  /// CHECK-START: int Main.lowerThreshold(int[]) licm (after)
+  /// CHECK-DAG: InstanceFieldGet field_name:Main.threshold loop:{{B\d+}}
+
+  int lowerThreshold(int[] values) {
+    int sum = 0;
+    for (int value : values) {
+      if (value < threshold) {
+        sum += value;
+        threshold = value;
+      }
+    }
+    return sum;
+  }
+
+  /// CHECK-START: int Main.sumWithListener(int[], Main$Listener) licm (after)
+  /// CHECK-DAG: InstanceFieldGet field_name:Main.threshold loop:{{B\d+}}
+
+  int sumWithListener(int[] values, Listener listener) {
+    // AOT code keeps the load in the loop because of the call. The JIT hoists it
+    // as `Listener.onValue$noinline$` does not write `threshold`, guarded by the
+    // class hierarchy analysis of that method.
+    int sum = 0;
+    for (int value : values) {
+      if (value < threshold) {
+        sum += value;
+      }
+      listener.onValue$noinline$(value);
+    }
+    return sum;
+  }
+
+  public static void main(String[] args) {
+    System.loadLibrary(args[0]);
+    int[] values = { 1, 7, 3, 9, 4 };
+    Main main = new Main();
+
+    main.threshold = 5;
+    assertEquals(8, main.sumBelowThreshold(values));
+    assertEquals(3, main.count);
+
+    assertEquals(1, main.lowerThreshold(values));
+    assertEquals(1, main.threshold);
+
+    main.threshold = 5;
+    Listener listener = new Listener();
+    for (int i = 0; i < 10; ++i) {
+      assertEquals(8, main.sumWithListener(values, listener));
+    }
+    ensureJitCompiled(Main.class, "sumWithListener");
+    assertEquals(8, main.sumWithListener(values, listener));
+    assertEquals(55, calls);
+
+    // The listener writes `threshold` after the first value.
+    assertEquals(1, main.sumWithListener(values, new ResettingListener(main)));
+    assertEquals(0, main.threshold);
+
+    System.out.println("passed");
+  }
+
+  private static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected: " + expected + ", found: " + actual);
+    }
+  }
+
+  private static native void ensureJitCompiled(Class<?> cls, String methodName);
+}
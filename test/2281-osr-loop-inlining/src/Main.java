@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+  static int setupCalls;
+
+  static int setup(int value) {
+    setupCalls++;
+    return value * 2;
+  }
+
+  static int mix(int value, int seed) {
+    int result = value ^ seed;
+    result = (result << 5) - result;
+    result ^= result >>> 7;
+    return result + (value & 3);
+  }
+
+  static int finish(int sum, int count) {
+    return sum + count * 17;
+  }
+
+  static int $noinline$sum(int count) {
+    // Outside of loops: not inlined when compiling OSR.
+    int seed = setup(21);
+    int sum = 0;
+    int i = 0;
+    for (; i < count; ++i) {
+      sum += mix(i, seed);
+      if (i == count / 2) {
+        ensureHasOsrCode("$noinline$sum");
+      }
+    }
+    // Runs in OSR code after the loop, if the method was interpreted.
+    return finish(sum, i);
+  }
+
+  static int expectedSum(int count) {
+    int seed = 42;
+    int sum = 0;
+    for (int i = 0; i < count; ++i) {
+      int result = i ^ seed;
+      result = (result << 5) - result;
+      result ^= result >>> 7;
+      sum += result + (i & 3);
+    }
+    return sum + count * 17;
+  }
+
+  public static void main(String[] args) {
+    System.loadLibrary(args[0]);
+    int count = 100000;
+    assertEquals(expectedSum(count), $noinline$sum(count));
+    assertEquals(1, setupCalls);
+    System.out.println("passed");
+  }
+
+  private static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected: " + expected + ", found: " + actual);
+    }
+  }
+
+  private static native void ensureHasOsrCode(String methodName);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  /// CHECK-START-X86_64: void Main.addInts(int[], int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature('avx2')
+  //
+  ///     CHECK-DAG: <<Eight:i\d+>> IntConstant 8                          loop:none
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                    loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld1:d\d+>>   VecLoad [{{l\d+}},<<Phi>>]             loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Ld2:d\d+>>   VecLoad [{{l\d+}},<<Phi>>]             loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Add:d\d+>>   VecAdd [<<Ld1>>,<<Ld2>>]               loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                VecStore [{{l\d+}},<<Phi>>,<<Add>>]    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                Add [<<Phi>>,<<Eight>>]                loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  public static void addInts(int[] a, int[] b, int[] c) {
+    for (int i = 0; i < c.length; i++) {
+      c[i] = a[i] + b[i];
+    }
+  }
+
+  /// CHECK-START-X86_64: void Main.scaleFloats(float[], float) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature('avx2')
+  //
+  ///     CHECK-DAG: <<Eight:i\d+>> IntConstant 8                          loop:none
+  ///     CHECK-DAG: <<Repl:d\d+>>  VecReplicateScalar                     loop:none
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                    loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld:d\d+>>    VecLoad [{{l\d+}},<<Phi>>]             loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Mul:d\d+>>   VecMul [<<Ld>>,<<Repl>>]               loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                VecStore [{{l\d+}},<<Phi>>,<<Mul>>]    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                Add [<<Phi>>,<<Eight>>]                loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  public static void scaleFloats(float[] a, float f) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] *= f;
+    }
+  }
+
+  /// CHECK-START-X86_64: void Main.shiftLongs(long[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature('avx2')
+  //
+  ///     CHECK-DAG: <<Four:i\d+>>  IntConstant 4                          loop:none
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                    loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Ld:d\d+>>    VecLoad [{{l\d+}},<<Phi>>]             loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Shl:d\d+>>   VecShl [<<Ld>>,{{i\d+}}]               loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                VecStore [{{l\d+}},<<Phi>>,<<Shl>>]    loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                Add [<<Phi>>,<<Four>>]                 loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  public static void shiftLongs(long[] a) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] <<= 3;
+    }
+  }
+
+  // Reductions only have 128-bit code generation, so this method keeps the narrower vectors.
+
+  /// CHECK-START-X86_64: int Main.sumInts(int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature('avx2')
+  //
+  ///     CHECK-DAG: <<Four:i\d+>>  IntConstant 4                          loop:none
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                    loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG:                VecAdd                                 loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                Add [<<Phi>>,<<Four>>]                 loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  public static int sumInts(int[] a) {
+    int sum = 0;
+    for (int i = 0; i < a.length; i++) {
+      sum += a[i];
+    }
+    return sum;
+  }
+
+  public static void main(String[] args) {
+    // Cover trip counts with and without a cleanup loop.
+    for (int n = 0; n <= 67; n++) {
+      int[] a = new int[n];
+      int[] b = new int[n];
+      int[] c = new int[n];
+      float[] f = new float[n];
+      long[] l = new long[n];
+      int expectedSum = 0;
+      for (int i = 0; i < n; i++) {
+        a[i] = i * 7 - 100;
+        b[i] = 3 - i * i;
+        f[i] = i * 0.5f;
+        l[i] = (long) i << 40;
+        expectedSum += a[i];
+      }
+      addInts(a, b, c);
+      scaleFloats(f, 3.0f);
+      shiftLongs(l);
+      for (int i = 0; i < n; i++) {
+        expectEquals(a[i] + b[i], c[i]);
+        expectEquals(i * 1.5f, f[i]);
+        expectEquals((long) i << 43, l[i]);
+      }
+      expectEquals(expectedSum, sumInts(a));
+    }
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(float expected, float result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
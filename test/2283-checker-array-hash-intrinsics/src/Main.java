@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.Arrays;
+
+public class Main {
+
+  /// CHECK-START: int Main.stringHashCode(java.lang.String) builder (after)
+  /// CHECK: InvokeVirtual intrinsic:StringHashCode
+  public static int stringHashCode(String s) {
+    return s.hashCode();
+  }
+
+  /// CHECK-START: int Main.arraysHashCode(byte[]) builder (after)
+  /// CHECK: InvokeStaticOrDirect intrinsic:ArraysHashCodeByte
+  public static int arraysHashCode(byte[] a) {
+    return Arrays.hashCode(a);
+  }
+
+  /// CHECK-START: boolean Main.arraysEquals(byte[], byte[]) builder (after)
+  /// CHECK: InvokeStaticOrDirect intrinsic:ArraysEqualsByte
+  public static boolean arraysEquals(byte[] a, byte[] b) {
+    return Arrays.equals(a, b);
+  }
+
+  private static int referenceHashCode(String s) {
+    int h = 0;
+    for (int i = 0; i < s.length(); i++) {
+      h = 31 * h + s.charAt(i);
+    }
+    return h;
+  }
+
+  private static int referenceHashCode(byte[] a) {
+    if (a == null) {
+      return 0;
+    }
+    int h = 1;
+    for (byte b : a) {
+      h = 31 * h + b;
+    }
+    return h;
+  }
+
+  public static void main(String[] args) {
+    testStringHashCode();
+    testArraysHashCode();
+    testArraysEquals();
+    System.out.println("passed");
+  }
+
+  private static void testStringHashCode() {
+    expectEquals(0, stringHashCode(""));
+    StringBuilder compressed = new StringBuilder();
+    StringBuilder uncompressed = new StringBuilder();
+    for (int length = 1; length <= 100; length++) {
+      compressed.append((char) ('!' + (length * 7) % 90));
+      uncompressed.append((char) (0x100 + length * 1031));
+      // Use new strings to avoid a hash code cached by an earlier call.
+      String c = new String(compressed);
+      String u = new String(uncompressed);
+      expectEquals(referenceHashCode(c), stringHashCode(c));
+      expectEquals(referenceHashCode(u), stringHashCode(u));
+      // The second call returns the cached hash code.
+      expectEquals(referenceHashCode(u), stringHashCode(u));
+    }
+  }
+
+  private static void testArraysHashCode() {
+    expectEquals(0, arraysHashCode(null));
+    for (int length = 0; length <= 100; length++) {
+      byte[] a = new byte[length];
+      for (int i = 0; i < length; i++) {
+        // Include negative values to exercise the sign extension.
+        a[i] = (byte) (i * 37 + length);
+      }
+      expectEquals(referenceHashCode(a), arraysHashCode(a));
+    }
+  }
+
+  private static void testArraysEquals() {
+    expectEquals(true, arraysEquals(null, null));
+    expectEquals(false, arraysEquals(new byte[0], null));
+    expectEquals(false, arraysEquals(null, new byte[0]));
+    expectEquals(false, arraysEquals(new byte[3], new byte[4]));
+    for (int length = 0; length <= 70; length++) {
+      byte[] a = new byte[length];
+      for (int i = 0; i < length; i++) {
+        a[i] = (byte) (i * 13 - 60);
+      }
+      byte[] b = a.clone();
+      expectEquals(true, arraysEquals(a, a));
+      expectEquals(true, arraysEquals(a, b));
+      // A difference at any position must be found.
+      for (int i = 0; i < length; i++) {
+        b[i] ^= (byte) 0x80;
+        expectEquals(false, arraysEquals(a, b));
+        b[i] = a[i];
+      }
+    }
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(boolean expected, boolean result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import java.util.Random;
+import java.util.zip.Adler32;
+
+/**
+ * The ART compiler can use intrinsics for the java.util.zip.Adler32 methods:
+ *   private native static int update(int adler, int b)
+ *   private native static int updateBytes(int adler, byte[] b, int off, int len)
+ *   private native static int updateByteBuffer(int adler, long addr, int off, int len)
+ *
+ * As the methods are private it is not possible to check the use of intrinsics
+ * for them directly.
+ * The tests check that correct checksums are produced.
+ */
+public class Main {
+  private static final int BASE = 65521;
+
+  // Straightforward implementation of the Adler-32 checksum.
+  private static long Adler32Reference(byte[] bytes, int off, int len) {
+    long a = 1;
+    long b = 0;
+    for (int i = off; i < off + len; ++i) {
+      a = (a + (bytes[i] & 0xff)) % BASE;
+      b = (b + a) % BASE;
+    }
+    return (b << 16) | a;
+  }
+
+  private static long Adler32UsingUpdateInt(byte[] bytes, int off, int len) {
+    Adler32 adler32 = new Adler32();
+    for (int i = off; i < off + len; ++i) {
+      adler32.update(bytes[i]);
+    }
+    return adler32.getValue();
+  }
+
+  private static long Adler32ByteArray(byte[] bytes, int off, int len) {
+    Adler32 adler32 = new Adler32();
+    adler32.update(bytes, off, len);
+    return adler32.getValue();
+  }
+
+  private static long Adler32ByteBuffer(byte[] bytes, int off, int len) {
+    ByteBuffer buf = ByteBuffer.wrap(bytes, 0, off + len);
+    buf.position(off);
+    Adler32 adler32 = new Adler32();
+    adler32.update(buf);
+    return adler32.getValue();
+  }
+
+  private static long Adler32DirectByteBuffer(byte[] bytes, int off, int len) {
+    final int total_len = off + len;
+    ByteBuffer buf = ByteBuffer.allocateDirect(total_len).put(bytes, 0, total_len);
+    buf.position(off);
+    Adler32 adler32 = new Adler32();
+    adler32.update(buf);
+    return adler32.getValue();
+  }
+
+  private static boolean Adler32ByteArrayThrowsAIOOBE(byte[] bytes, int off, int len) {
+    try {
+      Adler32 adler32 = new Adler32();
+      adler32.update(bytes, off, len);
+    } catch (ArrayIndexOutOfBoundsException ex) {
+      return true;
+    }
+    return false;
+  }
+
+  public static void assertEqual(long expected, long actual) {
+    if (expected != actual) {
+      throw new Error("Expected: " + expected + ", found: " + actual);
+    }
+  }
+
+  private static void assertEqual(boolean expected, boolean actual) {
+    if (expected != actual) {
+      throw new Error("Expected: " + expected + ", found: " + actual);
+    }
+  }
+
+  private static void TestAdler32Update(byte[] bytes) {
+    assertEqual(1L, Adler32UsingUpdateInt(bytes, 0, 0));
+    // Only the low byte of the argument is used.
+    Adler32 adler32 = new Adler32();
+    adler32.update(0x1ff);
+    assertEqual(Adler32Reference(new byte[] {-1}, 0, 1), adler32.getValue());
+
+    // Bytes of 0xff reach the modulo quickly.
+    byte[] ones = new byte[1000];
+    Arrays.fill(ones, (byte) -1);
+    assertEqual(Adler32Reference(ones, 0, ones.length),
+                Adler32UsingUpdateInt(ones, 0, ones.length));
+
+    for (int len = 0; len <= 300; ++len) {
+      assertEqual(Adler32Reference(bytes, 3, len), Adler32UsingUpdateInt(bytes, 3, len));
+    }
+  }
+
+  private static void TestAdler32UpdateBytes(byte[] bytes) {
+    assertEqual(1L, Adler32ByteArray(new byte[] {}, 0, 0));
+    assertEqual(1L, Adler32ByteArray(new byte[] {0}, 1, 0));
+    assertEqual(true, Adler32ByteArrayThrowsAIOOBE(new byte[] {0}, 0, 2));
+    assertEqual(true, Adler32ByteArrayThrowsAIOOBE(new byte[] {0}, -1, 1));
+    assertEqual(true, Adler32ByteArrayThrowsAIOOBE(new byte[] {0}, 0, -1));
+
+    // Lengths around the threshold for using the library and around the largest
+    // number of bytes processed without reducing the sums.
+    for (int off = 0; off < 4; ++off) {
+      for (int len = 0; len <= 1100; ++len) {
+        assertEqual(Adler32Reference(bytes, off, len), Adler32ByteArray(bytes, off, len));
+      }
+    }
+    for (int len = 5500; len <= 5600; ++len) {
+      assertEqual(Adler32Reference(bytes, 1, len), Adler32ByteArray(bytes, 1, len));
+    }
+    assertEqual(Adler32Reference(bytes, 0, bytes.length),
+                Adler32ByteArray(bytes, 0, bytes.length));
+
+    byte[] ones = new byte[5600];
+    Arrays.fill(ones, (byte) -1);
+    for (int len = 1000; len <= 1100; ++len) {
+      assertEqual(Adler32Reference(ones, 0, len), Adler32ByteArray(ones, 0, len));
+    }
+    assertEqual(Adler32Reference(ones, 0, ones.length), Adler32ByteArray(ones, 0, ones.length));
+
+    // Checksums continued from a previous state.
+    Adler32 adler32 = new Adler32();
+    adler32.update(bytes, 0, 700);
+    adler32.update(bytes, 700, 700);
+    assertEqual(Adler32Reference(bytes, 0, 1400), adler32.getValue());
+  }
+
+  private static void TestAdler32UpdateByteBuffer(byte[] bytes) {
+    for (int off = 0; off < 4; ++off) {
+      for (int len = 0; len <= 1100; len += 7) {
+        assertEqual(Adler32Reference(bytes, off, len), Adler32ByteBuffer(bytes, off, len));
+        assertEqual(Adler32Reference(bytes, off, len), Adler32DirectByteBuffer(bytes, off, len));
+      }
+    }
+    assertEqual(Adler32Reference(bytes, 0, bytes.length),
+                Adler32DirectByteBuffer(bytes, 0, bytes.length));
+  }
+
+  public static void main(String args[]) {
+    byte[] bytes = new byte[16 * 1024];
+    Random rnd = new Random(0);
+    rnd.nextBytes(bytes);
+
+    TestAdler32Update(bytes);
+    TestAdler32UpdateBytes(bytes);
+    TestAdler32UpdateByteBuffer(bytes);
+  }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+class Main {
+  // Each call site has its own inline cache, so each can make the optimized code deoptimize
+  // once.
+  public static int $noinline$foo(Main a, Main b) {
+    return a.value() + b.value();
+  }
+
+  public static void main(String[] args) throws Throwable {
+    System.loadLibrary(args[0]);
+    if (!hasJit() || isDebuggable()) {
+      // We do not deoptimize with inline caches when the app is debuggable, so just don't run the
+      // test.
+      return;
+    }
+
+    ensureJitBaselineCompiled(Main.class, "$noinline$foo");
+    // Surround the call with GCs to increase chances we execute $noinline$foo
+    // while the GC isn't marking. This makes sure the inline caches are populated.
+    Runtime.getRuntime().gc();
+    assertEquals(2, $noinline$foo(new Main(), new Main()));
+    Runtime.getRuntime().gc();
+
+    // The first deoptimization only updates the inline cache of the first call site. The method
+    // is not compiled again until it gets hot.
+    ensureJitCompiled(Main.class, "$noinline$foo");
+    assertEquals(3, $noinline$foo(new SubMain(), new Main()));
+    waitForCompilation();
+    if (hasJitCompiledEntrypoint(Main.class, "$noinline$foo")) {
+      throw new Error("Expected $noinline$foo to stay in the interpreter after one deoptimization");
+    }
+
+    // The second deoptimization, at the second call site, makes the JIT compile the method again
+    // without waiting for it to get hot.
+    ensureJitCompiled(Main.class, "$noinline$foo");
+    assertEquals(3, $noinline$foo(new Main(), new SubMain()));
+    waitForCompilation();
+    if (!hasJitCompiledEntrypoint(Main.class, "$noinline$foo")) {
+      throw new Error("Expected $noinline$foo to be compiled again after two deoptimizations");
+    }
+  }
+
+  public static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected + ", got " + actual);
+    }
+  }
+
+  public int value() {
+    return 1;
+  }
+
+  public static native boolean hasJit();
+  public static native boolean isDebuggable();
+  public static native void ensureJitCompiled(Class<?> cls, String methodName);
+  public static native void ensureJitBaselineCompiled(Class<?> cls, String methodName);
+  public static native boolean hasJitCompiledEntrypoint(Class<?> cls, String methodName);
+  public static native void waitForCompilation();
+}
+
+// Define a subclass with another implementation of value to deoptimize $noinline$foo.
+class SubMain extends Main {
+  public int value() {
+    return 2;
+  }
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+  public static void main(String[] args) {
+    System.loadLibrary(args[0]);
+    if (!hasJit()) {
+      return;
+    }
+    int expected = $noinline$optimizedOnly(newArray());
+    assertEquals(expected, $noinline$baselineFirst(newArray()));
+
+    // Without baseline code to fall back to, an optimized compilation that goes over the budget
+    // is finished without the expensive optimizations, rather than leaving the method in the
+    // interpreter. ensureJitCompiled() waits for optimized code.
+    ensureJitCompiled(Main.class, "$noinline$optimizedOnly");
+    assertEquals(expected, $noinline$optimizedOnly(newArray()));
+
+    // With baseline code, an optimized compilation over the budget is abandoned, and the method
+    // keeps running its baseline code.
+    ensureJitBaselineCompiled(Main.class, "$noinline$baselineFirst");
+    for (int i = 0; i < 10000; ++i) {
+      assertEquals(expected, $noinline$baselineFirst(newArray()));
+    }
+    waitForCompilation();
+    if (!hasJitCompiledEntrypoint(Main.class, "$noinline$baselineFirst")) {
+      throw new Error("Expected $noinline$baselineFirst to keep running JIT code");
+    }
+    assertEquals(expected, $noinline$baselineFirst(newArray()));
+
+    // The abandonment is recorded, so the baseline code getting hot again does not enqueue
+    // another optimized compilation, which would be abandoned again.
+    int abandoned = getAbandonedCompilationCount(Main.class, "$noinline$baselineFirst");
+    for (int i = 0; i < 10000; ++i) {
+      assertEquals(expected, $noinline$baselineFirst(newArray()));
+    }
+    waitForCompilation();
+    if (abandoned > 1 ||
+        getAbandonedCompilationCount(Main.class, "$noinline$baselineFirst") != abandoned) {
+      throw new Error("Expected at most one abandoned compilation of $noinline$baselineFirst");
+    }
+  }
+
+  static int[] newArray() {
+    int[] array = new int[16];
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = i * 31;
+    }
+    return array;
+  }
+
+  static int mix(int value, int seed) {
+    int result = value ^ seed;
+    result = (result << 5) - result;
+    return result ^ (result >>> 7);
+  }
+
+  // Large methods with many loops, that take long to optimize.
+  static int $noinline$optimizedOnly(int[] array) {
+    int sum = 0;
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 3);
+      sum += array[(i + 1) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 10);
+      sum += array[(i + 2) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 17);
+      sum += array[(i + 3) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 24);
+      sum += array[(i + 4) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 31);
+      sum += array[(i + 5) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 38);
+      sum += array[(i + 6) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 45);
+      sum += array[(i + 7) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 52);
+      sum += array[(i + 8) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 59);
+      sum += array[(i + 9) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 66);
+      sum += array[(i + 10) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 73);
+      sum += array[(i + 11) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 80);
+      sum += array[(i + 12) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 87);
+      sum += array[(i + 13) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 94);
+      sum += array[(i + 14) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 101);
+      sum += array[(i + 15) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 108);
+      sum += array[(i + 16) % array.length];
+    }
+    return sum;
+  }
+
+  static int $noinline$baselineFirst(int[] array) {
+    int sum = 0;
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 3);
+      sum += array[(i + 1) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 10);
+      sum += array[(i + 2) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 17);
+      sum += array[(i + 3) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 24);
+      sum += array[(i + 4) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 31);
+      sum += array[(i + 5) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 38);
+      sum += array[(i + 6) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 45);
+      sum += array[(i + 7) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 52);
+      sum += array[(i + 8) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 59);
+      sum += array[(i + 9) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 66);
+      sum += array[(i + 10) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 73);
+      sum += array[(i + 11) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 80);
+      sum += array[(i + 12) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 87);
+      sum += array[(i + 13) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 94);
+      sum += array[(i + 14) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 101);
+      sum += array[(i + 15) % array.length];
+    }
+    for (int i = 0; i < array.length; ++i) {
+      array[i] = mix(array[i], sum + 108);
+      sum += array[(i + 16) % array.length];
+    }
+    return sum;
+  }
+
+  public static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected + ", got " + actual);
+    }
+  }
+
+  public static native boolean hasJit();
+  public static native void ensureJitCompiled(Class<?> cls, String methodName);
+  public static native void ensureJitBaselineCompiled(Class<?> cls, String methodName);
+  public static native boolean hasJitCompiledEntrypoint(Class<?> cls, String methodName);
+  public static native void waitForCompilation();
+  public static native int getAbandonedCompilationCount(Class<?> cls, String methodName);
+}
@@ -0,0 +1,20 @@
+#
+# Copyright (C) 2026 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+def run(ctx, args):
+  # Class loaders must be unloaded by the mark-compact collector, which updates the roots in the
+  # linear allocs during its compaction pause. App images aren't unloaded with their dex files.
+  ctx.default_run(args, android_runtime_option=["-Xgc:CMC"], secondary_app_image=False)
@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Class loaded by a class loader that is unloaded right after.
+public class Unloaded {
+    private static String prefix = "Unloaded ";
+    private static Object[] values = new Object[16];
+
+    public static String run(int value) {
+        for (int i = 0; i < values.length; ++i) {
+            values[i] = new StringBuilder().append(prefix).append(i);
+        }
+        return prefix + value;
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.ref.WeakReference;
+import java.lang.reflect.Constructor;
+import java.lang.reflect.Method;
+import java.util.ArrayList;
+
+public class Main {
+    static final String DEX_FILE = System.getenv("DEX_LOCATION") + "/2287-class-unload-cmc-ex.jar";
+    static final String LIBRARY_SEARCH_PATH = System.getProperty("java.library.path");
+
+    public static void main(String[] args) throws Exception {
+        Class<?> pathClassLoader = Class.forName("dalvik.system.PathClassLoader");
+        Constructor<?> constructor =
+            pathClassLoader.getDeclaredConstructor(String.class, String.class, ClassLoader.class);
+
+        WeakReference<ClassLoader> loader = null;
+        for (int i = 0; i < 20; ++i) {
+            loader = setUpUnloadedLoader(constructor);
+            // Each collection unloads the previous class loader and compacts the heap, moving the
+            // objects that the live class loaders' linear allocs refer to.
+            allocateGarbage();
+            Runtime.getRuntime().gc();
+        }
+        // Do multiple GCs to prevent rare flakiness if some other thread is keeping the
+        // class loader live.
+        for (int i = 0; i < 5; ++i) {
+            Runtime.getRuntime().gc();
+        }
+        System.out.println(loader.get());
+
+        // Loading the class again must not find anything left from the unloaded loaders.
+        setUpUnloadedLoader(constructor);
+        Runtime.getRuntime().gc();
+        System.out.println("Done");
+    }
+
+    private static WeakReference<ClassLoader> setUpUnloadedLoader(Constructor<?> constructor)
+            throws Exception {
+        ClassLoader loader = (ClassLoader) constructor.newInstance(
+            DEX_FILE, LIBRARY_SEARCH_PATH, ClassLoader.getSystemClassLoader());
+        Class<?> klass = loader.loadClass("Unloaded");
+        // Resolve the strings, types and methods used by the class so that the dex cache arrays
+        // in the class loader's linear alloc refer to heap objects.
+        Method run = klass.getDeclaredMethod("run", int.class);
+        Object result = run.invoke(null, 10);
+        if (!"Unloaded 10".equals(result)) {
+            throw new Error("Unexpected result " + result);
+        }
+        return new WeakReference(loader);
+    }
+
+    private static void allocateGarbage() {
+        ArrayList<Object> list = new ArrayList<>();
+        for (int i = 0; i < 1000; ++i) {
+            list.add(new int[i % 100]);
+        }
+    }
+}
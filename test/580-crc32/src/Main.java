@@ -330,6 +330,15 @@ public class Main {
       }
     }
 
+    // Check lengths covering the blocks of 16 and 64 bytes processed at once
+    // by the intrinsics, together with the remaining bytes.
+    for (int o = 0; o < 4; ++o) {
+      for (int l = 17; l <= 300; ++l) {
+        assertEqual(CRC32BytesUsingUpdateInt(bytes, o, l),
+                    CRC32ByteArray(bytes, o, l));
+      }
+    }
+
     int len = bytes.length / 2;
     assertEqual(CRC32BytesUsingUpdateInt(bytes, 0, len - 1),
                 CRC32ByteArray(bytes, 0, len - 1));
@@ -513,6 +522,15 @@ public class Main {
       }
     }
 
+    // Check lengths covering the blocks of 16 and 64 bytes processed at once
+    // by the intrinsics, together with the remaining bytes.
+    for (int o = 0; o < 4; ++o) {
+      for (int l = 17; l <= 300; ++l) {
+        assertEqual(CRC32BytesUsingUpdateInt(bytes, o, l),
+                    CRC32DirectByteBuffer(bytes, o, l));
+      }
+    }
+
     int len = bytes.length / 2;
     assertEqual(CRC32BytesUsingUpdateInt(bytes, 0, len - 1),
                 CRC32DirectByteBuffer(bytes, 0, len - 1));
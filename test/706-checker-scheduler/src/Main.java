@@ -55,6 +55,26 @@ public class Main {
   /// CHECK:    <<res1:i\d+>>         Add [<<res0>>,<<ArrayGet1>>]
   /// CHECK:                          Add [<<res1>>,<<ArrayGet2>>]
 
+  /// CHECK-START-X86_64: int Main.arrayAccess() scheduler (before)
+  /// CHECK:    <<Const1:i\d+>>       IntConstant 1
+  /// CHECK:    <<res0:i\d+>>         Phi
+  /// CHECK:    <<i0:i\d+>>           Phi
+  /// CHECK:    <<ArrayGet1:i\d+>>    ArrayGet [<<Array:l\d+>>,<<i0>>]
+  /// CHECK:    <<res1:i\d+>>         Add [<<res0>>,<<ArrayGet1>>]
+  /// CHECK:    <<i1:i\d+>>           Add [<<i0>>,<<Const1>>]
+  /// CHECK:    <<ArrayGet2:i\d+>>    ArrayGet [<<Array>>,<<i1>>]
+  /// CHECK:                          Add [<<res1>>,<<ArrayGet2>>]
+
+  /// CHECK-START-X86_64: int Main.arrayAccess() scheduler (after)
+  /// CHECK:    <<Const1:i\d+>>       IntConstant 1
+  /// CHECK:    <<res0:i\d+>>         Phi
+  /// CHECK:    <<i0:i\d+>>           Phi
+  /// CHECK:    <<ArrayGet1:i\d+>>    ArrayGet [<<Array:l\d+>>,<<i0>>]
+  /// CHECK:    <<i1:i\d+>>           Add [<<i0>>,<<Const1>>]
+  /// CHECK:    <<ArrayGet2:i\d+>>    ArrayGet [<<Array>>,<<i1>>]
+  /// CHECK:    <<res1:i\d+>>         Add [<<res0>>,<<ArrayGet1>>]
+  /// CHECK:                          Add [<<res1>>,<<ArrayGet2>>]
+
   public static int arrayAccess() {
     int res = 0;
     int [] array = new int[10];
@@ -522,6 +542,38 @@ public class Main {
     return res;
   }
 
+  // The scheduler runs before memory operand generation, so it never sees an ArrayLength
+  // emitted at its BoundsCheck, and cannot move instructions between the two.
+  /// CHECK-START-X86_64: int Main.rowAccess(int[][], int) scheduler (after)
+  /// CHECK:               NullCheck loop:B{{\d+}}
+  /// CHECK:               ArrayLength loop:B{{\d+}}
+  /// CHECK:               BoundsCheck loop:B{{\d+}}
+
+  /// CHECK-START-X86_64: int Main.rowAccess(int[][], int) scheduler (after)
+  /// CHECK-NOT:           emitted_at_use:true
+  public static int rowAccess(int[][] rows, int d) {
+    int res = 0;
+    for (int i = 0; i < rows.length; i++) {
+      int[] row = rows[i];
+      res += row[i] + i / d;
+    }
+    return res;
+  }
+
+  public static void testRowAccess() {
+    int[][] rows = new int[3][];
+    for (int i = 0; i < rows.length; i++) {
+      rows[i] = new int[] { 1, 2, 3 };
+    }
+    expectEquals(9, rowAccess(rows, 1));
+    rows[1] = null;
+    try {
+      rowAccess(rows, 1);
+      System.out.println("FAIL: expected NullPointerException");
+    } catch (NullPointerException expected) {
+    }
+  }
+
   private static void expectEquals(int expected, int result) {
     if (expected != result) {
       throw new Error("Expected: " + expected + ", found: " + result);
@@ -704,6 +756,7 @@ public class Main {
     testCrossItersDependencies();
     testNoSelfDependantSchedNode(3);
     testNonPreventingSchedulingCrossItersDeps(3);
+    testRowAccess();
     if ((arrayAccess() + intDiv(10)) != -35) {
       System.out.println("FAIL");
     }
@@ -55,6 +55,10 @@ target_config = {
     'art-jit-on-first-use' : {
         'run-test' : ['--jit-on-first-use']
     },
+    'art-optimizing-graph-color' : {
+        # Allocate registers of all optimized code with the graph coloring allocator.
+        'run-test' : ['--optimizing-graph-color']
+    },
     'art-pictest' : {
         # Deprecated config: All AOT-compiled code is PIC now.
         'run-test' : ['--optimizing']
@@ -242,7 +242,8 @@ def gather_test_info():
   VARIANT_TYPE_DICT['jvmti'] = {'no-jvmti', 'jvmti-stress', 'redefine-stress', 'trace-stress',
                                 'field-stress', 'step-stress'}
   VARIANT_TYPE_DICT['compiler'] = {'interp-ac', 'interpreter', 'jit', 'jit-on-first-use',
-                                   'optimizing', 'speed-profile', 'baseline'}
+                                   'optimizing', 'optimizing-graph-color', 'speed-profile',
+                                   'baseline'}
 
   for v_type in VARIANT_TYPE_DICT:
     TOTAL_VARIANTS_SET = TOTAL_VARIANTS_SET.union(VARIANT_TYPE_DICT.get(v_type))
@@ -515,6 +516,9 @@ def run_tests(tests):
 
       if compiler == 'optimizing':
         args_test += ['--optimizing']
+      elif compiler == 'optimizing-graph-color':
+        args_test += ['--optimizing',
+                      '-Xcompiler-option', '--register-allocation-strategy=graph-color']
       elif compiler == 'interpreter':
         args_test += ['--interpreter']
       elif compiler == 'interp-ac':